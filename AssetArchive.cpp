@@ -0,0 +1,528 @@
+#include "AssetArchive.h"
+#include "LzCompression.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace std;
+
+AssetArchive::AssetArchive()
+{
+	_data = nullptr;
+	_size = 0;
+	_header = nullptr;
+	_entries = nullptr;
+	_slots = nullptr;
+	_names = nullptr;
+	_storedBytesRead = 0;
+	_dataBytesRead = 0;
+	_decompressNanoseconds = 0;
+}
+
+AssetArchive::~AssetArchive()
+{
+	Close();
+}
+
+bool AssetArchive::Open(const string& fileName)
+{
+	Close();
+	if (!_file.Open(fileName) || _file.GetSize() < sizeof(AssetArchiveHeader))
+	{
+		Close();
+		return false;
+	}
+	_data = _file.GetData();
+	_size = _file.GetSize();
+	_header = reinterpret_cast<const AssetArchiveHeader*>(_data);
+	_entries = reinterpret_cast<const AssetArchiveEntry*>(_data + sizeof(AssetArchiveHeader));
+	_slots = reinterpret_cast<const uint32_t*>(_entries + _header->EntryCount);
+	_names = reinterpret_cast<const char*>(_data + _header->NamesOffset);
+	if (!Validate())
+	{
+		Close();
+		return false;
+	}
+	_foundEntries = make_unique<atomic<bool>[]>(_header->EntryCount);
+	_storedBytesRead = 0;
+	_dataBytesRead = 0;
+	_decompressNanoseconds = 0;
+	return true;
+}
+
+void AssetArchive::Close()
+{
+	_file.Close();
+	_foundEntries.reset();
+	_data = nullptr;
+	_size = 0;
+	_header = nullptr;
+	_entries = nullptr;
+	_slots = nullptr;
+	_names = nullptr;
+}
+
+// Check that everything in the table of contents lies within the file, so that a damaged archive cannot
+// make us read outside the mapping
+bool AssetArchive::Validate() const
+{
+	if (_header->Magic != AssetArchiveMagic || _header->Version != AssetArchiveVersion)
+	{
+		return false;
+	}
+	if (_header->SlotCount == 0 || (_header->SlotCount & (_header->SlotCount - 1)) != 0 || _header->SlotCount <= _header->EntryCount)
+	{
+		return false;
+	}
+	uint64_t tableEnd = sizeof(AssetArchiveHeader) +
+						static_cast<uint64_t>(_header->EntryCount) * sizeof(AssetArchiveEntry) +
+						static_cast<uint64_t>(_header->SlotCount) * sizeof(uint32_t);
+	if (tableEnd > _size || _header->NamesOffset < tableEnd ||
+		_header->NamesOffset > _size || _header->NamesSize > _size - _header->NamesOffset)
+	{
+		return false;
+	}
+	for (uint32_t i = 0; i < _header->EntryCount; i++)
+	{
+		const AssetArchiveEntry& entry = _entries[i];
+		if (static_cast<uint64_t>(entry.NameOffset) + entry.NameLength > _header->NamesSize ||
+			entry.DataOffset > _size || entry.StoredSize > _size - entry.DataOffset)
+		{
+			return false;
+		}
+		if (entry.Compression == AssetCompressionNone)
+		{
+			if (entry.StoredSize != entry.DataSize)
+			{
+				return false;
+			}
+		}
+		else if (entry.Compression == AssetCompressionLz)
+		{
+			// The sizes of the chunks themselves are checked when the asset is read
+			if (entry.ChunkSize == 0 || (entry.DataSize + entry.ChunkSize - 1) / entry.ChunkSize * sizeof(uint32_t) > entry.StoredSize)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			return false;
+		}
+	}
+	// A lookup of a name that is not in the archive stops at an empty slot, so there has to be one
+	uint32_t emptySlotCount = 0;
+	for (uint32_t i = 0; i < _header->SlotCount; i++)
+	{
+		if (_slots[i] > _header->EntryCount)
+		{
+			return false;
+		}
+		if (_slots[i] == 0)
+		{
+			emptySlotCount++;
+		}
+	}
+	return emptySlotCount > 0;
+}
+
+const AssetArchiveEntry* AssetArchive::FindEntry(string_view name) const
+{
+	if (!_header)
+	{
+		return nullptr;
+	}
+	string normalisedName = NormaliseName(name);
+	uint64_t hash = HashName(normalisedName);
+	uint32_t mask = _header->SlotCount - 1;
+	uint32_t slot = static_cast<uint32_t>(hash) & mask;
+	for (uint32_t probe = 0; probe < _header->SlotCount && _slots[slot] != 0; probe++, slot = (slot + 1) & mask)
+	{
+		const AssetArchiveEntry& entry = _entries[_slots[slot] - 1];
+		if (entry.NameHash == hash && string_view(_names + entry.NameOffset, entry.NameLength) == normalisedName)
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+bool AssetArchive::Find(string_view name, const uint8_t*& data, size_t& size) const
+{
+	const AssetArchiveEntry* entry = FindEntry(name);
+	if (!entry || entry->Compression != AssetCompressionNone)
+	{
+		return false;
+	}
+	data = _data + entry->DataOffset;
+	size = static_cast<size_t>(entry->DataSize);
+	// Finding the asset again hands out the same memory, so it is only counted the first time
+	if (!_foundEntries[entry - _entries].exchange(true))
+	{
+		_storedBytesRead += size;
+		_dataBytesRead += size;
+	}
+	return true;
+}
+
+bool AssetArchive::GetAssetSize(string_view name, size_t& size) const
+{
+	const AssetArchiveEntry* entry = FindEntry(name);
+	if (!entry)
+	{
+		return false;
+	}
+	size = static_cast<size_t>(entry->DataSize);
+	return true;
+}
+
+bool AssetArchive::GetAssetOffset(string_view name, uint64_t& offset) const
+{
+	const AssetArchiveEntry* entry = FindEntry(name);
+	if (!entry)
+	{
+		return false;
+	}
+	offset = entry->DataOffset;
+	return true;
+}
+
+bool AssetArchive::Read(string_view name, uint8_t* destination, size_t destinationSize) const
+{
+	const AssetArchiveEntry* entry = FindEntry(name);
+	if (!entry || entry->DataSize != destinationSize)
+	{
+		return false;
+	}
+	const uint8_t* stored = _data + entry->DataOffset;
+	if (entry->Compression == AssetCompressionNone)
+	{
+		if (destinationSize > 0)
+		{
+			memcpy(destination, stored, destinationSize);
+		}
+		_storedBytesRead += destinationSize;
+		_dataBytesRead += destinationSize;
+		return true;
+	}
+
+	// Find where each chunk starts from the table of chunk sizes
+	size_t chunkCount = static_cast<size_t>((entry->DataSize + entry->ChunkSize - 1) / entry->ChunkSize);
+	const uint8_t* chunkSizes = stored;
+	vector<uint64_t> chunkOffsets(chunkCount + 1);
+	chunkOffsets[0] = chunkCount * sizeof(uint32_t);
+	for (size_t i = 0; i < chunkCount; i++)
+	{
+		uint32_t chunkSize;
+		memcpy(&chunkSize, chunkSizes + i * sizeof(uint32_t), sizeof(chunkSize));
+		chunkOffsets[i + 1] = chunkOffsets[i] + chunkSize;
+	}
+	if (chunkOffsets[chunkCount] > entry->StoredSize)
+	{
+		return false;
+	}
+
+	auto start = chrono::steady_clock::now();
+	atomic<bool> succeeded(true);
+	ParallelFor(chunkCount, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t dataOffset = i * entry->ChunkSize;
+			size_t dataSize = (std::min)(static_cast<size_t>(entry->ChunkSize), destinationSize - dataOffset);
+			const uint8_t* chunk = stored + chunkOffsets[i];
+			size_t chunkSize = static_cast<size_t>(chunkOffsets[i + 1] - chunkOffsets[i]);
+			if (chunkSize == dataSize)
+			{
+				// This chunk did not compress
+				memcpy(destination + dataOffset, chunk, dataSize);
+			}
+			else if (!LzDecompress(chunk, chunkSize, destination + dataOffset, dataSize))
+			{
+				succeeded = false;
+			}
+		}
+	});
+	auto finish = chrono::steady_clock::now();
+	_decompressNanoseconds += chrono::duration_cast<chrono::nanoseconds>(finish - start).count();
+	_storedBytesRead += entry->StoredSize;
+	_dataBytesRead += destinationSize;
+	return succeeded;
+}
+
+bool AssetArchive::Read(string_view name, vector<uint8_t>& contents) const
+{
+	size_t size;
+	if (!GetAssetSize(name, size))
+	{
+		return false;
+	}
+	contents.resize(size);
+	return Read(name, contents.data(), size);
+}
+
+AssetArchiveStatistics AssetArchive::GetStatistics() const
+{
+	AssetArchiveStatistics statistics;
+	statistics.StoredBytes = _storedBytesRead;
+	statistics.DataBytes = _dataBytesRead;
+	statistics.DecompressMilliseconds = _decompressNanoseconds / 1.0e6;
+	return statistics;
+}
+
+bool AssetArchive::Contains(string_view name) const
+{
+	return FindEntry(name) != nullptr;
+}
+
+string_view AssetArchive::GetAssetName(size_t i) const
+{
+	if (!_header || i >= _header->EntryCount)
+	{
+		return string_view();
+	}
+	return string_view(_names + _entries[i].NameOffset, _entries[i].NameLength);
+}
+
+string AssetArchive::NormaliseName(string_view name)
+{
+	string normalisedName;
+	normalisedName.reserve(name.size());
+	for (char character : name)
+	{
+		if (character == '\\')
+		{
+			character = '/';
+		}
+		else if (character >= 'A' && character <= 'Z')
+		{
+			character = character - 'A' + 'a';
+		}
+		// Collapse repeated separators
+		if (character == '/' && !normalisedName.empty() && normalisedName.back() == '/')
+		{
+			continue;
+		}
+		normalisedName.push_back(character);
+	}
+	while (normalisedName.compare(0, 2, "./") == 0)
+	{
+		normalisedName.erase(0, 2);
+	}
+	return normalisedName;
+}
+
+uint64_t AssetArchive::HashName(string_view normalisedName)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (char character : normalisedName)
+	{
+		hash = (hash ^ static_cast<uint8_t>(character)) * 1099511628211ull;
+	}
+	return hash;
+}
+
+// AssetArchiveWriter methods
+
+void AssetArchiveWriter::AddAsset(string_view name, vector<uint8_t> data)
+{
+	string normalisedName = AssetArchive::NormaliseName(name);
+	for (PendingAsset& asset : _assets)
+	{
+		if (asset.Name == normalisedName)
+		{
+			asset.Data = move(data);
+			return;
+		}
+	}
+	_assets.push_back({ normalisedName, move(data) });
+}
+
+bool AssetArchiveWriter::AddFile(string_view name, const string& fileName)
+{
+	vector<uint8_t> data;
+	if (!ReadFileContents(fileName, data))
+	{
+		return false;
+	}
+	AddAsset(name, move(data));
+	return true;
+}
+
+namespace
+{
+	// Compress an asset in chunks, in parallel.  Returns false (leaving stored empty) if compression would not
+	// save at least an eighth of the size, in which case the asset is better stored uncompressed.
+	bool CompressAsset(const vector<uint8_t>& data, vector<uint8_t>& stored)
+	{
+		size_t chunkCount = (data.size() + AssetArchiveChunkSize - 1) / AssetArchiveChunkSize;
+		if (chunkCount == 0)
+		{
+			return false;
+		}
+		vector<vector<uint8_t>> chunks(chunkCount);
+		ParallelFor(chunkCount, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				size_t dataOffset = i * AssetArchiveChunkSize;
+				size_t dataSize = (std::min)(static_cast<size_t>(AssetArchiveChunkSize), data.size() - dataOffset);
+				LzCompress(data.data() + dataOffset, dataSize, chunks[i]);
+				if (chunks[i].size() >= dataSize)
+				{
+					// Store the chunk as it is
+					chunks[i].assign(data.begin() + dataOffset, data.begin() + dataOffset + dataSize);
+				}
+			}
+		});
+		size_t storedSize = chunkCount * sizeof(uint32_t);
+		for (const vector<uint8_t>& chunk : chunks)
+		{
+			storedSize += chunk.size();
+		}
+		if (storedSize > data.size() - data.size() / 8)
+		{
+			return false;
+		}
+		stored.resize(chunkCount * sizeof(uint32_t));
+		stored.reserve(storedSize);
+		for (size_t i = 0; i < chunkCount; i++)
+		{
+			uint32_t chunkSize = static_cast<uint32_t>(chunks[i].size());
+			memcpy(stored.data() + i * sizeof(uint32_t), &chunkSize, sizeof(chunkSize));
+			stored.insert(stored.end(), chunks[i].begin(), chunks[i].end());
+		}
+		return true;
+	}
+}
+
+bool AssetArchiveWriter::Write(const string& fileName, bool compress) const
+{
+	// Sort the assets by name so that the same set of assets always produces the same archive
+	vector<const PendingAsset*> assets;
+	for (const PendingAsset& asset : _assets)
+	{
+		assets.push_back(&asset);
+	}
+	sort(assets.begin(), assets.end(), [](const PendingAsset* a, const PendingAsset* b) { return a->Name < b->Name; });
+
+	// Keep the hash table no more than half full
+	uint32_t slotCount = 16;
+	while (slotCount < assets.size() * 2)
+	{
+		slotCount *= 2;
+	}
+	AssetArchiveHeader header;
+	header.Magic = AssetArchiveMagic;
+	header.Version = AssetArchiveVersion;
+	header.EntryCount = static_cast<uint32_t>(assets.size());
+	header.SlotCount = slotCount;
+	header.NamesOffset = sizeof(AssetArchiveHeader) + assets.size() * sizeof(AssetArchiveEntry) + slotCount * sizeof(uint32_t);
+	header.NamesSize = 0;
+	for (const PendingAsset* asset : assets)
+	{
+		header.NamesSize += asset->Name.size();
+	}
+
+	// Data actually stored for each compressed asset (empty if the asset is stored uncompressed)
+	vector<vector<uint8_t>> compressedData(assets.size());
+	if (compress)
+	{
+		for (size_t i = 0; i < assets.size(); i++)
+		{
+			CompressAsset(assets[i]->Data, compressedData[i]);
+		}
+	}
+
+	vector<AssetArchiveEntry> entries(assets.size());
+	vector<uint32_t> slots(slotCount, 0);
+	uint32_t nameOffset = 0;
+	uint64_t dataOffset = header.NamesOffset + header.NamesSize;
+	for (size_t i = 0; i < assets.size(); i++)
+	{
+		dataOffset = (dataOffset + AssetArchiveAlignment - 1) / AssetArchiveAlignment * AssetArchiveAlignment;
+		AssetArchiveEntry& entry = entries[i];
+		entry.NameHash = AssetArchive::HashName(assets[i]->Name);
+		entry.DataOffset = dataOffset;
+		entry.DataSize = assets[i]->Data.size();
+		entry.NameOffset = nameOffset;
+		entry.NameLength = static_cast<uint32_t>(assets[i]->Name.size());
+		if (compressedData[i].empty())
+		{
+			entry.StoredSize = entry.DataSize;
+			entry.Compression = AssetCompressionNone;
+			entry.ChunkSize = 0;
+		}
+		else
+		{
+			entry.StoredSize = compressedData[i].size();
+			entry.Compression = AssetCompressionLz;
+			entry.ChunkSize = AssetArchiveChunkSize;
+		}
+		nameOffset += entry.NameLength;
+		dataOffset += entry.StoredSize;
+
+		uint32_t slot = static_cast<uint32_t>(entry.NameHash) & (slotCount - 1);
+		while (slots[slot] != 0)
+		{
+			slot = (slot + 1) & (slotCount - 1);
+		}
+		slots[slot] = static_cast<uint32_t>(i + 1);
+	}
+
+	// Write to a temporary file and then replace the archive, so that a reader never sees a partly written archive
+	filesystem::path archivePath = filesystem::u8path(fileName);
+	filesystem::path temporaryPath = archivePath;
+	temporaryPath += ".tmp";
+	{
+		ofstream file(temporaryPath, ios::binary | ios::trunc);
+		if (!file)
+		{
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(AssetArchiveEntry));
+		file.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(uint32_t));
+		for (const PendingAsset* asset : assets)
+		{
+			file.write(asset->Name.data(), asset->Name.size());
+		}
+		uint64_t position = header.NamesOffset + header.NamesSize;
+		const char padding[AssetArchiveAlignment] = {};
+		for (size_t i = 0; i < assets.size(); i++)
+		{
+			const vector<uint8_t>& stored = compressedData[i].empty() ? assets[i]->Data : compressedData[i];
+			file.write(padding, entries[i].DataOffset - position);
+			file.write(reinterpret_cast<const char*>(stored.data()), stored.size());
+			position = entries[i].DataOffset + entries[i].StoredSize;
+		}
+		if (!file)
+		{
+			return false;
+		}
+	}
+	error_code error;
+	filesystem::rename(temporaryPath, archivePath, error);
+	return !error;
+}
+
+bool ReadFileContents(const string& fileName, vector<uint8_t>& contents)
+{
+	ifstream file(filesystem::u8path(fileName), ios::binary | ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+	streamoff size = file.tellg();
+	if (size < 0)
+	{
+		return false;
+	}
+	contents.resize(static_cast<size_t>(size));
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(contents.data()), size);
+	return static_cast<bool>(file);
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include "MappedFile.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Packed asset archive.
+//
+// All of the assets are stored in a single file that is memory mapped when it is opened, so reading an
+// asset is just a lookup in the table of contents followed by a pointer into the mapping.  There are no
+// further opens or seeks, and the operating system reads the file through the page cache as it is used.
+//
+// The table of contents is a hash table.  Asset names are normalised (lower case, '/' separators, no
+// leading "./") and hashed with 64-bit FNV-1a, and the hash selects a slot in an open addressing table
+// (linear probing) that holds the index of the entry plus one, or zero for an empty slot.
+//
+// The file is laid out as (all values little-endian):
+//
+//		AssetArchiveHeader
+//		AssetArchiveEntry[EntryCount]
+//		uint32_t[SlotCount]				hash table of entry indices
+//		char[NamesSize]					asset names (UTF-8, not null terminated)
+//		asset data						each asset starts on a multiple of AssetArchiveAlignment
+//
+// Assets that compress well are split into chunks of AssetArchiveChunkSize bytes, each compressed on its
+// own (see LzCompression.h), so the chunks of an asset can be decompressed in parallel straight into the
+// memory the asset is going to be used from.  The data of a compressed asset starts with the stored size
+// of each chunk (as uint32_t), followed by the chunks.  A chunk that did not get smaller is stored as it
+// is.  Assets that do not compress well are stored uncompressed and can be used directly from the mapping.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+#define AssetArchiveMagic		0x4B505844		// "DXPK"
+#define AssetArchiveVersion		2
+#define AssetArchiveAlignment	16
+#define AssetArchiveChunkSize	(64 * 1024)
+
+#define AssetCompressionNone	0
+#define AssetCompressionLz		1
+
+struct AssetArchiveHeader
+{
+	uint32_t		Magic;
+	uint32_t		Version;
+	uint32_t		EntryCount;
+	// Number of slots in the hash table (a power of two)
+	uint32_t		SlotCount;
+	uint64_t		NamesOffset;
+	uint64_t		NamesSize;
+};
+
+struct AssetArchiveEntry
+{
+	uint64_t		NameHash;
+	uint64_t		DataOffset;
+	// Size of the asset once it has been decompressed
+	uint64_t		DataSize;
+	// Size of the data stored in the archive
+	uint64_t		StoredSize;
+	// Offset of the name from the start of the names
+	uint32_t		NameOffset;
+	uint32_t		NameLength;
+	uint32_t		Compression;
+	// Size of each chunk before it was compressed (the last chunk can be smaller)
+	uint32_t		ChunkSize;
+};
+
+// Totals for the assets read from an archive since it was opened.  Assets are counted each time they are
+// read, except that an uncompressed asset that is used from the mapping (see Find) is only counted once.
+struct AssetArchiveStatistics
+{
+	uint64_t		StoredBytes;
+	uint64_t		DataBytes;
+	// Time spent decompressing (summed over all of the threads that read assets)
+	double			DecompressMilliseconds;
+};
+
+class AssetArchive
+{
+public:
+	AssetArchive();
+	~AssetArchive();
+
+	AssetArchive(const AssetArchive&) = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+
+	// fileName is UTF-8.  Returns false if the file could not be opened or is not a valid archive.
+	bool					Open(const std::string& fileName);
+	void					Close();
+	inline bool				IsOpen() const { return _header != nullptr; }
+
+	// Find an asset that is stored uncompressed.  data points into the mapping of the archive and stays
+	// valid until the archive is closed.  Returns false if there is no such asset or if it is compressed.
+	bool					Find(std::string_view name, const uint8_t*& data, std::size_t& size) const;
+	bool					Contains(std::string_view name) const;
+
+	// Size of an asset once it has been decompressed
+	bool					GetAssetSize(std::string_view name, std::size_t& size) const;
+	// Where the data of an asset starts in the archive file, so that a set of assets can be read in the
+	// order they are stored
+	bool					GetAssetOffset(std::string_view name, uint64_t& offset) const;
+	// Decompress (or copy) a whole asset into destination, which must be the size of the asset.  The chunks of
+	// the asset are decompressed in parallel.  Returns false if there is no such asset or it is damaged.
+	bool					Read(std::string_view name, uint8_t* destination, std::size_t destinationSize) const;
+	bool					Read(std::string_view name, std::vector<uint8_t>& contents) const;
+
+	AssetArchiveStatistics	GetStatistics() const;
+
+	inline std::size_t		GetAssetCount() const { return _header ? _header->EntryCount : 0; }
+	std::string_view		GetAssetName(std::size_t i) const;
+
+	static std::string		NormaliseName(std::string_view name);
+	static uint64_t			HashName(std::string_view normalisedName);
+
+private:
+	const uint8_t*				_data;
+	std::size_t					_size;
+	const AssetArchiveHeader*	_header;
+	const AssetArchiveEntry*	_entries;
+	const uint32_t*				_slots;
+	const char*					_names;
+	// Whether each entry has been handed out by Find
+	mutable std::unique_ptr<std::atomic<bool>[]>	_foundEntries;
+	mutable std::atomic<uint64_t>	_storedBytesRead;
+	mutable std::atomic<uint64_t>	_dataBytesRead;
+	mutable std::atomic<uint64_t>	_decompressNanoseconds;
+	MappedFile					_file;
+
+	const AssetArchiveEntry*	FindEntry(std::string_view name) const;
+	bool						Validate() const;
+};
+
+// Builds an archive from a set of assets
+class AssetArchiveWriter
+{
+public:
+	// Adding an asset with the same name as an earlier one replaces it
+	void					AddAsset(std::string_view name, std::vector<uint8_t> data);
+	// fileName is UTF-8.  Returns false if the file could not be read.
+	bool					AddFile(std::string_view name, const std::string& fileName);
+
+	// If compress is true, assets that compress well are stored compressed.  Returns false if the archive
+	// could not be written.
+	bool					Write(const std::string& fileName, bool compress = true) const;
+
+	inline std::size_t		GetAssetCount() const { return _assets.size(); }
+
+private:
+	struct PendingAsset
+	{
+		std::string				Name;
+		std::vector<uint8_t>	Data;
+	};
+
+	std::vector<PendingAsset>	_assets;
+};
+
+// Read a whole file (fileName is UTF-8).  Returns false if the file could not be read.
+bool ReadFileContents(const std::string& fileName, std::vector<uint8_t>& contents);
@@ -0,0 +1,1010 @@
+#include "BlockCompression.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLOCK_COMPRESSION_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+	// The pixels of a block held as one array per channel (RGBA, 0 to 255), so that four pixels can be
+	// worked on at a time
+	struct BlockPixels
+	{
+		alignas(16) float	Channels[4][16];
+	};
+
+	// Palette weights of the second endpoint for each index
+	const float FourColourWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+	const float ThreeColourWeights[3] = { 0.0f, 1.0f, 0.5f };
+	const float AlphaWeights[8] = { 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+	// BC7 interpolation weights (out of 64) for 2-bit and 4-bit indices
+	const int Bc7Weights2[4] = { 0, 21, 43, 64 };
+	const int Bc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+	const float Bc7FloatWeights2[4] = { 0.0f, 21.0f / 64.0f, 43.0f / 64.0f, 1.0f };
+	const float Bc7FloatWeights4[16] = { 0.0f, 4.0f / 64.0f, 9.0f / 64.0f, 13.0f / 64.0f, 17.0f / 64.0f, 21.0f / 64.0f, 26.0f / 64.0f, 30.0f / 64.0f,
+										 34.0f / 64.0f, 38.0f / 64.0f, 43.0f / 64.0f, 47.0f / 64.0f, 51.0f / 64.0f, 55.0f / 64.0f, 60.0f / 64.0f, 1.0f };
+
+	inline float ClampChannel(float value)
+	{
+		return value > 0.0f ? (value < 255.0f ? value : 255.0f) : 0.0f;
+	}
+
+	inline int RoundChannel(float value, int maximum)
+	{
+		return (min)((max)(static_cast<int>(value + 0.5f), 0), maximum);
+	}
+
+	inline int InterpolateBc7(int first, int second, int weight)
+	{
+		return ((64 - weight) * first + weight * second + 32) >> 6;
+	}
+
+	// Reads a block of pixels, repeating the edge pixels of the image where the block goes past them
+	void LoadBlock(const uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch, bool bgra, uint32_t blockX, uint32_t blockY, BlockPixels& block)
+	{
+		for (uint32_t y = 0; y < 4; y++)
+		{
+			const uint8_t* row = pixels + (min)(blockY * 4 + y, height - 1) * rowPitch;
+			for (uint32_t x = 0; x < 4; x++)
+			{
+				const uint8_t* pixel = row + (min)(blockX * 4 + x, width - 1) * 4;
+				uint32_t i = y * 4 + x;
+				block.Channels[0][i] = pixel[bgra ? 2 : 0];
+				block.Channels[1][i] = pixel[1];
+				block.Channels[2][i] = pixel[bgra ? 0 : 2];
+				block.Channels[3][i] = pixel[3];
+			}
+		}
+	}
+
+	// Find the palette entry nearest to each pixel in mask (a bit per pixel), over the channels
+	// [firstChannel, firstChannel + channelCount).  Returns the total squared error of those pixels.
+	float ChooseIndices(const BlockPixels& block, int firstChannel, int channelCount, const float (*palette)[4], int paletteSize, uint32_t mask, uint8_t indices[16])
+	{
+		alignas(16) float errors[16];
+#ifdef BLOCK_COMPRESSION_SSE2
+		for (int group = 0; group < 16; group += 4)
+		{
+			__m128 best = _mm_set1_ps(FLT_MAX);
+			__m128 bestIndex = _mm_setzero_ps();
+			for (int entry = 0; entry < paletteSize; entry++)
+			{
+				__m128 distance = _mm_setzero_ps();
+				for (int c = firstChannel; c < firstChannel + channelCount; c++)
+				{
+					__m128 difference = _mm_sub_ps(_mm_load_ps(&block.Channels[c][group]), _mm_set1_ps(palette[entry][c]));
+					distance = _mm_add_ps(distance, _mm_mul_ps(difference, difference));
+				}
+				__m128 closer = _mm_cmplt_ps(distance, best);
+				best = _mm_min_ps(distance, best);
+				bestIndex = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps(static_cast<float>(entry))), _mm_andnot_ps(closer, bestIndex));
+			}
+			_mm_store_ps(errors + group, best);
+			alignas(16) int32_t groupIndices[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(groupIndices), _mm_cvttps_epi32(bestIndex));
+			for (int i = 0; i < 4; i++)
+			{
+				indices[group + i] = static_cast<uint8_t>(groupIndices[i]);
+			}
+		}
+#else
+		for (int i = 0; i < 16; i++)
+		{
+			errors[i] = FLT_MAX;
+			indices[i] = 0;
+			for (int entry = 0; entry < paletteSize; entry++)
+			{
+				float distance = 0.0f;
+				for (int c = firstChannel; c < firstChannel + channelCount; c++)
+				{
+					float difference = block.Channels[c][i] - palette[entry][c];
+					distance += difference * difference;
+				}
+				if (distance < errors[i])
+				{
+					errors[i] = distance;
+					indices[i] = static_cast<uint8_t>(entry);
+				}
+			}
+		}
+#endif
+		float error = 0.0f;
+		for (int i = 0; i < 16; i++)
+		{
+			if (mask & (1u << i))
+			{
+				error += errors[i];
+			}
+		}
+		return error;
+	}
+
+	// Endpoints at the ends of the principal axis of the pixels in mask
+	void FitPrincipalAxis(const BlockPixels& block, int firstChannel, int channelCount, uint32_t mask, float endpoints[2][4])
+	{
+		float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		int count = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			if (mask & (1u << i))
+			{
+				for (int c = 0; c < channelCount; c++)
+				{
+					mean[c] += block.Channels[firstChannel + c][i];
+				}
+				count++;
+			}
+		}
+		for (int c = 0; c < channelCount; c++)
+		{
+			mean[c] /= (max)(count, 1);
+		}
+
+		float covariance[4][4] = {};
+		for (int i = 0; i < 16; i++)
+		{
+			if (mask & (1u << i))
+			{
+				for (int c = 0; c < channelCount; c++)
+				{
+					for (int d = 0; d < channelCount; d++)
+					{
+						covariance[c][d] += (block.Channels[firstChannel + c][i] - mean[c]) * (block.Channels[firstChannel + d][i] - mean[d]);
+					}
+				}
+			}
+		}
+
+		// Power iteration, starting from the row of the channel that varies most
+		int widest = 0;
+		for (int c = 1; c < channelCount; c++)
+		{
+			if (covariance[c][c] > covariance[widest][widest])
+			{
+				widest = c;
+			}
+		}
+		float axis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int c = 0; c < channelCount; c++)
+		{
+			axis[c] = covariance[widest][c];
+		}
+		for (int iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float largest = 0.0f;
+			for (int c = 0; c < channelCount; c++)
+			{
+				for (int d = 0; d < channelCount; d++)
+				{
+					next[c] += covariance[c][d] * axis[d];
+				}
+				largest = (max)(largest, fabsf(next[c]));
+			}
+			if (largest == 0.0f)
+			{
+				break;
+			}
+			for (int c = 0; c < channelCount; c++)
+			{
+				axis[c] = next[c] / largest;
+			}
+		}
+
+		float axisLength = 0.0f;
+		for (int c = 0; c < channelCount; c++)
+		{
+			axisLength += axis[c] * axis[c];
+		}
+		float lowest = 0.0f;
+		float highest = 0.0f;
+		if (axisLength > 0.0f)
+		{
+			lowest = FLT_MAX;
+			highest = -FLT_MAX;
+			for (int i = 0; i < 16; i++)
+			{
+				if (mask & (1u << i))
+				{
+					float t = 0.0f;
+					for (int c = 0; c < channelCount; c++)
+					{
+						t += (block.Channels[firstChannel + c][i] - mean[c]) * axis[c];
+					}
+					t /= axisLength;
+					lowest = (min)(lowest, t);
+					highest = (max)(highest, t);
+				}
+			}
+		}
+		for (int c = 0; c < channelCount; c++)
+		{
+			endpoints[0][firstChannel + c] = ClampChannel(mean[c] + lowest * axis[c]);
+			endpoints[1][firstChannel + c] = ClampChannel(mean[c] + highest * axis[c]);
+		}
+	}
+
+	// Least squares endpoints for the pixels in mask, given the index chosen for each pixel and the weight of
+	// the second endpoint for each index.  Returns false if the indices do not pin the endpoints down.
+	bool RefineEndpoints(const BlockPixels& block, int firstChannel, int channelCount, uint32_t mask, const uint8_t indices[16], const float* weights, float endpoints[2][4])
+	{
+		float firstFirst = 0.0f;
+		float firstSecond = 0.0f;
+		float secondSecond = 0.0f;
+		float firstSum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float secondSum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 16; i++)
+		{
+			if (mask & (1u << i))
+			{
+				float second = weights[indices[i]];
+				float first = 1.0f - second;
+				firstFirst += first * first;
+				firstSecond += first * second;
+				secondSecond += second * second;
+				for (int c = firstChannel; c < firstChannel + channelCount; c++)
+				{
+					firstSum[c - firstChannel] += first * block.Channels[c][i];
+					secondSum[c - firstChannel] += second * block.Channels[c][i];
+				}
+			}
+		}
+		float determinant = firstFirst * secondSecond - firstSecond * firstSecond;
+		if (fabsf(determinant) < 1.0e-6f)
+		{
+			return false;
+		}
+		for (int c = 0; c < channelCount; c++)
+		{
+			endpoints[0][firstChannel + c] = ClampChannel((secondSecond * firstSum[c] - firstSecond * secondSum[c]) / determinant);
+			endpoints[1][firstChannel + c] = ClampChannel((firstFirst * secondSum[c] - firstSecond * firstSum[c]) / determinant);
+		}
+		return true;
+	}
+
+	inline int GetIterationCount(BlockQuality quality)
+	{
+		return quality == BlockQuality::Fast ? 1 : (quality == BlockQuality::Normal ? 3 : 6);
+	}
+
+	uint16_t PackColour565(const float colour[4])
+	{
+		return static_cast<uint16_t>((RoundChannel(colour[0] * 31.0f / 255.0f, 31) << 11) |
+									 (RoundChannel(colour[1] * 63.0f / 255.0f, 63) << 5) |
+									 RoundChannel(colour[2] * 31.0f / 255.0f, 31));
+	}
+
+	void UnpackColour565(uint16_t packed, int colour[3])
+	{
+		int red = packed >> 11;
+		int green = (packed >> 5) & 0x3F;
+		int blue = packed & 0x1F;
+		colour[0] = (red << 3) | (red >> 2);
+		colour[1] = (green << 2) | (green >> 4);
+		colour[2] = (blue << 3) | (blue >> 2);
+	}
+
+	// Colour part of a BC1 or BC3 block.  With transparency (BC1 only), pixels whose alpha is under 128 use
+	// the transparent index of the three colour mode.
+	void EncodeColourBlock(const BlockPixels& block, BlockQuality quality, bool allowTransparency, uint8_t* output)
+	{
+		uint32_t mask = 0xFFFF;
+		if (allowTransparency)
+		{
+			mask = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				if (block.Channels[3][i] >= 128.0f)
+				{
+					mask |= 1u << i;
+				}
+			}
+		}
+		bool threeColour = mask != 0xFFFF;
+
+		uint16_t bestCodes[2] = { 0, 0 };
+		uint8_t bestIndices[16] = {};
+		if (mask != 0)
+		{
+			float bestError = FLT_MAX;
+			float endpoints[2][4];
+			FitPrincipalAxis(block, 0, 3, mask, endpoints);
+			int iterations = GetIterationCount(quality);
+			for (int iteration = 0; iteration < iterations; iteration++)
+			{
+				uint16_t codes[2] = { PackColour565(endpoints[0]), PackColour565(endpoints[1]) };
+				// The order of the codes picks the mode (four colours if the first is greater)
+				if (threeColour ? codes[0] > codes[1] : codes[0] < codes[1])
+				{
+					swap(codes[0], codes[1]);
+					swap(endpoints[0], endpoints[1]);
+				}
+				int colours[2][3];
+				UnpackColour565(codes[0], colours[0]);
+				UnpackColour565(codes[1], colours[1]);
+				float palette[4][4] = {};
+				for (int c = 0; c < 3; c++)
+				{
+					palette[0][c] = static_cast<float>(colours[0][c]);
+					palette[1][c] = static_cast<float>(colours[1][c]);
+					palette[2][c] = threeColour ? (colours[0][c] + colours[1][c]) / 2.0f : (2 * colours[0][c] + colours[1][c]) / 3.0f;
+					palette[3][c] = (colours[0][c] + 2 * colours[1][c]) / 3.0f;
+				}
+				// With equal codes only the first index is the same in both modes
+				int paletteSize = codes[0] == codes[1] ? 1 : (threeColour ? 3 : 4);
+				uint8_t indices[16];
+				float error = ChooseIndices(block, 0, 3, palette, paletteSize, mask, indices);
+				if (error < bestError)
+				{
+					bestError = error;
+					bestCodes[0] = codes[0];
+					bestCodes[1] = codes[1];
+					memcpy(bestIndices, indices, sizeof(indices));
+				}
+				if (error == 0.0f || !RefineEndpoints(block, 0, 3, mask, indices, threeColour ? ThreeColourWeights : FourColourWeights, endpoints))
+				{
+					break;
+				}
+			}
+		}
+
+		uint32_t packedIndices = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			uint32_t index = (mask & (1u << i)) ? bestIndices[i] : 3;
+			packedIndices |= index << (i * 2);
+		}
+		output[0] = static_cast<uint8_t>(bestCodes[0]);
+		output[1] = static_cast<uint8_t>(bestCodes[0] >> 8);
+		output[2] = static_cast<uint8_t>(bestCodes[1]);
+		output[3] = static_cast<uint8_t>(bestCodes[1] >> 8);
+		for (int i = 0; i < 4; i++)
+		{
+			output[4 + i] = static_cast<uint8_t>(packedIndices >> (i * 8));
+		}
+	}
+
+	// Alpha part of a BC3 block, using the mode with eight alpha values
+	void EncodeAlphaBlock(const BlockPixels& block, BlockQuality quality, uint8_t* output)
+	{
+		float endpoints[2][4] = {};
+		endpoints[0][3] = *max_element(block.Channels[3], block.Channels[3] + 16);
+		endpoints[1][3] = *min_element(block.Channels[3], block.Channels[3] + 16);
+		int bestCodes[2] = { 0, 0 };
+		uint8_t bestIndices[16] = {};
+		float bestError = FLT_MAX;
+		int iterations = GetIterationCount(quality);
+		for (int iteration = 0; iteration < iterations; iteration++)
+		{
+			int codes[2] = { RoundChannel(endpoints[0][3], 255), RoundChannel(endpoints[1][3], 255) };
+			if (codes[0] < codes[1])
+			{
+				swap(codes[0], codes[1]);
+				swap(endpoints[0], endpoints[1]);
+			}
+			float palette[8][4] = {};
+			for (int i = 0; i < 8; i++)
+			{
+				palette[i][3] = codes[0] + AlphaWeights[i] * (codes[1] - codes[0]);
+			}
+			int paletteSize = codes[0] == codes[1] ? 1 : 8;
+			uint8_t indices[16];
+			float error = ChooseIndices(block, 3, 1, palette, paletteSize, 0xFFFF, indices);
+			if (error < bestError)
+			{
+				bestError = error;
+				bestCodes[0] = codes[0];
+				bestCodes[1] = codes[1];
+				memcpy(bestIndices, indices, sizeof(indices));
+			}
+			if (error == 0.0f || !RefineEndpoints(block, 3, 1, 0xFFFF, indices, AlphaWeights, endpoints))
+			{
+				break;
+			}
+		}
+
+		uint64_t packedIndices = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			packedIndices |= static_cast<uint64_t>(bestIndices[i]) << (i * 3);
+		}
+		output[0] = static_cast<uint8_t>(bestCodes[0]);
+		output[1] = static_cast<uint8_t>(bestCodes[1]);
+		for (int i = 0; i < 6; i++)
+		{
+			output[2 + i] = static_cast<uint8_t>(packedIndices >> (i * 8));
+		}
+	}
+
+	// Writes bits into a BC7 block from its lowest bit up
+	class BlockBitWriter
+	{
+	public:
+		BlockBitWriter(uint8_t* block) : _block(block), _position(0)
+		{
+			memset(block, 0, 16);
+		}
+
+		void Write(uint32_t value, int bitCount)
+		{
+			for (int i = 0; i < bitCount; i++, _position++)
+			{
+				if ((value >> i) & 1)
+				{
+					_block[_position >> 3] |= static_cast<uint8_t>(1 << (_position & 7));
+				}
+			}
+		}
+
+	private:
+		uint8_t*	_block;
+		int			_position;
+	};
+
+	class BlockBitReader
+	{
+	public:
+		BlockBitReader(const uint8_t* block) : _block(block), _position(0)
+		{
+		}
+
+		uint32_t Read(int bitCount)
+		{
+			uint32_t value = 0;
+			for (int i = 0; i < bitCount && _position < 128; i++, _position++)
+			{
+				value |= static_cast<uint32_t>((_block[_position >> 3] >> (_position & 7)) & 1) << i;
+			}
+			return value;
+		}
+
+	private:
+		const uint8_t*	_block;
+		int				_position;
+	};
+
+	// BC7 mode 6: one set of RGBA endpoints with 7 bits per channel and a p-bit (the lowest bit of every
+	// channel) each, and 4-bit indices.  Returns the squared error.
+	float EncodeBc7Mode6(const BlockPixels& block, BlockQuality quality, uint8_t* output)
+	{
+		float endpoints[2][4];
+		FitPrincipalAxis(block, 0, 4, 0xFFFF, endpoints);
+		int bestCodes[2][4] = {};
+		int bestPBits[2] = { 0, 0 };
+		uint8_t bestIndices[16] = {};
+		float bestError = FLT_MAX;
+		int iterations = GetIterationCount(quality);
+		for (int iteration = 0; iteration < iterations; iteration++)
+		{
+			// The p-bits to try.  Normally, each endpoint gets the p-bit that stores it most closely, but at
+			// high quality every combination is tried with the indices.
+			int pBitChoices[4][2];
+			int choiceCount = 0;
+			if (quality == BlockQuality::High)
+			{
+				for (int choice = 0; choice < 4; choice++)
+				{
+					pBitChoices[choice][0] = choice & 1;
+					pBitChoices[choice][1] = choice >> 1;
+				}
+				choiceCount = 4;
+			}
+			else
+			{
+				for (int e = 0; e < 2; e++)
+				{
+					float errors[2] = { 0.0f, 0.0f };
+					for (int p = 0; p < 2; p++)
+					{
+						for (int c = 0; c < 4; c++)
+						{
+							int value = RoundChannel((endpoints[e][c] - p) * 0.5f, 127) * 2 + p;
+							errors[p] += (value - endpoints[e][c]) * (value - endpoints[e][c]);
+						}
+					}
+					pBitChoices[0][e] = errors[1] < errors[0] ? 1 : 0;
+				}
+				choiceCount = 1;
+			}
+
+			uint8_t iterationIndices[16];
+			float iterationError = FLT_MAX;
+			for (int choice = 0; choice < choiceCount; choice++)
+			{
+				int codes[2][4];
+				int values[2][4];
+				for (int e = 0; e < 2; e++)
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						codes[e][c] = RoundChannel((endpoints[e][c] - pBitChoices[choice][e]) * 0.5f, 127);
+						values[e][c] = codes[e][c] * 2 + pBitChoices[choice][e];
+					}
+				}
+				float palette[16][4];
+				for (int i = 0; i < 16; i++)
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						palette[i][c] = static_cast<float>(InterpolateBc7(values[0][c], values[1][c], Bc7Weights4[i]));
+					}
+				}
+				uint8_t indices[16];
+				float error = ChooseIndices(block, 0, 4, palette, 16, 0xFFFF, indices);
+				if (error < iterationError)
+				{
+					iterationError = error;
+					memcpy(iterationIndices, indices, sizeof(indices));
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					memcpy(bestCodes, codes, sizeof(codes));
+					bestPBits[0] = pBitChoices[choice][0];
+					bestPBits[1] = pBitChoices[choice][1];
+					memcpy(bestIndices, indices, sizeof(indices));
+				}
+			}
+			if (iterationError == 0.0f || !RefineEndpoints(block, 0, 4, 0xFFFF, iterationIndices, Bc7FloatWeights4, endpoints))
+			{
+				break;
+			}
+		}
+
+		// The top bit of the first index is not stored, so it has to be 0
+		if (bestIndices[0] & 8)
+		{
+			swap(bestCodes[0], bestCodes[1]);
+			swap(bestPBits[0], bestPBits[1]);
+			for (int i = 0; i < 16; i++)
+			{
+				bestIndices[i] = static_cast<uint8_t>(15 - bestIndices[i]);
+			}
+		}
+
+		BlockBitWriter writer(output);
+		writer.Write(1 << 6, 7);
+		for (int c = 0; c < 4; c++)
+		{
+			writer.Write(bestCodes[0][c], 7);
+			writer.Write(bestCodes[1][c], 7);
+		}
+		writer.Write(bestPBits[0], 1);
+		writer.Write(bestPBits[1], 1);
+		writer.Write(bestIndices[0], 3);
+		for (int i = 1; i < 16; i++)
+		{
+			writer.Write(bestIndices[i], 4);
+		}
+		return bestError;
+	}
+
+	// BC7 mode 5: RGB endpoints with 7 bits per channel and alpha endpoints with 8 bits, each with their own
+	// 2-bit indices.  rotation (1 to 3) swaps red, green or blue with alpha, so that the channel that does not
+	// follow the others gets its own endpoints.  Returns the squared error.
+	float EncodeBc7Mode5(const BlockPixels& block, int rotation, BlockQuality quality, uint8_t* output)
+	{
+		BlockPixels rotated = block;
+		if (rotation != 0)
+		{
+			memcpy(rotated.Channels[3], block.Channels[rotation - 1], sizeof(rotated.Channels[3]));
+			memcpy(rotated.Channels[rotation - 1], block.Channels[3], sizeof(rotated.Channels[3]));
+		}
+		int iterations = GetIterationCount(quality);
+
+		// Colour
+		float endpoints[2][4] = {};
+		FitPrincipalAxis(rotated, 0, 3, 0xFFFF, endpoints);
+		int colourCodes[2][3] = {};
+		uint8_t colourIndices[16] = {};
+		float colourError = FLT_MAX;
+		for (int iteration = 0; iteration < iterations; iteration++)
+		{
+			int codes[2][3];
+			float palette[4][4] = {};
+			for (int e = 0; e < 2; e++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					codes[e][c] = RoundChannel(endpoints[e][c] * 127.0f / 255.0f, 127);
+				}
+			}
+			for (int i = 0; i < 4; i++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					int first = (codes[0][c] << 1) | (codes[0][c] >> 6);
+					int second = (codes[1][c] << 1) | (codes[1][c] >> 6);
+					palette[i][c] = static_cast<float>(InterpolateBc7(first, second, Bc7Weights2[i]));
+				}
+			}
+			uint8_t indices[16];
+			float error = ChooseIndices(rotated, 0, 3, palette, 4, 0xFFFF, indices);
+			if (error < colourError)
+			{
+				colourError = error;
+				memcpy(colourCodes, codes, sizeof(codes));
+				memcpy(colourIndices, indices, sizeof(indices));
+			}
+			if (error == 0.0f || !RefineEndpoints(rotated, 0, 3, 0xFFFF, indices, Bc7FloatWeights2, endpoints))
+			{
+				break;
+			}
+		}
+
+		// Alpha
+		endpoints[0][3] = *min_element(rotated.Channels[3], rotated.Channels[3] + 16);
+		endpoints[1][3] = *max_element(rotated.Channels[3], rotated.Channels[3] + 16);
+		int alphaCodes[2] = { 0, 0 };
+		uint8_t alphaIndices[16] = {};
+		float alphaError = FLT_MAX;
+		for (int iteration = 0; iteration < iterations; iteration++)
+		{
+			int codes[2] = { RoundChannel(endpoints[0][3], 255), RoundChannel(endpoints[1][3], 255) };
+			float palette[4][4] = {};
+			for (int i = 0; i < 4; i++)
+			{
+				palette[i][3] = static_cast<float>(InterpolateBc7(codes[0], codes[1], Bc7Weights2[i]));
+			}
+			uint8_t indices[16];
+			float error = ChooseIndices(rotated, 3, 1, palette, 4, 0xFFFF, indices);
+			if (error < alphaError)
+			{
+				alphaError = error;
+				memcpy(alphaCodes, codes, sizeof(codes));
+				memcpy(alphaIndices, indices, sizeof(indices));
+			}
+			if (error == 0.0f || !RefineEndpoints(rotated, 3, 1, 0xFFFF, indices, Bc7FloatWeights2, endpoints))
+			{
+				break;
+			}
+		}
+
+		// The top bit of the first index of each set is not stored, so it has to be 0
+		if (colourIndices[0] & 2)
+		{
+			swap(colourCodes[0], colourCodes[1]);
+			for (int i = 0; i < 16; i++)
+			{
+				colourIndices[i] = static_cast<uint8_t>(3 - colourIndices[i]);
+			}
+		}
+		if (alphaIndices[0] & 2)
+		{
+			swap(alphaCodes[0], alphaCodes[1]);
+			for (int i = 0; i < 16; i++)
+			{
+				alphaIndices[i] = static_cast<uint8_t>(3 - alphaIndices[i]);
+			}
+		}
+
+		BlockBitWriter writer(output);
+		writer.Write(1 << 5, 6);
+		writer.Write(rotation, 2);
+		for (int c = 0; c < 3; c++)
+		{
+			writer.Write(colourCodes[0][c], 7);
+			writer.Write(colourCodes[1][c], 7);
+		}
+		writer.Write(alphaCodes[0], 8);
+		writer.Write(alphaCodes[1], 8);
+		writer.Write(colourIndices[0], 1);
+		for (int i = 1; i < 16; i++)
+		{
+			writer.Write(colourIndices[i], 2);
+		}
+		writer.Write(alphaIndices[0], 1);
+		for (int i = 1; i < 16; i++)
+		{
+			writer.Write(alphaIndices[i], 2);
+		}
+		return colourError + alphaError;
+	}
+
+	void EncodeBc7Block(const BlockPixels& block, BlockQuality quality, uint8_t* output)
+	{
+		float error = EncodeBc7Mode6(block, quality, output);
+		if (quality == BlockQuality::Fast || error == 0.0f)
+		{
+			return;
+		}
+		bool opaque = *min_element(block.Channels[3], block.Channels[3] + 16) == 255.0f;
+		int lastRotation = quality == BlockQuality::High ? 3 : (opaque ? -1 : 0);
+		for (int rotation = 0; rotation <= lastRotation; rotation++)
+		{
+			uint8_t candidate[16];
+			float candidateError = EncodeBc7Mode5(block, rotation, quality, candidate);
+			if (candidateError < error)
+			{
+				error = candidateError;
+				memcpy(output, candidate, sizeof(candidate));
+			}
+		}
+	}
+
+	// Decoding (used to measure the error)
+
+	void DecodeColourBlock(const uint8_t* input, bool allowThreeColour, uint8_t pixels[16][4])
+	{
+		uint16_t codes[2] = { static_cast<uint16_t>(input[0] | (input[1] << 8)), static_cast<uint16_t>(input[2] | (input[3] << 8)) };
+		int colours[4][4];
+		UnpackColour565(codes[0], colours[0]);
+		UnpackColour565(codes[1], colours[1]);
+		colours[0][3] = colours[1][3] = colours[2][3] = colours[3][3] = 255;
+		bool threeColour = allowThreeColour && codes[0] <= codes[1];
+		for (int c = 0; c < 3; c++)
+		{
+			if (threeColour)
+			{
+				colours[2][c] = (colours[0][c] + colours[1][c] + 1) / 2;
+				colours[3][c] = 0;
+			}
+			else
+			{
+				colours[2][c] = (2 * colours[0][c] + colours[1][c] + 1) / 3;
+				colours[3][c] = (colours[0][c] + 2 * colours[1][c] + 1) / 3;
+			}
+		}
+		if (threeColour)
+		{
+			colours[3][3] = 0;
+		}
+		uint32_t indices = input[4] | (input[5] << 8) | (input[6] << 16) | (static_cast<uint32_t>(input[7]) << 24);
+		for (int i = 0; i < 16; i++)
+		{
+			const int* colour = colours[(indices >> (i * 2)) & 3];
+			for (int c = 0; c < 4; c++)
+			{
+				pixels[i][c] = static_cast<uint8_t>(colour[c]);
+			}
+		}
+	}
+
+	void DecodeAlphaBlock(const uint8_t* input, uint8_t pixels[16][4])
+	{
+		int alphas[8] = { input[0], input[1] };
+		if (alphas[0] > alphas[1])
+		{
+			for (int i = 2; i < 8; i++)
+			{
+				alphas[i] = ((8 - i) * alphas[0] + (i - 1) * alphas[1] + 3) / 7;
+			}
+		}
+		else
+		{
+			for (int i = 2; i < 6; i++)
+			{
+				alphas[i] = ((6 - i) * alphas[0] + (i - 1) * alphas[1] + 2) / 5;
+			}
+			alphas[6] = 0;
+			alphas[7] = 255;
+		}
+		uint64_t indices = 0;
+		for (int i = 0; i < 6; i++)
+		{
+			indices |= static_cast<uint64_t>(input[2 + i]) << (i * 8);
+		}
+		for (int i = 0; i < 16; i++)
+		{
+			pixels[i][3] = static_cast<uint8_t>(alphas[(indices >> (i * 3)) & 7]);
+		}
+	}
+
+	void DecodeBc7Block(const uint8_t* input, uint8_t pixels[16][4])
+	{
+		BlockBitReader reader(input);
+		int mode = 0;
+		while (mode < 8 && reader.Read(1) == 0)
+		{
+			mode++;
+		}
+		if (mode == 6)
+		{
+			int values[2][4];
+			int codes[2][4];
+			for (int c = 0; c < 4; c++)
+			{
+				codes[0][c] = reader.Read(7);
+				codes[1][c] = reader.Read(7);
+			}
+			int pBits[2] = { static_cast<int>(reader.Read(1)), static_cast<int>(reader.Read(1)) };
+			for (int e = 0; e < 2; e++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					values[e][c] = codes[e][c] * 2 + pBits[e];
+				}
+			}
+			for (int i = 0; i < 16; i++)
+			{
+				int index = reader.Read(i == 0 ? 3 : 4);
+				for (int c = 0; c < 4; c++)
+				{
+					pixels[i][c] = static_cast<uint8_t>(InterpolateBc7(values[0][c], values[1][c], Bc7Weights4[index]));
+				}
+			}
+		}
+		else if (mode == 5)
+		{
+			int rotation = reader.Read(2);
+			int colours[2][3];
+			for (int c = 0; c < 3; c++)
+			{
+				for (int e = 0; e < 2; e++)
+				{
+					int code = reader.Read(7);
+					colours[e][c] = (code << 1) | (code >> 6);
+				}
+			}
+			int alphas[2] = { static_cast<int>(reader.Read(8)), static_cast<int>(reader.Read(8)) };
+			for (int i = 0; i < 16; i++)
+			{
+				int index = reader.Read(i == 0 ? 1 : 2);
+				for (int c = 0; c < 3; c++)
+				{
+					pixels[i][c] = static_cast<uint8_t>(InterpolateBc7(colours[0][c], colours[1][c], Bc7Weights2[index]));
+				}
+			}
+			for (int i = 0; i < 16; i++)
+			{
+				int index = reader.Read(i == 0 ? 1 : 2);
+				pixels[i][3] = static_cast<uint8_t>(InterpolateBc7(alphas[0], alphas[1], Bc7Weights2[index]));
+				if (rotation != 0)
+				{
+					swap(pixels[i][3], pixels[i][rotation - 1]);
+				}
+			}
+		}
+		else
+		{
+			memset(pixels, 0, 16 * 4);
+		}
+	}
+}
+
+size_t GetBlockSize(BlockFormat format)
+{
+	return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+size_t GetBlockRowPitch(BlockFormat format, uint32_t width)
+{
+	return (max)((width + 3) / 4, 1u) * GetBlockSize(format);
+}
+
+size_t GetBlockCompressedSize(BlockFormat format, uint32_t width, uint32_t height)
+{
+	return GetBlockRowPitch(format, width) * (max)((height + 3) / 4, 1u);
+}
+
+bool IsOpaque(const uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch)
+{
+	for (uint32_t y = 0; y < height; y++)
+	{
+		const uint8_t* row = pixels + y * rowPitch;
+		for (uint32_t x = 0; x < width; x++)
+		{
+			if (row[x * 4 + 3] != 255)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool CompressBlocks(const uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch, bool bgra,
+					BlockFormat format, BlockQuality quality, vector<uint8_t>& blocks)
+{
+	if (pixels == nullptr || width == 0 || height == 0)
+	{
+		return false;
+	}
+	uint32_t blocksWide = (width + 3) / 4;
+	uint32_t blocksHigh = (height + 3) / 4;
+	size_t blockSize = GetBlockSize(format);
+	size_t blockRowPitch = GetBlockRowPitch(format, width);
+	blocks.resize(blockRowPitch * blocksHigh);
+	ParallelFor(blocksHigh, (max)(static_cast<size_t>(1), static_cast<size_t>(BlockCompressionBlocksPerTask / blocksWide)), [&](size_t begin, size_t end)
+	{
+		BlockPixels block;
+		for (size_t blockY = begin; blockY < end; blockY++)
+		{
+			uint8_t* output = blocks.data() + blockY * blockRowPitch;
+			for (uint32_t blockX = 0; blockX < blocksWide; blockX++, output += blockSize)
+			{
+				LoadBlock(pixels, width, height, rowPitch, bgra, blockX, static_cast<uint32_t>(blockY), block);
+				switch (format)
+				{
+				case BlockFormat::BC1:
+					EncodeColourBlock(block, quality, true, output);
+					break;
+				case BlockFormat::BC3:
+					EncodeAlphaBlock(block, quality, output);
+					EncodeColourBlock(block, quality, false, output + 8);
+					break;
+				case BlockFormat::BC7:
+					EncodeBc7Block(block, quality, output);
+					break;
+				}
+			}
+		}
+	});
+	return true;
+}
+
+void DecompressBlocks(const uint8_t* blocks, uint32_t width, uint32_t height, BlockFormat format, vector<uint8_t>& pixels)
+{
+	uint32_t blocksWide = (width + 3) / 4;
+	uint32_t blocksHigh = (height + 3) / 4;
+	size_t blockSize = GetBlockSize(format);
+	size_t blockRowPitch = GetBlockRowPitch(format, width);
+	pixels.resize(static_cast<size_t>(width) * height * 4);
+	ParallelFor(blocksHigh, (max)(static_cast<size_t>(1), static_cast<size_t>(BlockCompressionBlocksPerTask / blocksWide)), [&](size_t begin, size_t end)
+	{
+		uint8_t decoded[16][4];
+		for (size_t blockY = begin; blockY < end; blockY++)
+		{
+			const uint8_t* input = blocks + blockY * blockRowPitch;
+			for (uint32_t blockX = 0; blockX < blocksWide; blockX++, input += blockSize)
+			{
+				switch (format)
+				{
+				case BlockFormat::BC1:
+					DecodeColourBlock(input, true, decoded);
+					break;
+				case BlockFormat::BC3:
+					DecodeColourBlock(input + 8, false, decoded);
+					DecodeAlphaBlock(input, decoded);
+					break;
+				case BlockFormat::BC7:
+					DecodeBc7Block(input, decoded);
+					break;
+				}
+				for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; y++)
+				{
+					for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; x++)
+					{
+						memcpy(&pixels[((blockY * 4 + y) * width + blockX * 4 + x) * 4], decoded[y * 4 + x], 4);
+					}
+				}
+			}
+		}
+	});
+}
+
+BlockCompressionError MeasureBlockCompressionError(const uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch, bool bgra,
+												   BlockFormat format, const uint8_t* blocks)
+{
+	vector<uint8_t> decompressed;
+	DecompressBlocks(blocks, width, height, format, decompressed);
+	double squaredError = 0.0;
+	for (uint32_t y = 0; y < height; y++)
+	{
+		const uint8_t* row = pixels + y * rowPitch;
+		const uint8_t* decompressedRow = decompressed.data() + static_cast<size_t>(y) * width * 4;
+		for (uint32_t x = 0; x < width; x++)
+		{
+			const uint8_t* pixel = row + x * 4;
+			int original[4] = { pixel[bgra ? 2 : 0], pixel[1], pixel[bgra ? 0 : 2], pixel[3] };
+			for (int c = 0; c < 4; c++)
+			{
+				double difference = original[c] - decompressedRow[x * 4 + c];
+				squaredError += difference * difference;
+			}
+		}
+	}
+	BlockCompressionError error;
+	error.MeanSquaredError = width * height > 0 ? squaredError / (static_cast<double>(width) * height * 4) : 0.0;
+	error.Psnr = error.MeanSquaredError > 0.0 ? 10.0 * log10(255.0 * 255.0 / error.MeanSquaredError) : numeric_limits<double>::infinity();
+	return error;
+}
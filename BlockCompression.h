@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// CPU block compression of 8-bit RGBA images to BC1, BC3 and BC7, used when textures are loaded and by the
+// offline tools.  Block compressed textures take a quarter (BC3, BC7) or an eighth (BC1) of the memory and
+// bandwidth of uncompressed ones.
+//
+// Each 4x4 block is encoded on its own.  The endpoints start at the ends of the principal axis of the
+// block's colours and are then improved with least squares, using the palette indices chosen with them.
+// Choosing the indices (finding the nearest palette entry for each pixel) is where most of the time goes,
+// so it is done for four pixels at a time with SIMD (SSE2).  The rows of blocks are spread across threads.
+//
+//		BC1		RGB with 1-bit alpha, 8 bytes per block.  Pixels with alpha under 128 become transparent.
+//		BC3		BC1 colour with a separate 8-bit alpha block, 16 bytes per block.
+//		BC7		RGBA, 16 bytes per block.  Mode 6 (one set of 7.7.7.7 endpoints with a p-bit each and
+//				4-bit indices) is used for every block, and at the higher qualities mode 5 (separate colour
+//				and alpha endpoints, with any channel swapped into alpha) is tried as well.
+//
+// Images whose width or height is not a multiple of 4 are padded by repeating their edge pixels.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+// Roughly how many blocks each thread works on at a time
+#define BlockCompressionBlocksPerTask		256
+
+enum class BlockFormat
+{
+	BC1,
+	BC3,
+	BC7
+};
+
+enum class BlockQuality
+{
+	// The endpoints are the ends of the principal axis
+	Fast,
+	// The endpoints are refined with least squares, and BC7 blocks with alpha also try mode 5
+	Normal,
+	// More refinement, and BC7 tries every p-bit combination and every mode 5 channel rotation
+	High
+};
+
+// The compression error of an image (over all four channels)
+struct BlockCompressionError
+{
+	double					MeanSquaredError;
+	// Peak signal to noise ratio in dB.  Infinite if the image was compressed exactly.
+	double					Psnr;
+};
+
+std::size_t					GetBlockSize(BlockFormat format);
+// Bytes in a row of blocks, and in a whole compressed image
+std::size_t					GetBlockRowPitch(BlockFormat format, uint32_t width);
+std::size_t					GetBlockCompressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+// Returns true if every pixel of an 8-bit RGBA (or BGRA) image has an alpha of 255
+bool						IsOpaque(const uint8_t* pixels, uint32_t width, uint32_t height, std::size_t rowPitch);
+
+// Compress an 8-bit RGBA image (BGRA if bgra is true) into blocks, which are stored a row of blocks after
+// another.  Returns false if the image is empty.
+bool						CompressBlocks(const uint8_t* pixels, uint32_t width, uint32_t height, std::size_t rowPitch, bool bgra,
+										   BlockFormat format, BlockQuality quality, std::vector<uint8_t>& blocks);
+
+// Decompress blocks into an 8-bit RGBA image with tightly packed rows.  Only the BC7 modes that
+// CompressBlocks writes (5 and 6) are understood; other BC7 blocks decompress to transparent black.
+void						DecompressBlocks(const uint8_t* blocks, uint32_t width, uint32_t height, BlockFormat format, std::vector<uint8_t>& pixels);
+
+// Measure how far compressed blocks are from the image they were compressed from
+BlockCompressionError		MeasureBlockCompressionError(const uint8_t* pixels, uint32_t width, uint32_t height, std::size_t rowPitch, bool bgra,
+														 BlockFormat format, const uint8_t* blocks);
@@ -0,0 +1,221 @@
+#pragma once
+#include "ResourceMap.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+// Thread-safe map of resources used by the ResourceManager.
+//
+// The map is split into shards by the hash of the resource name, and each shard is a ResourceMap protected
+// by its own reader/writer lock.  Lookups only take a shared lock on one shard, so threads looking up
+// resources never block each other and only wait for a writer that is adding or removing a name in the
+// same shard.  Entries are held by shared pointers, so a thread can keep using an entry after the lock
+// has been released (even if the entry is removed from the map in the meantime).
+//
+// An entry is added in the Loading state by the thread that is going to load the resource.  Any other
+// thread that asks for the resource before it has been loaded waits for that thread to finish, so each
+// resource is only ever loaded once.  Reference counts are atomic since they are changed while holding
+// only a shared lock.  An entry can only be removed while nothing references it, and the check and the
+// removal happen under the shard's exclusive lock, so a lookup can never return an entry that is being
+// removed.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+enum class ResourceState
+{
+	Loading,
+	Loaded,
+	Failed
+};
+
+template<typename TResource>
+class ResourceEntry
+{
+public:
+	std::atomic<unsigned int>			ReferenceCount{ 0 };
+	// Value of the resource manager's use counter when the resource was last requested or released
+	std::atomic<unsigned long long>		LastUsed{ 0 };
+	std::atomic<ResourceState>			State{ ResourceState::Loading };
+
+	// This is only written by the loading thread before the state changes from Loading
+	std::shared_ptr<TResource>			ResourcePointer;
+	// These can also change if the resource is reloaded
+	std::atomic<std::size_t>			GpuBytes{ 0 };
+	std::atomic<std::size_t>			CpuBytes{ 0 };
+
+	void FinishLoading(std::shared_ptr<TResource> resource, std::size_t gpuBytes, std::size_t cpuBytes)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_loadMutex);
+			ResourcePointer = resource;
+			GpuBytes = gpuBytes;
+			CpuBytes = cpuBytes;
+			State = ResourceState::Loaded;
+		}
+		_loadFinished.notify_all();
+	}
+
+	void FailLoading()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_loadMutex);
+			State = ResourceState::Failed;
+		}
+		_loadFinished.notify_all();
+	}
+
+	// Wait until the resource has finished loading.  Returns false if it could not be loaded.
+	bool WaitForLoad()
+	{
+		if (State == ResourceState::Loading)
+		{
+			std::unique_lock<std::mutex> lock(_loadMutex);
+			_loadFinished.wait(lock, [this] { return State != ResourceState::Loading; });
+		}
+		return State == ResourceState::Loaded;
+	}
+
+	// Remove a reference.  Returns true if this was the last one.
+	bool Release()
+	{
+		unsigned int count = ReferenceCount;
+		do
+		{
+			if (count == 0)
+			{
+				return false;
+			}
+		} while (!ReferenceCount.compare_exchange_weak(count, count - 1));
+		return count == 1;
+	}
+
+private:
+	std::mutex							_loadMutex;
+	std::condition_variable				_loadFinished;
+};
+
+#define ResourceMapShardBits	4
+#define ResourceMapShardCount	(1 << ResourceMapShardBits)
+
+template<typename TResource>
+class ConcurrentResourceMap
+{
+public:
+	typedef std::shared_ptr<ResourceEntry<TResource>> EntryPointer;
+
+	EntryPointer Find(std::wstring_view name)
+	{
+		std::size_t hash = InternedName::HashName(name);
+		Shard& shard = GetShard(hash);
+		std::shared_lock<std::shared_mutex> lock(shard.Mutex);
+		EntryPointer* entry = shard.Entries.Find(name, hash);
+		return entry ? *entry : nullptr;
+	}
+
+	EntryPointer Find(const InternedName& name)
+	{
+		Shard& shard = GetShard(name.Hash());
+		std::shared_lock<std::shared_mutex> lock(shard.Mutex);
+		EntryPointer* entry = shard.Entries.Find(name);
+		return entry ? *entry : nullptr;
+	}
+
+	// Find an entry and add a reference to it.  The entry may still be loading.
+	EntryPointer Acquire(const InternedName& name, unsigned long long use)
+	{
+		Shard& shard = GetShard(name.Hash());
+		std::shared_lock<std::shared_mutex> lock(shard.Mutex);
+		EntryPointer* entry = shard.Entries.Find(name);
+		if (!entry)
+		{
+			return nullptr;
+		}
+		(*entry)->ReferenceCount++;
+		(*entry)->LastUsed = use;
+		return *entry;
+	}
+
+	// Add a new entry in the Loading state.  Returns nullptr if there is already an entry for the name.
+	EntryPointer Insert(const InternedName& name, unsigned int referenceCount, unsigned long long use)
+	{
+		Shard& shard = GetShard(name.Hash());
+		std::unique_lock<std::shared_mutex> lock(shard.Mutex);
+		EntryPointer& entry = shard.Entries[name];
+		if (entry)
+		{
+			return nullptr;
+		}
+		entry = std::make_shared<ResourceEntry<TResource>>();
+		entry->ReferenceCount = referenceCount;
+		entry->LastUsed = use;
+		return entry;
+	}
+
+	// Remove an entry if it has been loaded and nothing references it.  Returns the removed entry, or nullptr
+	// if it was not removed.
+	EntryPointer EraseIfUnreferenced(const InternedName& name)
+	{
+		Shard& shard = GetShard(name.Hash());
+		std::unique_lock<std::shared_mutex> lock(shard.Mutex);
+		EntryPointer* entry = shard.Entries.Find(name);
+		if (!entry || (*entry)->ReferenceCount != 0 || (*entry)->State != ResourceState::Loaded)
+		{
+			return nullptr;
+		}
+		EntryPointer removed = *entry;
+		shard.Entries.Erase(name);
+		return removed;
+	}
+
+	// Remove an entry whatever its state, but only if it is still the entry given
+	void Erase(const InternedName& name, const EntryPointer& expected)
+	{
+		Shard& shard = GetShard(name.Hash());
+		std::unique_lock<std::shared_mutex> lock(shard.Mutex);
+		EntryPointer* entry = shard.Entries.Find(name);
+		if (entry && *entry == expected)
+		{
+			shard.Entries.Erase(name);
+		}
+	}
+
+	// Call function(name, entry) for every entry.  Each shard is locked while it is visited, so function
+	// must not use the map.
+	template<typename TFunction>
+	void ForEach(const TFunction& function)
+	{
+		for (Shard& shard : _shards)
+		{
+			std::shared_lock<std::shared_mutex> lock(shard.Mutex);
+			shard.Entries.ForEach(function);
+		}
+	}
+
+	std::size_t Size()
+	{
+		std::size_t size = 0;
+		for (Shard& shard : _shards)
+		{
+			std::shared_lock<std::shared_mutex> lock(shard.Mutex);
+			size += shard.Entries.Size();
+		}
+		return size;
+	}
+
+private:
+	struct Shard
+	{
+		std::shared_mutex					Mutex;
+		ResourceMap<EntryPointer>			Entries;
+	};
+
+	Shard									_shards[ResourceMapShardCount];
+
+	// The slots of each ResourceMap are chosen by the low bits of the hash, so use the high bits for the shard
+	inline Shard& GetShard(std::size_t hash)
+	{
+		return _shards[(hash >> (sizeof(std::size_t) * 8 - ResourceMapShardBits)) & (ResourceMapShardCount - 1)];
+	}
+};
@@ -0,0 +1,101 @@
+#include "ContentHash.h"
+#include <cstring>
+
+#define HashPrime1		0x9E3779B185EBCA87ull
+#define HashPrime2		0xC2B2AE3D27D4EB4Full
+#define HashPrime3		0x165667B19E3779F9ull
+#define HashPrime4		0x85EBCA77C2B2AE63ull
+#define HashPrime5		0x27D4EB2F165667C5ull
+
+namespace
+{
+	inline uint64_t RotateLeft(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	// The data is read as little-endian words (memcpy copes with unaligned data)
+	inline uint64_t Read64(const uint8_t* data)
+	{
+		uint64_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	inline uint32_t Read32(const uint8_t* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	inline uint64_t Round(uint64_t lane, uint64_t input)
+	{
+		lane += input * HashPrime2;
+		lane = RotateLeft(lane, 31);
+		return lane * HashPrime1;
+	}
+
+	inline uint64_t MergeRound(uint64_t hash, uint64_t lane)
+	{
+		hash ^= Round(0, lane);
+		return hash * HashPrime1 + HashPrime4;
+	}
+}
+
+uint64_t HashContents(const void* data, std::size_t size, uint64_t seed)
+{
+	const uint8_t* input = static_cast<const uint8_t*>(data);
+	const uint8_t* end = input + size;
+	uint64_t hash;
+	if (size >= 32)
+	{
+		// Four lanes, each taking every fourth word
+		uint64_t lanes[4] = { seed + HashPrime1 + HashPrime2, seed + HashPrime2, seed, seed - HashPrime1 };
+		const uint8_t* lastStripe = end - 32;
+		do
+		{
+			lanes[0] = Round(lanes[0], Read64(input));
+			lanes[1] = Round(lanes[1], Read64(input + 8));
+			lanes[2] = Round(lanes[2], Read64(input + 16));
+			lanes[3] = Round(lanes[3], Read64(input + 24));
+			input += 32;
+		} while (input <= lastStripe);
+		hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) + RotateLeft(lanes[2], 12) + RotateLeft(lanes[3], 18);
+		for (uint64_t lane : lanes)
+		{
+			hash = MergeRound(hash, lane);
+		}
+	}
+	else
+	{
+		hash = seed + HashPrime5;
+	}
+	hash += static_cast<uint64_t>(size);
+
+	// Mix in what is left over a word at a time
+	for (; input + 8 <= end; input += 8)
+	{
+		hash ^= Round(0, Read64(input));
+		hash = RotateLeft(hash, 27) * HashPrime1 + HashPrime4;
+	}
+	if (input + 4 <= end)
+	{
+		hash ^= static_cast<uint64_t>(Read32(input)) * HashPrime1;
+		hash = RotateLeft(hash, 23) * HashPrime2 + HashPrime3;
+		input += 4;
+	}
+	for (; input < end; input++)
+	{
+		hash ^= *input * HashPrime5;
+		hash = RotateLeft(hash, 11) * HashPrime1;
+	}
+
+	// Avalanche, so every bit of the input affects every bit of the hash
+	hash ^= hash >> 33;
+	hash *= HashPrime2;
+	hash ^= hash >> 29;
+	hash *= HashPrime3;
+	hash ^= hash >> 32;
+	return hash;
+}
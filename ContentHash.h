@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Fast 64-bit hash of a block of memory, used to spot files with the same contents (e.g. the same image
+// saved under two names, see ResourceManager's texture cache).
+//
+// This is xxHash64: the data is read 32 bytes at a time into four independent 64-bit lanes, each mixed with
+// a multiply and rotate, so it runs at several gigabytes a second on one core (much faster than reading the
+// data byte by byte as FNV-1a does), and the lanes are combined and avalanched at the end.  It gives the
+// same values as the reference implementation, but it is not a cryptographic hash.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+uint64_t		HashContents(const void* data, std::size_t size, uint64_t seed = 0);
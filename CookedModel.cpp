@@ -0,0 +1,262 @@
+#include "CookedModel.h"
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+	class CookedModelWriter
+	{
+	public:
+		CookedModelWriter(vector<uint8_t>& data) : _data(data)
+		{
+		}
+
+		void WriteBytes(const void* bytes, size_t size)
+		{
+			const uint8_t* first = static_cast<const uint8_t*>(bytes);
+			_data.insert(_data.end(), first, first + size);
+		}
+
+		template<typename T>
+		void Write(const T& value)
+		{
+			WriteBytes(&value, sizeof(T));
+		}
+
+		void WriteString(const string& value)
+		{
+			Write(static_cast<uint32_t>(value.size()));
+			WriteBytes(value.data(), value.size());
+		}
+
+		template<typename T>
+		void WriteArray(const vector<T>& values)
+		{
+			Write(static_cast<uint32_t>(values.size()));
+			if (!values.empty())
+			{
+				WriteBytes(values.data(), values.size() * sizeof(T));
+			}
+		}
+
+	private:
+		vector<uint8_t>&	_data;
+	};
+
+	// Every read is checked against the end of the data, so a damaged file is rejected rather than read past
+	class CookedModelReader
+	{
+	public:
+		CookedModelReader(const uint8_t* data, size_t size) : _position(data), _end(data + size)
+		{
+		}
+
+		bool ReadBytes(void* bytes, size_t size)
+		{
+			if (size > static_cast<size_t>(_end - _position))
+			{
+				return false;
+			}
+			if (size > 0)
+			{
+				memcpy(bytes, _position, size);
+			}
+			_position += size;
+			return true;
+		}
+
+		template<typename T>
+		bool Read(T& value)
+		{
+			return ReadBytes(&value, sizeof(T));
+		}
+
+		bool ReadString(string& value)
+		{
+			uint32_t length;
+			if (!Read(length) || length > static_cast<size_t>(_end - _position))
+			{
+				return false;
+			}
+			value.assign(reinterpret_cast<const char*>(_position), length);
+			_position += length;
+			return true;
+		}
+
+		template<typename T>
+		bool ReadArray(vector<T>& values)
+		{
+			uint32_t count;
+			if (!Read(count) || count > static_cast<size_t>(_end - _position) / sizeof(T))
+			{
+				return false;
+			}
+			values.resize(count);
+			return ReadBytes(values.data(), count * sizeof(T));
+		}
+
+		inline bool AtEnd() const { return _position == _end; }
+
+	private:
+		const uint8_t*		_position;
+		const uint8_t*		_end;
+	};
+}
+
+void WriteCookedModel(const CookedModel& model, vector<uint8_t>& data)
+{
+	CookedModelWriter writer(data);
+	CookedModelHeader header;
+	header.Magic = CookedModelMagic;
+	header.Version = CookedModelVersion;
+	header.MaterialCount = static_cast<uint32_t>(model.Materials.size());
+	header.NodeCount = static_cast<uint32_t>(model.Nodes.size());
+	header.SubMeshCount = static_cast<uint32_t>(model.SubMeshes.size());
+	header.VertexCount = static_cast<uint32_t>(model.Vertices.size());
+	header.IndexCount = static_cast<uint32_t>(model.Indices.size());
+	writer.Write(header);
+	writer.WriteString(model.ImportProfile);
+	for (const CookedMaterial& material : model.Materials)
+	{
+		writer.Write(material.DiffuseColour);
+		writer.Write(material.SpecularColour);
+		writer.Write(material.Shininess);
+		writer.Write(material.Opacity);
+		writer.WriteString(material.TextureName);
+	}
+	for (const CookedNode& node : model.Nodes)
+	{
+		writer.WriteString(node.Name);
+		writer.Write(node.LocalTransformation);
+		writer.Write(node.Parent);
+		writer.WriteArray(node.SubMeshes);
+	}
+	for (const CookedSubMesh& subMesh : model.SubMeshes)
+	{
+		writer.Write(subMesh.BaseVertex);
+		writer.Write(subMesh.VertexCount);
+		writer.Write(subMesh.Material);
+		writer.Write(subMesh.HasTexCoords);
+		writer.Write(subMesh.BoxMinimum);
+		writer.Write(subMesh.BoxMaximum);
+		writer.Write(subMesh.SphereRadius);
+		writer.WriteArray(subMesh.LodLevels);
+	}
+	if (!model.Vertices.empty())
+	{
+		writer.WriteBytes(model.Vertices.data(), model.Vertices.size() * sizeof(CookedVertex));
+	}
+	if (!model.Indices.empty())
+	{
+		writer.WriteBytes(model.Indices.data(), model.Indices.size() * sizeof(uint32_t));
+	}
+}
+
+bool ReadCookedModel(const uint8_t* data, size_t size, CookedModel& model)
+{
+	CookedModelReader reader(data, size);
+	CookedModelHeader header;
+	if (!reader.Read(header) || header.Magic != CookedModelMagic || header.Version != CookedModelVersion)
+	{
+		return false;
+	}
+	// The counts are checked against the size of the data before anything is allocated for them
+	if (header.VertexCount > size / sizeof(CookedVertex) ||
+		header.IndexCount > size / sizeof(uint32_t) ||
+		header.MaterialCount > size || header.NodeCount > size || header.SubMeshCount > size)
+	{
+		return false;
+	}
+	if (!reader.ReadString(model.ImportProfile))
+	{
+		return false;
+	}
+	model.Materials.resize(header.MaterialCount);
+	for (CookedMaterial& material : model.Materials)
+	{
+		if (!reader.Read(material.DiffuseColour) ||
+			!reader.Read(material.SpecularColour) ||
+			!reader.Read(material.Shininess) ||
+			!reader.Read(material.Opacity) ||
+			!reader.ReadString(material.TextureName))
+		{
+			return false;
+		}
+	}
+	model.Nodes.resize(header.NodeCount);
+	for (size_t n = 0; n < model.Nodes.size(); n++)
+	{
+		CookedNode& node = model.Nodes[n];
+		if (!reader.ReadString(node.Name) ||
+			!reader.Read(node.LocalTransformation) ||
+			!reader.Read(node.Parent) ||
+			!reader.ReadArray(node.SubMeshes))
+		{
+			return false;
+		}
+		if (n == 0 ? node.Parent != -1 : node.Parent < 0 || node.Parent >= static_cast<int32_t>(n))
+		{
+			// Parents must come before their children and only the first node can be the root
+			return false;
+		}
+		for (uint32_t subMesh : node.SubMeshes)
+		{
+			if (subMesh >= header.SubMeshCount)
+			{
+				return false;
+			}
+		}
+	}
+	model.SubMeshes.resize(header.SubMeshCount);
+	for (CookedSubMesh& subMesh : model.SubMeshes)
+	{
+		if (!reader.Read(subMesh.BaseVertex) ||
+			!reader.Read(subMesh.VertexCount) ||
+			!reader.Read(subMesh.Material) ||
+			!reader.Read(subMesh.HasTexCoords) ||
+			!reader.Read(subMesh.BoxMinimum) ||
+			!reader.Read(subMesh.BoxMaximum) ||
+			!reader.Read(subMesh.SphereRadius) ||
+			!reader.ReadArray(subMesh.LodLevels))
+		{
+			return false;
+		}
+		if (subMesh.LodLevels.empty() ||
+			subMesh.BaseVertex > header.VertexCount || subMesh.VertexCount > header.VertexCount - subMesh.BaseVertex ||
+			subMesh.Material >= static_cast<int32_t>(header.MaterialCount))
+		{
+			return false;
+		}
+		for (const CookedLodLevel& lod : subMesh.LodLevels)
+		{
+			if (lod.StartIndex > header.IndexCount || lod.IndexCount > header.IndexCount - lod.StartIndex)
+			{
+				return false;
+			}
+		}
+	}
+	model.Vertices.resize(header.VertexCount);
+	model.Indices.resize(header.IndexCount);
+	if (!reader.ReadBytes(model.Vertices.data(), model.Vertices.size() * sizeof(CookedVertex)) ||
+		!reader.ReadBytes(model.Indices.data(), model.Indices.size() * sizeof(uint32_t)) ||
+		!reader.AtEnd())
+	{
+		return false;
+	}
+	// Indices are relative to the base vertex of their sub-mesh, so check that they stay inside it
+	for (const CookedSubMesh& subMesh : model.SubMeshes)
+	{
+		for (const CookedLodLevel& lod : subMesh.LodLevels)
+		{
+			for (uint32_t i = lod.StartIndex; i < lod.StartIndex + lod.IndexCount; i++)
+			{
+				if (model.Indices[i] >= subMesh.VertexCount)
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A model in the form the renderer draws it, independent of Assimp and DirectX.
+//
+// The ResourceManager turns an imported scene into a CookedModel (see ModelBuilder.h) and then creates the
+// mesh, its materials and its buffers from it.  The asset cooker does the import and the processing offline
+// and writes the result to a cooked model file, which the ResourceManager loads instead of the source model
+// when it is there, so none of the Assimp post-processing, node merging, normal generation or level of
+// detail simplification has to be done at run time.
+//
+// The layout of the data matches the structures used by Mesh.h: CookedVertex is laid out like Vertex and
+// transformations are stored row-major for use with row vectors, like SimpleMath's Matrix.  The file is
+// (all values little-endian):
+//
+//		CookedModelHeader
+//		import profile name, then for each material, node and sub-mesh its fields in the order they are
+//		declared below (strings and arrays are preceded by their length as a uint32_t)
+//		CookedVertex[VertexCount]
+//		uint32_t[IndexCount]
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+#define CookedModelMagic		0x4C444D43		// "CMDL"
+#define CookedModelVersion		1
+// Added to the name of the source model to get the name of the cooked model
+#define CookedModelExtension	".cmdl"
+
+struct CookedModelHeader
+{
+	uint32_t					Magic;
+	uint32_t					Version;
+	uint32_t					MaterialCount;
+	uint32_t					NodeCount;
+	uint32_t					SubMeshCount;
+	uint32_t					VertexCount;
+	uint32_t					IndexCount;
+};
+
+struct CookedVertex
+{
+	float						Position[3];
+	float						Normal[3];
+	float						TexCoord[2];
+};
+
+struct CookedMaterial
+{
+	float						DiffuseColour[4];
+	float						SpecularColour[4];
+	float						Shininess;
+	float						Opacity;
+	// Name of the diffuse texture relative to the directory of the model (UTF-8), or empty for none
+	std::string					TextureName;
+};
+
+struct CookedLodLevel
+{
+	uint32_t					StartIndex;
+	uint32_t					IndexCount;
+	float						Error;
+};
+
+struct CookedSubMesh
+{
+	uint32_t					BaseVertex;
+	uint32_t					VertexCount;
+	// Index into the materials, or -1 if the sub-mesh has no material
+	int32_t						Material;
+	uint32_t					HasTexCoords;
+	// Bounds in the space of the node that draws the sub-mesh.  The sphere is centred on the box.
+	float						BoxMinimum[3];
+	float						BoxMaximum[3];
+	float						SphereRadius;
+	// Level 0 is the full detail mesh
+	std::vector<CookedLodLevel>	LodLevels;
+};
+
+struct CookedNode
+{
+	std::string					Name;
+	// Transformation relative to the parent node (row-major, for row vectors)
+	float						LocalTransformation[16];
+	// Index of the parent node, or -1 for the root node.  Parents come before their children.
+	int32_t						Parent;
+	std::vector<uint32_t>		SubMeshes;
+};
+
+struct CookedModel
+{
+	// Name of the import profile the model was built with
+	std::string					ImportProfile;
+	std::vector<CookedMaterial>	Materials;
+	std::vector<CookedNode>		Nodes;
+	std::vector<CookedSubMesh>	SubMeshes;
+	std::vector<CookedVertex>	Vertices;
+	std::vector<uint32_t>		Indices;
+};
+
+// Write a model to memory in the cooked model format
+void	WriteCookedModel(const CookedModel& model, std::vector<uint8_t>& data);
+
+// Read a cooked model.  Returns false if the data is not a valid cooked model of the current version.
+bool	ReadCookedModel(const uint8_t* data, std::size_t size, CookedModel& model);
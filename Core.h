@@ -1,7 +1,7 @@
-#pragma once
-#include <windows.h>
-#include "Resource.h"
-#include <string>
-#include <exception>
-#include <memory>
-#include "HelperFunctions.h"
+#pragma once
+#include <windows.h>
+#include "Resource.h"
+#include <string>
+#include <exception>
+#include <memory>
+#include "HelperFunctions.h"
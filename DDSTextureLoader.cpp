@@ -0,0 +1,250 @@
+//--------------------------------------------------------------------------------------
+// File: DDSTextureLoader.cpp
+//
+// Function for creating a Direct3D runtime texture straight from the contents of a DDS
+// file (see DdsFile.h).  Every mip level and array slice (or cube face) in the file is
+// uploaded as it is, in any format the device supports including the block compressed
+// ones, so no pixel work is done on the CPU.
+//--------------------------------------------------------------------------------------
+
+#include "DDSTextureLoader.h"
+#include "DdsFile.h"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+#if !defined(NO_D3D11_DEBUG_NAME) && ( defined(_DEBUG) || defined(PROFILE) )
+#pragma comment(lib,"dxguid.lib")
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    //--------------------------------------------------------------------------------------
+    template<UINT TNameLength>
+    inline void SetDebugObjectName(_In_ ID3D11DeviceChild* resource, _In_ const char(&name)[TNameLength])
+    {
+#if !defined(NO_D3D11_DEBUG_NAME) && ( defined(_DEBUG) || defined(PROFILE) )
+        resource->SetPrivateData(WKPDID_D3DDebugObjectName, TNameLength - 1, name);
+#else
+        UNREFERENCED_PARAMETER(resource);
+        UNREFERENCED_PARAMETER(name);
+#endif
+    }
+
+
+    //--------------------------------------------------------------------------------------
+    HRESULT CreateTextureFromDDS(_In_ ID3D11Device* d3dDevice,
+        _In_ const DdsTexture& dds,
+        _In_ UINT skipMips,
+        _Outptr_ ID3D11Resource** texture,
+        _Out_ D3D11_SHADER_RESOURCE_VIEW_DESC& SRVDesc)
+    {
+        UINT mipLevels = dds.MipLevels - skipMips;
+        DXGI_FORMAT format = static_cast<DXGI_FORMAT>(dds.Format);
+
+        // Point the subresources straight at the file
+        std::unique_ptr<D3D11_SUBRESOURCE_DATA[]> initData(new (std::nothrow) D3D11_SUBRESOURCE_DATA[mipLevels * dds.ArraySize]);
+        if (!initData)
+            return E_OUTOFMEMORY;
+
+        for (UINT slice = 0; slice < dds.ArraySize; ++slice)
+        {
+            for (UINT level = 0; level < mipLevels; ++level)
+            {
+                const DdsSubresource& subresource = dds.Subresources[slice * dds.MipLevels + skipMips + level];
+                D3D11_SUBRESOURCE_DATA& data = initData[slice * mipLevels + level];
+                data.pSysMem = subresource.Data;
+                data.SysMemPitch = static_cast<UINT>(subresource.RowPitch);
+                data.SysMemSlicePitch = static_cast<UINT>(subresource.SlicePitch);
+            }
+        }
+
+        UINT width = (std::max)(dds.Width >> skipMips, 1u);
+        UINT height = (std::max)(dds.Height >> skipMips, 1u);
+        UINT depth = (std::max)(dds.Depth >> skipMips, 1u);
+
+        SRVDesc = {};
+        SRVDesc.Format = format;
+
+        HRESULT hr = E_FAIL;
+        switch (dds.Dimension)
+        {
+        case DdsDimension::Texture1D:
+        {
+            D3D11_TEXTURE1D_DESC desc = {};
+            desc.Width = width;
+            desc.MipLevels = mipLevels;
+            desc.ArraySize = dds.ArraySize;
+            desc.Format = format;
+            desc.Usage = D3D11_USAGE_DEFAULT;
+            desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+            ID3D11Texture1D* tex = nullptr;
+            hr = d3dDevice->CreateTexture1D(&desc, initData.get(), &tex);
+            if (SUCCEEDED(hr))
+            {
+                *texture = tex;
+                if (dds.ArraySize > 1)
+                {
+                    SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE1DARRAY;
+                    SRVDesc.Texture1DArray.MipLevels = mipLevels;
+                    SRVDesc.Texture1DArray.ArraySize = dds.ArraySize;
+                }
+                else
+                {
+                    SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE1D;
+                    SRVDesc.Texture1D.MipLevels = mipLevels;
+                }
+            }
+            break;
+        }
+
+        case DdsDimension::Texture2D:
+        {
+            D3D11_TEXTURE2D_DESC desc = {};
+            desc.Width = width;
+            desc.Height = height;
+            desc.MipLevels = mipLevels;
+            desc.ArraySize = dds.ArraySize;
+            desc.Format = format;
+            desc.SampleDesc.Count = 1;
+            desc.Usage = D3D11_USAGE_DEFAULT;
+            desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+            desc.MiscFlags = (dds.IsCube) ? D3D11_RESOURCE_MISC_TEXTURECUBE : 0;
+
+            ID3D11Texture2D* tex = nullptr;
+            hr = d3dDevice->CreateTexture2D(&desc, initData.get(), &tex);
+            if (SUCCEEDED(hr))
+            {
+                *texture = tex;
+                if (dds.IsCube && dds.ArraySize > 6)
+                {
+                    SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+                    SRVDesc.TextureCubeArray.MipLevels = mipLevels;
+                    SRVDesc.TextureCubeArray.NumCubes = dds.ArraySize / 6;
+                }
+                else if (dds.IsCube)
+                {
+                    SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+                    SRVDesc.TextureCube.MipLevels = mipLevels;
+                }
+                else if (dds.ArraySize > 1)
+                {
+                    SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+                    SRVDesc.Texture2DArray.MipLevels = mipLevels;
+                    SRVDesc.Texture2DArray.ArraySize = dds.ArraySize;
+                }
+                else
+                {
+                    SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+                    SRVDesc.Texture2D.MipLevels = mipLevels;
+                }
+            }
+            break;
+        }
+
+        case DdsDimension::Texture3D:
+        {
+            D3D11_TEXTURE3D_DESC desc = {};
+            desc.Width = width;
+            desc.Height = height;
+            desc.Depth = depth;
+            desc.MipLevels = mipLevels;
+            desc.Format = format;
+            desc.Usage = D3D11_USAGE_DEFAULT;
+            desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+            ID3D11Texture3D* tex = nullptr;
+            hr = d3dDevice->CreateTexture3D(&desc, initData.get(), &tex);
+            if (SUCCEEDED(hr))
+            {
+                *texture = tex;
+                SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE3D;
+                SRVDesc.Texture3D.MipLevels = mipLevels;
+            }
+            break;
+        }
+        }
+
+        return hr;
+    }
+} // anonymous namespace
+
+
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::CreateDDSTextureFromMemory(ID3D11Device* d3dDevice,
+    const uint8_t* ddsData,
+    size_t ddsDataSize,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView,
+    size_t maxsize)
+{
+    if (texture)
+    {
+        *texture = nullptr;
+    }
+    if (textureView)
+    {
+        *textureView = nullptr;
+    }
+
+    if (!d3dDevice || !ddsData || (!texture && !textureView))
+        return E_INVALIDARG;
+
+    DdsTexture dds;
+    if (!ParseDds(ddsData, ddsDataSize, dds))
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    // Leave out the levels that are too big.  The top level of a block compressed texture has to be a whole
+    // number of blocks, so levels are only left out down to the last one that is; if that is still bigger
+    // than maxsize, the texture is loaded from there.
+    UINT skipMips = 0;
+    if (maxsize)
+    {
+        size_t largest = (std::max)((std::max)(dds.Width, dds.Height), dds.Depth);
+        bool blockCompressed = IsDdsBlockCompressed(dds.Format);
+        while ((largest >> skipMips) > maxsize && skipMips + 1 < dds.MipLevels)
+        {
+            UINT width = (std::max)(dds.Width >> (skipMips + 1), 1u);
+            UINT height = (std::max)(dds.Height >> (skipMips + 1), 1u);
+            if (blockCompressed && ((width % 4) != 0 || (height % 4) != 0))
+                break;
+            ++skipMips;
+        }
+        if ((largest >> skipMips) > maxsize && !blockCompressed)
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    ID3D11Resource* resource = nullptr;
+    D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc;
+    HRESULT hr = CreateTextureFromDDS(d3dDevice, dds, skipMips, &resource, SRVDesc);
+    if (FAILED(hr))
+        return hr;
+
+    if (textureView != 0)
+    {
+        hr = d3dDevice->CreateShaderResourceView(resource, &SRVDesc, textureView);
+        if (FAILED(hr))
+        {
+            resource->Release();
+            return hr;
+        }
+        SetDebugObjectName(*textureView, "DDSTextureLoader");
+    }
+
+    if (texture != 0)
+    {
+        *texture = resource;
+    }
+    else
+    {
+        SetDebugObjectName(resource, "DDSTextureLoader");
+        resource->Release();
+    }
+
+    return hr;
+}
@@ -0,0 +1,33 @@
+//--------------------------------------------------------------------------------------
+// File: DDSTextureLoader.h
+//
+// Function for creating a Direct3D runtime texture straight from the contents of a DDS
+// file (see DdsFile.h).  Every mip level and array slice (or cube face) in the file is
+// uploaded as it is, in any format the device supports including the block compressed
+// ones, so no pixel work is done on the CPU.  Used with a memory mapped file (see
+// MappedFile.h), loading a pre-cooked texture costs only the I/O.
+//
+// Unlike CreateWICTextureFromMemory, this does not need CoInitializeEx and can be called
+// from any thread.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <d3d11_1.h>
+#include <stdint.h>
+
+
+namespace DirectX
+{
+    // If maxsize is not 0, the top mip levels that are bigger than maxsize (in any
+    // direction) are left out.  Fails if even the smallest level in the file is too big.
+    // Block compressed textures keep the smallest level that is a whole number of blocks
+    // instead, even if it is too big.
+    HRESULT CreateDDSTextureFromMemory(
+        _In_ ID3D11Device* d3dDevice,
+        _In_reads_bytes_(ddsDataSize) const uint8_t* ddsData,
+        _In_ size_t ddsDataSize,
+        _Outptr_opt_ ID3D11Resource** texture,
+        _Outptr_opt_ ID3D11ShaderResourceView** textureView,
+        _In_ size_t maxsize = 0);
+}
@@ -0,0 +1,453 @@
+#include "DdsFile.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+// Header flags
+#define DdsFlagCaps					0x1
+#define DdsFlagHeight				0x2
+#define DdsFlagWidth				0x4
+#define DdsFlagPitch				0x8
+#define DdsFlagPixelFormat			0x1000
+#define DdsFlagMipMapCount			0x20000
+#define DdsFlagLinearSize			0x80000
+#define DdsFlagDepth				0x800000
+// Pixel format flags
+#define DdsPixelAlphaPixels			0x1
+#define DdsPixelAlpha				0x2
+#define DdsPixelFourCC				0x4
+#define DdsPixelRgb					0x40
+#define DdsPixelLuminance			0x20000
+// Caps
+#define DdsCapsComplex				0x8
+#define DdsCapsTexture				0x1000
+#define DdsCapsMipMap				0x400000
+#define DdsCaps2CubeMap				0x200
+#define DdsCaps2AllFaces			0xFC00
+// DX10 header extension
+#define DdsDimensionTexture1D		2
+#define DdsDimensionTexture2D		3
+#define DdsDimensionTexture3D		4
+#define DdsMiscTextureCube			0x4
+
+// Direct3D 11 limits
+#define DdsMaxTextureSize			16384
+#define DdsMaxVolumeSize			2048
+#define DdsMaxArraySize				2048
+#define DdsMaxMipLevels				15
+
+namespace
+{
+	struct DdsPixelFormat
+	{
+		uint32_t	Size;
+		uint32_t	Flags;
+		uint32_t	FourCC;
+		uint32_t	RgbBitCount;
+		uint32_t	RedMask;
+		uint32_t	GreenMask;
+		uint32_t	BlueMask;
+		uint32_t	AlphaMask;
+	};
+
+	struct DdsHeader
+	{
+		uint32_t		Size;
+		uint32_t		Flags;
+		uint32_t		Height;
+		uint32_t		Width;
+		uint32_t		PitchOrLinearSize;
+		uint32_t		Depth;
+		uint32_t		MipMapCount;
+		uint32_t		Reserved1[11];
+		DdsPixelFormat	PixelFormat;
+		uint32_t		Caps;
+		uint32_t		Caps2;
+		uint32_t		Caps3;
+		uint32_t		Caps4;
+		uint32_t		Reserved2;
+	};
+
+	struct DdsHeaderDx10
+	{
+		uint32_t	Format;
+		uint32_t	ResourceDimension;
+		uint32_t	MiscFlag;
+		uint32_t	ArraySize;
+		uint32_t	MiscFlags2;
+	};
+
+	static_assert(sizeof(DdsPixelFormat) == 32, "DDS pixel format has the wrong size");
+	static_assert(sizeof(DdsHeader) == 124, "DDS header has the wrong size");
+	static_assert(sizeof(DdsHeaderDx10) == 20, "DDS DX10 header has the wrong size");
+
+	constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+	{
+		return static_cast<uint32_t>(static_cast<uint8_t>(a)) | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+			   (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+	}
+
+	// Bits per pixel of an uncompressed format, or bytes per 4x4 block of a block compressed one.  0 for
+	// formats that cannot be loaded (typeless depth formats, packed 4:2:2 formats, 1-bit and video formats).
+	uint32_t GetFormatSize(uint32_t format, bool& blockCompressed)
+	{
+		blockCompressed = false;
+		if (format >= 1 && format <= 4)
+		{
+			return 128;
+		}
+		if (format >= 5 && format <= 8)
+		{
+			return 96;
+		}
+		if (format >= 9 && format <= 22)
+		{
+			return 64;
+		}
+		if ((format >= 23 && format <= 47) || format == 67 || (format >= 87 && format <= 93))
+		{
+			return 32;
+		}
+		if ((format >= 48 && format <= 59) || format == 85 || format == 86 || format == 115)
+		{
+			return 16;
+		}
+		if (format >= 60 && format <= 65)
+		{
+			return 8;
+		}
+		blockCompressed = true;
+		if ((format >= 70 && format <= 72) || (format >= 79 && format <= 81))
+		{
+			return 8;
+		}
+		if ((format >= 73 && format <= 78) || (format >= 82 && format <= 84) || (format >= 94 && format <= 99))
+		{
+			return 16;
+		}
+		blockCompressed = false;
+		return 0;
+	}
+
+	bool HasMasks(const DdsPixelFormat& pixelFormat, uint32_t red, uint32_t green, uint32_t blue, uint32_t alpha)
+	{
+		return pixelFormat.RedMask == red && pixelFormat.GreenMask == green && pixelFormat.BlueMask == blue && pixelFormat.AlphaMask == alpha;
+	}
+
+	// The format of a file without the DX10 extension, or 0 if it has no DXGI equivalent
+	uint32_t GetLegacyFormat(const DdsPixelFormat& pixelFormat)
+	{
+		if (pixelFormat.Flags & DdsPixelFourCC)
+		{
+			switch (pixelFormat.FourCC)
+			{
+			case MakeFourCC('D', 'X', 'T', '1'):
+				return 71;
+			case MakeFourCC('D', 'X', 'T', '2'):
+			case MakeFourCC('D', 'X', 'T', '3'):
+				return 74;
+			case MakeFourCC('D', 'X', 'T', '4'):
+			case MakeFourCC('D', 'X', 'T', '5'):
+				return 77;
+			case MakeFourCC('A', 'T', 'I', '1'):
+			case MakeFourCC('B', 'C', '4', 'U'):
+				return 80;
+			case MakeFourCC('B', 'C', '4', 'S'):
+				return 81;
+			case MakeFourCC('A', 'T', 'I', '2'):
+			case MakeFourCC('B', 'C', '5', 'U'):
+				return 83;
+			case MakeFourCC('B', 'C', '5', 'S'):
+				return 84;
+			// D3DFORMAT values stored as the four character code
+			case 36:
+				return 11;
+			case 111:
+				return 54;
+			case 112:
+				return 34;
+			case 113:
+				return 10;
+			case 114:
+				return 41;
+			case 115:
+				return 16;
+			case 116:
+				return 2;
+			default:
+				return 0;
+			}
+		}
+		if (pixelFormat.Flags & DdsPixelRgb)
+		{
+			switch (pixelFormat.RgbBitCount)
+			{
+			case 32:
+				if (HasMasks(pixelFormat, 0xFF, 0xFF00, 0xFF0000, 0xFF000000))
+				{
+					return 28;
+				}
+				if (HasMasks(pixelFormat, 0xFF0000, 0xFF00, 0xFF, 0xFF000000))
+				{
+					return 87;
+				}
+				if (HasMasks(pixelFormat, 0xFF0000, 0xFF00, 0xFF, 0))
+				{
+					return 88;
+				}
+				if (HasMasks(pixelFormat, 0x3FF, 0xFFC00, 0x3FF00000, 0xC0000000))
+				{
+					return 24;
+				}
+				if (HasMasks(pixelFormat, 0xFFFF, 0xFFFF0000, 0, 0))
+				{
+					return 35;
+				}
+				if (HasMasks(pixelFormat, 0xFFFFFFFF, 0, 0, 0))
+				{
+					return 41;
+				}
+				return 0;
+			case 16:
+				if (HasMasks(pixelFormat, 0xF800, 0x7E0, 0x1F, 0))
+				{
+					return 85;
+				}
+				if (HasMasks(pixelFormat, 0x7C00, 0x3E0, 0x1F, 0x8000))
+				{
+					return 86;
+				}
+				return 0;
+			default:
+				return 0;
+			}
+		}
+		if (pixelFormat.Flags & DdsPixelLuminance)
+		{
+			if (pixelFormat.RgbBitCount == 8 && pixelFormat.RedMask == 0xFF)
+			{
+				return 61;
+			}
+			if (pixelFormat.RgbBitCount == 16 && pixelFormat.RedMask == 0xFFFF)
+			{
+				return 56;
+			}
+			if (pixelFormat.RgbBitCount == 16 && (pixelFormat.Flags & DdsPixelAlphaPixels) && HasMasks(pixelFormat, 0xFF, 0, 0, 0xFF00))
+			{
+				return 49;
+			}
+			return 0;
+		}
+		if ((pixelFormat.Flags & DdsPixelAlpha) && pixelFormat.RgbBitCount == 8)
+		{
+			return 65;
+		}
+		return 0;
+	}
+}
+
+bool IsDds(const uint8_t* data, size_t size)
+{
+	uint32_t magic;
+	if (data == nullptr || size < sizeof(magic) + sizeof(DdsHeader))
+	{
+		return false;
+	}
+	memcpy(&magic, data, sizeof(magic));
+	return magic == DdsMagic;
+}
+
+bool GetDdsLevelPitch(uint32_t format, uint32_t width, uint32_t height, size_t& rowPitch, size_t& slicePitch)
+{
+	bool blockCompressed;
+	uint32_t formatSize = GetFormatSize(format, blockCompressed);
+	if (formatSize == 0)
+	{
+		return false;
+	}
+	if (blockCompressed)
+	{
+		rowPitch = static_cast<size_t>((max)((width + 3) / 4, 1u)) * formatSize;
+		slicePitch = rowPitch * (max)((height + 3) / 4, 1u);
+	}
+	else
+	{
+		rowPitch = (static_cast<size_t>(width) * formatSize + 7) / 8;
+		slicePitch = rowPitch * height;
+	}
+	return true;
+}
+
+bool IsDdsBlockCompressed(uint32_t format)
+{
+	bool blockCompressed;
+	return GetFormatSize(format, blockCompressed) != 0 && blockCompressed;
+}
+
+bool ParseDds(const uint8_t* data, size_t size, DdsTexture& texture)
+{
+	if (!IsDds(data, size))
+	{
+		return false;
+	}
+	DdsHeader header;
+	memcpy(&header, data + sizeof(uint32_t), sizeof(header));
+	if (header.Size != sizeof(DdsHeader) || header.PixelFormat.Size != sizeof(DdsPixelFormat))
+	{
+		return false;
+	}
+	size_t offset = sizeof(uint32_t) + sizeof(DdsHeader);
+
+	texture.Width = (max)(header.Width, 1u);
+	texture.Height = (max)(header.Height, 1u);
+	texture.Depth = 1;
+	texture.MipLevels = (max)(header.MipMapCount, 1u);
+	texture.ArraySize = 1;
+	texture.IsCube = false;
+	if ((header.PixelFormat.Flags & DdsPixelFourCC) && header.PixelFormat.FourCC == MakeFourCC('D', 'X', '1', '0'))
+	{
+		DdsHeaderDx10 extension;
+		if (size < offset + sizeof(extension))
+		{
+			return false;
+		}
+		memcpy(&extension, data + offset, sizeof(extension));
+		offset += sizeof(extension);
+		texture.Format = extension.Format;
+		texture.ArraySize = extension.ArraySize;
+		if (texture.ArraySize == 0)
+		{
+			return false;
+		}
+		switch (extension.ResourceDimension)
+		{
+		case DdsDimensionTexture1D:
+			if ((header.Flags & DdsFlagHeight) && header.Height > 1)
+			{
+				return false;
+			}
+			texture.Dimension = DdsDimension::Texture1D;
+			texture.Height = 1;
+			break;
+		case DdsDimensionTexture2D:
+			texture.Dimension = DdsDimension::Texture2D;
+			if (extension.MiscFlag & DdsMiscTextureCube)
+			{
+				texture.IsCube = true;
+				texture.ArraySize *= 6;
+			}
+			break;
+		case DdsDimensionTexture3D:
+			if (!(header.Flags & DdsFlagDepth) || texture.ArraySize != 1)
+			{
+				return false;
+			}
+			texture.Dimension = DdsDimension::Texture3D;
+			texture.Depth = (max)(header.Depth, 1u);
+			break;
+		default:
+			return false;
+		}
+	}
+	else
+	{
+		texture.Format = GetLegacyFormat(header.PixelFormat);
+		if (header.Flags & DdsFlagDepth)
+		{
+			texture.Dimension = DdsDimension::Texture3D;
+			texture.Depth = (max)(header.Depth, 1u);
+		}
+		else
+		{
+			texture.Dimension = DdsDimension::Texture2D;
+			if (header.Caps2 & DdsCaps2CubeMap)
+			{
+				// Cube maps without all six faces cannot be made into a texture
+				if ((header.Caps2 & DdsCaps2AllFaces) != DdsCaps2AllFaces)
+				{
+					return false;
+				}
+				texture.IsCube = true;
+				texture.ArraySize = 6;
+			}
+		}
+	}
+
+	bool blockCompressed;
+	if (GetFormatSize(texture.Format, blockCompressed) == 0)
+	{
+		return false;
+	}
+	uint32_t maxSize = texture.Dimension == DdsDimension::Texture3D ? DdsMaxVolumeSize : DdsMaxTextureSize;
+	if (texture.Width > maxSize || texture.Height > maxSize || texture.Depth > DdsMaxVolumeSize ||
+		texture.ArraySize > (texture.IsCube ? DdsMaxArraySize * 6 : DdsMaxArraySize) || texture.MipLevels > DdsMaxMipLevels)
+	{
+		return false;
+	}
+	uint32_t fullMipLevels = 1;
+	for (uint32_t largest = (max)((max)(texture.Width, texture.Height), texture.Depth); largest > 1; largest >>= 1)
+	{
+		fullMipLevels++;
+	}
+	if (texture.MipLevels > fullMipLevels)
+	{
+		return false;
+	}
+
+	texture.Subresources.clear();
+	texture.Subresources.reserve(static_cast<size_t>(texture.ArraySize) * texture.MipLevels);
+	for (uint32_t slice = 0; slice < texture.ArraySize; slice++)
+	{
+		uint32_t width = texture.Width;
+		uint32_t height = texture.Height;
+		uint32_t depth = texture.Depth;
+		for (uint32_t level = 0; level < texture.MipLevels; level++)
+		{
+			DdsSubresource subresource;
+			GetDdsLevelPitch(texture.Format, width, height, subresource.RowPitch, subresource.SlicePitch);
+			uint64_t levelSize = static_cast<uint64_t>(subresource.SlicePitch) * depth;
+			if (levelSize > size - offset)
+			{
+				return false;
+			}
+			subresource.Data = data + offset;
+			texture.Subresources.push_back(subresource);
+			offset += static_cast<size_t>(levelSize);
+			width = (max)(width / 2, 1u);
+			height = (max)(height / 2, 1u);
+			depth = (max)(depth / 2, 1u);
+		}
+	}
+	return true;
+}
+
+void WriteDdsHeader(vector<uint8_t>& file, uint32_t format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t arraySize)
+{
+	size_t rowPitch = 0;
+	size_t slicePitch = 0;
+	bool blockCompressed;
+	GetFormatSize(format, blockCompressed);
+	GetDdsLevelPitch(format, width, height, rowPitch, slicePitch);
+
+	DdsHeader header = {};
+	header.Size = sizeof(DdsHeader);
+	header.Flags = DdsFlagCaps | DdsFlagHeight | DdsFlagWidth | DdsFlagPixelFormat | DdsFlagMipMapCount |
+				   (blockCompressed ? DdsFlagLinearSize : DdsFlagPitch);
+	header.Height = height;
+	header.Width = width;
+	header.PitchOrLinearSize = static_cast<uint32_t>(blockCompressed ? slicePitch : rowPitch);
+	header.MipMapCount = mipLevels;
+	header.PixelFormat.Size = sizeof(DdsPixelFormat);
+	header.PixelFormat.Flags = DdsPixelFourCC;
+	header.PixelFormat.FourCC = MakeFourCC('D', 'X', '1', '0');
+	header.Caps = DdsCapsTexture | (mipLevels > 1 ? DdsCapsMipMap | DdsCapsComplex : 0);
+	DdsHeaderDx10 extension = { format, DdsDimensionTexture2D, 0, arraySize, 0 };
+
+	uint32_t magic = DdsMagic;
+	size_t start = file.size();
+	file.resize(start + sizeof(magic) + sizeof(header) + sizeof(extension));
+	memcpy(&file[start], &magic, sizeof(magic));
+	memcpy(&file[start + sizeof(magic)], &header, sizeof(header));
+	memcpy(&file[start + sizeof(magic) + sizeof(header)], &extension, sizeof(extension));
+}
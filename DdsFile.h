@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Reading and writing DDS files.
+//
+// A DDS file holds a texture exactly as the GPU wants it: every mip level of every array slice (or cube
+// face), in any DXGI format including the block compressed ones.  ParseDds checks the header and works out
+// where each subresource is in the file without touching the pixels, so a texture can be created straight
+// from a memory mapped file (see MappedFile.h) and loading costs only the I/O.  Both the DX10 header
+// extension and the older pixel formats (DXT1 to DXT5, ATI1/ATI2, and the usual uncompressed masks) are
+// understood.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.  Formats are DXGI_FORMAT
+// values.
+
+#define DdsMagic					0x20534444		// "DDS "
+
+// The DXGI_FORMAT values used by the code that writes DDS files
+#define DdsFormatR8G8B8A8			28
+#define DdsFormatR8G8B8A8Srgb		29
+#define DdsFormatBC1				71
+#define DdsFormatBC1Srgb			72
+#define DdsFormatBC3				77
+#define DdsFormatBC3Srgb			78
+#define DdsFormatBC7				98
+#define DdsFormatBC7Srgb			99
+
+enum class DdsDimension
+{
+	Texture1D,
+	Texture2D,
+	Texture3D
+};
+
+// Where one mip level of one array slice is in the file
+struct DdsSubresource
+{
+	const uint8_t*					Data;
+	std::size_t						RowPitch;
+	// Size of one depth slice (the whole level unless it is a 3D texture)
+	std::size_t						SlicePitch;
+};
+
+struct DdsTexture
+{
+	DdsDimension					Dimension;
+	uint32_t						Format;
+	uint32_t						Width;
+	uint32_t						Height;
+	uint32_t						Depth;
+	uint32_t						MipLevels;
+	// Number of slices (six for each cube)
+	uint32_t						ArraySize;
+	bool							IsCube;
+	// MipLevels subresources for each array slice, in the order D3D numbers them
+	std::vector<DdsSubresource>		Subresources;
+};
+
+// Returns true if data starts like a DDS file
+bool			IsDds(const uint8_t* data, std::size_t size);
+
+// Check a DDS file and find its subresources, which point into data.  Returns false if the file is
+// damaged, is bigger than a Direct3D 11 texture can be, or uses a format that cannot be loaded.
+bool			ParseDds(const uint8_t* data, std::size_t size, DdsTexture& texture);
+
+// Bytes in a row of pixels (or of 4x4 blocks) of the given width, and in a whole level.  Returns false for
+// formats that cannot be loaded.
+bool			GetDdsLevelPitch(uint32_t format, uint32_t width, uint32_t height, std::size_t& rowPitch, std::size_t& slicePitch);
+
+// Returns true for the block compressed formats (BC1 to BC7), which are stored in 4x4 blocks
+bool			IsDdsBlockCompressed(uint32_t format);
+
+// Write the headers (with the DX10 extension) of a 2D texture.  The mip levels of each array slice follow.
+void			WriteDdsHeader(std::vector<uint8_t>& file, uint32_t format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t arraySize = 1);
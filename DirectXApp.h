@@ -1,13 +1,13 @@
-#pragma once
-#include "DirectXFramework.h"
-
-class DirectXApp : public DirectXFramework
-{
-public:
-	void CreateSceneGraph();
-	void UpdateSceneGraph();
-
-private:
-	float _rotationAngle{ 0 };
-};
-
+#pragma once
+#include "DirectXFramework.h"
+
+class DirectXApp : public DirectXFramework
+{
+public:
+	void CreateSceneGraph();
+	void UpdateSceneGraph();
+
+private:
+	float _rotationAngle{ 0 };
+};
+
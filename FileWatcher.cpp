@@ -0,0 +1,176 @@
+#include "FileWatcher.h"
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <unordered_set>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+FileWatcher::FileWatcher() : _notify(-1)
+{
+#ifdef __linux__
+	_notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+	if (_notify >= 0)
+	{
+		close(_notify);
+	}
+#endif
+}
+
+string FileWatcher::NormalisePath(const string& fileName)
+{
+	error_code error;
+	filesystem::path path = filesystem::absolute(filesystem::u8path(fileName), error);
+	if (error)
+	{
+		path = filesystem::u8path(fileName);
+	}
+	return path.lexically_normal().generic_u8string();
+}
+
+FileWatcher::FileStamp FileWatcher::GetFileStamp(const string& path)
+{
+	FileStamp stamp = { false, 0, 0 };
+	error_code error;
+	filesystem::path filePath = filesystem::u8path(path);
+	stamp.Size = filesystem::file_size(filePath, error);
+	if (error)
+	{
+		stamp.Size = 0;
+		return stamp;
+	}
+	stamp.ModifiedTime = filesystem::last_write_time(filePath, error).time_since_epoch().count();
+	stamp.Exists = !error;
+	return stamp;
+}
+
+void FileWatcher::Watch(const string& fileName)
+{
+	string path = NormalisePath(fileName);
+	lock_guard<mutex> lock(_mutex);
+	if (_files.find(path) != _files.end())
+	{
+		return;
+	}
+	FileStamp stamp = GetFileStamp(path);
+	_files.emplace(path, WatchedFile{ fileName, stamp, stamp });
+#ifdef __linux__
+	if (_notify >= 0)
+	{
+		// Adding a watch for a directory that is already watched returns the same watch descriptor
+		string directory = filesystem::u8path(path).parent_path().generic_u8string();
+		int watch = inotify_add_watch(_notify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ATTRIB);
+		if (watch >= 0)
+		{
+			_directories[watch] = directory;
+		}
+		else
+		{
+			// The directory cannot be watched (it may not exist yet), so fall back to polling every file
+			close(_notify);
+			_notify = -1;
+			_directories.clear();
+		}
+	}
+#endif
+}
+
+vector<string> FileWatcher::WaitForChanges(unsigned int timeoutMilliseconds)
+{
+	if (IsUsingNotifications())
+	{
+		return WaitForNotifications(timeoutMilliseconds);
+	}
+	this_thread::sleep_for(chrono::milliseconds(timeoutMilliseconds));
+	return PollFiles();
+}
+
+vector<string> FileWatcher::PollFiles()
+{
+	vector<string> changedFiles;
+	lock_guard<mutex> lock(_mutex);
+	for (auto& watchedFile : _files)
+	{
+		WatchedFile& file = watchedFile.second;
+		FileStamp stamp = GetFileStamp(watchedFile.first);
+		// Only report the file once it has stayed the same for a whole poll interval
+		if (stamp.Exists && stamp == file.Polled && stamp != file.Reported)
+		{
+			file.Reported = stamp;
+			changedFiles.push_back(file.Name);
+		}
+		file.Polled = stamp;
+	}
+	return changedFiles;
+}
+
+vector<string> FileWatcher::WaitForNotifications(unsigned int timeoutMilliseconds)
+{
+	vector<string> changedFiles;
+#ifdef __linux__
+	pollfd notification = { _notify, POLLIN, 0 };
+	if (poll(&notification, 1, static_cast<int>(timeoutMilliseconds)) <= 0)
+	{
+		return changedFiles;
+	}
+	// Gather events until the files have settled down
+	unordered_set<string> touchedPaths;
+	bool overflowed = false;
+	alignas(inotify_event) char buffer[4096];
+	do
+	{
+		ssize_t length;
+		while ((length = read(_notify, buffer, sizeof(buffer))) > 0)
+		{
+			lock_guard<mutex> lock(_mutex);
+			for (char* position = buffer; position < buffer + length; )
+			{
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(position);
+				position += sizeof(inotify_event) + event->len;
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					// Events were lost, so every file has to be checked
+					overflowed = true;
+					continue;
+				}
+				unordered_map<int, string>::const_iterator directory = _directories.find(event->wd);
+				if (directory != _directories.end() && event->len > 0)
+				{
+					touchedPaths.insert(directory->second + "/" + event->name);
+				}
+			}
+		}
+	} while (poll(&notification, 1, FileWatchSettleMilliseconds) > 0);
+
+	lock_guard<mutex> lock(_mutex);
+	for (auto& watchedFile : _files)
+	{
+		if (!overflowed && touchedPaths.find(watchedFile.first) == touchedPaths.end())
+		{
+			continue;
+		}
+		WatchedFile& file = watchedFile.second;
+		FileStamp stamp = GetFileStamp(watchedFile.first);
+		if (stamp.Exists && stamp != file.Reported)
+		{
+			file.Reported = stamp;
+			file.Polled = stamp;
+			changedFiles.push_back(file.Name);
+		}
+	}
+#else
+	(void)timeoutMilliseconds;
+#endif
+	return changedFiles;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Watches a set of files for changes.  Used by the ResourceManager to reload assets while the application
+// is running.
+//
+// On Linux, the directories holding the watched files are watched with inotify, so a waiting thread wakes
+// up as soon as a file is written or replaced (editors often save by writing a new file and renaming it
+// over the old one, which is why directories are watched rather than the files themselves).  Elsewhere,
+// or if inotify is not available, the size and modification time of each watched file are polled.
+//
+// A file is only reported once it has stopped changing, so a reader never sees a file that is still being
+// written: with inotify, events are gathered until none have arrived for FileWatchSettleMilliseconds, and
+// when polling, a new size and time have to be seen by two polls in a row.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+#define FileWatchPollMilliseconds		250
+#define FileWatchSettleMilliseconds		50
+
+class FileWatcher
+{
+public:
+	FileWatcher();
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	// Start watching a file (fileName is UTF-8).  The file does not have to exist yet.  Watching a file that
+	// is already watched does nothing.  Can be called from any thread.
+	void						Watch(const std::string& fileName);
+
+	// Wait for up to timeoutMilliseconds for watched files to change.  Returns the names (as they were given to
+	// Watch) of the files that have changed, each once.  Only one thread should wait at a time.
+	std::vector<std::string>	WaitForChanges(unsigned int timeoutMilliseconds);
+
+	inline bool					IsUsingNotifications() const { return _notify >= 0; }
+
+private:
+	// Size and modification time of a file.  A file that does not exist has Exists set to false.
+	struct FileStamp
+	{
+		bool					Exists;
+		unsigned long long		Size;
+		long long				ModifiedTime;
+
+		bool operator==(const FileStamp& other) const
+		{
+			return Exists == other.Exists && Size == other.Size && ModifiedTime == other.ModifiedTime;
+		}
+		bool operator!=(const FileStamp& other) const { return !(*this == other); }
+	};
+
+	struct WatchedFile
+	{
+		std::string				Name;
+		// Stamp of the version that was last reported (or that was there when watching started)
+		FileStamp				Reported;
+		// Stamp seen by the last poll
+		FileStamp				Polled;
+	};
+
+	std::mutex									_mutex;
+	// Keyed by the normalised path of each file
+	std::unordered_map<std::string, WatchedFile>	_files;
+	// inotify descriptor, or -1 if files are being polled
+	int											_notify;
+	// Watched directory for each inotify watch descriptor
+	std::unordered_map<int, std::string>		_directories;
+
+	static std::string			NormalisePath(const std::string& fileName);
+	static FileStamp			GetFileStamp(const std::string& path);
+	std::vector<std::string>	PollFiles();
+	std::vector<std::string>	WaitForNotifications(unsigned int timeoutMilliseconds);
+};
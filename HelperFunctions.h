@@ -1,13 +1,13 @@
-#pragma once
-
-// Various helper functions
-
-using namespace std;
-
-inline void ThrowIfFailed(HRESULT hr)
-{
-	if (FAILED(hr))
-	{
-		throw exception();
-	}
-}
+#pragma once
+
+// Various helper functions
+
+using namespace std;
+
+inline void ThrowIfFailed(HRESULT hr)
+{
+	if (FAILED(hr))
+	{
+		throw exception();
+	}
+}
@@ -0,0 +1,134 @@
+#include "HotReloader.h"
+#include "StringConversion.h"
+#include <algorithm>
+
+HotReloader::HotReloader(const function<void(const string&, const WatchedFile&)>& reloadFile)
+	: _reloadFile(reloadFile)
+{
+	_running = false;
+}
+
+HotReloader::~HotReloader()
+{
+	Disable();
+}
+
+void HotReloader::Enable()
+{
+	lock_guard<mutex> lock(_mutex);
+	if (_running)
+	{
+		return;
+	}
+	_fileWatcher = make_unique<FileWatcher>();
+	_running = true;
+	_thread = thread(&HotReloader::ReloadChangedFiles, this);
+}
+
+void HotReloader::Disable()
+{
+	{
+		lock_guard<mutex> lock(_mutex);
+		if (!_running)
+		{
+			return;
+		}
+		_running = false;
+	}
+	// The reload thread notices within one poll interval
+	_thread.join();
+	lock_guard<mutex> lock(_mutex);
+	_watchedFiles.clear();
+	_fileWatcher = nullptr;
+}
+
+unsigned int HotReloader::GetFileVersion(wstring_view fileName)
+{
+	lock_guard<mutex> lock(_mutex);
+	if (!_running)
+	{
+		return 0;
+	}
+	return WatchFile(fileName).Version;
+}
+
+void HotReloader::WatchMesh(wstring_view fileName, const InternedName& modelName, const string& importProfile)
+{
+	lock_guard<mutex> lock(_mutex);
+	if (!_running)
+	{
+		return;
+	}
+	pair<InternedName, string> mesh(modelName, importProfile);
+	vector<pair<InternedName, string>>& meshes = WatchFile(fileName).Meshes;
+	if (find(meshes.begin(), meshes.end(), mesh) == meshes.end())
+	{
+		meshes.push_back(mesh);
+	}
+}
+
+void HotReloader::WatchMaterial(wstring_view fileName, const InternedName& materialName)
+{
+	lock_guard<mutex> lock(_mutex);
+	if (!_running)
+	{
+		return;
+	}
+	vector<InternedName>& materials = WatchFile(fileName).Materials;
+	if (find(materials.begin(), materials.end(), materialName) == materials.end())
+	{
+		materials.push_back(materialName);
+	}
+}
+
+WatchedFile& HotReloader::WatchFile(wstring_view fileName)
+{
+	string name = ws2s(fileName);
+	map<string, WatchedFile>::iterator watchedFile = _watchedFiles.find(name);
+	if (watchedFile == _watchedFiles.end())
+	{
+		watchedFile = _watchedFiles.emplace(name, WatchedFile()).first;
+		_fileWatcher->Watch(name);
+	}
+	return watchedFile->second;
+}
+
+void HotReloader::ReloadChangedFiles()
+{
+	// Textures are loaded with WIC, which needs COM on this thread
+	HRESULT comInitialised = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+	while (_running)
+	{
+		for (const string& fileName : _fileWatcher->WaitForChanges(FileWatchPollMilliseconds))
+		{
+			ReloadFile(fileName);
+		}
+	}
+	if (SUCCEEDED(comInitialised))
+	{
+		CoUninitialize();
+	}
+}
+
+void HotReloader::ReloadFile(const string& fileName)
+{
+	// Take a copy of what was loaded from the file, since reloading it can start watching other files
+	WatchedFile file;
+	{
+		lock_guard<mutex> lock(_mutex);
+		map<string, WatchedFile>::iterator watchedFile = _watchedFiles.find(fileName);
+		if (watchedFile == _watchedFiles.end())
+		{
+			return;
+		}
+		file = watchedFile->second;
+	}
+	_reloadFile(fileName, file);
+	// Anything else using the file (such as a shader) reloads it when it sees the new version
+	lock_guard<mutex> lock(_mutex);
+	map<string, WatchedFile>::iterator watchedFile = _watchedFiles.find(fileName);
+	if (watchedFile != _watchedFiles.end())
+	{
+		watchedFile->second.Version++;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "core.h"
+#include "FileWatcher.h"
+#include "InternedName.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Keeps track of the files that loaded meshes and materials came from and, while hot reload is on, has a
+// background thread watch them (see FileWatcher.h) and hand each file that changes to the resource manager
+// to reload (see ResourceManager::EnableHotReload).  The version of each watched file goes up once it has
+// been reloaded, so users of files that the resource manager does not load itself (such as shaders) can
+// tell when they need to reload them.
+
+// The resources loaded from a watched file
+struct WatchedFile
+{
+	unsigned int							Version{ 0 };
+	// Meshes with the import profile they were loaded with
+	vector<pair<InternedName, string>>		Meshes;
+	// Materials that use the file as their texture
+	vector<InternedName>					Materials;
+};
+
+class HotReloader
+{
+public:
+	// reloadFile is called on the reload thread with the name (UTF-8) of each file that changes and a copy of
+	// what was loaded from it.  COM is initialised on that thread.
+	HotReloader(const function<void(const string&, const WatchedFile&)>& reloadFile);
+	~HotReloader();
+
+	HotReloader(const HotReloader&) = delete;
+	HotReloader& operator=(const HotReloader&) = delete;
+
+	void									Enable();
+	// Waits for the reload thread to finish the file it is reloading, then forgets every watched file
+	void									Disable();
+	inline bool								IsEnabled() { return _running; }
+
+	// Number of times a file has changed since it was first asked about.  Asking about a file starts watching
+	// it.  Always 0 when hot reload is off.
+	unsigned int							GetFileVersion(wstring_view fileName);
+	// Note that a mesh or a material was loaded from a file, which is watched from now on.  Does nothing when
+	// hot reload is off.
+	void									WatchMesh(wstring_view fileName, const InternedName& modelName, const string& importProfile);
+	void									WatchMaterial(wstring_view fileName, const InternedName& materialName);
+
+private:
+	function<void(const string&, const WatchedFile&)>	_reloadFile;
+	mutex									_mutex;
+	// By file name (UTF-8)
+	map<string, WatchedFile>				_watchedFiles;
+	unique_ptr<FileWatcher>					_fileWatcher;
+	thread									_thread;
+	atomic<bool>							_running;
+
+	// Start watching a file.  _mutex must be held.
+	WatchedFile&							WatchFile(wstring_view fileName);
+	void									ReloadChangedFiles();
+	void									ReloadFile(const string& fileName);
+};
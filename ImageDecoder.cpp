@@ -0,0 +1,1470 @@
+#include "ImageDecoder.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_DECODER_SSE2
+#include <emmintrin.h>
+#endif
+
+#define BmpCompressionRgb			0
+#define BmpCompressionBitFields		3
+#define BmpCompressionAlphaBitFields	6
+
+#define TgaColourMapped				1
+#define TgaTrueColour				2
+#define TgaGreyscale				3
+#define TgaRle						8
+#define TgaRightToLeft				0x10
+#define TgaTopToBottom				0x20
+
+#define PngGreyscale				0
+#define PngTrueColour				2
+#define PngIndexed					3
+#define PngGreyscaleAlpha			4
+#define PngTrueColourAlpha			6
+
+// Codes of up to this many bits are decoded with a single table lookup when inflating
+#define InflateFastBits				9
+
+using namespace std;
+
+namespace
+{
+	const uint8_t PngSignature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+	inline uint16_t ReadUInt16(const uint8_t* data)
+	{
+		return static_cast<uint16_t>(data[0] | (data[1] << 8));
+	}
+
+	inline uint32_t ReadUInt32(const uint8_t* data)
+	{
+		return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+	}
+
+	inline uint32_t ReadUInt32BigEndian(const uint8_t* data)
+	{
+		return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+	}
+
+	// A pixel in the order it is written out (the first byte is the lowest)
+	inline uint32_t MakePixel(uint32_t red, uint32_t green, uint32_t blue, uint32_t alpha, bool bgra)
+	{
+		return bgra ? (blue | (green << 8) | (red << 16) | (alpha << 24)) : (red | (green << 8) | (blue << 16) | (alpha << 24));
+	}
+
+	inline void StorePixel(uint8_t* output, uint32_t pixel)
+	{
+		memcpy(output, &pixel, sizeof(pixel));
+	}
+
+	// How the pixels of a row are stored in the file
+	enum class SourceLayout
+	{
+		// Three bytes, blue first
+		Bgr8,
+		// Four bytes, blue first
+		Bgra8,
+		// Four bytes, blue first, with the fourth byte unused
+		Bgrx8,
+		Rgb8,
+		Rgba8,
+		Grey8,
+		GreyAlpha8,
+		// 1, 2, 4 or 8-bit indices into Palette, the first pixel in the highest bits
+		Indexed,
+		// 16 or 32-bit little endian pixels whose channels are picked out with bit masks
+		Masked,
+		// 8 or 16-bit big endian PNG samples, possibly with a colour key
+		Samples
+	};
+
+	struct MaskChannel
+	{
+		uint32_t				Mask;
+		uint32_t				Shift;
+		uint32_t				Bits;
+	};
+
+	struct RowSource
+	{
+		SourceLayout			Layout;
+		// The top row of the image and the distance to the next one down, which is negative for images
+		// stored from the bottom up
+		const uint8_t*			Data;
+		ptrdiff_t				Pitch;
+		// Swap the red and blue channels (the SIMD layouts)
+		bool					Swap;
+		// Indexed.  The entries are already in the order they are written out.
+		uint32_t				BitsPerIndex;
+		uint32_t				Palette[256];
+		// Masked (red, green, blue and alpha)
+		uint32_t				BytesPerPixel;
+		MaskChannel				Channels[4];
+		// Samples
+		uint32_t				SampleCount;
+		uint32_t				BytesPerSample;
+		bool					HasKey;
+		uint16_t				Key[3];
+	};
+
+	void SetMasks(RowSource& source, uint32_t bytesPerPixel, uint32_t red, uint32_t green, uint32_t blue, uint32_t alpha)
+	{
+		source.Layout = SourceLayout::Masked;
+		source.BytesPerPixel = bytesPerPixel;
+		const uint32_t masks[4] = { red, green, blue, alpha };
+		for (int channel = 0; channel < 4; channel++)
+		{
+			MaskChannel& maskChannel = source.Channels[channel];
+			maskChannel.Mask = masks[channel];
+			maskChannel.Shift = 0;
+			maskChannel.Bits = 0;
+			if (masks[channel] != 0)
+			{
+				while (!(masks[channel] & (1u << maskChannel.Shift)))
+				{
+					maskChannel.Shift++;
+				}
+				while (maskChannel.Shift + maskChannel.Bits < 32 && (masks[channel] >> (maskChannel.Shift + maskChannel.Bits)))
+				{
+					maskChannel.Bits++;
+				}
+			}
+		}
+	}
+
+	inline uint32_t ExtractChannel(uint32_t pixel, const MaskChannel& channel, uint32_t missing)
+	{
+		if (channel.Bits == 0)
+		{
+			return missing;
+		}
+		uint32_t value = (pixel & channel.Mask) >> channel.Shift;
+		if (channel.Bits >= 8)
+		{
+			return value >> (channel.Bits - 8);
+		}
+		uint32_t maximum = (1u << channel.Bits) - 1;
+		return (value * 255 + maximum / 2) / maximum;
+	}
+
+#ifdef IMAGE_DECODER_SSE2
+	inline __m128i SwapRedBlue(__m128i pixels)
+	{
+		const __m128i greenAlpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+		const __m128i lowByte = _mm_set1_epi32(0xFF);
+		__m128i red = _mm_and_si128(_mm_srli_epi32(pixels, 16), lowByte);
+		__m128i blue = _mm_slli_epi32(_mm_and_si128(pixels, lowByte), 16);
+		return _mm_or_si128(_mm_and_si128(pixels, greenAlpha), _mm_or_si128(red, blue));
+	}
+#endif
+
+	inline uint32_t SwapRedBlue(uint32_t pixel)
+	{
+		return (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+	}
+
+	// The kernels convert a row and return the OR of the alpha of its pixels (the ones whose alpha comes from
+	// the file), for BMP files whose alpha is not used
+
+	uint32_t ConvertFourBytes(const uint8_t* row, uint8_t* output, uint32_t width, bool swap, bool opaque)
+	{
+		uint32_t x = 0;
+		uint32_t alpha = 0;
+#ifdef IMAGE_DECODER_SSE2
+		const __m128i opaqueAlpha = _mm_set1_epi32(opaque ? static_cast<int>(0xFF000000) : 0);
+		__m128i alphaSum = _mm_setzero_si128();
+		for (; x + 4 <= width; x += 4)
+		{
+			__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4));
+			alphaSum = _mm_or_si128(alphaSum, pixels);
+			pixels = _mm_or_si128(pixels, opaqueAlpha);
+			if (swap)
+			{
+				pixels = SwapRedBlue(pixels);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + x * 4), pixels);
+		}
+		alphaSum = _mm_or_si128(alphaSum, _mm_srli_si128(alphaSum, 8));
+		alphaSum = _mm_or_si128(alphaSum, _mm_srli_si128(alphaSum, 4));
+		alpha = static_cast<uint32_t>(_mm_cvtsi128_si32(alphaSum)) >> 24;
+#endif
+		for (; x < width; x++)
+		{
+			uint32_t pixel;
+			memcpy(&pixel, row + x * 4, sizeof(pixel));
+			alpha |= pixel >> 24;
+			pixel |= opaque ? 0xFF000000 : 0;
+			StorePixel(output + x * 4, swap ? SwapRedBlue(pixel) : pixel);
+		}
+		return alpha;
+	}
+
+	uint32_t ConvertThreeBytes(const uint8_t* row, uint8_t* output, uint32_t width, bool swap)
+	{
+		uint32_t x = 0;
+#ifdef IMAGE_DECODER_SSE2
+		// Four pixels are in the first 12 of the 16 bytes loaded, so the load stops short of the end of the row
+		const __m128i colourMask = _mm_set1_epi32(0x00FFFFFF);
+		const __m128i opaqueAlpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+		for (; x + 6 <= width; x += 4)
+		{
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 3));
+			__m128i pixels01 = _mm_unpacklo_epi32(bytes, _mm_srli_si128(bytes, 3));
+			__m128i pixels23 = _mm_unpacklo_epi32(_mm_srli_si128(bytes, 6), _mm_srli_si128(bytes, 9));
+			__m128i pixels = _mm_or_si128(_mm_and_si128(_mm_unpacklo_epi64(pixels01, pixels23), colourMask), opaqueAlpha);
+			if (swap)
+			{
+				pixels = SwapRedBlue(pixels);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + x * 4), pixels);
+		}
+#endif
+		for (; x < width; x++)
+		{
+			const uint8_t* pixel = row + x * 3;
+			uint32_t value = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16) | 0xFF000000;
+			StorePixel(output + x * 4, swap ? SwapRedBlue(value) : value);
+		}
+		return 0xFF;
+	}
+
+	uint32_t ConvertGrey(const uint8_t* row, uint8_t* output, uint32_t width)
+	{
+		uint32_t x = 0;
+#ifdef IMAGE_DECODER_SSE2
+		const __m128i opaqueAlpha = _mm_set1_epi8(static_cast<char>(0xFF));
+		for (; x + 16 <= width; x += 16)
+		{
+			__m128i grey = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+			__m128i greyGreyLow = _mm_unpacklo_epi8(grey, grey);
+			__m128i greyGreyHigh = _mm_unpackhi_epi8(grey, grey);
+			__m128i greyAlphaLow = _mm_unpacklo_epi8(grey, opaqueAlpha);
+			__m128i greyAlphaHigh = _mm_unpackhi_epi8(grey, opaqueAlpha);
+			__m128i* pixels = reinterpret_cast<__m128i*>(output + x * 4);
+			_mm_storeu_si128(pixels, _mm_unpacklo_epi16(greyGreyLow, greyAlphaLow));
+			_mm_storeu_si128(pixels + 1, _mm_unpackhi_epi16(greyGreyLow, greyAlphaLow));
+			_mm_storeu_si128(pixels + 2, _mm_unpacklo_epi16(greyGreyHigh, greyAlphaHigh));
+			_mm_storeu_si128(pixels + 3, _mm_unpackhi_epi16(greyGreyHigh, greyAlphaHigh));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			uint32_t grey = row[x];
+			StorePixel(output + x * 4, grey | (grey << 8) | (grey << 16) | 0xFF000000);
+		}
+		return 0xFF;
+	}
+
+	uint32_t ConvertGreyAlpha(const uint8_t* row, uint8_t* output, uint32_t width)
+	{
+		uint32_t x = 0;
+#ifdef IMAGE_DECODER_SSE2
+		const __m128i lowByte = _mm_set1_epi16(0xFF);
+		for (; x + 8 <= width; x += 8)
+		{
+			__m128i greyAlpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 2));
+			__m128i grey = _mm_and_si128(greyAlpha, lowByte);
+			__m128i greyGrey = _mm_or_si128(grey, _mm_slli_epi16(grey, 8));
+			__m128i* pixels = reinterpret_cast<__m128i*>(output + x * 4);
+			_mm_storeu_si128(pixels, _mm_unpacklo_epi16(greyGrey, greyAlpha));
+			_mm_storeu_si128(pixels + 1, _mm_unpackhi_epi16(greyGrey, greyAlpha));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			uint32_t grey = row[x * 2];
+			StorePixel(output + x * 4, grey | (grey << 8) | (grey << 16) | (static_cast<uint32_t>(row[x * 2 + 1]) << 24));
+		}
+		return 0xFF;
+	}
+
+	uint32_t ConvertIndexed(const RowSource& source, const uint8_t* row, uint8_t* output, uint32_t width)
+	{
+		if (source.BitsPerIndex == 8)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				StorePixel(output + x * 4, source.Palette[row[x]]);
+			}
+			return 0xFF;
+		}
+		uint32_t indicesPerByte = 8 / source.BitsPerIndex;
+		uint32_t indexMask = (1u << source.BitsPerIndex) - 1;
+		for (uint32_t x = 0; x < width; x++)
+		{
+			uint32_t shift = 8 - source.BitsPerIndex * (x % indicesPerByte + 1);
+			StorePixel(output + x * 4, source.Palette[(row[x / indicesPerByte] >> shift) & indexMask]);
+		}
+		return 0xFF;
+	}
+
+	uint32_t ConvertMasked(const RowSource& source, const uint8_t* row, uint8_t* output, uint32_t width, bool bgra)
+	{
+		uint32_t alpha = 0;
+		for (uint32_t x = 0; x < width; x++)
+		{
+			uint32_t pixel = source.BytesPerPixel == 2 ? ReadUInt16(row + x * 2) : ReadUInt32(row + x * 4);
+			uint32_t pixelAlpha = ExtractChannel(pixel, source.Channels[3], 255);
+			alpha |= pixelAlpha;
+			StorePixel(output + x * 4, MakePixel(ExtractChannel(pixel, source.Channels[0], 0), ExtractChannel(pixel, source.Channels[1], 0),
+												 ExtractChannel(pixel, source.Channels[2], 0), pixelAlpha, bgra));
+		}
+		return alpha;
+	}
+
+	uint32_t ConvertSamples(const RowSource& source, const uint8_t* row, uint8_t* output, uint32_t width, bool bgra)
+	{
+		uint32_t samples[4] = { 0, 0, 0, 0 };
+		for (uint32_t x = 0; x < width; x++)
+		{
+			const uint8_t* pixel = row + x * source.SampleCount * source.BytesPerSample;
+			for (uint32_t sample = 0; sample < source.SampleCount; sample++)
+			{
+				samples[sample] = source.BytesPerSample == 2 ? (pixel[sample * 2] << 8) | pixel[sample * 2 + 1] : pixel[sample];
+			}
+			// 16-bit samples keep their high byte
+			uint32_t shift = (source.BytesPerSample - 1) * 8;
+			uint32_t red, green, blue, alpha = 255;
+			if (source.SampleCount <= 2)
+			{
+				red = green = blue = samples[0] >> shift;
+				if (source.SampleCount == 2)
+				{
+					alpha = samples[1] >> shift;
+				}
+				else if (source.HasKey && samples[0] == source.Key[0])
+				{
+					alpha = 0;
+				}
+			}
+			else
+			{
+				red = samples[0] >> shift;
+				green = samples[1] >> shift;
+				blue = samples[2] >> shift;
+				if (source.SampleCount == 4)
+				{
+					alpha = samples[3] >> shift;
+				}
+				else if (source.HasKey && samples[0] == source.Key[0] && samples[1] == source.Key[1] && samples[2] == source.Key[2])
+				{
+					alpha = 0;
+				}
+			}
+			StorePixel(output + x * 4, MakePixel(red, green, blue, alpha, bgra));
+		}
+		return 0xFF;
+	}
+
+	uint32_t ConvertRow(const RowSource& source, const uint8_t* row, uint8_t* output, uint32_t width, bool bgra)
+	{
+		switch (source.Layout)
+		{
+			case SourceLayout::Bgr8:
+			case SourceLayout::Rgb8:
+				return ConvertThreeBytes(row, output, width, source.Swap);
+
+			case SourceLayout::Bgra8:
+			case SourceLayout::Rgba8:
+				return ConvertFourBytes(row, output, width, source.Swap, false);
+
+			case SourceLayout::Bgrx8:
+				return ConvertFourBytes(row, output, width, source.Swap, true);
+
+			case SourceLayout::Grey8:
+				return ConvertGrey(row, output, width);
+
+			case SourceLayout::GreyAlpha8:
+				return ConvertGreyAlpha(row, output, width);
+
+			case SourceLayout::Indexed:
+				return ConvertIndexed(source, row, output, width);
+
+			case SourceLayout::Masked:
+				return ConvertMasked(source, row, output, width, bgra);
+
+			default:
+				return ConvertSamples(source, row, output, width, bgra);
+		}
+	}
+
+	// Convert every row of the image in parallel.  If zeroAlphaIsOpaque is true and the alpha of every pixel
+	// is 0, the image is made opaque.
+	void ConvertRows(const RowSource& source, uint32_t width, uint32_t height, uint8_t* pixels, size_t rowPitch, bool bgra,
+					 bool zeroAlphaIsOpaque, bool rightToLeft)
+	{
+		size_t rowsPerTask = (max)(static_cast<size_t>(ImageDecodePixelsPerTask / width), static_cast<size_t>(1));
+		atomic<uint32_t> alpha(0);
+		ParallelFor(height, rowsPerTask, [&](size_t begin, size_t end)
+		{
+			uint32_t taskAlpha = 0;
+			for (size_t y = begin; y < end; y++)
+			{
+				uint8_t* output = pixels + y * rowPitch;
+				taskAlpha |= ConvertRow(source, source.Data + static_cast<ptrdiff_t>(y) * source.Pitch, output, width, bgra);
+				if (rightToLeft)
+				{
+					for (uint32_t left = 0, right = width - 1; left < right; left++, right--)
+					{
+						uint8_t pixel[4];
+						memcpy(pixel, output + left * 4, 4);
+						memcpy(output + left * 4, output + right * 4, 4);
+						memcpy(output + right * 4, pixel, 4);
+					}
+				}
+			}
+			alpha.fetch_or(taskAlpha);
+		});
+		if (zeroAlphaIsOpaque && alpha == 0)
+		{
+			ParallelFor(height, rowsPerTask, [&](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; y++)
+				{
+					uint8_t* output = pixels + y * rowPitch;
+					for (uint32_t x = 0; x < width; x++)
+					{
+						output[x * 4 + 3] = 255;
+					}
+				}
+			});
+		}
+	}
+
+	//
+	// BMP
+	//
+
+	struct BmpHeader
+	{
+		uint32_t				Width;
+		uint32_t				Height;
+		bool					BottomUp;
+		uint32_t				BitsPerPixel;
+		uint32_t				Compression;
+		uint32_t				PixelOffset;
+		size_t					RowPitch;
+		// Red, green, blue and alpha, for 16 and 32-bit images
+		uint32_t				Masks[4];
+		const uint8_t*			Palette;
+		uint32_t				PaletteSize;
+	};
+
+	bool ReadBmpHeader(const uint8_t* data, size_t size, BmpHeader& header)
+	{
+		if (size < 54 || data[0] != 'B' || data[1] != 'M')
+		{
+			return false;
+		}
+		header.PixelOffset = ReadUInt32(data + 10);
+		uint32_t headerSize = ReadUInt32(data + 14);
+		int64_t width = static_cast<int32_t>(ReadUInt32(data + 18));
+		int64_t height = static_cast<int32_t>(ReadUInt32(data + 22));
+		header.BitsPerPixel = ReadUInt16(data + 28);
+		header.Compression = ReadUInt32(data + 30);
+		uint32_t paletteSize = ReadUInt32(data + 46);
+		if (headerSize < 40 || 14 + static_cast<uint64_t>(headerSize) > size || width <= 0 || height == 0)
+		{
+			return false;
+		}
+		header.Width = static_cast<uint32_t>(width);
+		header.BottomUp = height > 0;
+		header.Height = static_cast<uint32_t>(height > 0 ? height : -height);
+
+		uint32_t bitsPerPixel = header.BitsPerPixel;
+		bool paletted = bitsPerPixel == 1 || bitsPerPixel == 4 || bitsPerPixel == 8;
+		if (header.Compression == BmpCompressionRgb)
+		{
+			if (!paletted && bitsPerPixel != 16 && bitsPerPixel != 24 && bitsPerPixel != 32)
+			{
+				return false;
+			}
+			// 16-bit images are 5.5.5 and the fourth byte of 32-bit ones may or may not be alpha
+			header.Masks[0] = bitsPerPixel == 16 ? 0x7C00 : 0xFF0000;
+			header.Masks[1] = bitsPerPixel == 16 ? 0x03E0 : 0xFF00;
+			header.Masks[2] = bitsPerPixel == 16 ? 0x001F : 0xFF;
+			header.Masks[3] = bitsPerPixel == 32 ? 0xFF000000 : 0;
+		}
+		else if (header.Compression == BmpCompressionBitFields || header.Compression == BmpCompressionAlphaBitFields)
+		{
+			// The masks are in the header from version 2 on and follow it otherwise
+			bool alphaMask = headerSize >= 56 || header.Compression == BmpCompressionAlphaBitFields;
+			if ((bitsPerPixel != 16 && bitsPerPixel != 32) || (alphaMask ? 70u : 66u) > size)
+			{
+				return false;
+			}
+			for (int channel = 0; channel < 4; channel++)
+			{
+				header.Masks[channel] = channel < 3 || alphaMask ? ReadUInt32(data + 54 + channel * 4) : 0;
+			}
+		}
+		else
+		{
+			return false;
+		}
+
+		header.RowPitch = ((static_cast<size_t>(header.Width) * bitsPerPixel + 31) / 32) * 4;
+		if (header.PixelOffset + static_cast<uint64_t>(header.RowPitch) * header.Height > size)
+		{
+			return false;
+		}
+		header.Palette = nullptr;
+		header.PaletteSize = 0;
+		if (paletted)
+		{
+			uint32_t maximumSize = 1u << bitsPerPixel;
+			header.PaletteSize = paletteSize == 0 || paletteSize > maximumSize ? maximumSize : paletteSize;
+			header.Palette = data + 14 + headerSize;
+			if (14 + static_cast<uint64_t>(headerSize) + header.PaletteSize * 4 > size)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool DecodeBmp(const uint8_t* data, size_t size, uint8_t* pixels, size_t rowPitch, bool bgra)
+	{
+		BmpHeader header;
+		if (!ReadBmpHeader(data, size, header))
+		{
+			return false;
+		}
+		unique_ptr<RowSource> source(new RowSource());
+		source->Data = data + header.PixelOffset + (header.BottomUp ? header.RowPitch * (header.Height - 1) : 0);
+		source->Pitch = header.BottomUp ? -static_cast<ptrdiff_t>(header.RowPitch) : static_cast<ptrdiff_t>(header.RowPitch);
+		source->Swap = !bgra;
+		bool zeroAlphaIsOpaque = false;
+		const uint32_t* masks = header.Masks;
+		if (header.Palette)
+		{
+			// Indices past the end of the palette use its first entry
+			source->Layout = SourceLayout::Indexed;
+			source->BitsPerIndex = header.BitsPerPixel;
+			for (uint32_t index = 0; index < 256; index++)
+			{
+				const uint8_t* entry = header.Palette + (index < header.PaletteSize ? index : 0) * 4;
+				source->Palette[index] = MakePixel(entry[2], entry[1], entry[0], 255, bgra);
+			}
+		}
+		else if (header.BitsPerPixel == 24)
+		{
+			source->Layout = SourceLayout::Bgr8;
+		}
+		else if (header.BitsPerPixel == 32 && masks[0] == 0xFF0000 && masks[1] == 0xFF00 && masks[2] == 0xFF && (masks[3] == 0 || masks[3] == 0xFF000000))
+		{
+			source->Layout = masks[3] == 0 ? SourceLayout::Bgrx8 : SourceLayout::Bgra8;
+			zeroAlphaIsOpaque = masks[3] != 0;
+		}
+		else
+		{
+			SetMasks(*source, header.BitsPerPixel / 8, masks[0], masks[1], masks[2], masks[3]);
+			zeroAlphaIsOpaque = masks[3] != 0;
+		}
+		ConvertRows(*source, header.Width, header.Height, pixels, rowPitch, bgra, zeroAlphaIsOpaque, false);
+		return true;
+	}
+
+	//
+	// TGA
+	//
+
+	struct TgaHeader
+	{
+		uint32_t				Width;
+		uint32_t				Height;
+		uint32_t				ImageType;
+		uint32_t				BitsPerPixel;
+		uint32_t				Descriptor;
+		// The colour map
+		uint32_t				FirstEntry;
+		uint32_t				EntryCount;
+		uint32_t				BitsPerEntry;
+		const uint8_t*			ColourMap;
+		size_t					PixelOffset;
+	};
+
+	bool ReadTgaHeader(const uint8_t* data, size_t size, TgaHeader& header)
+	{
+		if (size < 18)
+		{
+			return false;
+		}
+		uint32_t idLength = data[0];
+		uint32_t colourMapType = data[1];
+		header.ImageType = data[2];
+		header.FirstEntry = ReadUInt16(data + 3);
+		header.EntryCount = ReadUInt16(data + 5);
+		header.BitsPerEntry = data[7];
+		header.Width = ReadUInt16(data + 12);
+		header.Height = ReadUInt16(data + 14);
+		header.BitsPerPixel = data[16];
+		header.Descriptor = data[17];
+		uint32_t baseType = header.ImageType & ~TgaRle;
+		uint32_t bits = header.BitsPerPixel;
+		bool trueColourBits = bits == 15 || bits == 16 || bits == 24 || bits == 32;
+		bool valid = colourMapType <= 1 && (header.ImageType & ~(TgaRle | 3)) == 0 && baseType != 0 && header.Width > 0 && header.Height > 0 &&
+					 (header.Descriptor & 0xC0) == 0;
+		if (baseType == TgaColourMapped)
+		{
+			uint32_t entryBits = header.BitsPerEntry;
+			valid = valid && colourMapType == 1 && bits == 8 && (entryBits == 15 || entryBits == 16 || entryBits == 24 || entryBits == 32);
+		}
+		else
+		{
+			valid = valid && (baseType == TgaTrueColour ? trueColourBits : (bits == 8 || bits == 16));
+		}
+		if (!valid)
+		{
+			return false;
+		}
+		header.ColourMap = data + 18 + idLength;
+		header.PixelOffset = 18 + idLength + (colourMapType == 1 ? header.EntryCount * static_cast<size_t>((header.BitsPerEntry + 7) / 8) : 0);
+		if (header.PixelOffset > size)
+		{
+			return false;
+		}
+		// Compressed images are checked as they are expanded
+		if (!(header.ImageType & TgaRle) &&
+			header.PixelOffset + static_cast<uint64_t>(header.Width) * header.Height * ((header.BitsPerPixel + 7) / 8) > size)
+		{
+			return false;
+		}
+		return true;
+	}
+
+	// Expand the runs of an RLE compressed image into pixels the size they are in the file
+	bool ExpandTgaRuns(const uint8_t* data, size_t size, size_t bytesPerPixel, uint8_t* pixels, size_t pixelCount)
+	{
+		const uint8_t* end = data + size;
+		size_t remaining = pixelCount;
+		while (remaining > 0)
+		{
+			if (data >= end)
+			{
+				return false;
+			}
+			uint32_t packet = *data++;
+			size_t count = (min)(static_cast<size_t>((packet & 0x7F) + 1), remaining);
+			if (packet & 0x80)
+			{
+				if (static_cast<size_t>(end - data) < bytesPerPixel)
+				{
+					return false;
+				}
+				for (size_t i = 0; i < count; i++, pixels += bytesPerPixel)
+				{
+					memcpy(pixels, data, bytesPerPixel);
+				}
+				data += bytesPerPixel;
+			}
+			else
+			{
+				size_t bytes = count * bytesPerPixel;
+				if (static_cast<size_t>(end - data) < bytes)
+				{
+					return false;
+				}
+				memcpy(pixels, data, bytes);
+				pixels += bytes;
+				data += bytes;
+			}
+			remaining -= count;
+		}
+		return true;
+	}
+
+	uint32_t ReadTgaColour(const uint8_t* entry, uint32_t bits, bool useAlphaBit, bool bgra)
+	{
+		if (bits == 15 || bits == 16)
+		{
+			uint32_t value = ReadUInt16(entry);
+			uint32_t red = (value >> 10) & 0x1F;
+			uint32_t green = (value >> 5) & 0x1F;
+			uint32_t blue = value & 0x1F;
+			return MakePixel((red * 255 + 15) / 31, (green * 255 + 15) / 31, (blue * 255 + 15) / 31, !useAlphaBit || (value & 0x8000) ? 255 : 0, bgra);
+		}
+		return MakePixel(entry[2], entry[1], entry[0], bits == 32 ? entry[3] : 255, bgra);
+	}
+
+	bool DecodeTga(const uint8_t* data, size_t size, uint8_t* pixels, size_t rowPitch, bool bgra)
+	{
+		TgaHeader header;
+		if (!ReadTgaHeader(data, size, header))
+		{
+			return false;
+		}
+		size_t bytesPerPixel = (header.BitsPerPixel + 7) / 8;
+		size_t sourcePitch = header.Width * bytesPerPixel;
+		const uint8_t* image = data + header.PixelOffset;
+		unique_ptr<uint8_t[]> expanded;
+		if (header.ImageType & TgaRle)
+		{
+			expanded.reset(new (nothrow) uint8_t[sourcePitch * header.Height]);
+			if (!expanded || !ExpandTgaRuns(image, size - header.PixelOffset, bytesPerPixel, expanded.get(), static_cast<size_t>(header.Width) * header.Height))
+			{
+				return false;
+			}
+			image = expanded.get();
+		}
+
+		unique_ptr<RowSource> source(new RowSource());
+		bool topToBottom = (header.Descriptor & TgaTopToBottom) != 0;
+		source->Data = image + (topToBottom ? 0 : sourcePitch * (header.Height - 1));
+		source->Pitch = topToBottom ? static_cast<ptrdiff_t>(sourcePitch) : -static_cast<ptrdiff_t>(sourcePitch);
+		source->Swap = !bgra;
+		// The number of alpha bits in the descriptor says whether the top bit of a 16-bit pixel is alpha
+		bool useAlphaBit = (header.Descriptor & 0xF) == 1;
+		bool zeroAlphaIsOpaque = false;
+		switch (header.ImageType & ~TgaRle)
+		{
+			case TgaColourMapped:
+			{
+				source->Layout = SourceLayout::Indexed;
+				source->BitsPerIndex = 8;
+				size_t bytesPerEntry = (header.BitsPerEntry + 7) / 8;
+				for (uint32_t index = 0; index < 256; index++)
+				{
+					source->Palette[index] = MakePixel(0, 0, 0, 255, bgra);
+					if (index >= header.FirstEntry && index - header.FirstEntry < header.EntryCount)
+					{
+						source->Palette[index] = ReadTgaColour(header.ColourMap + (index - header.FirstEntry) * bytesPerEntry, header.BitsPerEntry,
+															   useAlphaBit, bgra);
+					}
+				}
+				break;
+			}
+
+			case TgaTrueColour:
+				if (header.BitsPerPixel == 24)
+				{
+					source->Layout = SourceLayout::Bgr8;
+				}
+				else if (header.BitsPerPixel == 32)
+				{
+					source->Layout = SourceLayout::Bgra8;
+					zeroAlphaIsOpaque = true;
+				}
+				else
+				{
+					SetMasks(*source, 2, 0x7C00, 0x03E0, 0x001F, useAlphaBit ? 0x8000 : 0);
+				}
+				break;
+
+			default:
+				source->Layout = header.BitsPerPixel == 8 ? SourceLayout::Grey8 : SourceLayout::GreyAlpha8;
+				break;
+		}
+		ConvertRows(*source, header.Width, header.Height, pixels, rowPitch, bgra, zeroAlphaIsOpaque, (header.Descriptor & TgaRightToLeft) != 0);
+		return true;
+	}
+
+	//
+	// Inflate (RFC 1950 and 1951), for PNG
+	//
+
+	const uint16_t InflateLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const uint8_t InflateLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const uint16_t InflateDistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+											   6145, 8193, 12289, 16385, 24577 };
+	const uint8_t InflateDistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	const uint8_t InflateCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	// Deflate streams are read from the lowest bit of each byte up
+	struct BitReader
+	{
+		const uint8_t*			Data;
+		size_t					Size;
+		size_t					Position;
+		uint64_t				Bits;
+		uint32_t				BitCount;
+
+		// Past the end of the data the stream reads as zeros.  Overrun says whether any of those were used.
+		inline void Refill()
+		{
+			while (BitCount <= 56)
+			{
+				uint64_t byte = Position < Size ? Data[Position] : 0;
+				Position++;
+				Bits |= byte << BitCount;
+				BitCount += 8;
+			}
+		}
+
+		inline uint32_t Read(uint32_t count)
+		{
+			if (BitCount < count)
+			{
+				Refill();
+			}
+			uint32_t value = static_cast<uint32_t>(Bits & ((1ull << count) - 1));
+			Bits >>= count;
+			BitCount -= count;
+			return value;
+		}
+
+		inline bool Overrun() const
+		{
+			return Position - BitCount / 8 > Size;
+		}
+	};
+
+	// A canonical Huffman code.  Codes no longer than InflateFastBits are found with one lookup in Fast; the
+	// longer ones are found by comparing the code (with its bits reversed) against the largest code of each
+	// length.
+	struct Huffman
+	{
+		// The length in the top bits and the symbol in the bottom 9, or 0 if the code is longer
+		uint16_t				Fast[1 << InflateFastBits];
+		uint32_t				FirstCode[16];
+		uint32_t				FirstSymbol[16];
+		// One past the largest code of each length, shifted up to 16 bits
+		uint32_t				MaximumCode[17];
+		uint32_t				CodeCount;
+		uint16_t				Symbols[288];
+	};
+
+	inline uint32_t ReverseBits(uint32_t value, uint32_t count)
+	{
+		uint32_t reversed = 0;
+		for (uint32_t i = 0; i < count; i++, value >>= 1)
+		{
+			reversed = (reversed << 1) | (value & 1);
+		}
+		return reversed;
+	}
+
+	bool BuildHuffman(Huffman& huffman, const uint8_t* lengths, uint32_t symbolCount)
+	{
+		uint32_t lengthCounts[16] = {};
+		for (uint32_t symbol = 0; symbol < symbolCount; symbol++)
+		{
+			lengthCounts[lengths[symbol]]++;
+		}
+		lengthCounts[0] = 0;
+		memset(huffman.Fast, 0, sizeof(huffman.Fast));
+
+		uint32_t nextCode[16];
+		uint32_t code = 0;
+		uint32_t symbolIndex = 0;
+		for (uint32_t length = 1; length < 16; length++)
+		{
+			nextCode[length] = code;
+			huffman.FirstCode[length] = code;
+			huffman.FirstSymbol[length] = symbolIndex;
+			code += lengthCounts[length];
+			if (lengthCounts[length] > 0 && code - 1 >= (1u << length))
+			{
+				return false;
+			}
+			huffman.MaximumCode[length] = code << (16 - length);
+			code <<= 1;
+			symbolIndex += lengthCounts[length];
+		}
+		huffman.MaximumCode[16] = 0x10000;
+		huffman.CodeCount = symbolIndex;
+
+		for (uint32_t symbol = 0; symbol < symbolCount; symbol++)
+		{
+			uint32_t length = lengths[symbol];
+			if (length == 0)
+			{
+				continue;
+			}
+			huffman.Symbols[nextCode[length] - huffman.FirstCode[length] + huffman.FirstSymbol[length]] = static_cast<uint16_t>(symbol);
+			if (length <= InflateFastBits)
+			{
+				uint16_t entry = static_cast<uint16_t>((length << 9) | symbol);
+				for (uint32_t index = ReverseBits(nextCode[length], length); index < (1u << InflateFastBits); index += 1u << length)
+				{
+					huffman.Fast[index] = entry;
+				}
+			}
+			nextCode[length]++;
+		}
+		return true;
+	}
+
+	// Returns -1 if the bits are not a code
+	inline int DecodeSymbol(BitReader& reader, const Huffman& huffman)
+	{
+		if (reader.BitCount < 16)
+		{
+			reader.Refill();
+		}
+		uint16_t entry = huffman.Fast[reader.Bits & ((1 << InflateFastBits) - 1)];
+		uint32_t length;
+		uint32_t symbol;
+		if (entry)
+		{
+			length = entry >> 9;
+			symbol = entry & 0x1FF;
+		}
+		else
+		{
+			uint32_t code = ReverseBits(static_cast<uint32_t>(reader.Bits & 0xFFFF), 16);
+			for (length = InflateFastBits + 1; code >= huffman.MaximumCode[length]; length++)
+			{
+			}
+			uint32_t index = (code >> (16 - length)) - huffman.FirstCode[length] + huffman.FirstSymbol[length];
+			if (length >= 16 || index >= huffman.CodeCount)
+			{
+				return -1;
+			}
+			symbol = huffman.Symbols[index];
+		}
+		reader.Bits >>= length;
+		reader.BitCount -= length;
+		return static_cast<int>(symbol);
+	}
+
+	bool ReadDynamicHuffman(BitReader& reader, Huffman& literals, Huffman& distances)
+	{
+		uint32_t literalCount = reader.Read(5) + 257;
+		uint32_t distanceCount = reader.Read(5) + 1;
+		uint32_t codeLengthCount = reader.Read(4) + 4;
+		if (literalCount > 286 || distanceCount > 30)
+		{
+			return false;
+		}
+		uint8_t codeLengthLengths[19] = {};
+		for (uint32_t i = 0; i < codeLengthCount; i++)
+		{
+			codeLengthLengths[InflateCodeLengthOrder[i]] = static_cast<uint8_t>(reader.Read(3));
+		}
+		Huffman codeLengths;
+		if (!BuildHuffman(codeLengths, codeLengthLengths, 19))
+		{
+			return false;
+		}
+
+		uint8_t lengths[286 + 30];
+		uint32_t count = 0;
+		while (count < literalCount + distanceCount)
+		{
+			int symbol = DecodeSymbol(reader, codeLengths);
+			if (symbol < 0)
+			{
+				return false;
+			}
+			if (symbol < 16)
+			{
+				lengths[count++] = static_cast<uint8_t>(symbol);
+				continue;
+			}
+			uint8_t value = 0;
+			uint32_t repeat;
+			if (symbol == 16)
+			{
+				if (count == 0)
+				{
+					return false;
+				}
+				value = lengths[count - 1];
+				repeat = reader.Read(2) + 3;
+			}
+			else
+			{
+				repeat = symbol == 17 ? reader.Read(3) + 3 : reader.Read(7) + 11;
+			}
+			if (count + repeat > literalCount + distanceCount)
+			{
+				return false;
+			}
+			memset(lengths + count, value, repeat);
+			count += repeat;
+		}
+		return BuildHuffman(literals, lengths, literalCount) && BuildHuffman(distances, lengths + literalCount, distanceCount);
+	}
+
+	// Inflate a zlib stream whose output is known to be exactly outputSize bytes
+	bool Inflate(const uint8_t* data, size_t size, uint8_t* output, size_t outputSize)
+	{
+		// The zlib header: deflate, with no preset dictionary
+		if (size < 2 || (data[0] & 0xF) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20))
+		{
+			return false;
+		}
+		BitReader reader = { data, size, 2, 0, 0 };
+		unique_ptr<Huffman> literals(new Huffman());
+		unique_ptr<Huffman> distances(new Huffman());
+		size_t position = 0;
+		bool finalBlock = false;
+		while (!finalBlock)
+		{
+			finalBlock = reader.Read(1) != 0;
+			uint32_t blockType = reader.Read(2);
+			if (blockType == 0)
+			{
+				// Stored: start again from the byte after the bits already read
+				reader.Position -= reader.BitCount / 8;
+				reader.Bits = 0;
+				reader.BitCount = 0;
+				if (reader.Position + 4 > size)
+				{
+					return false;
+				}
+				uint32_t length = ReadUInt16(data + reader.Position);
+				uint32_t complement = ReadUInt16(data + reader.Position + 2);
+				reader.Position += 4;
+				if ((length ^ 0xFFFF) != complement || reader.Position + length > size || position + length > outputSize)
+				{
+					return false;
+				}
+				memcpy(output + position, data + reader.Position, length);
+				reader.Position += length;
+				position += length;
+				continue;
+			}
+			if (blockType == 1)
+			{
+				uint8_t lengths[288 + 30];
+				memset(lengths, 8, 144);
+				memset(lengths + 144, 9, 112);
+				memset(lengths + 256, 7, 24);
+				memset(lengths + 280, 8, 8);
+				memset(lengths + 288, 5, 30);
+				BuildHuffman(*literals, lengths, 288);
+				BuildHuffman(*distances, lengths + 288, 30);
+			}
+			else if (blockType != 2 || !ReadDynamicHuffman(reader, *literals, *distances))
+			{
+				return false;
+			}
+
+			for (;;)
+			{
+				int symbol = DecodeSymbol(reader, *literals);
+				if (symbol < 256)
+				{
+					if (symbol < 0 || position >= outputSize)
+					{
+						return false;
+					}
+					output[position++] = static_cast<uint8_t>(symbol);
+					continue;
+				}
+				if (symbol == 256)
+				{
+					break;
+				}
+				symbol -= 257;
+				if (symbol >= 29)
+				{
+					return false;
+				}
+				size_t length = InflateLengthBase[symbol] + reader.Read(InflateLengthExtra[symbol]);
+				int distanceSymbol = DecodeSymbol(reader, *distances);
+				if (distanceSymbol < 0 || distanceSymbol >= 30)
+				{
+					return false;
+				}
+				size_t distance = InflateDistanceBase[distanceSymbol] + reader.Read(InflateDistanceExtra[distanceSymbol]);
+				if (distance > position || length > outputSize - position)
+				{
+					return false;
+				}
+				uint8_t* target = output + position;
+				const uint8_t* match = target - distance;
+				if (distance >= length)
+				{
+					memcpy(target, match, length);
+				}
+				else
+				{
+					// The match overlaps what it is copying, so it repeats
+					for (size_t i = 0; i < length; i++)
+					{
+						target[i] = match[i];
+					}
+				}
+				position += length;
+			}
+			if (reader.Overrun())
+			{
+				return false;
+			}
+		}
+		return position == outputSize;
+	}
+
+	//
+	// PNG
+	//
+
+	struct PngHeader
+	{
+		uint32_t				Width;
+		uint32_t				Height;
+		uint32_t				BitDepth;
+		uint32_t				ColourType;
+		bool					Srgb;
+		const uint8_t*			Palette;
+		uint32_t				PaletteSize;
+		const uint8_t*			Transparency;
+		uint32_t				TransparencySize;
+		// The compressed image, which may be split over several chunks
+		vector<pair<const uint8_t*, size_t>>	ImageData;
+	};
+
+	bool ReadPngHeader(const uint8_t* data, size_t size, PngHeader& header)
+	{
+		if (size < 8 + 25 || memcmp(data, PngSignature, 8) != 0 || ReadUInt32BigEndian(data + 8) != 13 || memcmp(data + 12, "IHDR", 4) != 0)
+		{
+			return false;
+		}
+		const uint8_t* imageHeader = data + 16;
+		header.Width = ReadUInt32BigEndian(imageHeader);
+		header.Height = ReadUInt32BigEndian(imageHeader + 4);
+		header.BitDepth = imageHeader[8];
+		header.ColourType = imageHeader[9];
+		uint32_t depth = header.BitDepth;
+		bool validDepth;
+		switch (header.ColourType)
+		{
+			case PngGreyscale:
+				validDepth = depth == 1 || depth == 2 || depth == 4 || depth == 8 || depth == 16;
+				break;
+
+			case PngIndexed:
+				validDepth = depth == 1 || depth == 2 || depth == 4 || depth == 8;
+				break;
+
+			case PngTrueColour:
+			case PngGreyscaleAlpha:
+			case PngTrueColourAlpha:
+				validDepth = depth == 8 || depth == 16;
+				break;
+
+			default:
+				validDepth = false;
+				break;
+		}
+		// Compression, filter method and interlacing
+		if (!validDepth || header.Width == 0 || header.Height == 0 || header.Width > 0x7FFFFFFF || header.Height > 0x7FFFFFFF ||
+			imageHeader[10] != 0 || imageHeader[11] != 0 || imageHeader[12] != 0)
+		{
+			return false;
+		}
+
+		header.Srgb = false;
+		header.Palette = nullptr;
+		header.PaletteSize = 0;
+		header.Transparency = nullptr;
+		header.TransparencySize = 0;
+		header.ImageData.clear();
+		size_t position = 8 + 25;
+		while (position + 12 <= size)
+		{
+			uint32_t length = ReadUInt32BigEndian(data + position);
+			const uint8_t* type = data + position + 4;
+			const uint8_t* contents = data + position + 8;
+			if (length > size - position - 12)
+			{
+				return false;
+			}
+			if (memcmp(type, "IDAT", 4) == 0)
+			{
+				header.ImageData.emplace_back(contents, length);
+			}
+			else if (memcmp(type, "PLTE", 4) == 0)
+			{
+				header.Palette = contents;
+				header.PaletteSize = (min)(length / 3, 256u);
+			}
+			else if (memcmp(type, "tRNS", 4) == 0)
+			{
+				header.Transparency = contents;
+				header.TransparencySize = length;
+			}
+			else if (memcmp(type, "sRGB", 4) == 0)
+			{
+				header.Srgb = true;
+			}
+			else if (memcmp(type, "IEND", 4) == 0)
+			{
+				break;
+			}
+			position += 12 + static_cast<size_t>(length);
+		}
+		return !header.ImageData.empty() && (header.ColourType != PngIndexed || header.Palette != nullptr);
+	}
+
+	inline uint32_t PngSampleCount(uint32_t colourType)
+	{
+		switch (colourType)
+		{
+			case PngTrueColour:
+				return 3;
+
+			case PngGreyscaleAlpha:
+				return 2;
+
+			case PngTrueColourAlpha:
+				return 4;
+
+			default:
+				return 1;
+		}
+	}
+
+	inline uint8_t Paeth(uint8_t left, uint8_t above, uint8_t aboveLeft)
+	{
+		int estimate = left + above - aboveLeft;
+		int leftDistance = abs(estimate - left);
+		int aboveDistance = abs(estimate - above);
+		int aboveLeftDistance = abs(estimate - aboveLeft);
+		if (leftDistance <= aboveDistance && leftDistance <= aboveLeftDistance)
+		{
+			return left;
+		}
+		return aboveDistance <= aboveLeftDistance ? above : aboveLeft;
+	}
+
+	// Undo the filter of each row in place.  Each row starts with its filter type.
+	bool UnfilterPng(uint8_t* rows, size_t stride, uint32_t height, size_t bytesPerPixel)
+	{
+		vector<uint8_t> zeros(stride, 0);
+		const uint8_t* previous = zeros.data();
+		for (uint32_t y = 0; y < height; y++)
+		{
+			uint8_t* row = rows + y * (stride + 1);
+			uint32_t filter = row[0];
+			row++;
+			switch (filter)
+			{
+				case 0:
+					break;
+
+				case 1:
+					for (size_t i = bytesPerPixel; i < stride; i++)
+					{
+						row[i] = static_cast<uint8_t>(row[i] + row[i - bytesPerPixel]);
+					}
+					break;
+
+				case 2:
+					for (size_t i = 0; i < stride; i++)
+					{
+						row[i] = static_cast<uint8_t>(row[i] + previous[i]);
+					}
+					break;
+
+				case 3:
+					for (size_t i = 0; i < stride; i++)
+					{
+						uint32_t left = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+						row[i] = static_cast<uint8_t>(row[i] + ((left + previous[i]) >> 1));
+					}
+					break;
+
+				case 4:
+					for (size_t i = 0; i < stride; i++)
+					{
+						uint8_t left = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+						uint8_t aboveLeft = i >= bytesPerPixel ? previous[i - bytesPerPixel] : 0;
+						row[i] = static_cast<uint8_t>(row[i] + Paeth(left, previous[i], aboveLeft));
+					}
+					break;
+
+				default:
+					return false;
+			}
+			previous = row;
+		}
+		return true;
+	}
+
+	bool DecodePng(const uint8_t* data, size_t size, uint8_t* pixels, size_t rowPitch, bool bgra)
+	{
+		PngHeader header;
+		if (!ReadPngHeader(data, size, header))
+		{
+			return false;
+		}
+		uint32_t sampleCount = PngSampleCount(header.ColourType);
+		size_t bitsPerPixel = sampleCount * header.BitDepth;
+		size_t stride = (header.Width * bitsPerPixel + 7) / 8;
+		size_t rawSize = (stride + 1) * header.Height;
+		unique_ptr<uint8_t[]> raw(new (nothrow) uint8_t[rawSize]);
+		if (!raw)
+		{
+			return false;
+		}
+
+		// The compressed data is used in place unless it is split over several chunks
+		const uint8_t* compressed = header.ImageData[0].first;
+		size_t compressedSize = header.ImageData[0].second;
+		vector<uint8_t> joined;
+		if (header.ImageData.size() > 1)
+		{
+			for (const pair<const uint8_t*, size_t>& chunk : header.ImageData)
+			{
+				joined.insert(joined.end(), chunk.first, chunk.first + chunk.second);
+			}
+			compressed = joined.data();
+			compressedSize = joined.size();
+		}
+		if (!Inflate(compressed, compressedSize, raw.get(), rawSize) || !UnfilterPng(raw.get(), stride, header.Height, (max)(bitsPerPixel / 8, static_cast<size_t>(1))))
+		{
+			return false;
+		}
+
+		unique_ptr<RowSource> source(new RowSource());
+		source->Data = raw.get() + 1;
+		source->Pitch = static_cast<ptrdiff_t>(stride + 1);
+		source->Swap = bgra;
+		const uint8_t* transparency = header.Transparency;
+		if (header.ColourType == PngIndexed)
+		{
+			source->Layout = SourceLayout::Indexed;
+			source->BitsPerIndex = header.BitDepth;
+			for (uint32_t index = 0; index < 256; index++)
+			{
+				const uint8_t* entry = header.Palette + (index < header.PaletteSize ? index : 0) * 3;
+				uint32_t alpha = transparency && index < header.TransparencySize ? transparency[index] : 255;
+				source->Palette[index] = MakePixel(entry[0], entry[1], entry[2], alpha, bgra);
+			}
+		}
+		else if (header.ColourType == PngGreyscale && header.BitDepth <= 8 && (header.BitDepth < 8 || transparency))
+		{
+			// Small greyscale images (and ones with a transparent grey) are looked up like a palette
+			source->Layout = SourceLayout::Indexed;
+			source->BitsPerIndex = header.BitDepth;
+			uint32_t maximum = (1u << header.BitDepth) - 1;
+			uint32_t key = transparency && header.TransparencySize >= 2 ? (transparency[0] << 8) | transparency[1] : 0x10000;
+			for (uint32_t index = 0; index < 256; index++)
+			{
+				uint32_t grey = (min)(index, maximum) * 255 / maximum;
+				source->Palette[index] = MakePixel(grey, grey, grey, index == key ? 0 : 255, bgra);
+			}
+		}
+		else if (header.BitDepth == 8 && !transparency && header.ColourType != PngGreyscale)
+		{
+			switch (header.ColourType)
+			{
+				case PngTrueColour:
+					source->Layout = SourceLayout::Rgb8;
+					break;
+
+				case PngGreyscaleAlpha:
+					source->Layout = SourceLayout::GreyAlpha8;
+					break;
+
+				default:
+					source->Layout = SourceLayout::Rgba8;
+					break;
+			}
+		}
+		else if (header.BitDepth == 8 && !transparency)
+		{
+			source->Layout = SourceLayout::Grey8;
+		}
+		else
+		{
+			source->Layout = SourceLayout::Samples;
+			source->SampleCount = sampleCount;
+			source->BytesPerSample = header.BitDepth / 8;
+			source->HasKey = transparency && header.TransparencySize >= (header.ColourType == PngTrueColour ? 6u : 2u) && sampleCount != 2 && sampleCount != 4;
+			for (uint32_t sample = 0; sample < 3; sample++)
+			{
+				source->Key[sample] = source->HasKey && (sample == 0 || sampleCount == 3) ? static_cast<uint16_t>((transparency[sample * 2] << 8) | transparency[sample * 2 + 1]) : 0;
+			}
+		}
+		ConvertRows(*source, header.Width, header.Height, pixels, rowPitch, bgra, false, false);
+		return true;
+	}
+}
+
+ImageFileFormat GetImageFileFormat(const uint8_t* data, size_t size)
+{
+	if (size >= 8 && memcmp(data, PngSignature, 8) == 0)
+	{
+		return ImageFileFormat::Png;
+	}
+	if (size >= 2 && data[0] == 'B' && data[1] == 'M')
+	{
+		return ImageFileFormat::Bmp;
+	}
+	TgaHeader header;
+	if (ReadTgaHeader(data, size, header))
+	{
+		return ImageFileFormat::Tga;
+	}
+	return ImageFileFormat::Unknown;
+}
+
+bool ReadImageInfo(const uint8_t* data, size_t size, ImageInfo& info)
+{
+	info.Format = GetImageFileFormat(data, size);
+	info.Srgb = false;
+	switch (info.Format)
+	{
+		case ImageFileFormat::Bmp:
+		{
+			BmpHeader header;
+			if (!ReadBmpHeader(data, size, header))
+			{
+				return false;
+			}
+			info.Width = header.Width;
+			info.Height = header.Height;
+			info.HasAlpha = header.Masks[3] != 0 && header.Palette == nullptr;
+			return true;
+		}
+
+		case ImageFileFormat::Tga:
+		{
+			TgaHeader header;
+			ReadTgaHeader(data, size, header);
+			info.Width = header.Width;
+			info.Height = header.Height;
+			uint32_t bits = (header.ImageType & ~TgaRle) == TgaColourMapped ? header.BitsPerEntry : header.BitsPerPixel;
+			info.HasAlpha = bits == 32 || ((bits == 16) && ((header.ImageType & ~TgaRle) == TgaGreyscale || (header.Descriptor & 0xF) == 1));
+			return true;
+		}
+
+		case ImageFileFormat::Png:
+		{
+			PngHeader header;
+			if (!ReadPngHeader(data, size, header))
+			{
+				return false;
+			}
+			info.Width = header.Width;
+			info.Height = header.Height;
+			info.HasAlpha = header.ColourType == PngGreyscaleAlpha || header.ColourType == PngTrueColourAlpha || header.Transparency != nullptr;
+			info.Srgb = header.Srgb;
+			return true;
+		}
+
+		default:
+			return false;
+	}
+}
+
+bool DecodeImage(const uint8_t* data, size_t size, uint8_t* pixels, size_t rowPitch, bool bgra)
+{
+	switch (GetImageFileFormat(data, size))
+	{
+		case ImageFileFormat::Bmp:
+			return DecodeBmp(data, size, pixels, rowPitch, bgra);
+
+		case ImageFileFormat::Tga:
+			return DecodeTga(data, size, pixels, rowPitch, bgra);
+
+		case ImageFileFormat::Png:
+			return DecodePng(data, size, pixels, rowPitch, bgra);
+
+		default:
+			return false;
+	}
+}
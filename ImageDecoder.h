@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Decoding of the image files we ship (BMP, TGA and PNG) into 8-bit RGBA, without WIC.
+//
+// The pixels are written straight into memory the caller provides (any row pitch), so an image can be
+// decoded into the buffer it is uploaded or processed from without another copy.  Converting the rows to
+// RGBA (swizzling BGR to RGB and adding alpha) is done with SIMD (SSE2) and the rows are spread across
+// threads.  The parts that can only be done in order, inflating and unfiltering a PNG and expanding the runs
+// of an RLE compressed TGA, are done first on the calling thread.
+//
+//		BMP		1, 4 and 8-bit with a palette, 16-bit and 32-bit with bit masks, 24-bit and 32-bit.  32-bit
+//				images whose alpha is 0 everywhere are taken to be opaque.  RLE compressed files are not read.
+//		TGA		Uncompressed and RLE compressed, with a colour map (8-bit indices), true colour (15, 16, 24
+//				and 32-bit) and greyscale (8-bit, or 16-bit with alpha).
+//		PNG		Every colour type and bit depth, including palettes and tRNS transparency.  16-bit channels
+//				are reduced to 8 bits.  Interlaced files are not read.  Chunk CRCs are not checked.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+// Roughly how many pixels each thread converts at a time.  Converting is quick, so small images are done
+// on the calling thread.
+#define ImageDecodePixelsPerTask	65536
+
+enum class ImageFileFormat
+{
+	Unknown,
+	Bmp,
+	Tga,
+	Png
+};
+
+struct ImageInfo
+{
+	ImageFileFormat			Format;
+	uint32_t				Width;
+	uint32_t				Height;
+	// False if the file format says that every pixel is opaque
+	bool					HasAlpha;
+	// The file says that its colours are sRGB encoded (a PNG with an sRGB chunk)
+	bool					Srgb;
+};
+
+// Works out the format from the start of the file.  TGA files have no signature, so their header is checked
+// instead.
+ImageFileFormat				GetImageFileFormat(const uint8_t* data, std::size_t size);
+
+// Read the size of the image without decoding it.  Returns false if the file is not an image that
+// DecodeImage can read.
+bool						ReadImageInfo(const uint8_t* data, std::size_t size, ImageInfo& info);
+
+// Decode the image into width * 4 bytes of 8-bit RGBA (BGRA if bgra is true) in each row of pixels, the rows
+// rowPitch bytes apart from the top down.  Returns false if the file is damaged or cannot be read, in which
+// case the contents of pixels are undefined.
+bool						DecodeImage(const uint8_t* data, std::size_t size, uint8_t* pixels, std::size_t rowPitch, bool bgra = false);
@@ -0,0 +1,616 @@
+#include "ImageResampler.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_RESAMPLER_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+	// A pixel held as four floats
+#ifdef IMAGE_RESAMPLER_SSE2
+	typedef __m128 Float4;
+
+	inline Float4 LoadFloat4(const float* values) { return _mm_loadu_ps(values); }
+	inline void StoreFloat4(float* values, Float4 value) { _mm_storeu_ps(values, value); }
+	inline Float4 ZeroFloat4() { return _mm_setzero_ps(); }
+	inline Float4 MultiplyAddFloat4(Float4 sum, Float4 value, float weight) { return _mm_add_ps(sum, _mm_mul_ps(value, _mm_set1_ps(weight))); }
+	inline Float4 SetFloat4(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+	inline Float4 ClampFloat4(Float4 value) { return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f)); }
+
+	// (alpha, alpha, alpha, 1), to scale the colour channels of a pixel by its alpha and leave alpha as it is
+	inline Float4 GetAlphaFactor(Float4 value)
+	{
+		Float4 factor = _mm_move_ss(_mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3)), _mm_set_ss(1.0f));
+		return _mm_shuffle_ps(factor, factor, _MM_SHUFFLE(0, 1, 1, 1));
+	}
+
+	inline Float4 PremultiplyFloat4(Float4 value) { return _mm_mul_ps(value, GetAlphaFactor(value)); }
+
+	inline Float4 UnpremultiplyFloat4(Float4 value)
+	{
+		// Colour with no alpha left is black
+		Float4 factor = GetAlphaFactor(value);
+		Float4 visible = _mm_cmpgt_ps(factor, _mm_setzero_ps());
+		return _mm_and_ps(_mm_div_ps(value, _mm_or_ps(factor, _mm_andnot_ps(visible, _mm_set1_ps(1.0f)))), visible);
+	}
+#else
+	struct Float4
+	{
+		float Values[4];
+	};
+
+	inline Float4 LoadFloat4(const float* values) { Float4 value; memcpy(value.Values, values, sizeof(value.Values)); return value; }
+	inline void StoreFloat4(float* values, Float4 value) { memcpy(values, value.Values, sizeof(value.Values)); }
+	inline Float4 ZeroFloat4() { return Float4{ { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+	inline Float4 MultiplyAddFloat4(Float4 sum, Float4 value, float weight)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			sum.Values[i] += value.Values[i] * weight;
+		}
+		return sum;
+	}
+	inline Float4 SetFloat4(float x, float y, float z, float w) { return Float4{ { x, y, z, w } }; }
+	inline Float4 ClampFloat4(Float4 value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			value.Values[i] = value.Values[i] > 0.0f ? (value.Values[i] < 1.0f ? value.Values[i] : 1.0f) : 0.0f;
+		}
+		return value;
+	}
+
+	inline Float4 PremultiplyFloat4(Float4 value)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			value.Values[i] *= value.Values[3];
+		}
+		return value;
+	}
+
+	inline Float4 UnpremultiplyFloat4(Float4 value)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			value.Values[i] = value.Values[3] > 0.0f ? value.Values[i] / value.Values[3] : 0.0f;
+		}
+		return value;
+	}
+#endif
+
+	const float Pi = 3.14159265358979f;
+
+	// Linear light is split into this many equal steps for encoding to sRGB.  The closest any two thresholds
+	// get is 1 / (255 * 12.92) near black, which is more than a step, so a step never holds two of them.
+	const int SrgbEncodeSteps = 4096;
+
+	// Conversions between sRGB encoded 8-bit values and linear floats
+	struct SrgbTables
+	{
+		float	ToLinear[256];
+		float	ToFloat[256];
+		// Linear value half way between each pair of neighbouring 8-bit sRGB values (the last is past 1, so
+		// nothing reaches it)
+		float	Thresholds[256];
+		// The sRGB value at the start of each step of linear light (and at 1).  A value inside the step is
+		// either that or, if it has passed the next threshold, one more.
+		uint8_t	StepStart[SrgbEncodeSteps + 1];
+
+		SrgbTables()
+		{
+			for (int i = 0; i < 256; i++)
+			{
+				ToLinear[i] = SrgbToLinear(i / 255.0f);
+				ToFloat[i] = i / 255.0f;
+			}
+			for (int i = 0; i < 255; i++)
+			{
+				Thresholds[i] = SrgbToLinear((i + 0.5f) / 255.0f);
+			}
+			Thresholds[255] = 2.0f;
+			int code = 0;
+			for (int step = 0; step <= SrgbEncodeSteps; step++)
+			{
+				float start = static_cast<float>(step) / SrgbEncodeSteps;
+				while (start >= Thresholds[code])
+				{
+					code++;
+				}
+				StepStart[step] = static_cast<uint8_t>(code);
+			}
+		}
+
+		// Encode a linear value between 0 and 1.  This gives the same value as searching the thresholds.
+		inline uint8_t ToSrgb(float value) const
+		{
+			int code = StepStart[static_cast<int>(value * SrgbEncodeSteps)];
+			return static_cast<uint8_t>(code + (value >= Thresholds[code] ? 1 : 0));
+		}
+
+		static float SrgbToLinear(float value)
+		{
+			return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+		}
+	};
+
+	const SrgbTables& GetSrgbTables()
+	{
+		static const SrgbTables tables;
+		return tables;
+	}
+
+	float HalfToFloat(uint16_t half)
+	{
+		uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+		uint32_t exponent = (half >> 10) & 0x1F;
+		uint32_t mantissa = half & 0x3FF;
+		uint32_t bits;
+		if (exponent == 0)
+		{
+			// Zero or a denormal
+			float value = mantissa * (1.0f / 16777216.0f);
+			return sign ? -value : value;
+		}
+		else if (exponent == 31)
+		{
+			// Infinity or NaN
+			bits = sign | 0x7F800000 | (mantissa << 13);
+		}
+		else
+		{
+			bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+		}
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	uint16_t FloatToHalf(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+		uint32_t magnitude = bits & 0x7FFFFFFF;
+		if (magnitude > 0x7F800000)
+		{
+			return sign | 0x7E00;
+		}
+		if (magnitude >= 0x477FF000)
+		{
+			// Too big, so infinity
+			return sign | 0x7C00;
+		}
+		if (magnitude < 0x38800000)
+		{
+			// Too small for a normal half, so a denormal (or zero)
+			float absolute;
+			memcpy(&absolute, &magnitude, sizeof(absolute));
+			return sign | static_cast<uint16_t>(absolute * 16777216.0f + 0.5f);
+		}
+		// Round to nearest even and rebias the exponent
+		uint32_t rounded = magnitude + 0xFFF + ((magnitude >> 13) & 1);
+		return sign | static_cast<uint16_t>((rounded - 0x38000000) >> 13);
+	}
+
+	// Modified Bessel function of the first kind, order 0 (used by the Kaiser window)
+	float BesselI0(float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+		float halfX = x * 0.5f;
+		for (int k = 1; k < 32 && term > sum * 1.0e-8f; k++)
+		{
+			term *= (halfX / k) * (halfX / k);
+			sum += term;
+		}
+		return sum;
+	}
+
+
+	float KaiserFilter(float t)
+	{
+		if (fabsf(t) >= ResampleKaiserWidth)
+		{
+			return 0.0f;
+		}
+		float ratio = t / ResampleKaiserWidth;
+		float window = BesselI0(ResampleKaiserAlpha * sqrtf(1.0f - ratio * ratio)) / BesselI0(ResampleKaiserAlpha);
+		float sinc = t == 0.0f ? 1.0f : sinf(Pi * t) / (Pi * t);
+		return sinc * window;
+	}
+
+	float MitchellFilter(float t)
+	{
+		const float B = 1.0f / 3.0f;
+		const float C = 1.0f / 3.0f;
+		t = fabsf(t);
+		if (t < 1.0f)
+		{
+			return ((12.0f - 9.0f * B - 6.0f * C) * t * t * t + (-18.0f + 12.0f * B + 6.0f * C) * t * t + (6.0f - 2.0f * B)) / 6.0f;
+		}
+		if (t < 2.0f)
+		{
+			return ((-B - 6.0f * C) * t * t * t + (6.0f * B + 30.0f * C) * t * t + (-12.0f * B - 48.0f * C) * t + (8.0f * B + 24.0f * C)) / 6.0f;
+		}
+		return 0.0f;
+	}
+
+	float LanczosFilter(float t)
+	{
+		if (t == 0.0f)
+		{
+			return 1.0f;
+		}
+		if (fabsf(t) >= 3.0f)
+		{
+			return 0.0f;
+		}
+		return 3.0f * sinf(Pi * t) * sinf(Pi * t / 3.0f) / (Pi * Pi * t * t);
+	}
+
+	// Half the width of each filter, in pixels of the smaller image
+	float GetFilterRadius(ResampleFilter filter)
+	{
+		switch (filter)
+		{
+		case ResampleFilter::Box:
+			return 0.5f;
+		case ResampleFilter::Triangle:
+			return 1.0f;
+		case ResampleFilter::Mitchell:
+			return 2.0f;
+		case ResampleFilter::Lanczos3:
+			return 3.0f;
+		default:
+			return ResampleKaiserWidth;
+		}
+	}
+
+	// t is in pixels of the smaller image
+	float EvaluateFilter(ResampleFilter filter, float t)
+	{
+		switch (filter)
+		{
+		case ResampleFilter::Triangle:
+			return (max)(1.0f - fabsf(t), 0.0f);
+		case ResampleFilter::Mitchell:
+			return MitchellFilter(t);
+		case ResampleFilter::Lanczos3:
+			return LanczosFilter(t);
+		default:
+			return KaiserFilter(t);
+		}
+	}
+
+	// The filter kernel for each pixel of a row (or column) of the new image.  Pixel i is the sum of
+	// Weights[i * Stride + j] * source[First[i] + j] for j < Count[i].
+	struct FilterWeights
+	{
+		vector<uint32_t>	First;
+		vector<uint32_t>	Count;
+		vector<float>		Weights;
+		uint32_t			Stride;
+	};
+
+	FilterWeights ComputeFilterWeights(uint32_t sourceSize, uint32_t destinationSize, ResampleFilter filter)
+	{
+		float scale = static_cast<float>(sourceSize) / destinationSize;
+		// When enlarging, the filter stays the width it is in source pixels
+		float filterScale = (max)(scale, 1.0f);
+		float radius = GetFilterRadius(filter) * filterScale;
+		FilterWeights weights;
+		weights.Stride = static_cast<uint32_t>(ceilf(radius * 2.0f)) + 2;
+		weights.First.resize(destinationSize);
+		weights.Count.resize(destinationSize);
+		weights.Weights.assign(static_cast<size_t>(destinationSize) * weights.Stride, 0.0f);
+		if (sourceSize == destinationSize)
+		{
+			// Leave the pixels as they are (the wider filters would blur them a little)
+			for (uint32_t i = 0; i < destinationSize; i++)
+			{
+				weights.First[i] = i;
+				weights.Count[i] = 1;
+				weights.Weights[static_cast<size_t>(i) * weights.Stride] = 1.0f;
+			}
+			return weights;
+		}
+		for (uint32_t i = 0; i < destinationSize; i++)
+		{
+			// Centre of the new pixel in the coordinates of the source row
+			float centre = (i + 0.5f) * scale;
+			int first = static_cast<int>(floorf(centre - radius));
+			int last = static_cast<int>(ceilf(centre + radius));
+			// Pixels off the edge are clamped, so their weight goes to the edge pixel
+			int firstClamped = (min)((max)(first, 0), static_cast<int>(sourceSize) - 1);
+			int lastClamped = (max)((min)(last, static_cast<int>(sourceSize)) - 1, firstClamped);
+			float* pixelWeights = &weights.Weights[static_cast<size_t>(i) * weights.Stride];
+			float total = 0.0f;
+			for (int x = first; x < last; x++)
+			{
+				float weight;
+				if (filter == ResampleFilter::Box)
+				{
+					// How much of the source pixel the new pixel covers
+					weight = (max)((min)(x + 1.0f, centre + radius) - (max)(static_cast<float>(x), centre - radius), 0.0f);
+				}
+				else
+				{
+					weight = EvaluateFilter(filter, (x + 0.5f - centre) / filterScale);
+				}
+				int clamped = (min)((max)(x, firstClamped), lastClamped);
+				pixelWeights[clamped - firstClamped] += weight;
+				total += weight;
+			}
+			if (total != 0.0f)
+			{
+				for (int j = 0; j <= lastClamped - firstClamped; j++)
+				{
+					pixelWeights[j] /= total;
+				}
+			}
+			else
+			{
+				pixelWeights[0] = 1.0f;
+			}
+			weights.First[i] = static_cast<uint32_t>(firstClamped);
+			weights.Count[i] = static_cast<uint32_t>(lastClamped - firstClamped + 1);
+		}
+		return weights;
+	}
+
+	void FilterRow(const float* source, const FilterWeights& columnWeights, uint32_t destinationWidth, float* destination)
+	{
+		for (uint32_t x = 0; x < destinationWidth; x++)
+		{
+			const float* weights = &columnWeights.Weights[static_cast<size_t>(x) * columnWeights.Stride];
+			const float* sourcePixel = source + static_cast<size_t>(columnWeights.First[x]) * 4;
+			Float4 sum = ZeroFloat4();
+			for (uint32_t j = 0; j < columnWeights.Count[x]; j++)
+			{
+				sum = MultiplyAddFloat4(sum, LoadFloat4(sourcePixel + j * 4), weights[j]);
+			}
+			StoreFloat4(destination + x * 4, sum);
+		}
+	}
+
+	// Make the new image in bands of rows.  readRow(y, scratch) returns row y of the source as linear floats,
+	// using scratch (room for a source row) if it has to convert it.  writeRow(y, row) is given each row of the
+	// new image as linear floats.
+	template<typename TReadRow, typename TWriteRow>
+	void ResampleBands(uint32_t sourceWidth, uint32_t sourceHeight, uint32_t destinationWidth, uint32_t destinationHeight,
+					   ResampleFilter filter, const TReadRow& readRow, const TWriteRow& writeRow)
+	{
+		FilterWeights columnWeights = ComputeFilterWeights(sourceWidth, destinationWidth, filter);
+		FilterWeights rowWeights = ComputeFilterWeights(sourceHeight, destinationHeight, filter);
+		size_t bandRows = (max)(static_cast<size_t>(ResampleMinimumBandRows), static_cast<size_t>(ResamplePixelsPerTask / destinationWidth));
+		ParallelFor(destinationHeight, bandRows, [&](size_t begin, size_t end)
+		{
+			// The source rows this band needs
+			uint32_t firstSourceRow = rowWeights.First[begin];
+			uint32_t endSourceRow = firstSourceRow;
+			for (size_t y = begin; y < end; y++)
+			{
+				firstSourceRow = (min)(firstSourceRow, rowWeights.First[y]);
+				endSourceRow = (max)(endSourceRow, rowWeights.First[y] + rowWeights.Count[y]);
+			}
+
+			// Filter each of them to the new width
+			size_t filteredPitch = static_cast<size_t>(destinationWidth) * 4;
+			vector<float> filtered((endSourceRow - firstSourceRow) * filteredPitch);
+			vector<float> scratch(static_cast<size_t>(sourceWidth) * 4);
+			for (uint32_t sourceRow = firstSourceRow; sourceRow < endSourceRow; sourceRow++)
+			{
+				FilterRow(readRow(sourceRow, scratch.data()), columnWeights, destinationWidth, &filtered[(sourceRow - firstSourceRow) * filteredPitch]);
+			}
+
+			// Then combine them into the rows of the band
+			vector<float> row(filteredPitch);
+			for (size_t y = begin; y < end; y++)
+			{
+				const float* weights = &rowWeights.Weights[y * rowWeights.Stride];
+				const float* sourceRows = &filtered[(rowWeights.First[y] - firstSourceRow) * filteredPitch];
+				for (uint32_t x = 0; x < destinationWidth; x++)
+				{
+					Float4 sum = ZeroFloat4();
+					for (uint32_t j = 0; j < rowWeights.Count[y]; j++)
+					{
+						sum = MultiplyAddFloat4(sum, LoadFloat4(sourceRows + j * filteredPitch + x * 4), weights[j]);
+					}
+					StoreFloat4(&row[x * 4], sum);
+				}
+				writeRow(y, row.data());
+			}
+		});
+	}
+}
+
+size_t GetResamplePixelSize(ResampleFormat format)
+{
+	switch (format)
+	{
+	case ResampleFormat::RGBA8:
+		return 4;
+	case ResampleFormat::RGBA16F:
+		return 8;
+	default:
+		return 16;
+	}
+}
+
+void DecodeResampleRow(const uint8_t* source, uint32_t width, ResampleFormat format, bool srgb, float* destination, bool premultiply)
+{
+	switch (format)
+	{
+	case ResampleFormat::RGBA8:
+	{
+		// Each channel is looked up in a table, and the pixel is premultiplied while it is in registers
+		const SrgbTables& tables = GetSrgbTables();
+		const float* colour = srgb ? tables.ToLinear : tables.ToFloat;
+		for (uint32_t x = 0; x < width; x++, source += 4, destination += 4)
+		{
+			Float4 pixel = SetFloat4(colour[source[0]], colour[source[1]], colour[source[2]], tables.ToFloat[source[3]]);
+			StoreFloat4(destination, premultiply ? PremultiplyFloat4(pixel) : pixel);
+		}
+		break;
+	}
+	case ResampleFormat::RGBA16F:
+	{
+		const uint16_t* halves = reinterpret_cast<const uint16_t*>(source);
+		for (uint32_t x = 0; x < width; x++, halves += 4, destination += 4)
+		{
+			Float4 pixel = SetFloat4(HalfToFloat(halves[0]), HalfToFloat(halves[1]), HalfToFloat(halves[2]), HalfToFloat(halves[3]));
+			StoreFloat4(destination, premultiply ? PremultiplyFloat4(pixel) : pixel);
+		}
+		break;
+	}
+	case ResampleFormat::RGBA32F:
+		memcpy(destination, source, width * 4 * sizeof(float));
+		if (premultiply)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				StoreFloat4(destination + x * 4, PremultiplyFloat4(LoadFloat4(destination + x * 4)));
+			}
+		}
+		break;
+	}
+}
+
+void EncodeResampleRow(const float* source, uint32_t width, ResampleFormat format, bool srgb, uint8_t* destination, bool unpremultiply)
+{
+	switch (format)
+	{
+	case ResampleFormat::RGBA8:
+		if (srgb)
+		{
+			// Clamp the pixel with SIMD, then look up the colour channels in the encoding table
+			const SrgbTables& tables = GetSrgbTables();
+			for (uint32_t x = 0; x < width; x++, source += 4, destination += 4)
+			{
+				Float4 pixel = LoadFloat4(source);
+				float values[4];
+				StoreFloat4(values, ClampFloat4(unpremultiply ? UnpremultiplyFloat4(pixel) : pixel));
+				destination[0] = tables.ToSrgb(values[0]);
+				destination[1] = tables.ToSrgb(values[1]);
+				destination[2] = tables.ToSrgb(values[2]);
+				destination[3] = static_cast<uint8_t>(values[3] * 255.0f + 0.5f);
+			}
+		}
+		else
+		{
+			uint32_t x = 0;
+#ifdef IMAGE_RESAMPLER_SSE2
+			// Clamp, scale and round four channels at a time, then pack them down to bytes
+			const __m128 scale = _mm_set1_ps(255.0f);
+			for (; x + 4 <= width; x += 4)
+			{
+				__m128i pixels[4];
+				for (int p = 0; p < 4; p++)
+				{
+					__m128 value = LoadFloat4(source + (x + p) * 4);
+					value = ClampFloat4(unpremultiply ? UnpremultiplyFloat4(value) : value);
+					pixels[p] = _mm_cvtps_epi32(_mm_mul_ps(value, scale));
+				}
+				__m128i packed = _mm_packus_epi16(_mm_packs_epi32(pixels[0], pixels[1]), _mm_packs_epi32(pixels[2], pixels[3]));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x * 4), packed);
+			}
+#endif
+			for (; x < width; x++)
+			{
+				Float4 pixel = LoadFloat4(source + x * 4);
+				float values[4];
+				StoreFloat4(values, ClampFloat4(unpremultiply ? UnpremultiplyFloat4(pixel) : pixel));
+				for (int c = 0; c < 4; c++)
+				{
+					destination[x * 4 + c] = static_cast<uint8_t>(values[c] * 255.0f + 0.5f);
+				}
+			}
+		}
+		break;
+	case ResampleFormat::RGBA16F:
+	{
+		uint16_t* halves = reinterpret_cast<uint16_t*>(destination);
+		for (uint32_t x = 0; x < width; x++, source += 4, halves += 4)
+		{
+			Float4 pixel = LoadFloat4(source);
+			float values[4];
+			StoreFloat4(values, unpremultiply ? UnpremultiplyFloat4(pixel) : pixel);
+			for (int c = 0; c < 4; c++)
+			{
+				halves[c] = FloatToHalf(values[c]);
+			}
+		}
+		break;
+	}
+	case ResampleFormat::RGBA32F:
+		if (unpremultiply)
+		{
+			float* values = reinterpret_cast<float*>(destination);
+			for (uint32_t x = 0; x < width; x++)
+			{
+				StoreFloat4(values + x * 4, UnpremultiplyFloat4(LoadFloat4(source + x * 4)));
+			}
+		}
+		else
+		{
+			memcpy(destination, source, width * 4 * sizeof(float));
+		}
+		break;
+	}
+}
+
+bool ResampleImage(const void* source, uint32_t sourceWidth, uint32_t sourceHeight, size_t sourceRowPitch,
+				   void* destination, uint32_t destinationWidth, uint32_t destinationHeight, size_t destinationRowPitch,
+				   ResampleFormat format, bool srgb, ResampleFilter filter, ResampleAlpha alpha)
+{
+	if (source == nullptr || destination == nullptr || sourceWidth == 0 || sourceHeight == 0 || destinationWidth == 0 || destinationHeight == 0)
+	{
+		return false;
+	}
+	srgb = srgb && format == ResampleFormat::RGBA8;
+	bool premultiply = alpha != ResampleAlpha::Separate;
+	bool unpremultiply = alpha == ResampleAlpha::Straight;
+	const uint8_t* sourcePixels = static_cast<const uint8_t*>(source);
+	uint8_t* destinationPixels = static_cast<uint8_t*>(destination);
+	ResampleBands(sourceWidth, sourceHeight, destinationWidth, destinationHeight, filter,
+		[&](uint32_t y, float* scratch) -> const float*
+		{
+			DecodeResampleRow(sourcePixels + y * sourceRowPitch, sourceWidth, format, srgb, scratch, premultiply);
+			return scratch;
+		},
+		[&](size_t y, const float* row)
+		{
+			EncodeResampleRow(row, destinationWidth, format, srgb, destinationPixels + y * destinationRowPitch, unpremultiply);
+		});
+	return true;
+}
+
+bool ResampleLinearImage(const float* source, uint32_t sourceWidth, uint32_t sourceHeight,
+						 float* destination, uint32_t destinationWidth, uint32_t destinationHeight, ResampleFilter filter)
+{
+	if (source == nullptr || destination == nullptr || sourceWidth == 0 || sourceHeight == 0 || destinationWidth == 0 || destinationHeight == 0)
+	{
+		return false;
+	}
+	size_t sourcePitch = static_cast<size_t>(sourceWidth) * 4;
+	size_t destinationPitch = static_cast<size_t>(destinationWidth) * 4;
+	ResampleBands(sourceWidth, sourceHeight, destinationWidth, destinationHeight, filter,
+		[&](uint32_t y, float*) -> const float*
+		{
+			return source + y * sourcePitch;
+		},
+		[&](size_t y, const float* row)
+		{
+			memcpy(destination + y * destinationPitch, row, destinationPitch * sizeof(float));
+		});
+	return true;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// CPU image resizing, used to shrink textures that are too big when they are loaded, for mipmap generation
+// (see MipGenerator.h) and by the offline tools.
+//
+// The resize is separable: each row is filtered to the new width, then the filtered rows are combined into
+// the rows of the new image.  The filter kernel for every column and row of the new image (each phase of
+// the filter) is worked out once, with its weights normalised and the taps off the edge clamped onto the
+// edge pixel, so any sizes are handled exactly, upwards as well as downwards.  Pixels are filtered as four
+// floats at a time with SIMD (SSE2) whatever format they are stored in.
+//
+// The new image is made in bands of rows, each on its own thread: a band filters just the source rows it
+// needs (converting them to floats as it goes) and combines them into its rows, so only a few rows of
+// floats are held at a time however big the image is.  The source rows shared by neighbouring bands are
+// filtered by both.
+//
+// The colour channels of 8-bit images are normally sRGB encoded, so they are converted to linear light
+// before filtering and back afterwards.  Alpha is always linear, as are the 16-bit and 32-bit float formats.
+// Both conversions use tables: decoding looks each byte up, and encoding looks up the step of linear light a
+// value is in and then makes at most one comparison, which gives the same result as searching for the
+// nearest sRGB value but is several times faster.
+//
+// Images whose alpha is coverage can be filtered with their colour premultiplied by alpha, so that
+// transparent pixels do not bleed their colour into the pixels round them.  Pixels are premultiplied as they
+// are converted to floats and divided by alpha again as they are converted back (see ResampleAlpha), so this
+// does not add any passes over the image.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+// Half width of the Kaiser filter (in pixels of the smaller image) and its alpha (higher is smoother)
+#define ResampleKaiserWidth			3.0f
+#define ResampleKaiserAlpha			4.0f
+// Roughly how many pixels of the new image each thread makes at a time, and the fewest rows in a band
+#define ResamplePixelsPerTask		16384
+#define ResampleMinimumBandRows		16
+
+// Four channels per pixel, in any order as long as alpha is last (so BGRA images can be used as RGBA8)
+enum class ResampleFormat
+{
+	RGBA8,
+	RGBA16F,
+	RGBA32F
+};
+
+enum class ResampleFilter
+{
+	// Averages the pixels each new pixel covers (nearest neighbour when enlarging).  Fast, but soft.
+	Box,
+	// Linear interpolation (a tent over two pixels of the smaller image)
+	Triangle,
+	// Mitchell-Netravali cubic (B = C = 1/3).  Sharp with very little ringing; a good default.
+	Mitchell,
+	// Lanczos windowed sinc over three lobes.  The sharpest, but it can ring around hard edges.
+	Lanczos3,
+	// Kaiser windowed sinc.  Between Mitchell and Lanczos3.
+	Kaiser
+};
+
+enum class ResampleAlpha
+{
+	// Alpha is filtered like the other channels.  Use this for opaque images, images that are already
+	// premultiplied and images whose alpha is not coverage.
+	Separate,
+	// The image has straight alpha.  It is filtered premultiplied and the new image has straight alpha.
+	Straight,
+	// The image has straight alpha.  It is filtered premultiplied and the new image stays premultiplied.
+	Premultiply
+};
+
+std::size_t		GetResamplePixelSize(ResampleFormat format);
+
+// Convert a row of pixels to and from four linear floats per pixel.  srgb says whether the colour channels
+// of an RGBA8 image are sRGB encoded (it is ignored for the float formats).  premultiply multiplies the
+// colour channels by alpha as they are decoded, and unpremultiply divides them by it as they are encoded
+// (colour with no alpha becomes black).
+void			DecodeResampleRow(const uint8_t* source, uint32_t width, ResampleFormat format, bool srgb, float* destination, bool premultiply = false);
+void			EncodeResampleRow(const float* source, uint32_t width, ResampleFormat format, bool srgb, uint8_t* destination, bool unpremultiply = false);
+
+// Resize an image.  Returns false if either image is empty.
+bool			ResampleImage(const void* source, uint32_t sourceWidth, uint32_t sourceHeight, std::size_t sourceRowPitch,
+							  void* destination, uint32_t destinationWidth, uint32_t destinationHeight, std::size_t destinationRowPitch,
+							  ResampleFormat format, bool srgb, ResampleFilter filter, ResampleAlpha alpha = ResampleAlpha::Separate);
+
+// Resize an image held as four linear floats per pixel with tightly packed rows (as made by
+// DecodeResampleRow), e.g. to make each mip level from the one above without rounding in between
+bool			ResampleLinearImage(const float* source, uint32_t sourceWidth, uint32_t sourceHeight,
+									float* destination, uint32_t destinationWidth, uint32_t destinationHeight, ResampleFilter filter);
@@ -0,0 +1,127 @@
+#include "InternedName.h"
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+using namespace std;
+
+const wstring InternedName::EmptyName;
+
+namespace
+{
+	// The table of interned names.  Entries live in a deque so that their addresses never change, and
+	// are found through an open addressing hash table (linear probing) of pointers to the entries.
+	// Names can be interned from any thread.  Lookups take a shared lock, so only adding a new name
+	// makes other threads wait.
+	class NameTable
+	{
+	public:
+		NameTable() : _count(0)
+		{
+			_slots.resize(64, nullptr);
+		}
+
+		const InternedNameEntry* Find(wstring_view name, size_t hash)
+		{
+			shared_lock<shared_mutex> lock(_mutex);
+			return FindLocked(name, hash);
+		}
+
+		const InternedNameEntry* Intern(wstring_view name)
+		{
+			size_t hash = InternedName::HashName(name);
+			const InternedNameEntry* entry = Find(name, hash);
+			if (entry)
+			{
+				return entry;
+			}
+			unique_lock<shared_mutex> lock(_mutex);
+			// Another thread may have added the name since we looked
+			entry = FindLocked(name, hash);
+			if (entry)
+			{
+				return entry;
+			}
+			// Keep the table no more than half full so that probe sequences stay short
+			if ((_count + 1) * 2 > _slots.size())
+			{
+				Grow();
+			}
+			_entries.push_back({ wstring(name), hash });
+			entry = &_entries.back();
+			Insert(entry);
+			_count++;
+			return entry;
+		}
+
+	private:
+		deque<InternedNameEntry>			_entries;
+		vector<const InternedNameEntry*>	_slots;
+		size_t								_count;
+		shared_mutex						_mutex;
+
+		const InternedNameEntry* FindLocked(wstring_view name, size_t hash) const
+		{
+			size_t mask = _slots.size() - 1;
+			for (size_t slot = hash & mask; _slots[slot] != nullptr; slot = (slot + 1) & mask)
+			{
+				if (_slots[slot]->Hash == hash && _slots[slot]->Name == name)
+				{
+					return _slots[slot];
+				}
+			}
+			return nullptr;
+		}
+
+		void Insert(const InternedNameEntry* entry)
+		{
+			size_t mask = _slots.size() - 1;
+			size_t slot = entry->Hash & mask;
+			while (_slots[slot] != nullptr)
+			{
+				slot = (slot + 1) & mask;
+			}
+			_slots[slot] = entry;
+		}
+
+		void Grow()
+		{
+			vector<const InternedNameEntry*> oldSlots(_slots.size() * 2, nullptr);
+			oldSlots.swap(_slots);
+			for (const InternedNameEntry* entry : oldSlots)
+			{
+				if (entry)
+				{
+					Insert(entry);
+				}
+			}
+		}
+	};
+
+	NameTable& GetNameTable()
+	{
+		static NameTable nameTable;
+		return nameTable;
+	}
+}
+
+InternedName::InternedName(wstring_view name) : _entry(GetNameTable().Intern(name))
+{
+}
+
+size_t InternedName::HashName(wstring_view name)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (wchar_t character : name)
+	{
+		hash = (hash ^ static_cast<uint64_t>(character)) * 1099511628211ull;
+	}
+	return static_cast<size_t>(hash);
+}
+
+InternedName InternedName::Find(wstring_view name)
+{
+	return InternedName(GetNameTable().Find(name, HashName(name)));
+}
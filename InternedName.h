@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Interned resource names.
+//
+// Each distinct name is stored once in a global table along with its hash, which is calculated when the
+// name is first interned.  An InternedName is just a pointer to that entry, so copying one is cheap,
+// comparing two of them is a pointer comparison and hashing one costs nothing.  Names are never removed
+// from the table, so an InternedName stays valid for the lifetime of the program.  Names can be interned
+// from any thread.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+struct InternedNameEntry
+{
+	std::wstring	Name;
+	std::size_t		Hash;
+};
+
+class InternedName
+{
+public:
+	InternedName() : _entry(nullptr) {}
+	explicit InternedName(std::wstring_view name);
+
+	inline std::wstring_view	View() const { return _entry ? std::wstring_view(_entry->Name) : std::wstring_view(); }
+	inline const std::wstring&	String() const { return _entry ? _entry->Name : EmptyName; }
+	inline std::size_t			Hash() const { return _entry ? _entry->Hash : HashName(std::wstring_view()); }
+	inline bool					IsEmpty() const { return _entry == nullptr || _entry->Name.empty(); }
+
+	inline bool					operator==(const InternedName& other) const { return _entry == other._entry; }
+	inline bool					operator!=(const InternedName& other) const { return _entry != other._entry; }
+
+	// Hash function used for names (64-bit FNV-1a over the characters of the name)
+	static std::size_t			HashName(std::wstring_view name);
+
+	// Returns the existing entry for a name without adding it to the table.  The result is empty if the
+	// name has never been interned.
+	static InternedName			Find(std::wstring_view name);
+
+private:
+	explicit InternedName(const InternedNameEntry* entry) : _entry(entry) {}
+
+	static const std::wstring	EmptyName;
+
+	const InternedNameEntry*	_entry;
+};
@@ -0,0 +1,189 @@
+#include "LzCompression.h"
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+	const unsigned int HashBits = 14;
+	const size_t HashSize = static_cast<size_t>(1) << HashBits;
+
+	inline uint32_t Read32(const uint8_t* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	inline uint32_t HashSequence(uint32_t sequence)
+	{
+		// Multiplicative (Fibonacci) hash of the four bytes
+		return (sequence * 2654435761u) >> (32 - HashBits);
+	}
+
+	// Write the extra bytes of a length that did not fit in its half of the token
+	inline void WriteLengthExtension(size_t length, vector<uint8_t>& output)
+	{
+		while (length >= 255)
+		{
+			output.push_back(255);
+			length -= 255;
+		}
+		output.push_back(static_cast<uint8_t>(length));
+	}
+
+	inline void WriteSequence(const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength, vector<uint8_t>& output)
+	{
+		size_t matchCode = matchLength == 0 ? 0 : matchLength - LzMinimumMatch;
+		uint8_t token = static_cast<uint8_t>(((literalCount < 15 ? literalCount : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+		output.push_back(token);
+		if (literalCount >= 15)
+		{
+			WriteLengthExtension(literalCount - 15, output);
+		}
+		output.insert(output.end(), literals, literals + literalCount);
+		if (matchLength == 0)
+		{
+			// Last sequence
+			return;
+		}
+		output.push_back(static_cast<uint8_t>(offset));
+		output.push_back(static_cast<uint8_t>(offset >> 8));
+		if (matchCode >= 15)
+		{
+			WriteLengthExtension(matchCode - 15, output);
+		}
+	}
+
+	// Read the extra bytes of a length.  Returns false if the input runs out.
+	inline bool ReadLengthExtension(const uint8_t*& input, const uint8_t* inputEnd, size_t& length)
+	{
+		uint8_t value;
+		do
+		{
+			if (input >= inputEnd)
+			{
+				return false;
+			}
+			value = *input++;
+			length += value;
+		} while (value == 255);
+		return true;
+	}
+}
+
+size_t LzCompress(const uint8_t* source, size_t sourceSize, vector<uint8_t>& compressed)
+{
+	size_t startSize = compressed.size();
+	// Positions (plus one, so that zero is empty) of the last sequence seen with each hash
+	vector<uint32_t> table(HashSize, 0);
+	size_t literalStart = 0;
+	size_t position = 0;
+	// Step through the input faster while no matches are being found, so that incompressible data is quick
+	unsigned int missCount = 0;
+	while (sourceSize >= LzMinimumMatch && position <= sourceSize - LzMinimumMatch)
+	{
+		uint32_t sequence = Read32(source + position);
+		uint32_t& slot = table[HashSequence(sequence)];
+		size_t candidate = slot;
+		slot = static_cast<uint32_t>(position + 1);
+		if (candidate == 0 || position - (candidate - 1) > LzMaximumOffset || Read32(source + candidate - 1) != sequence)
+		{
+			position += 1 + (missCount++ >> 5);
+			continue;
+		}
+		missCount = 0;
+		size_t matchStart = candidate - 1;
+		// Extend the match backwards over any literals and then forwards as far as it goes
+		while (position > literalStart && matchStart > 0 && source[position - 1] == source[matchStart - 1])
+		{
+			position--;
+			matchStart--;
+		}
+		size_t matchLength = LzMinimumMatch;
+		while (position + matchLength < sourceSize && source[position + matchLength] == source[matchStart + matchLength])
+		{
+			matchLength++;
+		}
+		WriteSequence(source + literalStart, position - literalStart, position - matchStart, matchLength, compressed);
+		position += matchLength;
+		literalStart = position;
+		// Add the position just before the end of the match so that the next match can be found from there
+		if (position >= 2 && position - 2 + LzMinimumMatch <= sourceSize)
+		{
+			table[HashSequence(Read32(source + position - 2))] = static_cast<uint32_t>(position - 1);
+		}
+	}
+	WriteSequence(source + literalStart, sourceSize - literalStart, 0, 0, compressed);
+	return compressed.size() - startSize;
+}
+
+bool LzDecompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize)
+{
+	const uint8_t* input = source;
+	const uint8_t* inputEnd = source + sourceSize;
+	uint8_t* output = destination;
+	uint8_t* outputEnd = destination + destinationSize;
+	while (input < inputEnd)
+	{
+		uint8_t token = *input++;
+		size_t literalCount = token >> 4;
+		if (literalCount == 15 && !ReadLengthExtension(input, inputEnd, literalCount))
+		{
+			return false;
+		}
+		if (literalCount > static_cast<size_t>(inputEnd - input) || literalCount > static_cast<size_t>(outputEnd - output))
+		{
+			return false;
+		}
+		memcpy(output, input, literalCount);
+		input += literalCount;
+		output += literalCount;
+		if (input == inputEnd)
+		{
+			// The last sequence has no match
+			break;
+		}
+
+		if (inputEnd - input < 2)
+		{
+			return false;
+		}
+		size_t offset = input[0] | (static_cast<size_t>(input[1]) << 8);
+		input += 2;
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLengthExtension(input, inputEnd, matchLength))
+		{
+			return false;
+		}
+		matchLength += LzMinimumMatch;
+		if (offset == 0 || offset > static_cast<size_t>(output - destination) || matchLength > static_cast<size_t>(outputEnd - output))
+		{
+			return false;
+		}
+		const uint8_t* match = output - offset;
+		if (offset >= 8)
+		{
+			// Copy eight bytes at a time.  Each copy only reads bytes that have already been written.
+			size_t copied = 0;
+			for (; copied + 8 <= matchLength; copied += 8)
+			{
+				memcpy(output + copied, match + copied, 8);
+			}
+			for (; copied < matchLength; copied++)
+			{
+				output[copied] = match[copied];
+			}
+		}
+		else
+		{
+			// Overlapping copy of a short repeating pattern
+			for (size_t i = 0; i < matchLength; i++)
+			{
+				output[i] = match[i];
+			}
+		}
+		output += matchLength;
+	}
+	return output == outputEnd;
+}
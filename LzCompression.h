@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fast LZ77 block compression used for assets in the asset archive.
+//
+// The format follows LZ4's block format: a block is a sequence of (literals, match) pairs, each starting
+// with a token byte whose high four bits hold the number of literals and whose low four bits hold the
+// match length minus the minimum match of four bytes.  A value of 15 in either half is extended by
+// following bytes, each adding up to 255.  The literals are followed by the two-byte little-endian offset
+// of the match back from the current position.  The last sequence has literals only.  Offsets are 16
+// bits, so blocks should be no larger than 64KB.
+//
+// The compressor is a greedy single pass over a hash table of four-byte sequences, which favours speed
+// over ratio.  The decompressor checks every length and offset against the input and output buffers, so a
+// damaged block is reported as an error rather than reading or writing outside the buffers.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+#define LzMinimumMatch			4
+#define LzMaximumOffset			65535
+
+// Compress a block, appending the result to compressed.  Returns the number of bytes appended.
+std::size_t		LzCompress(const uint8_t* source, std::size_t sourceSize, std::vector<uint8_t>& compressed);
+
+// Decompress a block that decompresses to exactly destinationSize bytes.  Returns false if the block is damaged.
+bool			LzDecompress(const uint8_t* source, std::size_t sourceSize, uint8_t* destination, std::size_t destinationSize);
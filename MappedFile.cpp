@@ -0,0 +1,108 @@
+#include "MappedFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#include "StringConversion.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+MappedFile::MappedFile()
+{
+	_data = nullptr;
+	_size = 0;
+#ifdef _WIN32
+	_file = INVALID_HANDLE_VALUE;
+	_mapping = nullptr;
+#else
+	_file = -1;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const string& fileName)
+{
+	Close();
+#ifdef _WIN32
+	_file = CreateFileW(s2ws(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (_file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(_file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+	_mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (_mapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+	_data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	_file = open(fileName.c_str(), O_RDONLY);
+	if (_file < 0)
+	{
+		return false;
+	}
+	struct stat fileStatus;
+	if (fstat(_file, &fileStatus) != 0 || fileStatus.st_size == 0)
+	{
+		Close();
+		return false;
+	}
+	_size = static_cast<size_t>(fileStatus.st_size);
+	void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file, 0);
+	_data = mapping == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(mapping);
+#endif
+	if (_data == nullptr)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (_data)
+	{
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping)
+	{
+		CloseHandle(_mapping);
+		_mapping = nullptr;
+	}
+	if (_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(_file);
+		_file = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (_data)
+	{
+		munmap(const_cast<uint8_t*>(_data), _size);
+	}
+	if (_file >= 0)
+	{
+		close(_file);
+		_file = -1;
+	}
+#endif
+	_data = nullptr;
+	_size = 0;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A whole file mapped read-only into memory.  Used for the asset archive and for textures that can be used
+// straight from the file (see DdsFile.h), so reading them costs no more than the I/O.  The operating system
+// reads the file through the page cache as the mapping is used.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// fileName is UTF-8.  Returns false if the file could not be opened or is empty.
+	bool					Open(const std::string& fileName);
+	void					Close();
+	inline bool				IsOpen() const { return _data != nullptr; }
+
+	// Valid until the file is closed
+	inline const uint8_t*	GetData() const { return _data; }
+	inline std::size_t		GetSize() const { return _size; }
+
+private:
+	const uint8_t*			_data;
+	std::size_t				_size;
+#ifdef _WIN32
+	void*					_file;
+	void*					_mapping;
+#else
+	int						_file;
+#endif
+};
@@ -1,65 +1,315 @@
-#include "Mesh.h"
-
-// Material methods
-
-Material::Material(wstring materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, ComPtr<ID3D11ShaderResourceView> texture)
-{
-	_materialName = materialName;
-	_diffuseColour = diffuseColour;
-	_specularColour = specularColour;
-	_shininess = shininess;
-	_opacity = opacity;
-    _texture = texture;
-}
-
-Material::~Material(void)
-{
-}
-
-// SubMesh methods
-
-SubMesh::SubMesh(ComPtr<ID3D11Buffer> vertexBuffer,
-				ComPtr<ID3D11Buffer> indexBuffer,
-				UINT vertexCount,
-				UINT indexCount,
-				shared_ptr<Material> material,
-				bool hasNormals,
-				bool hasTexCoords)
-{			
-	_vertexBuffer = vertexBuffer;
-	_indexBuffer = indexBuffer;
-	_vertexCount = vertexCount;
-	_indexCount = indexCount;
-	_material = material;
-	_hasNormals = hasNormals;
-	_hasTexCoords = hasTexCoords;
-}
-
-SubMesh::~SubMesh(void)
-{
-}
-
-// Mesh methods
-
-size_t Mesh::GetSubMeshCount()
-{
-	return _subMeshList.size();
-}
-
-shared_ptr<SubMesh> Mesh::GetSubMesh(unsigned int i)
-{
-	if (i >= 0 && i < _subMeshList.size())
-	{
-		return _subMeshList[i];
-	}
-	else
-	{
-		return nullptr;
-	}
-}
-
-void Mesh::AddSubMesh(shared_ptr<SubMesh> subMesh)
-{
-	_subMeshList.push_back(subMesh);
-}
-
+#include "Mesh.h"
+
+namespace
+{
+	// Size of a pixel in bits, or of a 4x4 block in bytes for block compressed formats.  Returns 0 for
+	// formats that textures are never created with.
+	size_t GetFormatBitsPerPixel(DXGI_FORMAT format, bool& blockCompressed)
+	{
+		blockCompressed = false;
+		switch (format)
+		{
+			case DXGI_FORMAT_R32G32B32A32_FLOAT:
+			case DXGI_FORMAT_R32G32B32A32_UINT:
+				return 128;
+
+			case DXGI_FORMAT_R16G16B16A16_FLOAT:
+			case DXGI_FORMAT_R16G16B16A16_UNORM:
+			case DXGI_FORMAT_R32G32_FLOAT:
+				return 64;
+
+			case DXGI_FORMAT_R8G8B8A8_UNORM:
+			case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+			case DXGI_FORMAT_B8G8R8A8_UNORM:
+			case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+			case DXGI_FORMAT_B8G8R8X8_UNORM:
+			case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+			case DXGI_FORMAT_R10G10B10A2_UNORM:
+			case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+			case DXGI_FORMAT_R11G11B10_FLOAT:
+			case DXGI_FORMAT_R32_FLOAT:
+				return 32;
+
+			case DXGI_FORMAT_B5G5R5A1_UNORM:
+			case DXGI_FORMAT_B5G6R5_UNORM:
+			case DXGI_FORMAT_R16_FLOAT:
+			case DXGI_FORMAT_R16_UNORM:
+			case DXGI_FORMAT_R8G8_UNORM:
+				return 16;
+
+			case DXGI_FORMAT_R8_UNORM:
+			case DXGI_FORMAT_A8_UNORM:
+				return 8;
+
+			case DXGI_FORMAT_R1_UNORM:
+				return 1;
+
+			case DXGI_FORMAT_BC1_UNORM:
+			case DXGI_FORMAT_BC1_UNORM_SRGB:
+			case DXGI_FORMAT_BC4_UNORM:
+			case DXGI_FORMAT_BC4_SNORM:
+				blockCompressed = true;
+				return 8;
+
+			case DXGI_FORMAT_BC2_UNORM:
+			case DXGI_FORMAT_BC2_UNORM_SRGB:
+			case DXGI_FORMAT_BC3_UNORM:
+			case DXGI_FORMAT_BC3_UNORM_SRGB:
+			case DXGI_FORMAT_BC5_UNORM:
+			case DXGI_FORMAT_BC5_SNORM:
+			case DXGI_FORMAT_BC6H_UF16:
+			case DXGI_FORMAT_BC6H_SF16:
+			case DXGI_FORMAT_BC7_UNORM:
+			case DXGI_FORMAT_BC7_UNORM_SRGB:
+				blockCompressed = true;
+				return 16;
+
+			default:
+				return 0;
+		}
+	}
+
+	size_t GetBufferMemorySize(ID3D11Buffer* buffer)
+	{
+		if (!buffer)
+		{
+			return 0;
+		}
+		D3D11_BUFFER_DESC bufferDescriptor;
+		buffer->GetDesc(&bufferDescriptor);
+		return bufferDescriptor.ByteWidth;
+	}
+}
+
+// The size of the data the texture was created with.  The driver may add some padding that we cannot see.
+size_t GetTextureMemorySize(ID3D11ShaderResourceView* shaderResourceView)
+{
+	ComPtr<ID3D11Resource> resource;
+	shaderResourceView->GetResource(resource.GetAddressOf());
+	ComPtr<ID3D11Texture2D> texture;
+	if (FAILED(resource.As(&texture)))
+	{
+		return 0;
+	}
+	D3D11_TEXTURE2D_DESC textureDescriptor;
+	texture->GetDesc(&textureDescriptor);
+	bool blockCompressed;
+	size_t bitsPerPixel = GetFormatBitsPerPixel(textureDescriptor.Format, blockCompressed);
+	size_t size = 0;
+	for (UINT level = 0; level < textureDescriptor.MipLevels; level++)
+	{
+		size_t width = (std::max)(textureDescriptor.Width >> level, 1u);
+		size_t height = (std::max)(textureDescriptor.Height >> level, 1u);
+		if (blockCompressed)
+		{
+			size += ((width + 3) / 4) * ((height + 3) / 4) * bitsPerPixel;
+		}
+		else
+		{
+			size += ((width * bitsPerPixel + 7) / 8) * height;
+		}
+	}
+	return size * textureDescriptor.ArraySize;
+}
+
+size_t GetTextureLargestSize(ID3D11ShaderResourceView* shaderResourceView)
+{
+	ComPtr<ID3D11Resource> resource;
+	shaderResourceView->GetResource(resource.GetAddressOf());
+	ComPtr<ID3D11Texture2D> texture;
+	if (FAILED(resource.As(&texture)))
+	{
+		return 0;
+	}
+	D3D11_TEXTURE2D_DESC textureDescriptor;
+	texture->GetDesc(&textureDescriptor);
+	return (std::max)(textureDescriptor.Width, textureDescriptor.Height);
+}
+
+// Material methods
+
+Material::Material(InternedName materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, ComPtr<ID3D11ShaderResourceView> texture, wstring_view textureName)
+{
+	_materialName = materialName;
+	_diffuseColour = diffuseColour;
+	_specularColour = specularColour;
+	_shininess = shininess;
+	_opacity = opacity;
+    _texture = texture;
+	_textureName = textureName;
+	_atlasRegion = Vector4::Zero;
+}
+
+Material::~Material(void)
+{
+}
+
+void Material::Update(Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, ComPtr<ID3D11ShaderResourceView> texture, wstring_view textureName)
+{
+	_diffuseColour = diffuseColour;
+	_specularColour = specularColour;
+	_shininess = shininess;
+	_opacity = opacity;
+	_texture = texture;
+	_textureName = textureName;
+}
+
+void Material::SetTexture(ComPtr<ID3D11ShaderResourceView> texture)
+{
+	_texture = texture;
+}
+
+void Material::SetAtlasRegion(const Vector4& atlasRegion)
+{
+	_atlasRegion = atlasRegion;
+}
+
+void Material::NoteScreenSize(float pixels)
+{
+	float screenSize = _screenSize;
+	while (pixels > screenSize && !_screenSize.compare_exchange_weak(screenSize, pixels))
+	{
+	}
+}
+
+float Material::TakeScreenSize()
+{
+	return _screenSize.exchange(0.0f);
+}
+
+size_t Material::GetGpuMemorySize()
+{
+	if (!_texture)
+	{
+		return 0;
+	}
+	size_t size = GetTextureMemorySize(_texture.Get());
+	if (IsInAtlas())
+	{
+		size = static_cast<size_t>(size * _atlasRegion.z * _atlasRegion.w);
+	}
+	return size;
+}
+
+size_t Material::GetCpuMemorySize()
+{
+	return sizeof(Material) + _textureName.capacity() * sizeof(wchar_t);
+}
+
+// SubMesh methods
+
+SubMesh::SubMesh(UINT baseVertex,
+				UINT vertexCount,
+				UINT startIndex,
+				UINT indexCount,
+				shared_ptr<Material> material,
+				bool hasNormals,
+				bool hasTexCoords)
+{			
+	_baseVertex = baseVertex;
+	_vertexCount = vertexCount;
+	_material = material;
+	_hasNormals = hasNormals;
+	_hasTexCoords = hasTexCoords;
+	_lodLevels.push_back({ startIndex, indexCount, 0.0f });
+}
+
+SubMesh::~SubMesh(void)
+{
+}
+
+void SubMesh::SetBounds(const BoundingBox& boundingBox, const BoundingSphere& boundingSphere)
+{
+	_boundingBox = boundingBox;
+	_boundingSphere = boundingSphere;
+}
+
+void SubMesh::AddLodLevel(UINT startIndex, UINT indexCount, float error)
+{
+	_lodLevels.push_back({ startIndex, indexCount, error });
+}
+
+size_t SubMesh::GetCpuMemorySize()
+{
+	return sizeof(SubMesh) + _lodLevels.capacity() * sizeof(LodLevel);
+}
+
+// Mesh methods
+
+size_t Mesh::GetSubMeshCount()
+{
+	return _subMeshList.size();
+}
+
+shared_ptr<SubMesh> Mesh::GetSubMesh(unsigned int i)
+{
+	if (i >= 0 && i < _subMeshList.size())
+	{
+		return _subMeshList[i];
+	}
+	else
+	{
+		return nullptr;
+	}
+}
+
+void Mesh::AddSubMesh(shared_ptr<SubMesh> subMesh, const Matrix& modelTransformation)
+{
+	BoundingBox boundingBox;
+	BoundingSphere boundingSphere;
+	subMesh->GetBoundingBox().Transform(boundingBox, modelTransformation);
+	subMesh->GetBoundingSphere().Transform(boundingSphere, modelTransformation);
+	if (_subMeshList.empty())
+	{
+		_boundingBox = boundingBox;
+		_boundingSphere = boundingSphere;
+	}
+	else
+	{
+		BoundingBox::CreateMerged(_boundingBox, _boundingBox, boundingBox);
+		BoundingSphere::CreateMerged(_boundingSphere, _boundingSphere, boundingSphere);
+	}
+	_subMeshList.push_back(subMesh);
+}
+
+void Mesh::AddNode(const MeshNode& node)
+{
+	_nodes.push_back(node);
+}
+
+void Mesh::Swap(Mesh& other)
+{
+	_subMeshList.swap(other._subMeshList);
+	_nodes.swap(other._nodes);
+	_vertexBuffer.Swap(other._vertexBuffer);
+	_indexBuffer.Swap(other._indexBuffer);
+	swap(_boundingBox, other._boundingBox);
+	swap(_boundingSphere, other._boundingSphere);
+	_version++;
+	other._version++;
+}
+
+void Mesh::SetBuffers(ComPtr<ID3D11Buffer> vertexBuffer, ComPtr<ID3D11Buffer> indexBuffer)
+{
+	_vertexBuffer = vertexBuffer;
+	_indexBuffer = indexBuffer;
+}
+
+size_t Mesh::GetGpuMemorySize()
+{
+	return GetBufferMemorySize(_vertexBuffer.Get()) + GetBufferMemorySize(_indexBuffer.Get());
+}
+
+size_t Mesh::GetCpuMemorySize()
+{
+	size_t size = sizeof(Mesh) + _subMeshList.capacity() * sizeof(shared_ptr<SubMesh>) + _nodes.capacity() * sizeof(MeshNode);
+	for (shared_ptr<SubMesh>& subMesh : _subMeshList)
+	{
+		size += subMesh->GetCpuMemorySize();
+	}
+	for (MeshNode& node : _nodes)
+	{
+		size += node.Name.capacity() * sizeof(wchar_t) + node.SubMeshes.capacity() * sizeof(UINT);
+	}
+	return size;
+}
@@ -1,90 +1,202 @@
-#pragma once
-#include "core.h"
-#include "DirectXCore.h"
-#include <vector>
-#include <memory>
-#include "SimpleMath.h"
-
-using namespace DirectX::SimpleMath;
-
-struct Vertex
-{
-	Vector3 Position;
-	Vector3 Normal;
-	Vector2 TexCoord;
-};
-
-
-// Core material class.  Ideally, this should be extended to include more material attributes that can be
-// recovered from Assimp, but this handles the basics.
-
-class Material
-{
-public:
-	Material(wstring materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, ComPtr<ID3D11ShaderResourceView> texture );
-	~Material();
-
-	inline wstring							GetMaterialName() { return _materialName;  }
-	inline Vector4							GetDiffuseColour() { return _diffuseColour; }
-	inline Vector4							GetSpecularColour() { return _specularColour; }
-	inline float							GetShininess() { return _shininess; }
-	inline float							GetOpacity() { return _opacity; }
-	inline ComPtr<ID3D11ShaderResourceView>	GetTexture() { return _texture; }
-
-private:
-	wstring									_materialName;
-	Vector4									_diffuseColour;
-	Vector4									_specularColour;
-	float									_shininess;
-	float									_opacity;
-    ComPtr<ID3D11ShaderResourceView>		_texture;
-};
-
-// Basic SubMesh class.  A Mesh consists of one or more sub-meshes.  The submesh provides everything that is needed to
-// draw the sub-mesh.
-
-class SubMesh
-{
-public:
-	SubMesh(ComPtr<ID3D11Buffer> vertexBuffer,
-		ComPtr<ID3D11Buffer> indexBuffer,
-		UINT vertexCount,
-		UINT indexCount,
-		shared_ptr<Material> material,
-		bool hasNormals,
-		bool hasTexCoords);
-		
-	~SubMesh();
-
-	inline ComPtr<ID3D11Buffer>			GetVertexBuffer() { return _vertexBuffer; }
-	inline ComPtr<ID3D11Buffer>			GetIndexBuffer() { return _indexBuffer; }
-	inline shared_ptr<Material>			GetMaterial() { return _material; }
-	inline UINT							GetVertexCount() { return _vertexCount; }
-	inline UINT							GetIndexCount() { return _indexCount; }
-	inline bool							HasNormals() { return _hasNormals; }
-	inline bool							HasTexCoords() { return _hasTexCoords; }
-
-private:
-   	ComPtr<ID3D11Buffer>				_vertexBuffer;
-	ComPtr<ID3D11Buffer>				_indexBuffer;
-	shared_ptr<Material>				_material;
-	UINT								_vertexCount;
-	UINT								_indexCount;
-	bool								_hasNormals;
-	bool								_hasTexCoords;
-};
-
-// Core mesh class
-
-class Mesh
-{
-public:
-	size_t								GetSubMeshCount();
-	shared_ptr<SubMesh>					GetSubMesh(unsigned int i);
-	void								AddSubMesh(shared_ptr<SubMesh> subMesh);
-
-private:
-	vector<shared_ptr<SubMesh>> 		_subMeshList;
-};
-
-
+#pragma once
+#include "core.h"
+#include "DirectXCore.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include "SimpleMath.h"
+#include "InternedName.h"
+
+using namespace DirectX::SimpleMath;
+
+// Size of the data in every mip level and array slice of a 2D texture
+size_t GetTextureMemorySize(ID3D11ShaderResourceView* shaderResourceView);
+// Largest width or height of the top mip level of a 2D texture
+size_t GetTextureLargestSize(ID3D11ShaderResourceView* shaderResourceView);
+
+struct Vertex
+{
+	Vector3 Position;
+	Vector3 Normal;
+	Vector2 TexCoord;
+};
+
+
+// Core material class.  Ideally, this should be extended to include more material attributes that can be
+// recovered from Assimp, but this handles the basics.
+
+class Material
+{
+public:
+	Material(InternedName materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, ComPtr<ID3D11ShaderResourceView> texture, wstring_view textureName = L"");
+	~Material();
+
+	inline InternedName						GetMaterialName() { return _materialName;  }
+	inline Vector4							GetDiffuseColour() { return _diffuseColour; }
+	inline Vector4							GetSpecularColour() { return _specularColour; }
+	inline float							GetShininess() { return _shininess; }
+	inline float							GetOpacity() { return _opacity; }
+	inline ComPtr<ID3D11ShaderResourceView>	GetTexture() { return _texture; }
+	inline const wstring&					GetTextureName() { return _textureName; }
+
+	// Used when the material is reloaded.  The caller must stop anything from drawing with the material while
+	// it is changed (the ResourceManager holds the device context mutex).
+	void									Update(Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, ComPtr<ID3D11ShaderResourceView> texture, wstring_view textureName);
+	void									SetTexture(ComPtr<ID3D11ShaderResourceView> texture);
+
+	// If the material's texture has been put in a texture atlas shared with other materials (see TextureAtlas.h),
+	// the texture is the atlas and the region is where the material's image is in it: texture coordinates map to
+	// (u, v) * (Z, W) + (X, Y).  The texture coordinates of the meshes using the material have already been
+	// mapped.  The region is all zero if the material has a texture of its own.
+	void									SetAtlasRegion(const Vector4& atlasRegion);
+	inline const Vector4&					GetAtlasRegion() { return _atlasRegion; }
+	inline bool								IsInAtlas() { return _atlasRegion.z > 0.0f; }
+
+	// Nodes drawing with the material note how many pixels across it covers on screen, and the texture streamer
+	// (see ResourceManager::EnableTextureStreaming) takes the largest size noted since it last looked.  Can be
+	// called from any thread.
+	void									NoteScreenSize(float pixels);
+	float									TakeScreenSize();
+
+	// Memory used by the material's texture on the GPU and by the material itself on the CPU.  A material in an
+	// atlas counts the part of the atlas its image covers.
+	size_t									GetGpuMemorySize();
+	size_t									GetCpuMemorySize();
+
+private:
+	InternedName							_materialName;
+	Vector4									_diffuseColour;
+	Vector4									_specularColour;
+	float									_shininess;
+	float									_opacity;
+    ComPtr<ID3D11ShaderResourceView>		_texture;
+	wstring									_textureName;
+	Vector4									_atlasRegion;
+	atomic<float>							_screenSize{ 0.0f };
+};
+
+// Basic SubMesh class.  A Mesh consists of one or more sub-meshes.  The submesh provides everything that is needed to
+// draw the sub-mesh apart from the vertex and index buffers, which are shared by all of the sub-meshes in the mesh.
+// The sub-mesh records where its vertices and indices start in those buffers, so it is drawn with
+// DrawIndexed(GetIndexCount(lod), GetStartIndex(lod), GetBaseVertex()).
+//
+// Each sub-mesh can also have a chain of lower levels of detail.  Every level uses the same vertices and has its
+// own range of indices, together with the geometric error (in model units) that the simplification introduced.
+// Level 0 is always the full detail mesh.
+
+class SubMesh
+{
+public:
+	SubMesh(UINT baseVertex,
+		UINT vertexCount,
+		UINT startIndex,
+		UINT indexCount,
+		shared_ptr<Material> material,
+		bool hasNormals,
+		bool hasTexCoords);
+		
+	~SubMesh();
+
+	inline shared_ptr<Material>			GetMaterial() { return _material; }
+	inline UINT							GetBaseVertex() { return _baseVertex; }
+	inline UINT							GetVertexCount() { return _vertexCount; }
+	inline bool							HasNormals() { return _hasNormals; }
+	inline bool							HasTexCoords() { return _hasTexCoords; }
+
+	void								SetBounds(const BoundingBox& boundingBox, const BoundingSphere& boundingSphere);
+	inline const BoundingBox&			GetBoundingBox() { return _boundingBox; }
+	inline const BoundingSphere&		GetBoundingSphere() { return _boundingSphere; }
+
+	void								AddLodLevel(UINT startIndex, UINT indexCount, float error);
+	inline UINT							GetLodCount() { return static_cast<UINT>(_lodLevels.size()); }
+	inline UINT							GetStartIndex(UINT lod) { return _lodLevels[lod].StartIndex; }
+	inline UINT							GetIndexCount(UINT lod) { return _lodLevels[lod].IndexCount; }
+	inline float						GetLodError(UINT lod) { return _lodLevels[lod].Error; }
+
+	size_t								GetCpuMemorySize();
+
+private:
+	struct LodLevel
+	{
+		UINT							StartIndex;
+		UINT							IndexCount;
+		float							Error;
+	};
+
+	shared_ptr<Material>				_material;
+	UINT								_baseVertex;
+	UINT								_vertexCount;
+	bool								_hasNormals;
+	bool								_hasTexCoords;
+	vector<LodLevel>					_lodLevels;
+	BoundingBox							_boundingBox;
+	BoundingSphere						_boundingSphere;
+};
+
+// A node of the hierarchy of a model.  Only the parts of the hierarchy that can move independently are
+// kept as nodes.  Static parts of the model are merged into their nearest kept ancestor when the model is
+// loaded, so the sub-meshes of a node are in the coordinate space of that node.  Nodes are stored with
+// parents before their children.
+
+struct MeshNode
+{
+	wstring								Name;
+	// Transformation relative to the parent node
+	Matrix								LocalTransformation;
+	// Index of the parent node, or -1 for the root node
+	int									Parent;
+	// Indices of the sub-meshes drawn by this node
+	vector<UINT>						SubMeshes;
+};
+
+// Core mesh class.  The mesh owns the vertex and index buffers that all of its sub-meshes are drawn from,
+// so drawing a whole mesh only needs the buffers to be bound once.  The bounds of the mesh are the union
+// of the bounds of its sub-meshes (in model space) and are updated as sub-meshes are added.
+
+class Mesh
+{
+public:
+	size_t								GetSubMeshCount();
+	shared_ptr<SubMesh>					GetSubMesh(unsigned int i);
+	// modelTransformation transforms the sub-mesh from the space of the node it belongs to into model space
+	void								AddSubMesh(shared_ptr<SubMesh> subMesh, const Matrix& modelTransformation = Matrix::Identity);
+
+	inline size_t						GetNodeCount() { return _nodes.size(); }
+	inline const MeshNode&				GetNode(size_t i) { return _nodes[i]; }
+	void								AddNode(const MeshNode& node);
+
+	void								SetBuffers(ComPtr<ID3D11Buffer> vertexBuffer, ComPtr<ID3D11Buffer> indexBuffer);
+	inline ComPtr<ID3D11Buffer>			GetVertexBuffer() { return _vertexBuffer; }
+	inline ComPtr<ID3D11Buffer>			GetIndexBuffer() { return _indexBuffer; }
+
+	inline const BoundingBox&			GetBoundingBox() { return _boundingBox; }
+	inline const BoundingSphere&		GetBoundingSphere() { return _boundingSphere; }
+
+	// The import profile the model was loaded with (see ModelImporter.h)
+	inline void							SetImportProfile(const string& importProfile) { _importProfile = importProfile; }
+	inline const string&				GetImportProfile() { return _importProfile; }
+
+	// Exchange the contents of two meshes.  Used to swap a reloaded model into the mesh that everything already
+	// references.  The version changes each time, so users that cache anything derived from the mesh (such as
+	// its bounds) can tell when it has been reloaded.  The caller must stop anything from drawing with either
+	// mesh while they are swapped (the ResourceManager holds the device context mutex).
+	void								Swap(Mesh& other);
+	inline unsigned int					GetVersion() { return _version; }
+
+	// Memory used by the vertex and index buffers on the GPU and by the mesh, its sub-meshes and its nodes
+	// on the CPU.  Materials are accounted for separately.
+	size_t								GetGpuMemorySize();
+	size_t								GetCpuMemorySize();
+
+private:
+	vector<shared_ptr<SubMesh>> 		_subMeshList;
+	vector<MeshNode>					_nodes;
+	ComPtr<ID3D11Buffer>				_vertexBuffer;
+	ComPtr<ID3D11Buffer>				_indexBuffer;
+	BoundingBox							_boundingBox;
+	BoundingSphere						_boundingSphere;
+	string								_importProfile;
+	unsigned int						_version{ 0 };
+};
+
+
@@ -0,0 +1,25 @@
+#pragma once
+#include "DirectXCore.h"
+#include "MeshProcessing.h"
+
+// DirectX bounding volumes of a mesh, found with the portable functions in MeshProcessing.h.  The bounding
+// sphere is centred on the bounding box.
+
+inline void ComputeBounds(const XMFLOAT3* positions, size_t positionStride, size_t vertexCount,
+						  BoundingBox& boundingBox, BoundingSphere& boundingSphere)
+{
+	XMFLOAT3 minimum;
+	XMFLOAT3 maximum;
+	ComputeBoundingBox(&positions->x, positionStride, vertexCount, &minimum.x, &maximum.x);
+	BoundingBox::CreateFromPoints(boundingBox, XMLoadFloat3(&minimum), XMLoadFloat3(&maximum));
+	boundingSphere.Center = boundingBox.Center;
+	boundingSphere.Radius = ComputeBoundingRadius(&positions->x, positionStride, vertexCount, &boundingBox.Center.x);
+}
+
+// Version for vertex structures that have an XMFLOAT3 Position member
+
+template<typename TVertex>
+inline void ComputeBounds(const TVertex* vertices, size_t vertexCount, BoundingBox& boundingBox, BoundingSphere& boundingSphere)
+{
+	ComputeBounds(&vertices[0].Position, sizeof(TVertex), vertexCount, boundingBox, boundingSphere);
+}
@@ -0,0 +1,203 @@
+#include "MeshProcessing.h"
+#include "ParallelFor.h"
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+	// Number of triangles or vertices handled by each task
+	const size_t BatchSize = 4096;
+
+	template<typename T>
+	inline T* Element(T* first, size_t stride, size_t index)
+	{
+		return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(first) + stride * index);
+	}
+
+	template<typename T>
+	inline const T* Element(const T* first, size_t stride, size_t index)
+	{
+		return reinterpret_cast<const T*>(reinterpret_cast<const unsigned char*>(first) + stride * index);
+	}
+
+	// Build a list of the triangle corners (i.e. positions in the index list) that use each vertex
+	void BuildVertexCorners(size_t vertexCount, const uint32_t* indices, size_t indexCount, vector<uint32_t>& offsets, vector<uint32_t>& corners)
+	{
+		offsets.assign(vertexCount + 1, 0);
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			offsets[indices[i] + 1]++;
+		}
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			offsets[v + 1] += offsets[v];
+		}
+		corners.resize(indexCount);
+		vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			corners[fill[indices[i]]++] = static_cast<uint32_t>(i);
+		}
+	}
+
+	// Calculate the unnormalised normal of every triangle.  The length of the cross product is twice the
+	// area of the triangle, so adding these together gives area weighting for free.  Four triangles are
+	// processed at a time with each SIMD lane working on a different triangle.
+	void ComputeFaceNormals(const float* positions, size_t positionStride, const uint32_t* indices, size_t triangleCount, float* faceNormals)
+	{
+		ParallelFor(triangleCount, BatchSize, [&](size_t begin, size_t end)
+		{
+#ifdef MESH_PROCESSING_SSE2
+			for (size_t t = begin; t < end; t += 4)
+			{
+				// Gather the corners of four triangles into structure of arrays form.  If there are fewer
+				// than four triangles left, the last one is repeated to fill the unused lanes.
+				alignas(16) float corner[3][3][4];
+				size_t lanes = end - t < 4 ? end - t : 4;
+				for (size_t lane = 0; lane < 4; lane++)
+				{
+					size_t triangle = t + (lane < lanes ? lane : lanes - 1);
+					for (int c = 0; c < 3; c++)
+					{
+						const float* p = Element(positions, positionStride, indices[triangle * 3 + c]);
+						corner[c][0][lane] = p[0];
+						corner[c][1][lane] = p[1];
+						corner[c][2][lane] = p[2];
+					}
+				}
+				__m128 x0 = _mm_load_ps(corner[0][0]);
+				__m128 y0 = _mm_load_ps(corner[0][1]);
+				__m128 z0 = _mm_load_ps(corner[0][2]);
+				__m128 e1x = _mm_sub_ps(_mm_load_ps(corner[1][0]), x0);
+				__m128 e1y = _mm_sub_ps(_mm_load_ps(corner[1][1]), y0);
+				__m128 e1z = _mm_sub_ps(_mm_load_ps(corner[1][2]), z0);
+				__m128 e2x = _mm_sub_ps(_mm_load_ps(corner[2][0]), x0);
+				__m128 e2y = _mm_sub_ps(_mm_load_ps(corner[2][1]), y0);
+				__m128 e2z = _mm_sub_ps(_mm_load_ps(corner[2][2]), z0);
+
+				// Cross product of the two edges
+				alignas(16) float normal[3][4];
+				_mm_store_ps(normal[0], _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e1z, e2y)));
+				_mm_store_ps(normal[1], _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e1x, e2z)));
+				_mm_store_ps(normal[2], _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e1y, e2x)));
+				for (size_t lane = 0; lane < lanes; lane++)
+				{
+					faceNormals[(t + lane) * 3] = normal[0][lane];
+					faceNormals[(t + lane) * 3 + 1] = normal[1][lane];
+					faceNormals[(t + lane) * 3 + 2] = normal[2][lane];
+				}
+			}
+#else
+			for (size_t t = begin; t < end; t++)
+			{
+				const float* p0 = Element(positions, positionStride, indices[t * 3]);
+				const float* p1 = Element(positions, positionStride, indices[t * 3 + 1]);
+				const float* p2 = Element(positions, positionStride, indices[t * 3 + 2]);
+				float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+				faceNormals[t * 3] = e1[1] * e2[2] - e1[2] * e2[1];
+				faceNormals[t * 3 + 1] = e1[2] * e2[0] - e1[0] * e2[2];
+				faceNormals[t * 3 + 2] = e1[0] * e2[1] - e1[1] * e2[0];
+			}
+#endif
+		});
+	}
+}
+
+void ComputeVertexNormals(const float* positions, size_t positionStride,
+						  float* normals, size_t normalStride,
+						  size_t vertexCount,
+						  const uint32_t* indices, size_t indexCount)
+{
+	size_t triangleCount = indexCount / 3;
+	vector<float> faceNormals(triangleCount * 3);
+	ComputeFaceNormals(positions, positionStride, indices, triangleCount, faceNormals.data());
+
+	vector<uint32_t> offsets;
+	vector<uint32_t> corners;
+	BuildVertexCorners(vertexCount, indices, triangleCount * 3, offsets, corners);
+
+	ParallelFor(vertexCount, BatchSize, [&](size_t begin, size_t end)
+	{
+		for (size_t v = begin; v < end; v++)
+		{
+			float sum[3] = { 0.0f, 0.0f, 0.0f };
+			for (uint32_t c = offsets[v]; c < offsets[v + 1]; c++)
+			{
+				const float* faceNormal = &faceNormals[corners[c] / 3 * 3];
+				sum[0] += faceNormal[0];
+				sum[1] += faceNormal[1];
+				sum[2] += faceNormal[2];
+			}
+			float length = sqrtf(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+			float scale = length > 0.0f ? 1.0f / length : 0.0f;
+			float* normal = Element(normals, normalStride, v);
+			normal[0] = sum[0] * scale;
+			normal[1] = sum[1] * scale;
+			normal[2] = sum[2] * scale;
+		}
+	});
+}
+
+BoundsAccumulator::BoundsAccumulator()
+{
+#ifdef MESH_PROCESSING_SSE2
+	_minimum = _mm_set1_ps(FLT_MAX);
+	_maximum = _mm_set1_ps(-FLT_MAX);
+#else
+	for (int axis = 0; axis < 3; axis++)
+	{
+		_minimum[axis] = FLT_MAX;
+		_maximum[axis] = -FLT_MAX;
+	}
+#endif
+	_empty = true;
+}
+
+void BoundsAccumulator::GetBox(float minimum[3], float maximum[3]) const
+{
+#ifdef MESH_PROCESSING_SSE2
+	alignas(16) float boxMinimum[4];
+	alignas(16) float boxMaximum[4];
+	_mm_store_ps(boxMinimum, _minimum);
+	_mm_store_ps(boxMaximum, _maximum);
+#else
+	const float* boxMinimum = _minimum;
+	const float* boxMaximum = _maximum;
+#endif
+	for (int axis = 0; axis < 3; axis++)
+	{
+		minimum[axis] = _empty ? 0.0f : boxMinimum[axis];
+		maximum[axis] = _empty ? 0.0f : boxMaximum[axis];
+	}
+}
+
+void ComputeBoundingBox(const float* positions, size_t positionStride, size_t vertexCount,
+						float minimum[3], float maximum[3])
+{
+	BoundsAccumulator bounds;
+	for (size_t v = 0; v < vertexCount; v++)
+	{
+		bounds.Add(Element(positions, positionStride, v));
+	}
+	bounds.GetBox(minimum, maximum);
+}
+
+float ComputeBoundingRadius(const float* positions, size_t positionStride, size_t vertexCount,
+							const float centre[3])
+{
+	float radiusSquared = 0.0f;
+	for (size_t v = 0; v < vertexCount; v++)
+	{
+		const float* position = Element(positions, positionStride, v);
+		float dx = position[0] - centre[0];
+		float dy = position[1] - centre[1];
+		float dz = position[2] - centre[2];
+		float distanceSquared = dx * dx + dy * dy + dz * dz;
+		radiusSquared = distanceSquared > radiusSquared ? distanceSquared : radiusSquared;
+	}
+	return sqrtf(radiusSquared);
+}
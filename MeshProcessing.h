@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MESH_PROCESSING_SSE2
+#include <emmintrin.h>
+#endif
+
+// Mesh processing functions shared by the procedural scene nodes, the ResourceManager and the asset cooker
+// (through ModelBuilder).
+//
+// Positions and normals are three floats, accessed through a pointer to the component in the first vertex
+// and a stride in bytes, so these functions work directly on any vertex structure (there are template
+// versions below for the common case).  The work is split into batches of triangles, which are processed
+// four at a time using SIMD, and batches of vertices which are spread across threads.  Each vertex gathers
+// the contributions from the triangles that use it (rather than each triangle scattering its contribution
+// into its vertices), so no two threads ever write to the same vertex.  Meshes smaller than one batch (such
+// as the cube nodes) are processed on the calling thread.  Where SSE2 is not available the same work is done
+// one triangle at a time.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.  The DirectX bounding volume
+// versions are in MeshBounds.h.
+
+// Calculate area weighted vertex normals (the contribution of each triangle is weighted by its area).
+// A vertex that is not used by any triangle with an area gets a zero normal.
+void ComputeVertexNormals(const float* positions, size_t positionStride,
+						  float* normals, size_t normalStride,
+						  size_t vertexCount,
+						  const uint32_t* indices, size_t indexCount);
+
+// Finds the axis aligned bounding box of points as they are added, using a SIMD min/max, so that the box
+// can be found while vertex data is being copied rather than in a pass of its own.
+class BoundsAccumulator
+{
+public:
+	BoundsAccumulator();
+
+	inline void Add(const float* position)
+	{
+#ifdef MESH_PROCESSING_SSE2
+		__m128 point = _mm_setr_ps(position[0], position[1], position[2], 0.0f);
+		_minimum = _mm_min_ps(_minimum, point);
+		_maximum = _mm_max_ps(_maximum, point);
+#else
+		for (int axis = 0; axis < 3; axis++)
+		{
+			_minimum[axis] = position[axis] < _minimum[axis] ? position[axis] : _minimum[axis];
+			_maximum[axis] = position[axis] > _maximum[axis] ? position[axis] : _maximum[axis];
+		}
+#endif
+		_empty = false;
+	}
+
+	inline bool IsEmpty() const { return _empty; }
+	// The box of the points added so far.  Both corners are the origin if none have been added.
+	void GetBox(float minimum[3], float maximum[3]) const;
+
+private:
+#ifdef MESH_PROCESSING_SSE2
+	__m128						_minimum;
+	__m128						_maximum;
+#else
+	float						_minimum[3];
+	float						_maximum[3];
+#endif
+	bool						_empty;
+};
+
+// Calculate the axis aligned bounding box of a set of points
+void ComputeBoundingBox(const float* positions, size_t positionStride, size_t vertexCount,
+						float minimum[3], float maximum[3]);
+
+// Calculate the radius of a bounding sphere with the given centre (normally the centre of the bounding box),
+// i.e. the distance to the furthest point from it
+float ComputeBoundingRadius(const float* positions, size_t positionStride, size_t vertexCount,
+							const float centre[3]);
+
+// Versions for vertex structures that have Position and Normal members made of three floats (e.g. float[3]
+// or XMFLOAT3)
+
+template<typename TVertex>
+inline void ComputeVertexNormals(TVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount)
+{
+	ComputeVertexNormals(reinterpret_cast<const float*>(&vertices[0].Position), sizeof(TVertex),
+						 reinterpret_cast<float*>(&vertices[0].Normal), sizeof(TVertex),
+						 vertexCount, indices, indexCount);
+}
+
+template<typename TVertex>
+inline void ComputeBoundingBox(const TVertex* vertices, size_t vertexCount, float minimum[3], float maximum[3])
+{
+	ComputeBoundingBox(reinterpret_cast<const float*>(&vertices[0].Position), sizeof(TVertex), vertexCount, minimum, maximum);
+}
+
+template<typename TVertex>
+inline float ComputeBoundingRadius(const TVertex* vertices, size_t vertexCount, const float centre[3])
+{
+	return ComputeBoundingRadius(reinterpret_cast<const float*>(&vertices[0].Position), sizeof(TVertex), vertexCount, centre);
+}
@@ -0,0 +1,531 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+using namespace std;
+
+namespace
+{
+	// Border and seam edges get an extra plane quadric perpendicular to the triangle that they
+	// belong to.  This weight controls how strongly the outline is preserved.
+	const double BorderEdgeWeight = 10.0;
+
+	// Classification of each position in the mesh
+	enum VertexKind : unsigned char
+	{
+		Manifold,	// Interior vertex. Can collapse onto any neighbour.
+		Border,		// Vertex on an open border.  Can only move along the border.
+		Seam,		// Vertex on a UV seam.  Can only move along the seam (both sides together).
+		Locked		// Corner of a border/seam or complex vertex.  Never moves.
+	};
+
+	// Symmetric 4x4 quadric matrix plus the total weight of the planes that have been added
+	struct Quadric
+	{
+		double a00, a11, a22;
+		double a10, a20, a21;
+		double b0, b1, b2;
+		double c;
+		double w;
+
+		void AddPlane(double a, double b, double cc, double d, double weight)
+		{
+			a00 += a * a * weight;
+			a11 += b * b * weight;
+			a22 += cc * cc * weight;
+			a10 += a * b * weight;
+			a20 += a * cc * weight;
+			a21 += b * cc * weight;
+			b0 += a * d * weight;
+			b1 += b * d * weight;
+			b2 += cc * d * weight;
+			c += d * d * weight;
+			w += weight;
+		}
+
+		void Add(const Quadric& q)
+		{
+			a00 += q.a00; a11 += q.a11; a22 += q.a22;
+			a10 += q.a10; a20 += q.a20; a21 += q.a21;
+			b0 += q.b0; b1 += q.b1; b2 += q.b2;
+			c += q.c;
+			w += q.w;
+		}
+
+		// Returns the weighted mean squared distance of (x, y, z) from the planes in the quadric
+		double Error(double x, double y, double z) const
+		{
+			double rx = a00 * x + a10 * y + a20 * z + b0;
+			double ry = a10 * x + a11 * y + a21 * z + b1;
+			double rz = a20 * x + a21 * y + a22 * z + b2;
+			double r = rx * x + ry * y + rz * z + b0 * x + b1 * y + b2 * z + c;
+			return w > 0.0 ? fabs(r) / w : 0.0;
+		}
+	};
+
+	struct Collapse
+	{
+		unsigned int	From;
+		unsigned int	To;
+		double			Error;
+	};
+
+	// Simple compressed adjacency list (offsets into a single data array)
+	struct Adjacency
+	{
+		vector<unsigned int>	Offsets;
+		vector<unsigned int>	Data;
+
+		inline const unsigned int* Begin(unsigned int i) const { return Data.data() + Offsets[i]; }
+		inline const unsigned int* End(unsigned int i) const { return Data.data() + Offsets[i + 1]; }
+	};
+
+	inline void Cross(const float* a, const float* b, const float* c, double* normal)
+	{
+		double e1x = b[0] - a[0], e1y = b[1] - a[1], e1z = b[2] - a[2];
+		double e2x = c[0] - a[0], e2y = c[1] - a[1], e2z = c[2] - a[2];
+		normal[0] = e1y * e2z - e1z * e2y;
+		normal[1] = e1z * e2x - e1x * e2z;
+		normal[2] = e1x * e2y - e1y * e2x;
+	}
+
+	struct PositionHash
+	{
+		const float* Positions;
+
+		size_t operator()(unsigned int index) const
+		{
+			unsigned int bits[3];
+			memcpy(bits, Positions + index * 3, sizeof(bits));
+			// Treat -0 and +0 as the same value
+			for (unsigned int& b : bits)
+			{
+				b = (b == 0x80000000) ? 0 : b;
+			}
+			return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+		}
+	};
+
+	struct PositionEqual
+	{
+		const float* Positions;
+
+		bool operator()(unsigned int a, unsigned int b) const
+		{
+			const float* pa = Positions + a * 3;
+			const float* pb = Positions + b * 3;
+			return pa[0] == pb[0] && pa[1] == pb[1] && pa[2] == pb[2];
+		}
+	};
+}
+
+MeshSimplifier::MeshSimplifier(const float* positions, size_t vertexStride, unsigned int vertexCount)
+{
+	_positions.resize(vertexCount);
+	const unsigned char* source = reinterpret_cast<const unsigned char*>(positions);
+	float minimum[3] = { 0.0f, 0.0f, 0.0f };
+	float maximum[3] = { 0.0f, 0.0f, 0.0f };
+	for (unsigned int i = 0; i < vertexCount; i++)
+	{
+		memcpy(&_positions[i], source + i * vertexStride, sizeof(Position));
+		const float* p = &_positions[i].x;
+		for (int k = 0; k < 3; k++)
+		{
+			minimum[k] = (i == 0 || p[k] < minimum[k]) ? p[k] : minimum[k];
+			maximum[k] = (i == 0 || p[k] > maximum[k]) ? p[k] : maximum[k];
+		}
+	}
+	float dx = maximum[0] - minimum[0];
+	float dy = maximum[1] - minimum[1];
+	float dz = maximum[2] - minimum[2];
+	_extent = sqrtf(dx * dx + dy * dy + dz * dz);
+	BuildPositionRemap();
+}
+
+void MeshSimplifier::BuildPositionRemap()
+{
+	unsigned int vertexCount = static_cast<unsigned int>(_positions.size());
+	const float* positions = &_positions[0].x;
+	unordered_map<unsigned int, unsigned int, PositionHash, PositionEqual> firstVertex(vertexCount, PositionHash{ positions }, PositionEqual{ positions });
+
+	_remap.resize(vertexCount);
+	_wedge.resize(vertexCount);
+	for (unsigned int i = 0; i < vertexCount; i++)
+	{
+		auto result = firstVertex.emplace(i, i);
+		unsigned int first = result.first->second;
+		_remap[i] = first;
+		if (first == i)
+		{
+			_wedge[i] = i;
+		}
+		else
+		{
+			// Insert this vertex into the circular list of vertices at this position
+			_wedge[i] = _wedge[first];
+			_wedge[first] = i;
+		}
+	}
+}
+
+vector<unsigned int> MeshSimplifier::Simplify(const vector<unsigned int>& indices, unsigned int targetIndexCount, float maxError, float* resultError, bool lockBorders) const
+{
+	unsigned int vertexCount = static_cast<unsigned int>(_positions.size());
+	const float* positions = &_positions[0].x;
+	vector<unsigned int> result(indices);
+	double maxErrorSquared = static_cast<double>(maxError) * maxError;
+	double largestError = 0.0;
+
+	// Quadrics are accumulated per position (i.e. on the first vertex at each position) and are
+	// carried through all collapses so that error builds up correctly across passes.
+	vector<Quadric> quadrics(vertexCount);
+	memset(quadrics.data(), 0, sizeof(Quadric) * vertexCount);
+	for (size_t i = 0; i + 2 < result.size(); i += 3)
+	{
+		const float* p0 = positions + result[i] * 3;
+		const float* p1 = positions + result[i + 1] * 3;
+		const float* p2 = positions + result[i + 2] * 3;
+		double normal[3];
+		Cross(p0, p1, p2, normal);
+		double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (length == 0.0)
+		{
+			continue;
+		}
+		double area = length * 0.5;
+		double a = normal[0] / length;
+		double b = normal[1] / length;
+		double c = normal[2] / length;
+		double d = -(a * p0[0] + b * p0[1] + c * p0[2]);
+		Quadric q = {};
+		q.AddPlane(a, b, c, d, area);
+		quadrics[_remap[result[i]]].Add(q);
+		quadrics[_remap[result[i + 1]]].Add(q);
+		quadrics[_remap[result[i + 2]]].Add(q);
+	}
+	bool bordersAdded = false;
+
+	vector<unsigned char> kind(vertexCount);
+	vector<unsigned char> locked(vertexCount);
+	vector<unsigned int> collapseTo(vertexCount);
+	vector<Collapse> candidates;
+	Adjacency edges;
+	Adjacency triangles;
+
+	while (result.size() > targetIndexCount)
+	{
+		size_t triangleCount = result.size() / 3;
+
+		// Build vertex -> neighbouring vertex (directed edges) adjacency for the current triangles
+		edges.Offsets.assign(vertexCount + 1, 0);
+		for (size_t i = 0; i < result.size(); i++)
+		{
+			edges.Offsets[result[i] + 1]++;
+		}
+		for (unsigned int i = 0; i < vertexCount; i++)
+		{
+			edges.Offsets[i + 1] += edges.Offsets[i];
+		}
+		edges.Data.resize(result.size());
+		{
+			vector<unsigned int> fill(edges.Offsets.begin(), edges.Offsets.end() - 1);
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				edges.Data[fill[result[i]]++] = result[i + 1];
+				edges.Data[fill[result[i + 1]]++] = result[i + 2];
+				edges.Data[fill[result[i + 2]]++] = result[i];
+			}
+		}
+		auto hasEdge = [&](unsigned int from, unsigned int to)
+		{
+			return find(edges.Begin(from), edges.End(from), to) != edges.End(from);
+		};
+
+		// Build position -> triangle adjacency used for the flip test
+		triangles.Offsets.assign(vertexCount + 1, 0);
+		for (size_t i = 0; i < result.size(); i++)
+		{
+			triangles.Offsets[_remap[result[i]] + 1]++;
+		}
+		for (unsigned int i = 0; i < vertexCount; i++)
+		{
+			triangles.Offsets[i + 1] += triangles.Offsets[i];
+		}
+		triangles.Data.resize(result.size());
+		{
+			vector<unsigned int> fill(triangles.Offsets.begin(), triangles.Offsets.end() - 1);
+			for (size_t i = 0; i < result.size(); i++)
+			{
+				triangles.Data[fill[_remap[result[i]]]++] = static_cast<unsigned int>(i / 3);
+			}
+		}
+
+		// Classify each position.  A directed edge is open if there is no matching edge going the
+		// other way.  Open edges are either mesh borders or UV seams (where the vertices on each
+		// side of the edge have different attributes).
+		vector<unsigned int> openOut(vertexCount, 0);
+		vector<unsigned int> openIn(vertexCount, 0);
+		for (unsigned int v = 0; v < vertexCount; v++)
+		{
+			for (const unsigned int* e = edges.Begin(v); e != edges.End(v); e++)
+			{
+				if (!hasEdge(*e, v))
+				{
+					openOut[v]++;
+					openIn[*e]++;
+				}
+			}
+		}
+		for (unsigned int v = 0; v < vertexCount; v++)
+		{
+			if (_remap[v] != v)
+			{
+				continue;
+			}
+			unsigned int wedgeCount = 0;
+			bool simpleChain = true;
+			unsigned int w = v;
+			do
+			{
+				wedgeCount++;
+				if (openOut[w] != openIn[w] || openOut[w] > 1)
+				{
+					simpleChain = false;
+				}
+				w = _wedge[w];
+			} while (w != v);
+			if (wedgeCount == 1)
+			{
+				// Without border locking, only the corners of borders stay put
+				kind[v] = openOut[v] == 0 ? Manifold : (simpleChain ? (lockBorders ? Border : Manifold) : Locked);
+			}
+			else if (wedgeCount == 2 && simpleChain && openOut[v] == 1 && openOut[_wedge[v]] == 1)
+			{
+				kind[v] = Seam;
+			}
+			else
+			{
+				kind[v] = Locked;
+			}
+		}
+
+		// The first time through, add planes along the open edges so that borders and seams keep
+		// their shape as the vertices along them are collapsed.
+		if (!bordersAdded)
+		{
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				double normal[3];
+				Cross(positions + result[i] * 3, positions + result[i + 1] * 3, positions + result[i + 2] * 3, normal);
+				for (int e = 0; e < 3; e++)
+				{
+					unsigned int a = result[i + e];
+					unsigned int b = result[i + (e + 1) % 3];
+					if (hasEdge(b, a))
+					{
+						continue;
+					}
+					const float* pa = positions + a * 3;
+					const float* pb = positions + b * 3;
+					double ex = pb[0] - pa[0], ey = pb[1] - pa[1], ez = pb[2] - pa[2];
+					double length = sqrt(ex * ex + ey * ey + ez * ez);
+					// Plane through the edge and perpendicular to the triangle
+					double px = ey * normal[2] - ez * normal[1];
+					double py = ez * normal[0] - ex * normal[2];
+					double pz = ex * normal[1] - ey * normal[0];
+					double planeLength = sqrt(px * px + py * py + pz * pz);
+					if (planeLength == 0.0)
+					{
+						continue;
+					}
+					px /= planeLength;
+					py /= planeLength;
+					pz /= planeLength;
+					double d = -(px * pa[0] + py * pa[1] + pz * pa[2]);
+					Quadric q = {};
+					q.AddPlane(px, py, pz, d, length * length * BorderEdgeWeight);
+					quadrics[_remap[a]].Add(q);
+					quadrics[_remap[b]].Add(q);
+				}
+			}
+			bordersAdded = true;
+		}
+
+		// Gather the candidate collapses.  Border and seam vertices can only collapse along an
+		// open edge, which means that they slide along the border or seam.
+		candidates.clear();
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (int e = 0; e < 3; e++)
+			{
+				unsigned int a = result[i + e];
+				unsigned int b = result[i + (e + 1) % 3];
+				unsigned int ra = _remap[a];
+				unsigned int rb = _remap[b];
+				if (ra == rb)
+				{
+					continue;
+				}
+				bool open = !hasEdge(b, a);
+				for (int direction = 0; direction < 2; direction++)
+				{
+					unsigned int from = direction == 0 ? ra : rb;
+					unsigned int to = direction == 0 ? rb : ra;
+					if (kind[from] == Locked || (kind[from] != Manifold && (!open || kind[to] == Manifold)))
+					{
+						continue;
+					}
+					const float* p = positions + to * 3;
+					candidates.push_back({ from, to, quadrics[from].Error(p[0], p[1], p[2]) });
+				}
+			}
+		}
+		if (candidates.empty())
+		{
+			break;
+		}
+		sort(candidates.begin(), candidates.end(), [](const Collapse& lhs, const Collapse& rhs) { return lhs.Error < rhs.Error; });
+
+		// Now perform as many of the cheapest collapses as we can in this pass.  Positions
+		// involved in a collapse (and their neighbours) are locked for the rest of the pass so
+		// that the adjacency information stays valid.
+		fill(locked.begin(), locked.end(), static_cast<unsigned char>(0));
+		for (unsigned int v = 0; v < vertexCount; v++)
+		{
+			collapseTo[v] = v;
+		}
+		size_t targetTriangles = targetIndexCount / 3;
+		size_t remainingTriangles = triangleCount;
+		unsigned int collapseCount = 0;
+		for (const Collapse& collapse : candidates)
+		{
+			if (remainingTriangles <= targetTriangles || collapse.Error > maxErrorSquared)
+			{
+				break;
+			}
+			unsigned int from = collapse.From;
+			unsigned int to = collapse.To;
+			if (locked[from] || locked[to])
+			{
+				continue;
+			}
+
+			// Reject the collapse if any triangle around 'from' would flip over or collapse
+			// into a sliver.  Also count the triangles that will disappear.
+			const float* target = positions + to * 3;
+			bool valid = true;
+			size_t removed = 0;
+			for (const unsigned int* t = triangles.Begin(from); t != triangles.End(from) && valid; t++)
+			{
+				const unsigned int* triangle = &result[*t * 3];
+				unsigned int r0 = _remap[triangle[0]];
+				unsigned int r1 = _remap[triangle[1]];
+				unsigned int r2 = _remap[triangle[2]];
+				if (r0 == to || r1 == to || r2 == to)
+				{
+					removed++;
+					continue;
+				}
+				const float* p[3] = { positions + triangle[0] * 3, positions + triangle[1] * 3, positions + triangle[2] * 3 };
+				double before[3];
+				Cross(p[0], p[1], p[2], before);
+				for (int k = 0; k < 3; k++)
+				{
+					if (_remap[triangle[k]] == from)
+					{
+						p[k] = target;
+					}
+				}
+				double after[3];
+				Cross(p[0], p[1], p[2], after);
+				double dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+				double lengthBefore = sqrt(before[0] * before[0] + before[1] * before[1] + before[2] * before[2]);
+				double lengthAfter = sqrt(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]);
+				valid = dot > 0.25 * lengthBefore * lengthAfter;
+			}
+			if (!valid)
+			{
+				continue;
+			}
+
+			// Every vertex at the 'from' position must collapse onto a vertex at the 'to'
+			// position that it shares an edge with, so that attributes are kept on each
+			// side of a seam.
+			unsigned int w = from;
+			do
+			{
+				unsigned int partner = vertexCount;
+				unsigned int u = to;
+				do
+				{
+					if (hasEdge(w, u) || hasEdge(u, w))
+					{
+						partner = u;
+						break;
+					}
+					u = _wedge[u];
+				} while (u != to);
+				if (partner == vertexCount)
+				{
+					valid = false;
+					break;
+				}
+				collapseTo[w] = partner;
+				w = _wedge[w];
+			} while (w != from);
+			if (!valid)
+			{
+				w = from;
+				do
+				{
+					collapseTo[w] = w;
+					w = _wedge[w];
+				} while (w != from);
+				continue;
+			}
+
+			// Lock everything around the collapse for the rest of this pass
+			for (const unsigned int* t = triangles.Begin(from); t != triangles.End(from); t++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					locked[_remap[result[*t * 3 + k]]] = 1;
+				}
+			}
+			locked[to] = 1;
+			quadrics[to].Add(quadrics[from]);
+			largestError = max(largestError, collapse.Error);
+			remainingTriangles -= removed;
+			collapseCount++;
+		}
+		if (collapseCount == 0)
+		{
+			break;
+		}
+
+		// Apply the collapses and throw away the triangles that have become degenerate
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			unsigned int i0 = collapseTo[result[i]];
+			unsigned int i1 = collapseTo[result[i + 1]];
+			unsigned int i2 = collapseTo[result[i + 2]];
+			if (_remap[i0] == _remap[i1] || _remap[i1] == _remap[i2] || _remap[i0] == _remap[i2])
+			{
+				continue;
+			}
+			result[write++] = i0;
+			result[write++] = i1;
+			result[write++] = i2;
+		}
+		result.resize(write);
+	}
+
+	if (resultError != nullptr)
+	{
+		*resultError = static_cast<float>(sqrt(largestError));
+	}
+	return result;
+}
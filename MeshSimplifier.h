@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Quadric error metric (QEM) mesh simplifier, used to build the level of detail chain for
+// each sub-mesh when a model is loaded.
+//
+// Edges are only ever collapsed onto an existing vertex, so every level of detail is just a
+// new index list that is drawn using the original vertex buffer.  Vertices that share a
+// position but have different normals or texture coordinates (i.e. UV seams) and vertices on
+// open borders are only allowed to slide along the seam or border they lie on, and the corners
+// of seams and borders never move, so texture mapping is preserved.  Each sub-mesh only has a
+// single material, so material boundaries are preserved by simplifying sub-meshes separately.
+// Border locking can be turned off for meshes that cannot otherwise be simplified (e.g. flat
+// sheets that are almost all border), in which case border vertices can collapse inwards like
+// any other vertex.  The planes along the border still count towards the error, so the outline
+// only moves as far as the error limit allows.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+class MeshSimplifier
+{
+public:
+	// positions points at the x component of the position of the first vertex and vertexStride
+	// is the distance in bytes between the positions of consecutive vertices.
+	MeshSimplifier(const float* positions, std::size_t vertexStride, unsigned int vertexCount);
+
+	// Simplify the triangle list in indices until it has no more than targetIndexCount indices,
+	// or until the next collapse would introduce an error (in model units) larger than maxError.
+	// The simplified index list is returned.  If resultError is not null, the error introduced
+	// by the simplification is returned in it.  If lockBorders is false, vertices on open borders
+	// are not limited to sliding along the border.
+	std::vector<unsigned int>	Simplify(const std::vector<unsigned int>& indices,
+										 unsigned int targetIndexCount,
+										 float maxError,
+										 float* resultError = nullptr,
+										 bool lockBorders = true) const;
+
+	// Length of the diagonal of the box around all of the vertices.  Useful for expressing
+	// maxError relative to the size of the mesh.
+	inline float				GetExtent() const { return _extent; }
+
+private:
+	struct Position
+	{
+		float x;
+		float y;
+		float z;
+	};
+
+	std::vector<Position>		_positions;
+	// Index of the first vertex that has the same position as each vertex
+	std::vector<unsigned int>	_remap;
+	// Circular list linking together all vertices that share the same position
+	std::vector<unsigned int>	_wedge;
+	float						_extent;
+
+	void						BuildPositionRemap();
+};
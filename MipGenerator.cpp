@@ -0,0 +1,113 @@
+#include "MipGenerator.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+	inline size_t RowsPerTask(uint32_t width)
+	{
+		return (max)(static_cast<size_t>(1), static_cast<size_t>(MipPixelsPerTask / width));
+	}
+}
+
+uint32_t CountMipLevels(uint32_t width, uint32_t height)
+{
+	uint32_t levels = 1;
+	for (uint32_t size = (max)(width, height); size > 1; size >>= 1)
+	{
+		levels++;
+	}
+	return levels;
+}
+
+size_t GetMipPixelSize(MipFormat format)
+{
+	return GetResamplePixelSize(format);
+}
+
+bool GenerateMipChain(const void* pixels, uint32_t width, uint32_t height, size_t rowPitch,
+					  MipFormat format, bool srgb, MipFilter filter, MipChain& chain, uint32_t levelCount, MipAlpha alpha)
+{
+	if (pixels == nullptr || width == 0 || height == 0)
+	{
+		return false;
+	}
+	uint32_t fullLevelCount = CountMipLevels(width, height);
+	if (levelCount == 0 || levelCount > fullLevelCount)
+	{
+		levelCount = fullLevelCount;
+	}
+	srgb = srgb && format == MipFormat::RGBA8;
+	bool premultiply = alpha != MipAlpha::Separate;
+	bool unpremultiply = alpha == MipAlpha::Straight;
+
+	// Lay out the levels
+	size_t pixelSize = GetMipPixelSize(format);
+	chain.Format = format;
+	chain.Levels.clear();
+	size_t offset = 0;
+	uint32_t levelWidth = width;
+	uint32_t levelHeight = height;
+	for (uint32_t level = 0; level < levelCount; level++)
+	{
+		MipLevel mipLevel{ levelWidth, levelHeight, levelWidth * pixelSize, offset };
+		chain.Levels.push_back(mipLevel);
+		offset += mipLevel.RowPitch * levelHeight;
+		levelWidth = (max)(levelWidth / 2, 1u);
+		levelHeight = (max)(levelHeight / 2, 1u);
+	}
+	chain.Pixels.resize(offset);
+
+	// Level 0 is the image as it is (unless it is being premultiplied, when it is made from the floats below)
+	const uint8_t* sourcePixels = static_cast<const uint8_t*>(pixels);
+	bool copyLevel0 = alpha != MipAlpha::Premultiply;
+	if (copyLevel0)
+	{
+		for (uint32_t y = 0; y < height; y++)
+		{
+			memcpy(chain.Pixels.data() + y * chain.Levels[0].RowPitch, sourcePixels + y * rowPitch, chain.Levels[0].RowPitch);
+		}
+		if (levelCount == 1)
+		{
+			return true;
+		}
+	}
+
+	// The level above the one being made, as (linear) floats
+	vector<float> current(static_cast<size_t>(width) * height * 4);
+	ParallelFor(height, RowsPerTask(width), [&](size_t begin, size_t end)
+	{
+		for (size_t y = begin; y < end; y++)
+		{
+			DecodeResampleRow(sourcePixels + y * rowPitch, width, format, srgb, &current[y * width * 4], premultiply);
+			if (!copyLevel0)
+			{
+				EncodeResampleRow(&current[y * width * 4], width, format, srgb, chain.Pixels.data() + y * chain.Levels[0].RowPitch);
+			}
+		}
+	});
+
+	vector<float> next;
+	for (uint32_t level = 1; level < levelCount; level++)
+	{
+		const MipLevel& source = chain.Levels[level - 1];
+		const MipLevel& destination = chain.Levels[level];
+		next.resize(static_cast<size_t>(destination.Width) * destination.Height * 4);
+		ResampleLinearImage(current.data(), source.Width, source.Height, next.data(), destination.Width, destination.Height, filter);
+
+		// Store the new level in the chain, and keep it as floats for making the next one
+		uint8_t* destinationPixels = chain.Pixels.data() + destination.Offset;
+		ParallelFor(destination.Height, RowsPerTask(destination.Width), [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; y++)
+			{
+				EncodeResampleRow(&next[y * destination.Width * 4], destination.Width, format, srgb, destinationPixels + y * destination.RowPitch, unpremultiply);
+			}
+		});
+		current.swap(next);
+	}
+	return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "ImageResampler.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// CPU mipmap generation, used when textures are loaded and by the offline tools.
+//
+// Each level is made from the level above it with the separable resampler (see ImageResampler.h), so sizes
+// that are not a power of two are handled exactly and edges are clamped.  Each level is kept as linear
+// floats for making the next one, so 8-bit images are only rounded once per level; levels depend on the
+// level above, so they are made one after another.
+//
+// The colour channels of 8-bit images are normally sRGB encoded, so they are converted to linear light
+// before filtering and back afterwards.  Averaging the encoded values would make the smaller levels darker
+// than they should be.  Alpha is always linear, as are the 16-bit and 32-bit float formats.  Images with
+// straight alpha can be filtered premultiplied (see ResampleAlpha), which stops the colour of transparent
+// pixels showing round the edges of what is left in the smaller levels.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+// Roughly how many pixels each thread works on at a time
+#define MipPixelsPerTask		16384
+
+// The pixel formats and filters are the resampler's.  The box filter is fast but soft; the others keep more
+// detail in the smaller levels at the cost of a wider filter.
+typedef ResampleFormat			MipFormat;
+typedef ResampleFilter			MipFilter;
+typedef ResampleAlpha			MipAlpha;
+
+struct MipLevel
+{
+	uint32_t				Width;
+	uint32_t				Height;
+	std::size_t				RowPitch;
+	// Where the level starts in the chain's pixels
+	std::size_t				Offset;
+};
+
+// The levels of a chain are stored one after another with their rows tightly packed
+struct MipChain
+{
+	MipFormat				Format;
+	std::vector<MipLevel>	Levels;
+	std::vector<uint8_t>	Pixels;
+
+	inline const uint8_t*	GetLevelPixels(std::size_t level) const { return Pixels.data() + Levels[level].Offset; }
+};
+
+// Number of levels in a full chain (down to 1x1)
+uint32_t		CountMipLevels(uint32_t width, uint32_t height);
+std::size_t		GetMipPixelSize(MipFormat format);
+
+// Make a mip chain from an image.  Level 0 is a copy of the image.  levelCount is the number of levels to
+// make, or 0 for a full chain.  srgb says whether the colour channels of an RGBA8 image are sRGB encoded.
+// With MipAlpha::Premultiply, level 0 is premultiplied too.  Returns false if the image is empty.
+bool			GenerateMipChain(const void* pixels, uint32_t width, uint32_t height, std::size_t rowPitch,
+								 MipFormat format, bool srgb, MipFilter filter, MipChain& chain, uint32_t levelCount = 0,
+								 MipAlpha alpha = MipAlpha::Separate);
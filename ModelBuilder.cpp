@@ -0,0 +1,438 @@
+#include "ModelBuilder.h"
+#include "MeshProcessing.h"
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <set>
+
+using namespace std;
+
+namespace
+{
+	// A mesh from a model file, together with the transformation into the space of the node that draws it
+	struct MeshInstance
+	{
+		const aiMesh*			SourceMesh;
+		aiMatrix4x4				Transformation;
+	};
+
+	// Assimp matrices are used with column vectors, so they are transposed to store them for row vectors
+	void StoreTransformation(const aiMatrix4x4& m, float* transformation)
+	{
+		for (unsigned int row = 0; row < 4; row++)
+		{
+			for (unsigned int column = 0; column < 4; column++)
+			{
+				transformation[row * 4 + column] = m[column][row];
+			}
+		}
+	}
+
+	// Walk the node hierarchy.  The root node and animated nodes are kept.  Every other node is merged into its
+	// nearest kept ancestor: its meshes are added to the ancestor's list of meshes along with the transformation
+	// from the node to the ancestor.  toKeptNode is the transformation from the space of the parent of node to
+	// the space of keptNode.
+	void CollectMeshNodes(const aiScene* scene, const aiNode* node, const aiMatrix4x4& toKeptNode, int keptNode, const set<string>& animatedNodes,
+						  vector<CookedNode>& nodes, vector<vector<MeshInstance>>& nodeInstances)
+	{
+		aiMatrix4x4 toNode = toKeptNode * node->mTransformation;
+		int nodeIndex = keptNode;
+		if (keptNode < 0 || animatedNodes.find(node->mName.C_Str()) != animatedNodes.end())
+		{
+			CookedNode cookedNode;
+			cookedNode.Name = node->mName.C_Str();
+			StoreTransformation(toNode, cookedNode.LocalTransformation);
+			cookedNode.Parent = keptNode;
+			nodeIndex = static_cast<int>(nodes.size());
+			nodes.push_back(cookedNode);
+			nodeInstances.emplace_back();
+			toNode = aiMatrix4x4();
+		}
+		for (unsigned int i = 0; i < node->mNumMeshes; i++)
+		{
+			nodeInstances[nodeIndex].push_back({ scene->mMeshes[node->mMeshes[i]], toNode });
+		}
+		for (unsigned int i = 0; i < node->mNumChildren; i++)
+		{
+			CollectMeshNodes(scene, node->mChildren[i], toNode, nodeIndex, animatedNodes, nodes, nodeInstances);
+		}
+	}
+
+	// Handle negative texture coordinates by wrapping them to positive.  This should ideally be handled in
+	// the shader.  Note we are assuming that negative coordinates here are no smaller than -1.0 - this may
+	// not be a valid assumption.
+	inline float WrapTexCoord(float texCoord)
+	{
+		return texCoord < 0 ? texCoord + 1.0f : texCoord;
+	}
+
+	// Copy the vertices and indices of a mesh onto the end of the model's vertices and indices, transforming
+	// them into the space of the node that draws them.  Indices are relative to baseVertex, the first vertex of
+	// the sub-mesh that the mesh is being merged into.  The positions are added to the sub-mesh's bounds as they
+	// are copied.  Returns false if the mesh is not made of triangles.
+	bool AppendMeshInstance(const MeshInstance& instance, uint32_t baseVertex, CookedModel& model, BoundsAccumulator& bounds)
+	{
+		const aiMesh* subMesh = instance.SourceMesh;
+		unsigned int numVertices = subMesh->mNumVertices;
+		bool hasNormals = subMesh->HasNormals();
+		bool hasTexCoords = subMesh->HasTextureCoords(0);
+		unsigned int numberOfFaces = subMesh->mNumFaces;
+		if (numVertices == 0 || numberOfFaces == 0)
+		{
+			return true;
+		}
+		if (subMesh->mFaces[0].mNumIndices != 3)
+		{
+			// We are not dealing with triangles, so we cannot handle it
+			return false;
+		}
+
+		// Normals are transformed by the inverse transpose so that they stay perpendicular to the surface when
+		// there is non-uniform scaling.  A transformation that mirrors the mesh also reverses the winding order
+		// of its triangles, so this has to be put back.
+		bool transformed = !instance.Transformation.IsIdentity();
+		aiMatrix3x3 normalTransformation(instance.Transformation);
+		if (transformed)
+		{
+			normalTransformation.Inverse().Transpose();
+		}
+		bool mirrored = instance.Transformation.Determinant() < 0.0f;
+
+		// We only handle one set of UV coordinates at the moment
+		uint32_t firstVertex = static_cast<uint32_t>(model.Vertices.size());
+		model.Vertices.resize(firstVertex + numVertices);
+		CookedVertex* modelVertices = &model.Vertices[firstVertex];
+		for (unsigned int i = 0; i < numVertices; i++)
+		{
+			CookedVertex& vertex = modelVertices[i];
+			aiVector3D position = subMesh->mVertices[i];
+			aiVector3D normal = hasNormals ? subMesh->mNormals[i] : aiVector3D(0.0f, 0.0f, 0.0f);
+			if (transformed)
+			{
+				position = instance.Transformation * position;
+				if (hasNormals)
+				{
+					normal = (normalTransformation * normal).Normalize();
+				}
+			}
+			vertex.Position[0] = position.x;
+			vertex.Position[1] = position.y;
+			vertex.Position[2] = position.z;
+			bounds.Add(vertex.Position);
+			vertex.Normal[0] = normal.x;
+			vertex.Normal[1] = normal.y;
+			vertex.Normal[2] = normal.z;
+			if (hasTexCoords)
+			{
+				vertex.TexCoord[0] = WrapTexCoord(subMesh->mTextureCoords[0][i].x);
+				vertex.TexCoord[1] = WrapTexCoord(subMesh->mTextureCoords[0][i].y);
+			}
+			else
+			{
+				// If the model does not have texture coordinates, set them to 0
+				vertex.TexCoord[0] = 0.0f;
+				vertex.TexCoord[1] = 0.0f;
+			}
+		}
+
+		// Now extract the indices.  These start off relative to the first vertex of this mesh so that normals
+		// can be generated if needed.
+		unsigned int numberOfIndices = numberOfFaces * 3;
+		uint32_t startIndex = static_cast<uint32_t>(model.Indices.size());
+		model.Indices.resize(startIndex + numberOfIndices);
+		uint32_t* currentIndex = &model.Indices[startIndex];
+		for (unsigned int i = 0; i < numberOfFaces; i++)
+		{
+			const aiFace& face = subMesh->mFaces[i];
+			*currentIndex++ = face.mIndices[0];
+			*currentIndex++ = face.mIndices[mirrored ? 2 : 1];
+			*currentIndex++ = face.mIndices[mirrored ? 1 : 2];
+		}
+		if (!hasNormals)
+		{
+			// The model did not provide normals, so generate them from the triangles
+			ComputeVertexNormals(modelVertices, numVertices, &model.Indices[startIndex], numberOfIndices);
+		}
+		// Make the indices relative to the first vertex of the sub-mesh since the base vertex is passed to DrawIndexed
+		uint32_t indexOffset = firstVertex - baseVertex;
+		if (indexOffset != 0)
+		{
+			for (unsigned int i = startIndex; i < startIndex + numberOfIndices; i++)
+			{
+				model.Indices[i] += indexOffset;
+			}
+		}
+		return true;
+	}
+
+	// Build the level of detail chain for a sub-mesh.  Each level is simplified from the one before it and
+	// uses the same vertices as the full detail mesh, so it just needs its own range of indices, which are
+	// added to the end of the model's indices.
+	void BuildLodLevels(CookedSubMesh& subMesh, CookedModel& model)
+	{
+		MeshSimplifier simplifier(model.Vertices[subMesh.BaseVertex].Position, sizeof(CookedVertex), subMesh.VertexCount);
+		float maxError = simplifier.GetExtent() * LodMaxErrorFraction;
+		const CookedLodLevel& fullDetail = subMesh.LodLevels[0];
+		vector<unsigned int> lodIndices(model.Indices.begin() + fullDetail.StartIndex,
+										model.Indices.begin() + fullDetail.StartIndex + fullDetail.IndexCount);
+		float lodError = 0.0f;
+		for (unsigned int lod = 1; lod < MaxLodLevels; lod++)
+		{
+			unsigned int targetIndexCount = static_cast<unsigned int>(lodIndices.size() / 3 * LodReductionRatio) * 3;
+			auto simplify = [&](bool lockBorders, float& error)
+			{
+				vector<unsigned int> simplifiedIndices = simplifier.Simplify(lodIndices, targetIndexCount, maxError - lodError, &error, lockBorders);
+				if (simplifiedIndices.size() < 3 ||
+					simplifiedIndices.size() > lodIndices.size() * (1.0f - LodMinimumReduction))
+				{
+					simplifiedIndices.clear();
+				}
+				return simplifiedIndices;
+			};
+			float error = 0.0f;
+			vector<unsigned int> simplifiedIndices = simplify(true, error);
+			if (simplifiedIndices.empty() && lod < MinLodLevels)
+			{
+				// Flat or open meshes are mostly border, so letting the border move is often all they need
+				simplifiedIndices = simplify(false, error);
+			}
+			if (simplifiedIndices.empty())
+			{
+				// Simplification has run out of things it can do within the error limit
+				break;
+			}
+			lodIndices.swap(simplifiedIndices);
+			// The error of each level is relative to the previous level, so accumulate it to get an upper bound
+			// on the error relative to the full detail mesh.
+			lodError += error;
+
+			uint32_t startIndex = static_cast<uint32_t>(model.Indices.size());
+			model.Indices.insert(model.Indices.end(), lodIndices.begin(), lodIndices.end());
+			subMesh.LodLevels.push_back({ startIndex, static_cast<uint32_t>(lodIndices.size()), lodError });
+		}
+	}
+}
+
+bool BuildCookedModel(const aiScene* scene, const string& modelName, const string& importProfile, CookedModel& model)
+{
+	model = CookedModel();
+	model.ImportProfile = importProfile;
+	if (!scene || !scene->HasMeshes())
+	{
+		// If there are no meshes, then there is nothing to do
+		return false;
+	}
+	model.Materials.resize(scene->mNumMaterials);
+	for (unsigned int i = 0; i < scene->mNumMaterials; i++)
+	{
+		// Get the core material properties.  Ideally, we would be looking for more information
+		// e.g. emissive colour, etc.  This is a task for later.
+		const aiMaterial* material = scene->mMaterials[i];
+		aiColor3D diffuseColour(0.0f, 0.0f, 0.0f);
+		material->Get(AI_MATKEY_COLOR_DIFFUSE, diffuseColour);
+		aiColor3D specularColour(0.0f, 0.0f, 0.0f);
+		material->Get(AI_MATKEY_COLOR_SPECULAR, specularColour);
+		float shininess = 0.0f;
+		material->Get(AI_MATKEY_SHININESS, shininess);
+		float opacity = 1.0f;
+		material->Get(AI_MATKEY_OPACITY, opacity);
+
+		CookedMaterial& cookedMaterial = model.Materials[i];
+		cookedMaterial.DiffuseColour[0] = diffuseColour.r;
+		cookedMaterial.DiffuseColour[1] = diffuseColour.g;
+		cookedMaterial.DiffuseColour[2] = diffuseColour.b;
+		cookedMaterial.DiffuseColour[3] = 1.0f;
+		cookedMaterial.SpecularColour[0] = specularColour.r;
+		cookedMaterial.SpecularColour[1] = specularColour.g;
+		cookedMaterial.SpecularColour[2] = specularColour.b;
+		cookedMaterial.SpecularColour[3] = 1.0f;
+		cookedMaterial.Shininess = shininess;
+		cookedMaterial.Opacity = opacity;
+		if (material->GetTextureCount(aiTextureType_DIFFUSE) > 0)
+		{
+			aiString textureName;
+			if (material->GetTexture(aiTextureType_DIFFUSE, 0, &textureName) == AI_SUCCESS)
+			{
+				// This assumes that textures are in the same folder as the model files
+				cookedMaterial.TextureName.assign(textureName.data, textureName.length);
+			}
+		}
+	}
+
+	// Find the nodes that are animated.  These have to stay as separate nodes so that they can move.
+	set<string> animatedNodes;
+	for (unsigned int a = 0; a < scene->mNumAnimations; a++)
+	{
+		const aiAnimation* animation = scene->mAnimations[a];
+		for (unsigned int c = 0; c < animation->mNumChannels; c++)
+		{
+			animatedNodes.insert(animation->mChannels[c]->mNodeName.C_Str());
+		}
+	}
+
+	// Walk the node hierarchy.  Static nodes are merged into their nearest kept ancestor, so we end up with
+	// the list of meshes that each kept node has to draw (transformed into the space of that node).
+	vector<vector<MeshInstance>> nodeInstances;
+	if (scene->mRootNode)
+	{
+		CollectMeshNodes(scene, scene->mRootNode, aiMatrix4x4(), -1, animatedNodes, model.Nodes, nodeInstances);
+	}
+	else
+	{
+		// No hierarchy, so just draw every mesh as it is
+		CookedNode rootNode;
+		rootNode.Name = modelName;
+		StoreTransformation(aiMatrix4x4(), rootNode.LocalTransformation);
+		rootNode.Parent = -1;
+		model.Nodes.push_back(rootNode);
+		nodeInstances.emplace_back();
+		for (unsigned int m = 0; m < scene->mNumMeshes; m++)
+		{
+			nodeInstances[0].push_back({ scene->mMeshes[m], aiMatrix4x4() });
+		}
+	}
+
+	// The geometry for all of the sub-meshes (including their levels of detail) is packed into one set of
+	// vertices and indices.  Each sub-mesh just records where its data starts.  All of the meshes drawn by a
+	// node that share a material are merged into a single sub-mesh, so they only need one draw.
+	for (size_t n = 0; n < model.Nodes.size(); n++)
+	{
+		const vector<MeshInstance>& instances = nodeInstances[n];
+		vector<bool> merged(instances.size(), false);
+		for (size_t first = 0; first < instances.size(); first++)
+		{
+			if (merged[first])
+			{
+				continue;
+			}
+			unsigned int materialIndex = instances[first].SourceMesh->mMaterialIndex;
+			bool hasTexCoords = instances[first].SourceMesh->HasTextureCoords(0);
+			uint32_t baseVertex = static_cast<uint32_t>(model.Vertices.size());
+			uint32_t startIndex = static_cast<uint32_t>(model.Indices.size());
+			BoundsAccumulator bounds;
+			for (size_t i = first; i < instances.size(); i++)
+			{
+				// Meshes without texture coordinates are kept apart from those with them since they are drawn
+				// with a different shader
+				if (merged[i] ||
+					instances[i].SourceMesh->mMaterialIndex != materialIndex ||
+					instances[i].SourceMesh->HasTextureCoords(0) != hasTexCoords)
+				{
+					continue;
+				}
+				merged[i] = true;
+				if (!AppendMeshInstance(instances[i], baseVertex, model, bounds))
+				{
+					return false;
+				}
+			}
+			CookedSubMesh subMesh;
+			subMesh.BaseVertex = baseVertex;
+			subMesh.VertexCount = static_cast<uint32_t>(model.Vertices.size()) - baseVertex;
+			subMesh.Material = materialIndex < scene->mNumMaterials ? static_cast<int32_t>(materialIndex) : -1;
+			subMesh.HasTexCoords = hasTexCoords ? 1 : 0;
+			subMesh.LodLevels.push_back({ startIndex, static_cast<uint32_t>(model.Indices.size()) - startIndex, 0.0f });
+			if (subMesh.VertexCount == 0)
+			{
+				// The meshes were empty
+				continue;
+			}
+			// The bounding sphere is centred on the bounding box
+			bounds.GetBox(subMesh.BoxMinimum, subMesh.BoxMaximum);
+			float centre[3];
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				centre[axis] = (subMesh.BoxMinimum[axis] + subMesh.BoxMaximum[axis]) * 0.5f;
+			}
+			subMesh.SphereRadius = ComputeBoundingRadius(&model.Vertices[baseVertex], subMesh.VertexCount, centre);
+			BuildLodLevels(subMesh, model);
+			model.Nodes[n].SubMeshes.push_back(static_cast<uint32_t>(model.SubMeshes.size()));
+			model.SubMeshes.push_back(subMesh);
+		}
+	}
+	// Fail if none of the nodes draw anything
+	return !model.Vertices.empty();
+}
+
+void MergeSubMeshes(CookedModel& model, const vector<int>& keys, vector<uint32_t>& mergedInto)
+{
+	vector<CookedSubMesh> subMeshes;
+	vector<uint32_t> indices;
+	indices.reserve(model.Indices.size());
+	mergedInto.assign(model.SubMeshes.size(), 0);
+	vector<bool> merged(model.SubMeshes.size(), false);
+	for (CookedNode& node : model.Nodes)
+	{
+		vector<uint32_t> nodeSubMeshes;
+		for (size_t first = 0; first < node.SubMeshes.size(); first++)
+		{
+			uint32_t s = node.SubMeshes[first];
+			if (merged[s])
+			{
+				continue;
+			}
+			// Find the sub-meshes of the node that are merged with this one
+			vector<const CookedSubMesh*> parts;
+			for (size_t i = first; i < node.SubMeshes.size(); i++)
+			{
+				uint32_t other = node.SubMeshes[i];
+				if (other == s || (keys[s] >= 0 && !merged[other] && keys[other] == keys[s]))
+				{
+					merged[other] = true;
+					mergedInto[other] = static_cast<uint32_t>(subMeshes.size());
+					parts.push_back(&model.SubMeshes[other]);
+				}
+			}
+
+			// The vertices stay where they are, so the merged sub-mesh covers the vertices of all of its parts
+			CookedSubMesh subMesh = *parts[0];
+			uint32_t endVertex = subMesh.BaseVertex + subMesh.VertexCount;
+			size_t lodCount = 0;
+			BoundsAccumulator bounds;
+			for (const CookedSubMesh* part : parts)
+			{
+				subMesh.BaseVertex = (min)(subMesh.BaseVertex, part->BaseVertex);
+				endVertex = (max)(endVertex, part->BaseVertex + part->VertexCount);
+				lodCount = (max)(lodCount, part->LodLevels.size());
+				bounds.Add(part->BoxMinimum);
+				bounds.Add(part->BoxMaximum);
+			}
+			subMesh.VertexCount = endVertex - subMesh.BaseVertex;
+			bounds.GetBox(subMesh.BoxMinimum, subMesh.BoxMaximum);
+			float centre[3];
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				centre[axis] = (subMesh.BoxMinimum[axis] + subMesh.BoxMaximum[axis]) * 0.5f;
+			}
+			subMesh.SphereRadius = 0.0f;
+			for (const CookedSubMesh* part : parts)
+			{
+				subMesh.SphereRadius = (max)(subMesh.SphereRadius, ComputeBoundingRadius(&model.Vertices[part->BaseVertex], part->VertexCount, centre));
+			}
+
+			// Each level of the merged sub-mesh is the same level of each of its parts.  A part with fewer
+			// levels uses its last one, which is as simple as it can be made.
+			subMesh.LodLevels.clear();
+			for (size_t lod = 0; lod < lodCount; lod++)
+			{
+				CookedLodLevel level{ static_cast<uint32_t>(indices.size()), 0, 0.0f };
+				for (const CookedSubMesh* part : parts)
+				{
+					const CookedLodLevel& partLevel = part->LodLevels[(min)(lod, part->LodLevels.size() - 1)];
+					uint32_t offset = part->BaseVertex - subMesh.BaseVertex;
+					for (uint32_t i = partLevel.StartIndex; i < partLevel.StartIndex + partLevel.IndexCount; i++)
+					{
+						indices.push_back(model.Indices[i] + offset);
+					}
+					level.Error = (max)(level.Error, partLevel.Error);
+				}
+				level.IndexCount = static_cast<uint32_t>(indices.size()) - level.StartIndex;
+				subMesh.LodLevels.push_back(level);
+			}
+			nodeSubMeshes.push_back(static_cast<uint32_t>(subMeshes.size()));
+			subMeshes.push_back(move(subMesh));
+		}
+		node.SubMeshes = move(nodeSubMeshes);
+	}
+	model.SubMeshes = move(subMeshes);
+	model.Indices = move(indices);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "CookedModel.h"
+#include "ModelImporter.h"
+
+// Builds the geometry the renderer draws from an imported Assimp scene.  This is the import path shared by
+// the ResourceManager (when there is no cooked model) and the asset cooker.
+//
+// The node hierarchy is walked and only the root node and animated nodes are kept.  Every other node is
+// merged into its nearest kept ancestor, and all of the meshes drawn by a kept node that share a material
+// are merged into a single sub-mesh, transformed into the space of that node, so they only need one draw.
+// Missing normals are generated, the bounds of each sub-mesh are found and a level of detail chain is
+// built for each sub-mesh using MeshSimplifier.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+// Each level of detail aims to have this fraction of the triangles in the previous level
+#define LodReductionRatio		0.5f
+// Stop building levels of detail when a level would remove less than this fraction of the triangles in the previous level
+#define LodMinimumReduction		0.1f
+// Largest error that simplification is allowed to introduce, as a fraction of the size of the sub-mesh
+#define LodMaxErrorFraction		0.05f
+// Maximum number of levels of detail (including the full detail mesh) built for each sub-mesh
+#define MaxLodLevels			5
+// Levels below this count are simplified again without border locking (see MeshSimplifier.h) if the error
+// limit stops them being built with it.  A sub-mesh that still cannot be simplified has fewer levels.
+#define MinLodLevels			3
+
+// modelName is used to name the root node if the scene has no hierarchy.  Returns false if the scene has
+// nothing to draw or has meshes that are not made of triangles.
+bool	BuildCookedModel(const aiScene* scene, const std::string& modelName, const std::string& importProfile, CookedModel& model);
+
+// Merge the sub-meshes of each node that have the same key (e.g. sub-meshes whose materials share a texture
+// atlas) into one, so they only need one draw.  Sub-meshes with a key of -1 are left alone.  The merged
+// sub-mesh takes the place of the first of them and keeps its material, and the indices are rebuilt without
+// the ones that are no longer used.  mergedInto is set to the sub-mesh that each of the original sub-meshes
+// is now drawn as part of.
+void	MergeSubMeshes(CookedModel& model, const std::vector<int>& keys, std::vector<uint32_t>& mergedInto);
@@ -0,0 +1,248 @@
+#include "ModelImporter.h"
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/MemoryIOWrapper.h>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace Assimp;
+
+namespace
+{
+	// Steps that every profile needs.  The renderer only draws triangles and uses a left-handed
+	// coordinate system.
+	const unsigned int RequiredSteps = aiProcess_Triangulate |
+									   aiProcess_ConvertToLeftHanded;
+
+	const ImportProfile ImportProfiles[] =
+	{
+		{ FastLoadProfile, RequiredSteps },
+		{ RenderOptimalProfile, RequiredSteps |
+								aiProcess_JoinIdenticalVertices |
+								aiProcess_ImproveCacheLocality |
+								aiProcess_OptimizeMeshes |
+								aiProcess_OptimizeGraph |
+								aiProcess_SortByPType }
+	};
+
+	Importer& GetThreadImporter()
+	{
+		thread_local unique_ptr<Importer> importer;
+		if (!importer)
+		{
+			importer = make_unique<Importer>();
+			// SortByPType splits off any points and lines left after triangulation.  We cannot draw
+			// them, so drop them altogether.
+			importer->SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_POINT | aiPrimitiveType_LINE);
+			// Match the vertex cache size that ACMR is reported against
+			importer->SetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE, AcmrCacheSize);
+		}
+		return *importer;
+	}
+
+	// IO system that gives Assimp the files in an asset archive.  Files stored uncompressed are read from
+	// the archive's memory without being copied, and compressed files are decompressed into a buffer owned
+	// by the stream.  Anything that is not in the archive is read from the file system.
+	class ArchiveIOSystem : public IOSystem
+	{
+	public:
+		ArchiveIOSystem(const AssetArchive& archive) : _archive(archive)
+		{
+		}
+
+		bool Exists(const char* fileName) const override
+		{
+			return _archive.Contains(fileName) || _fileSystem.Exists(fileName);
+		}
+
+		char getOsSeparator() const override
+		{
+			return '/';
+		}
+
+		IOStream* Open(const char* fileName, const char* mode) override
+		{
+			const uint8_t* data;
+			size_t size;
+			if (strchr(mode, 'w') == nullptr)
+			{
+				if (_archive.Find(fileName, data, size))
+				{
+					return new MemoryIOStream(data, size);
+				}
+				if (_archive.GetAssetSize(fileName, size))
+				{
+					unique_ptr<uint8_t[]> contents(new uint8_t[size]);
+					if (!_archive.Read(fileName, contents.get(), size))
+					{
+						return nullptr;
+					}
+					return new MemoryIOStream(contents.release(), size, true);
+				}
+			}
+			return _fileSystem.Open(fileName, mode);
+		}
+
+		void Close(IOStream* file) override
+		{
+			delete file;
+		}
+
+		bool ComparePaths(const char* first, const char* second) const override
+		{
+			return AssetArchive::NormaliseName(first) == AssetArchive::NormaliseName(second);
+		}
+
+	private:
+		const AssetArchive&		_archive;
+		DefaultIOSystem			_fileSystem;
+	};
+
+	// Count one draw for every mesh referenced by each node in the hierarchy
+	unsigned int CountDraws(const aiNode* node)
+	{
+		unsigned int drawCount = node->mNumMeshes;
+		for (unsigned int i = 0; i < node->mNumChildren; i++)
+		{
+			drawCount += CountDraws(node->mChildren[i]);
+		}
+		return drawCount;
+	}
+}
+
+const ImportProfile* FindImportProfile(const string& profileName)
+{
+	for (const ImportProfile& profile : ImportProfiles)
+	{
+		if (profileName == profile.Name)
+		{
+			return &profile;
+		}
+	}
+	return nullptr;
+}
+
+const ImportProfile* GetImportProfiles(size_t& profileCount)
+{
+	profileCount = sizeof(ImportProfiles) / sizeof(ImportProfiles[0]);
+	return ImportProfiles;
+}
+
+const aiScene* ImportScene(const string& fileName, const ImportProfile& profile, const AssetArchive* archive)
+{
+	return ImportScene(fileName, profile, archive && archive->IsOpen() ? new ArchiveIOSystem(*archive) : nullptr);
+}
+
+const aiScene* ImportScene(const string& fileName, const ImportProfile& profile, IOSystem* ioSystem)
+{
+	Importer& importer = GetThreadImporter();
+	// The importer owns its IO system and deletes the previous one when it is replaced.  Passing nullptr
+	// goes back to reading from the file system.
+	importer.SetIOHandler(ioSystem);
+	return importer.ReadFile(fileName.c_str(), profile.PostProcessSteps);
+}
+
+void ReleaseImportedScene()
+{
+	GetThreadImporter().FreeScene();
+}
+
+float ComputeAcmr(const unsigned int* indices, size_t indexCount, unsigned int cacheSize)
+{
+	if (indexCount < 3 || cacheSize == 0)
+	{
+		return 0.0f;
+	}
+	// Simulate a FIFO cache.  cacheTime records when each vertex entered the cache, so a vertex is
+	// in the cache if fewer than cacheSize misses have happened since then.
+	unsigned int maximumIndex = 0;
+	for (size_t i = 0; i < indexCount; i++)
+	{
+		if (indices[i] > maximumIndex)
+		{
+			maximumIndex = indices[i];
+		}
+	}
+	vector<size_t> cacheTime(static_cast<size_t>(maximumIndex) + 1, 0);
+	size_t misses = 0;
+	for (size_t i = 0; i < indexCount; i++)
+	{
+		size_t& entered = cacheTime[indices[i]];
+		if (entered == 0 || misses + 1 - entered > cacheSize)
+		{
+			misses++;
+			entered = misses;
+		}
+	}
+	return static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+}
+
+bool MeasureImport(const string& fileName, const ImportProfile& profile, ImportStatistics& statistics)
+{
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+	const aiScene* scene = ImportScene(fileName, profile);
+	chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
+	if (!scene)
+	{
+		return false;
+	}
+	statistics.ImportMilliseconds = chrono::duration<double, milli>(end - start).count();
+	statistics.DrawCount = scene->mRootNode ? CountDraws(scene->mRootNode) : scene->mNumMeshes;
+	statistics.VertexCount = 0;
+	statistics.TriangleCount = 0;
+
+	// ACMR is calculated for each mesh and weighted by the number of triangles in the mesh
+	double weightedAcmr = 0.0;
+	vector<unsigned int> indices;
+	for (unsigned int m = 0; m < scene->mNumMeshes; m++)
+	{
+		const aiMesh* mesh = scene->mMeshes[m];
+		indices.clear();
+		for (unsigned int f = 0; f < mesh->mNumFaces; f++)
+		{
+			const aiFace& face = mesh->mFaces[f];
+			if (face.mNumIndices == 3)
+			{
+				indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+			}
+		}
+		unsigned int triangleCount = static_cast<unsigned int>(indices.size() / 3);
+		statistics.VertexCount += mesh->mNumVertices;
+		statistics.TriangleCount += triangleCount;
+		weightedAcmr += ComputeAcmr(indices.data(), indices.size(), AcmrCacheSize) * triangleCount;
+	}
+	statistics.Acmr = statistics.TriangleCount > 0 ? static_cast<float>(weightedAcmr / statistics.TriangleCount) : 0.0f;
+	ReleaseImportedScene();
+	return true;
+}
+
+void ReportImportBenchmark(const string& fileName, ostream& report)
+{
+	report << "Import benchmark: " << fileName << "\n";
+	report << left << setw(16) << "Profile"
+		   << right << setw(12) << "Import ms"
+		   << setw(8) << "Draws"
+		   << setw(12) << "Vertices"
+		   << setw(12) << "Triangles"
+		   << setw(8) << "ACMR" << "\n";
+	size_t profileCount;
+	const ImportProfile* profiles = GetImportProfiles(profileCount);
+	for (size_t i = 0; i < profileCount; i++)
+	{
+		ImportStatistics statistics;
+		report << left << setw(16) << profiles[i].Name << right;
+		if (!MeasureImport(fileName, profiles[i], statistics))
+		{
+			report << "  failed to load\n";
+			continue;
+		}
+		report << fixed << setprecision(2) << setw(12) << statistics.ImportMilliseconds
+			   << setw(8) << statistics.DrawCount
+			   << setw(12) << statistics.VertexCount
+			   << setw(12) << statistics.TriangleCount
+			   << setprecision(3) << setw(8) << statistics.Acmr << "\n";
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <assimp/Importer.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include "AssetArchive.h"
+
+// Assimp import profiles and the importers used to load models.
+//
+// A profile is a named set of Assimp post-processing steps.  "fast-load" does the minimum needed
+// to get a model on screen.  "render-optimal" takes longer to load but welds duplicate vertices,
+// reorders triangles for the post-transform vertex cache and merges meshes and nodes to reduce the
+// number of draw calls.  Each loader thread keeps its own Assimp importer, which is reused for every
+// model it loads rather than creating a new importer for each model.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+#define FastLoadProfile			"fast-load"
+#define RenderOptimalProfile	"render-optimal"
+#define DefaultImportProfile	FastLoadProfile
+
+// Size of the FIFO vertex cache used when calculating ACMR
+#define AcmrCacheSize			16
+
+struct ImportProfile
+{
+	const char*		Name;
+	unsigned int	PostProcessSteps;
+};
+
+// Returns nullptr if there is no profile with the given name
+const ImportProfile*	FindImportProfile(const std::string& profileName);
+const ImportProfile*	GetImportProfiles(std::size_t& profileCount);
+
+// Import a model using the importer that belongs to the calling thread.  The scene is owned by
+// that importer and remains valid until the next call to ImportScene or ReleaseImportedScene on
+// the same thread.  Returns nullptr if the model could not be loaded.
+//
+// If an archive is given, files are read from the archive when it contains them (straight from its
+// memory mapping) and from the file system otherwise.
+const aiScene*			ImportScene(const std::string& fileName, const ImportProfile& profile, const AssetArchive* archive = nullptr);
+// Import a model reading files through the given IO system, which the importer takes ownership of
+const aiScene*			ImportScene(const std::string& fileName, const ImportProfile& profile, Assimp::IOSystem* ioSystem);
+void					ReleaseImportedScene();
+
+struct ImportStatistics
+{
+	double			ImportMilliseconds;
+	// Number of draw calls needed to render the scene (one per mesh referenced by each node)
+	unsigned int	DrawCount;
+	unsigned int	VertexCount;
+	unsigned int	TriangleCount;
+	// Average cache miss ratio - the number of vertices transformed per triangle
+	float			Acmr;
+};
+
+// ACMR of a triangle list using a FIFO cache of cacheSize vertices
+float					ComputeAcmr(const unsigned int* indices, std::size_t indexCount, unsigned int cacheSize);
+
+// Import a model with a profile and measure the result.  Returns false if the model could not be loaded.
+bool					MeasureImport(const std::string& fileName, const ImportProfile& profile, ImportStatistics& statistics);
+
+// Import a model with every profile and write a table of the results to report
+void					ReportImportBenchmark(const std::string& fileName, std::ostream& report);
@@ -1,192 +1,370 @@
-#include "ModelNode.h"
-#include "DirectXFramework.h"
-
-bool ModelNode::Initialise()
-{
-	//Gathering key variables from framework
-	DirectXFramework* _DXFramework = DirectXFramework::GetDXFramework();
-	_device = _DXFramework->GetDevice();
-	_deviceContext = _DXFramework->GetDeviceContext();
-	_viewTransformation = _DXFramework->GetViewTransformation();
-	_projectionTransformation = _DXFramework->GetProjectionTransformation();
-	_eyePosition = _DXFramework->GetEyePos();
-
-	//Getting resource manager and mesh for model.
-	_resourceManager = _DXFramework->GetResourceManager();
-	_mesh = _resourceManager->GetMesh(L"airplane.x");
-	
-	//Getting common cbuffer values
-	_directionalLightColour = _DXFramework->GetDirectionalLightColour();
-	_directionalLightVector = _DXFramework->GetDirectionalLightVector();
-	_specularColour = _DXFramework->GetSpecularColour();
-	_specularPower = _DXFramework->GetSpecularPower();
-
-	BuildShaders();
-	BuildRasteriserState();
-	BuildVertexLayout();
-	BuildConstantBuffer();
-
-	return true;
-}
-
-void ModelNode::Render()
-{
-	const float clearColour[] = { 0.0f, 0.0f, 0.0f, 1.0f };
-
-	// Calculate the world x view x projection transformation
-	Matrix completeTransformation = _cumulativeWorldTransformation * _viewTransformation * _projectionTransformation;
-
-	//These are the getters for the relevant variables in which we can load in for each submesh, this current mesh does not have good lighting 
-	// so I have added my own. This is to show you I can gather these values.
-	//_subMesh->GetMaterial()->GetDiffuseColour();
-	//_subMesh->GetMaterial()->GetShininess();
-	//_subMesh->GetMaterial()->GetSpecularColour();
-
-	CBuffer constantBuffer;
-	constantBuffer.WorldViewProjection = completeTransformation;
-	constantBuffer.World = _cumulativeWorldTransformation;
-	constantBuffer.AmbientLightColour = _ambientLightColour;
-	constantBuffer.DirectionalLightVector = _directionalLightVector;
-	constantBuffer.EyePosition = _eyePosition;
-	constantBuffer.DirectionalLightColour = _directionalLightColour;
-	constantBuffer.SpecularPower = _specularPower;
-	constantBuffer.SpecularColour = _specularColour;
-
-	_deviceContext->VSSetConstantBuffers(0, 1, _constantBuffer.GetAddressOf());
-	_deviceContext->PSSetConstantBuffers(0, 1, _constantBuffer.GetAddressOf());
-	_deviceContext->UpdateSubresource(_constantBuffer.Get(), 0, 0, &constantBuffer, 0, 0);
-
-	for (int i = 0; i < _mesh->GetSubMeshCount(); i++)
-	{
-		_subMesh = _mesh->GetSubMesh(i);
-
-		// Now render the cube
-		// Specify the distance between vertices and the starting point in the vertex buffer
-		UINT stride = sizeof(Vertex);
-		UINT offset = 0;
-
-		_deviceContext->IASetVertexBuffers(0, 1, _subMesh->GetVertexBuffer().GetAddressOf(), &stride, &offset);
-		_deviceContext->IASetIndexBuffer(_subMesh->GetIndexBuffer().Get(), DXGI_FORMAT_R32_UINT, 0);
-		_deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-		//// Specify the layout of the input vertices.  This must match the layout of the input vertices in the shader
-		_deviceContext->IASetInputLayout(_layout.Get());
-		_deviceContext->VSSetShader(_vertexShader.Get(), 0, 0);
-
-		//If has texture coordinates then apply texture and use texture pixel shader. otherwise use normal pixelshader.
-		if (_subMesh->HasTexCoords())
-		{
-			_deviceContext->PSSetShader(_texturePixelShader.Get(), 0, 0);
-			_texture = _subMesh->GetMaterial()->GetTexture();//Get texture from submesh.
-			_deviceContext->PSSetShaderResources(0, 1, _texture.GetAddressOf()); //apply texture to PS 
-		}
-		else
-		{
-			_deviceContext->PSSetShader(_pixelShader.Get(), 0, 0);
-		}
-
-		//Now draw the first cube
-		_deviceContext->DrawIndexed(_subMesh->GetIndexCount(), 0, 0);
-	}
-}
-
-void ModelNode::Shutdown()
-{
-	_resourceManager->ReleaseMesh(L"airplane.x");
-}
-
-void ModelNode::BuildShaders()
-{
-	DWORD shaderCompileFlags = 0;
-#if defined( _DEBUG )
-	shaderCompileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
-
-	ComPtr<ID3DBlob> compilationMessages = nullptr;
-
-	//Compile vertex shader
-	HRESULT hr = D3DCompileFromFile(textureShaderFileName,
-		nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE,
-		VertexShaderName, "vs_5_0",
-		shaderCompileFlags, 0,
-		_vertexShaderByteCode.GetAddressOf(),
-		compilationMessages.GetAddressOf());
-
-	if (compilationMessages.Get() != nullptr)
-	{
-		// If there were any compilation messages, display them
-		MessageBoxA(0, (char*)compilationMessages->GetBufferPointer(), 0, 0);
-	}
-	// Even if there are no compiler messages, check to make sure there were no other errors.
-	ThrowIfFailed(hr);
-	ThrowIfFailed(_device->CreateVertexShader(_vertexShaderByteCode->GetBufferPointer(), _vertexShaderByteCode->GetBufferSize(), NULL, _vertexShader.GetAddressOf()));
-
-	// Compile pixel shader
-	hr = D3DCompileFromFile(textureShaderFileName,
-		nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE,
-		PixelShaderName, "ps_5_0",
-		shaderCompileFlags, 0,
-		_pixelShaderByteCode.GetAddressOf(),
-		compilationMessages.GetAddressOf());
-
-	if (compilationMessages.Get() != nullptr)
-	{
-		// If there were any compilation messages, display them
-		MessageBoxA(0, (char*)compilationMessages->GetBufferPointer(), 0, 0);
-	}
-	ThrowIfFailed(hr);
-	ThrowIfFailed(_device->CreatePixelShader(_pixelShaderByteCode->GetBufferPointer(), _pixelShaderByteCode->GetBufferSize(), NULL, _pixelShader.GetAddressOf()));
-
-	// Compile pixel shader
-	hr = D3DCompileFromFile(textureShaderFileName,
-		nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE,
-		texturePixelShaderName, "ps_5_0",
-		shaderCompileFlags, 0,
-		_texturePixelShaderByteCode.GetAddressOf(),
-		compilationMessages.GetAddressOf());
-
-	if (compilationMessages.Get() != nullptr)
-	{
-		// If there were any compilation messages, display them
-		MessageBoxA(0, (char*)compilationMessages->GetBufferPointer(), 0, 0);
-	}
-	ThrowIfFailed(hr);
-	ThrowIfFailed(_device->CreatePixelShader(_texturePixelShaderByteCode->GetBufferPointer(), _texturePixelShaderByteCode->GetBufferSize(), NULL, _texturePixelShader.GetAddressOf()));
-}
-
-
-void ModelNode::BuildVertexLayout()
-{
-	// Create the vertex input layout. This tells DirectX the format
-	// of each of the vertices we are sending to it. The vertexDesc array is
-	// defined in Geometry.h
-
-	ThrowIfFailed(_device->CreateInputLayout(vertexDesc, ARRAYSIZE(vertexDesc), _vertexShaderByteCode->GetBufferPointer(), _vertexShaderByteCode->GetBufferSize(), _layout.GetAddressOf()));
-}
-
-void ModelNode::BuildConstantBuffer()
-{
-	D3D11_BUFFER_DESC bufferDesc;
-	ZeroMemory(&bufferDesc, sizeof(bufferDesc));
-	bufferDesc.Usage = D3D11_USAGE_DEFAULT;
-	bufferDesc.ByteWidth = sizeof(CBuffer);
-	bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-
-	ThrowIfFailed(_device->CreateBuffer(&bufferDesc, NULL, _constantBuffer.GetAddressOf()));
-}
-
-void ModelNode::BuildRasteriserState()
-{
-	D3D11_RASTERIZER_DESC rasteriserDesc{};
-	rasteriserDesc.CullMode = D3D11_CULL_BACK;
-	rasteriserDesc.FrontCounterClockwise = false;
-	rasteriserDesc.DepthBias = 0;
-	rasteriserDesc.SlopeScaledDepthBias = 0.0f;
-	rasteriserDesc.DepthBiasClamp = 0.0f;
-	rasteriserDesc.DepthClipEnable = true;
-	rasteriserDesc.ScissorEnable = false;
-	rasteriserDesc.MultisampleEnable = false;
-	rasteriserDesc.AntialiasedLineEnable = false;
-	rasteriserDesc.FillMode = D3D11_FILL_SOLID;
-	ThrowIfFailed(_device->CreateRasterizerState(&rasteriserDesc, _rasteriserState.GetAddressOf()));
+#include "ModelNode.h"
+#include "DirectXFramework.h"
+#include <cfloat>
+
+bool ModelNode::Initialise()
+{
+	//Gathering key variables from framework
+	DirectXFramework* _DXFramework = DirectXFramework::GetDXFramework();
+	_device = _DXFramework->GetDevice();
+	_deviceContext = _DXFramework->GetDeviceContext();
+	_viewTransformation = _DXFramework->GetViewTransformation();
+	_projectionTransformation = _DXFramework->GetProjectionTransformation();
+	_eyePosition = _DXFramework->GetEyePos();
+
+	//Getting resource manager and mesh for model (unless CreateModel has already given us the mesh).
+	_resourceManager = _DXFramework->GetResourceManager();
+	if (!_mesh)
+	{
+		_mesh = _resourceManager->GetMesh(_modelName, _importProfile);
+		if (!_mesh)
+		{
+			return false;
+		}
+	}
+
+	ComputeBoundingSphere();
+	
+	//Getting common cbuffer values
+	_directionalLightColour = _DXFramework->GetDirectionalLightColour();
+	_directionalLightVector = _DXFramework->GetDirectionalLightVector();
+	_specularColour = _DXFramework->GetSpecularColour();
+	_specularPower = _DXFramework->GetSpecularPower();
+
+	_shaderVersion = _resourceManager->GetFileVersion(textureShaderFileName);
+	BuildShaders();
+	BuildRasteriserState();
+	BuildVertexLayout();
+	BuildConstantBuffer();
+
+	return true;
+}
+
+void ModelNode::Render()
+{
+	// Pick up any changes made to the shader file or the model while the application is running
+	unsigned int shaderVersion = _resourceManager->GetFileVersion(textureShaderFileName);
+	if (shaderVersion != _shaderVersion)
+	{
+		_shaderVersion = shaderVersion;
+		ReloadShaders();
+	}
+	if (_mesh->GetVersion() != _meshVersion)
+	{
+		ComputeBoundingSphere();
+	}
+
+	const float clearColour[] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+	// Calculate the world x view x projection transformation
+	Matrix completeTransformation = _cumulativeWorldTransformation * _viewTransformation * _projectionTransformation;
+
+	//These are the getters for the relevant variables in which we can load in for each submesh, this current mesh does not have good lighting 
+	// so I have added my own. This is to show you I can gather these values.
+	//_subMesh->GetMaterial()->GetDiffuseColour();
+	//_subMesh->GetMaterial()->GetShininess();
+	//_subMesh->GetMaterial()->GetSpecularColour();
+
+	CBuffer constantBuffer;
+	constantBuffer.WorldViewProjection = completeTransformation;
+	constantBuffer.World = _cumulativeWorldTransformation;
+	constantBuffer.AmbientLightColour = _ambientLightColour;
+	constantBuffer.DirectionalLightVector = _directionalLightVector;
+	constantBuffer.EyePosition = _eyePosition;
+	constantBuffer.DirectionalLightColour = _directionalLightColour;
+	constantBuffer.SpecularPower = _specularPower;
+	constantBuffer.SpecularColour = _specularColour;
+
+	_deviceContext->VSSetConstantBuffers(0, 1, _constantBuffer.GetAddressOf());
+	_deviceContext->PSSetConstantBuffers(0, 1, _constantBuffer.GetAddressOf());
+	_deviceContext->UpdateSubresource(_constantBuffer.Get(), 0, 0, &constantBuffer, 0, 0);
+
+	// All of the sub-meshes are drawn from the vertex and index buffers owned by the mesh, so these
+	// (and the rest of the pipeline state that does not depend on the material) only need setting once.
+	// Specify the distance between vertices and the starting point in the vertex buffer
+	UINT stride = sizeof(Vertex);
+	UINT offset = 0;
+
+	_deviceContext->IASetVertexBuffers(0, 1, _mesh->GetVertexBuffer().GetAddressOf(), &stride, &offset);
+	_deviceContext->IASetIndexBuffer(_mesh->GetIndexBuffer().Get(), DXGI_FORMAT_R32_UINT, 0);
+	_deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	//// Specify the layout of the input vertices.  This must match the layout of the input vertices in the shader
+	_deviceContext->IASetInputLayout(_layout.Get());
+	_deviceContext->VSSetShader(_vertexShader.Get(), 0, 0);
+
+	// Work out how big one unit in model space is on screen so that we can pick the level of detail for each sub-mesh
+	float pixelsPerUnit = GetPixelsPerUnit();
+
+	// Sub-meshes whose textures are in the same atlas (see ResourceManager::SetTextureAtlasing) share a texture,
+	// so the pixel shader and texture are only set when they change
+	ID3D11PixelShader* currentPixelShader = nullptr;
+	ID3D11ShaderResourceView* currentTexture = nullptr;
+	bool textureSet = false;
+
+	const MeshNode& meshNode = _mesh->GetNode(_meshNodeIndex);
+	for (size_t i = 0; i < meshNode.SubMeshes.size(); i++)
+	{
+		_subMesh = _mesh->GetSubMesh(meshNode.SubMeshes[i]);
+		UINT lod = SelectLod(_subMesh, pixelsPerUnit);
+
+		//If has texture coordinates then apply texture and use texture pixel shader. otherwise use normal pixelshader.
+		ID3D11PixelShader* pixelShader = _pixelShader.Get();
+		if (_subMesh->HasTexCoords())
+		{
+			pixelShader = _texturePixelShader.Get();
+			// Tell the texture streamer how much detail the texture needs
+			_subMesh->GetMaterial()->NoteScreenSize(GetScreenSize(_subMesh, pixelsPerUnit));
+			_texture = _subMesh->GetMaterial()->GetTexture();//Get texture from submesh.
+			if (!textureSet || _texture.Get() != currentTexture)
+			{
+				_deviceContext->PSSetShaderResources(0, 1, _texture.GetAddressOf()); //apply texture to PS 
+				currentTexture = _texture.Get();
+				textureSet = true;
+			}
+		}
+		if (pixelShader != currentPixelShader)
+		{
+			_deviceContext->PSSetShader(pixelShader, 0, 0);
+			currentPixelShader = pixelShader;
+		}
+
+		// Draw the sub-mesh from its range of the shared buffers
+		_deviceContext->DrawIndexed(_subMesh->GetIndexCount(lod), _subMesh->GetStartIndex(lod), _subMesh->GetBaseVertex());
+	}
+}
+
+void ModelNode::ComputeBoundingSphere()
+{
+	// Work out the bounds of the sub-meshes that we draw
+	const MeshNode& meshNode = _mesh->GetNode(_meshNodeIndex);
+	for (size_t i = 0; i < meshNode.SubMeshes.size(); i++)
+	{
+		const BoundingSphere& subMeshSphere = _mesh->GetSubMesh(meshNode.SubMeshes[i])->GetBoundingSphere();
+		if (i == 0)
+		{
+			_boundingSphere = subMeshSphere;
+		}
+		else
+		{
+			BoundingSphere::CreateMerged(_boundingSphere, _boundingSphere, subMeshSphere);
+		}
+	}
+	_meshVersion = _mesh->GetVersion();
+}
+
+float ModelNode::GetPixelsPerUnit()
+{
+	// The largest scale in the world transformation tells us how big a model unit is in world space
+	float worldScale = max(max(_cumulativeWorldTransformation.Right().Length(),
+							   _cumulativeWorldTransformation.Up().Length()),
+						   _cumulativeWorldTransformation.Backward().Length());
+	// Measure the distance to the nearest point of the model's bounding sphere rather than to its origin, so
+	// large models and models whose origin is a long way from their geometry are not coarsened too early
+	BoundingSphere worldSphere;
+	_boundingSphere.Transform(worldSphere, _cumulativeWorldTransformation);
+	float distance = (Vector3(worldSphere.Center) - _eyePosition).Length() - worldSphere.Radius;
+	if (distance < 1.0f)
+	{
+		// Too close to the camera (the near plane is at 1.0), so always use full detail
+		return FLT_MAX;
+	}
+	// _22 of the projection matrix is cot(fov / 2), so this gives the number of pixels covered by one world
+	// unit at this distance
+	float screenHeight = static_cast<float>(DirectXFramework::GetDXFramework()->GetWindowHeight());
+	return worldScale * _projectionTransformation._22 * screenHeight * 0.5f / distance;
+}
+
+float ModelNode::GetScreenSize(shared_ptr<SubMesh> subMesh, float pixelsPerUnit)
+{
+	// The diameter of the sub-mesh's bounding sphere in pixels, which is about the number of texels across its
+	// texture that can be seen if the texture covers it once.  It is never more than the window is wide.
+	float windowSize = static_cast<float>(max(DirectXFramework::GetDXFramework()->GetWindowWidth(), DirectXFramework::GetDXFramework()->GetWindowHeight()));
+	float diameter = 2.0f * subMesh->GetBoundingSphere().Radius;
+	return diameter < windowSize / pixelsPerUnit ? diameter * pixelsPerUnit : windowSize;
+}
+
+UINT ModelNode::SelectLod(shared_ptr<SubMesh> subMesh, float pixelsPerUnit)
+{
+	// Use the coarsest level of detail whose error is not visible on screen
+	UINT lod = 0;
+	for (UINT i = 1; i < subMesh->GetLodCount(); i++)
+	{
+		if (subMesh->GetLodError(i) * pixelsPerUnit > LodPixelError)
+		{
+			break;
+		}
+		lod = i;
+	}
+	return lod;
+}
+
+void ModelNode::Shutdown()
+{
+	if (_mesh)
+	{
+		_resourceManager->ReleaseMesh(_modelName);
+		_mesh = nullptr;
+	}
+}
+
+SceneGraphPointer ModelNode::CreateModel(wstring name, wstring modelName, Vector4 ambientLightColour, const string& importProfile)
+{
+	shared_ptr<ResourceManager> resourceManager = DirectXFramework::GetDXFramework()->GetResourceManager();
+	shared_ptr<Mesh> mesh = resourceManager->GetMesh(modelName, importProfile);
+	if (!mesh)
+	{
+		return nullptr;
+	}
+	SceneGraphPointer model = make_shared<SceneGraph>(name);
+	// Each ModelNode holds its own reference to the mesh and releases it when it is shut down.  The reference
+	// we got above is handed to the first ModelNode.
+	bool referenceUsed = false;
+	// The nodes are stored with parents first, so the parent of each node has always been created before it
+	vector<SceneGraphPointer> nodes;
+	for (size_t i = 0; i < mesh->GetNodeCount(); i++)
+	{
+		const MeshNode& meshNode = mesh->GetNode(i);
+		SceneGraphPointer node = make_shared<SceneGraph>(meshNode.Name);
+		node->SetWorldTransform(meshNode.LocalTransformation);
+		if (meshNode.Parent < 0)
+		{
+			model->Add(node);
+		}
+		else
+		{
+			nodes[meshNode.Parent]->Add(node);
+		}
+		nodes.push_back(node);
+		if (!meshNode.SubMeshes.empty())
+		{
+			if (referenceUsed)
+			{
+				resourceManager->GetMesh(modelName, importProfile);
+			}
+			referenceUsed = true;
+			node->Add(make_shared<ModelNode>(meshNode.Name + L"Mesh", modelName, mesh, static_cast<UINT>(i), ambientLightColour));
+		}
+	}
+	if (!referenceUsed)
+	{
+		resourceManager->ReleaseMesh(modelName);
+	}
+	return model;
+}
+
+void ModelNode::BuildShaders()
+{
+	// The resource manager compiles the shaders and shares the byte code between nodes (it may already have
+	// compiled them while preloading)
+
+	ComPtr<ID3DBlob> compilationMessages = nullptr;
+
+	//Compile vertex shader
+	HRESULT hr = _resourceManager->GetShaderByteCode(textureShaderFileName,
+		VertexShaderName, "vs_5_0",
+		_vertexShaderByteCode.GetAddressOf(),
+		compilationMessages.GetAddressOf());
+
+	if (compilationMessages.Get() != nullptr)
+	{
+		// If there were any compilation messages, display them
+		MessageBoxA(0, (char*)compilationMessages->GetBufferPointer(), 0, 0);
+	}
+	// Even if there are no compiler messages, check to make sure there were no other errors.
+	ThrowIfFailed(hr);
+	ThrowIfFailed(_device->CreateVertexShader(_vertexShaderByteCode->GetBufferPointer(), _vertexShaderByteCode->GetBufferSize(), NULL, _vertexShader.GetAddressOf()));
+
+	// Compile pixel shader
+	hr = _resourceManager->GetShaderByteCode(textureShaderFileName,
+		PixelShaderName, "ps_5_0",
+		_pixelShaderByteCode.GetAddressOf(),
+		compilationMessages.GetAddressOf());
+
+	if (compilationMessages.Get() != nullptr)
+	{
+		// If there were any compilation messages, display them
+		MessageBoxA(0, (char*)compilationMessages->GetBufferPointer(), 0, 0);
+	}
+	ThrowIfFailed(hr);
+	ThrowIfFailed(_device->CreatePixelShader(_pixelShaderByteCode->GetBufferPointer(), _pixelShaderByteCode->GetBufferSize(), NULL, _pixelShader.GetAddressOf()));
+
+	// Compile pixel shader
+	hr = _resourceManager->GetShaderByteCode(textureShaderFileName,
+		texturePixelShaderName, "ps_5_0",
+		_texturePixelShaderByteCode.GetAddressOf(),
+		compilationMessages.GetAddressOf());
+
+	if (compilationMessages.Get() != nullptr)
+	{
+		// If there were any compilation messages, display them
+		MessageBoxA(0, (char*)compilationMessages->GetBufferPointer(), 0, 0);
+	}
+	ThrowIfFailed(hr);
+	ThrowIfFailed(_device->CreatePixelShader(_texturePixelShaderByteCode->GetBufferPointer(), _texturePixelShaderByteCode->GetBufferSize(), NULL, _texturePixelShader.GetAddressOf()));
+}
+
+
+void ModelNode::ReloadShaders()
+{
+	// Everything is built before anything is replaced, so if the changed file does not compile we carry on
+	// with the shaders we already have
+	ComPtr<ID3DBlob> vertexShaderByteCode = _resourceManager->CompileShader(textureShaderFileName, VertexShaderName, "vs_5_0");
+	ComPtr<ID3DBlob> pixelShaderByteCode = _resourceManager->CompileShader(textureShaderFileName, PixelShaderName, "ps_5_0");
+	ComPtr<ID3DBlob> texturePixelShaderByteCode = _resourceManager->CompileShader(textureShaderFileName, texturePixelShaderName, "ps_5_0");
+	ComPtr<ID3D11VertexShader> vertexShader;
+	ComPtr<ID3D11PixelShader> pixelShader;
+	ComPtr<ID3D11PixelShader> texturePixelShader;
+	ComPtr<ID3D11InputLayout> layout;
+	if (!vertexShaderByteCode || !pixelShaderByteCode || !texturePixelShaderByteCode ||
+		FAILED(_device->CreateVertexShader(vertexShaderByteCode->GetBufferPointer(), vertexShaderByteCode->GetBufferSize(), NULL, vertexShader.GetAddressOf())) ||
+		FAILED(_device->CreatePixelShader(pixelShaderByteCode->GetBufferPointer(), pixelShaderByteCode->GetBufferSize(), NULL, pixelShader.GetAddressOf())) ||
+		FAILED(_device->CreatePixelShader(texturePixelShaderByteCode->GetBufferPointer(), texturePixelShaderByteCode->GetBufferSize(), NULL, texturePixelShader.GetAddressOf())) ||
+		FAILED(_device->CreateInputLayout(vertexDesc, ARRAYSIZE(vertexDesc), vertexShaderByteCode->GetBufferPointer(), vertexShaderByteCode->GetBufferSize(), layout.GetAddressOf())))
+	{
+		return;
+	}
+	_vertexShaderByteCode = vertexShaderByteCode;
+	_pixelShaderByteCode = pixelShaderByteCode;
+	_texturePixelShaderByteCode = texturePixelShaderByteCode;
+	_vertexShader = vertexShader;
+	_pixelShader = pixelShader;
+	_texturePixelShader = texturePixelShader;
+	_layout = layout;
+}
+
+void ModelNode::BuildVertexLayout()
+{
+	// Create the vertex input layout. This tells DirectX the format
+	// of each of the vertices we are sending to it. The vertexDesc array is
+	// defined in Geometry.h
+
+	ThrowIfFailed(_device->CreateInputLayout(vertexDesc, ARRAYSIZE(vertexDesc), _vertexShaderByteCode->GetBufferPointer(), _vertexShaderByteCode->GetBufferSize(), _layout.GetAddressOf()));
+}
+
+void ModelNode::BuildConstantBuffer()
+{
+	D3D11_BUFFER_DESC bufferDesc;
+	ZeroMemory(&bufferDesc, sizeof(bufferDesc));
+	bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+	bufferDesc.ByteWidth = sizeof(CBuffer);
+	bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+
+	ThrowIfFailed(_device->CreateBuffer(&bufferDesc, NULL, _constantBuffer.GetAddressOf()));
+}
+
+void ModelNode::BuildRasteriserState()
+{
+	D3D11_RASTERIZER_DESC rasteriserDesc{};
+	rasteriserDesc.CullMode = D3D11_CULL_BACK;
+	rasteriserDesc.FrontCounterClockwise = false;
+	rasteriserDesc.DepthBias = 0;
+	rasteriserDesc.SlopeScaledDepthBias = 0.0f;
+	rasteriserDesc.DepthBiasClamp = 0.0f;
+	rasteriserDesc.DepthClipEnable = true;
+	rasteriserDesc.ScissorEnable = false;
+	rasteriserDesc.MultisampleEnable = false;
+	rasteriserDesc.AntialiasedLineEnable = false;
+	rasteriserDesc.FillMode = D3D11_FILL_SOLID;
+	ThrowIfFailed(_device->CreateRasterizerState(&rasteriserDesc, _rasteriserState.GetAddressOf()));
 }
\ No newline at end of file
@@ -1,103 +1,135 @@
-#pragma once
-#include "SceneNode.h"
-#include "Mesh.h"
-#include "ResourceManager.h"
-#include <vector>
-
-#define textureShaderFileName		L"ModelShader.hlsl"
-//#define ShaderFileName				L"shader.hlsl"
-#define VertexShaderName	"VS"
-#define PixelShaderName		"PS"
-#define texturePixelShaderName		"TPS"
-
-class ModelNode : public SceneNode
-{
-
-public:
-	ModelNode(wstring name, Vector4 ambientLightColour) : SceneNode(name) { _ambientLightColour = ambientLightColour; };
-	~ModelNode(void) {};
-
-	bool Initialise() override;
-	void Render() override;
-	void Shutdown() override;
-
-private:
-	Vector4 _ambientLightColour;
-
-	void BuildShaders();
-	void BuildVertexLayout();
-	void BuildConstantBuffer();
-	void BuildRasteriserState();
-
-	shared_ptr<ResourceManager> _resourceManager;
-
-	shared_ptr<Mesh> _mesh;
-	shared_ptr<SubMesh> _subMesh;
-
-	ComPtr<ID3D11Device>			_device;
-	ComPtr<ID3D11DeviceContext>		_deviceContext;
-	ComPtr<IDXGISwapChain>			_swapChain;
-	ComPtr<ID3D11Texture2D>			_depthStencilBuffer;
-	ComPtr<ID3D11RenderTargetView>	_renderTargetView;
-	ComPtr<ID3D11DepthStencilView>	_depthStencilView;
-
-	ComPtr<ID3D11Buffer>			_vertexBuffer;
-	ComPtr<ID3D11Buffer>			_indexBuffer;
-
-	ComPtr<ID3DBlob>				_vertexShaderByteCode = nullptr;
-	ComPtr<ID3DBlob>				_pixelShaderByteCode = nullptr;
-
-	ComPtr<ID3DBlob>				_textureVertexShaderByteCode = nullptr;
-	ComPtr<ID3DBlob>				_texturePixelShaderByteCode = nullptr;
-
-	ComPtr<ID3D11VertexShader>		_vertexShader;
-	ComPtr<ID3D11VertexShader>		_textureVertexShader;
-	ComPtr<ID3D11PixelShader>		_pixelShader;
-	ComPtr<ID3D11PixelShader>		_texturePixelShader;
-
-	ComPtr<ID3D11InputLayout>		_layout;
-	ComPtr<ID3D11Buffer>			_constantBuffer;
-
-	ComPtr<ID3D11RasterizerState>   _rasteriserState;
-
-	Vector4							_directionalLightColour;
-	Vector4							_directionalLightVector;
-	float							_specularPower{ 0 };
-	Vector4							_specularColour;
-
-	Vector3							_eyePosition;
-	Vector3							_focalPointPosition;
-	Vector3							_upVector;
-
-	Matrix							_viewTransformation;
-	Matrix							_projectionTransformation;
-
-	ComPtr<ID3D11ShaderResourceView> _texture;
-
-	struct  CBuffer
-	{
-		Matrix		WorldViewProjection;
-		Matrix		World;
-		Vector4		AmbientLightColour;
-		Vector4		DirectionalLightColour;
-		Vector4		DirectionalLightVector;
-		Vector3		EyePosition;
-		float		SpecularPower{ 0 };
-		Vector4		SpecularColour;
-	};
-
-	struct Vertex
-	{
-		Vector3		Position;
-		Vector3		Normal;
-		Vector2		TextureCoordinates;
-	};
-
-	D3D11_INPUT_ELEMENT_DESC vertexDesc[3] =
-	{
-		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "TEXTURE", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 }
-	};
-};
-
+#pragma once
+#include "SceneNode.h"
+#include "SceneGraph.h"
+#include "Mesh.h"
+#include "ResourceManager.h"
+#include <vector>
+
+#define textureShaderFileName		L"ModelShader.hlsl"
+//#define ShaderFileName				L"shader.hlsl"
+#define VertexShaderName	"VS"
+#define PixelShaderName		"PS"
+#define texturePixelShaderName		"TPS"
+// A level of detail is only used if the error it introduces covers less than this many pixels on screen
+#define LodPixelError				1.0f
+
+// Draws the sub-meshes of one node of a model.  Use CreateModel to build the scene graph subtree for a whole
+// model.  A ModelNode created directly draws the root node of the model, which is the whole model unless
+// it has animated parts.
+
+class ModelNode : public SceneNode
+{
+
+public:
+	ModelNode(wstring name, wstring modelName, Vector4 ambientLightColour, const string& importProfile = DefaultImportProfile) :
+		SceneNode(name) { _modelName = modelName; _ambientLightColour = ambientLightColour; _importProfile = importProfile; _meshNodeIndex = 0; };
+	// Used by CreateModel.  The node takes over a reference to mesh that has already been obtained from the resource manager.
+	ModelNode(wstring name, wstring modelName, shared_ptr<Mesh> mesh, UINT meshNodeIndex, Vector4 ambientLightColour) :
+		SceneNode(name) { _modelName = modelName; _mesh = mesh; _meshNodeIndex = meshNodeIndex; _ambientLightColour = ambientLightColour; };
+	~ModelNode(void) {};
+
+	// Build a scene graph subtree for a model.  The root of the subtree is called name.  Below it, there is a
+	// SceneGraph node for each node of the model's hierarchy (named after the node in the model file and holding
+	// its local transformation), with a ModelNode child that draws the sub-meshes of that node.  Returns nullptr
+	// if the model cannot be loaded.
+	static SceneGraphPointer CreateModel(wstring name, wstring modelName, Vector4 ambientLightColour, const string& importProfile = DefaultImportProfile);
+
+	bool Initialise() override;
+	void Render() override;
+	void Shutdown() override;
+
+private:
+	Vector4 _ambientLightColour;
+
+	void BuildShaders();
+	void ReloadShaders();
+	void ComputeBoundingSphere();
+	void BuildVertexLayout();
+	void BuildConstantBuffer();
+	void BuildRasteriserState();
+
+	float GetPixelsPerUnit();
+	// Pixels across a sub-mesh on screen (see Material::NoteScreenSize)
+	float GetScreenSize(shared_ptr<SubMesh> subMesh, float pixelsPerUnit);
+	UINT SelectLod(shared_ptr<SubMesh> subMesh, float pixelsPerUnit);
+
+	shared_ptr<ResourceManager> _resourceManager;
+
+	wstring _modelName;
+	string _importProfile;
+	shared_ptr<Mesh> _mesh;
+	UINT _meshNodeIndex;
+	shared_ptr<SubMesh> _subMesh;
+	// Bounds of the sub-meshes drawn by this node, worked out from this version of the mesh
+	BoundingSphere _boundingSphere;
+	unsigned int _meshVersion{ 0 };
+	// Version of the shader file that is in use (see ResourceManager::GetFileVersion)
+	unsigned int _shaderVersion{ 0 };
+
+	ComPtr<ID3D11Device>			_device;
+	ComPtr<ID3D11DeviceContext>		_deviceContext;
+	ComPtr<IDXGISwapChain>			_swapChain;
+	ComPtr<ID3D11Texture2D>			_depthStencilBuffer;
+	ComPtr<ID3D11RenderTargetView>	_renderTargetView;
+	ComPtr<ID3D11DepthStencilView>	_depthStencilView;
+
+	ComPtr<ID3D11Buffer>			_vertexBuffer;
+	ComPtr<ID3D11Buffer>			_indexBuffer;
+
+	ComPtr<ID3DBlob>				_vertexShaderByteCode = nullptr;
+	ComPtr<ID3DBlob>				_pixelShaderByteCode = nullptr;
+
+	ComPtr<ID3DBlob>				_textureVertexShaderByteCode = nullptr;
+	ComPtr<ID3DBlob>				_texturePixelShaderByteCode = nullptr;
+
+	ComPtr<ID3D11VertexShader>		_vertexShader;
+	ComPtr<ID3D11VertexShader>		_textureVertexShader;
+	ComPtr<ID3D11PixelShader>		_pixelShader;
+	ComPtr<ID3D11PixelShader>		_texturePixelShader;
+
+	ComPtr<ID3D11InputLayout>		_layout;
+	ComPtr<ID3D11Buffer>			_constantBuffer;
+
+	ComPtr<ID3D11RasterizerState>   _rasteriserState;
+
+	Vector4							_directionalLightColour;
+	Vector4							_directionalLightVector;
+	float							_specularPower{ 0 };
+	Vector4							_specularColour;
+
+	Vector3							_eyePosition;
+	Vector3							_focalPointPosition;
+	Vector3							_upVector;
+
+	Matrix							_viewTransformation;
+	Matrix							_projectionTransformation;
+
+	ComPtr<ID3D11ShaderResourceView> _texture;
+
+	struct  CBuffer
+	{
+		Matrix		WorldViewProjection;
+		Matrix		World;
+		Vector4		AmbientLightColour;
+		Vector4		DirectionalLightColour;
+		Vector4		DirectionalLightVector;
+		Vector3		EyePosition;
+		float		SpecularPower{ 0 };
+		Vector4		SpecularColour;
+	};
+
+	struct Vertex
+	{
+		Vector3		Position;
+		Vector3		Normal;
+		Vector2		TextureCoordinates;
+	};
+
+	D3D11_INPUT_ELEMENT_DESC vertexDesc[3] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "TEXTURE", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 }
+	};
+};
+
@@ -0,0 +1,173 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Simple data-parallel loop used by the CPU side processing code (mesh processing, texture
+// processing, decompression, etc).
+//
+// The range [0, count) is split into chunks of grainSize items and the chunks are handed out to
+// worker threads (and the calling thread) as each one finishes its previous chunk.  body is
+// called as body(begin, end) for each chunk.  Each chunk is processed by exactly one thread, so
+// body only needs to avoid writing to data that belongs to other chunks.  Small ranges are run
+// directly on the calling thread.
+//
+// The worker threads belong to a pool that is started the first time it is needed and lasts until
+// the program exits, so per-thread state (such as the Assimp importers in ModelImporter.cpp) is
+// kept from one loop to the next.  A loop started from inside another loop's body runs directly on
+// the thread that started it, since the outer loop is already using every core.  Loops started at
+// the same time from different threads share the workers.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+class ParallelForPool
+{
+public:
+	static ParallelForPool& Get()
+	{
+		static ParallelForPool pool;
+		return pool;
+	}
+
+	ParallelForPool(const ParallelForPool&) = delete;
+	ParallelForPool& operator=(const ParallelForPool&) = delete;
+
+	// Number of threads that work on a loop, including the one that starts it
+	inline std::size_t GetThreadCount() const { return _workers.size() + 1; }
+
+	// True on a worker thread, or on a thread that is running a chunk of a loop it started
+	static bool& IsInsideLoop()
+	{
+		thread_local bool insideLoop = false;
+		return insideLoop;
+	}
+
+	// Run chunks 0 to chunkCount - 1 as runChunk(context, chunk) on the workers and the calling thread,
+	// and return once they have all finished
+	void Run(std::size_t chunkCount, void (*runChunk)(void*, std::size_t), void* context)
+	{
+		Job job{ chunkCount, 0, 0, runChunk, context };
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_jobs.push_back(&job);
+		}
+		_workAvailable.notify_all();
+		IsInsideLoop() = true;
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (job.NextChunk < job.ChunkCount)
+		{
+			RunNextChunk(job, lock);
+		}
+		_jobFinished.wait(lock, [&]() { return job.FinishedChunks == job.ChunkCount; });
+		lock.unlock();
+		IsInsideLoop() = false;
+	}
+
+private:
+	// A loop.  Chunks are handed out and counted under _mutex, and the job is taken off the queue once
+	// all of its chunks have been handed out, so nothing refers to it after the last one finishes.
+	struct Job
+	{
+		std::size_t					ChunkCount;
+		std::size_t					NextChunk;
+		std::size_t					FinishedChunks;
+		void						(*RunChunk)(void*, std::size_t);
+		void*						Context;
+	};
+
+	std::mutex						_mutex;
+	std::condition_variable			_workAvailable;
+	std::condition_variable			_jobFinished;
+	std::deque<Job*>				_jobs;
+	std::vector<std::thread>		_workers;
+	bool							_stopping;
+
+	ParallelForPool()
+	{
+		_stopping = false;
+		unsigned int threadCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+		for (unsigned int i = 1; i < threadCount; i++)
+		{
+			_workers.emplace_back([this]()
+			{
+				IsInsideLoop() = true;
+				std::unique_lock<std::mutex> lock(_mutex);
+				for (;;)
+				{
+					_workAvailable.wait(lock, [&]() { return _stopping || !_jobs.empty(); });
+					if (_stopping)
+					{
+						return;
+					}
+					RunNextChunk(*_jobs.front(), lock);
+				}
+			});
+		}
+	}
+
+	~ParallelForPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopping = true;
+		}
+		_workAvailable.notify_all();
+		for (std::thread& worker : _workers)
+		{
+			worker.join();
+		}
+	}
+
+	// Hand out the next chunk of a job and run it.  lock holds _mutex, which is released while the chunk runs.
+	void RunNextChunk(Job& job, std::unique_lock<std::mutex>& lock)
+	{
+		std::size_t chunk = job.NextChunk++;
+		if (job.NextChunk == job.ChunkCount)
+		{
+			_jobs.erase(std::find(_jobs.begin(), _jobs.end(), &job));
+		}
+		lock.unlock();
+		job.RunChunk(job.Context, chunk);
+		lock.lock();
+		if (++job.FinishedChunks == job.ChunkCount)
+		{
+			_jobFinished.notify_all();
+		}
+	}
+};
+
+template<typename TBody>
+void ParallelFor(std::size_t count, std::size_t grainSize, const TBody& body)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	if (grainSize == 0)
+	{
+		grainSize = 1;
+	}
+	std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+	if (chunkCount <= 1 || ParallelForPool::IsInsideLoop() || ParallelForPool::Get().GetThreadCount() <= 1)
+	{
+		body(static_cast<std::size_t>(0), count);
+		return;
+	}
+
+	struct Loop
+	{
+		const TBody&	Body;
+		std::size_t		Count;
+		std::size_t		GrainSize;
+	} loop{ body, count, grainSize };
+	ParallelForPool::Get().Run(chunkCount, [](void* context, std::size_t chunk)
+	{
+		const Loop& loop = *static_cast<const Loop*>(context);
+		std::size_t begin = chunk * loop.GrainSize;
+		loop.Body(begin, (std::min)(begin + loop.GrainSize, loop.Count));
+	}, &loop);
+}
@@ -1,406 +1,1581 @@
-#include "ResourceManager.h"
-#include "DirectXFramework.h"
-#include <sstream>
-#include "WICTextureLoader.h"
-#include <locale>
-#include <codecvt>
-
-#pragma comment(lib, "Assimp/lib/release/assimp-vc143-mt.lib")
-
-using namespace Assimp;
-
-//-------------------------------------------------------------------------------------------
-// Utility functions to convert from wstring to string and back
-// Copied from https://stackoverflow.com/questions/4804298/how-to-convert-wstring-into-string
-
-wstring s2ws(const std::string& str)
-{
-	using convert_typeX = std::codecvt_utf8<wchar_t>;
-	std::wstring_convert<convert_typeX, wchar_t> converterX;
-
-	return converterX.from_bytes(str);
-}
-
-string ws2s(const std::wstring& wstr)
-{
-	using convert_typeX = std::codecvt_utf8<wchar_t>;
-	std::wstring_convert<convert_typeX, wchar_t> converterX;
-
-	return converterX.to_bytes(wstr);
-}
-
-//-------------------------------------------------------------------------------------------
-
-ResourceManager::ResourceManager()
-{
-	_device = DirectXFramework::GetDXFramework()->GetDevice();
-	_deviceContext = DirectXFramework::GetDXFramework()->GetDeviceContext();
-}
-
-ResourceManager::~ResourceManager(void)
-{
-}
-
-shared_ptr<Mesh> ResourceManager::GetMesh(wstring modelName)
-{
-	// CHeck to see if the mesh has already been loaded
-	MeshResourceMap::iterator it = _meshResources.find(modelName);
-	if (it != _meshResources.end())
-	{
-		// Update reference count and return pointer to existing mesh
-		it->second.ReferenceCount++;
-		return it->second.MeshPointer;
-	}
-	else
-	{
-		// This is the first request for this model.  Load the mesh and
-		// save a reference to it.
-		shared_ptr<Mesh> mesh = LoadModelFromFile(modelName);
-		if (mesh != nullptr)
-		{
-			MeshResourceStruct resourceStruct;
-			resourceStruct.ReferenceCount = 1;
-			resourceStruct.MeshPointer = mesh;
-			_meshResources[modelName] = resourceStruct;
-			return mesh;
-		}
-		else
-		{
-			return nullptr;
-		}
-	}
-}
-
-void ResourceManager::ReleaseMesh(wstring modelName)
-{
-	MeshResourceMap::iterator it = _meshResources.find(modelName);
-	if (it != _meshResources.end())
-	{
-		it->second.ReferenceCount--;
-		if (it->second.ReferenceCount == 0)
-		{
-			// Release any materials used by this mesh
-			shared_ptr<Mesh> mesh = it->second.MeshPointer;
-			unsigned int subMeshCount = static_cast<unsigned int>(mesh->GetSubMeshCount());
-			// Loop through all submeshes in the mesh
-			for (unsigned int i = 0; i < subMeshCount; i++)
-			{
-				shared_ptr<SubMesh> subMesh = mesh->GetSubMesh(i);
-				wstring materialName = subMesh->GetMaterial()->GetMaterialName();
-				ReleaseMaterial(materialName);
-			}
-			// If no other nodes are using this mesh, remove it frmo the map
-			// (which will also release the resources).
-			it->second.MeshPointer = nullptr;
-			_meshResources.erase(modelName);
-		}
-	}
-}
-
-void ResourceManager::CreateMaterialFromTexture(wstring textureName)
-{
-    // We have no diffuse or specular colours here since we are just building a default material structure
-    // based on a provided texture. Just use the texture name as the material name in this case
-    InitialiseMaterial(textureName, 
-                       Vector4(1.0f, 1.0f, 1.0f, 1.0f), 
-                       Vector4(0.0f, 0.0f, 0.0f, 1.0f),
-                       0,
-	   			       1.0f,
-                       textureName);
-}
-
-void ResourceManager::CreateMaterialWithNoTexture(wstring materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity)
-{
-    InitialiseMaterial(materialName, diffuseColour, specularColour, shininess, opacity, L"");
-}
-
-void ResourceManager::CreateMaterial(wstring materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring textureName)
-{
-    InitialiseMaterial(materialName, diffuseColour, specularColour, shininess, opacity, textureName);
-}
-
-shared_ptr<Material> ResourceManager::GetMaterial(wstring materialName)
-{
-	// This works a bit different to the GetMesh method.  We can only find
-	// materials we have previously created (usually when the mesh was loaded
-	// from the file).
-	MaterialResourceMap::iterator it = _materialResources.find(materialName);
-	if (it != _materialResources.end())
-	{
-		it->second.ReferenceCount++;
-		return it->second.MaterialPointer;
-	}
-	else
-	{
-		// Material not previously created.
-		return nullptr;
-	}
-}
-
-void ResourceManager::ReleaseMaterial(wstring materialName)
-{
-	MaterialResourceMap::iterator it = _materialResources.find(materialName);
-	if (it != _materialResources.end())
-	{
-		it->second.ReferenceCount--;
-		if (it->second.ReferenceCount == 0)
-		{
-			it->second.MaterialPointer = nullptr;
-			_meshResources.erase(materialName);
-		}
-	}
-}
-
-void ResourceManager::InitialiseMaterial(wstring materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring textureName)
-{
-	MaterialResourceMap::iterator it = _materialResources.find(materialName);
-	if (it == _materialResources.end())
-	{
-		// We are creating the material for the first time
-		ComPtr<ID3D11ShaderResourceView> texture;
-		if (textureName.size() > 0)
-		{
-			// A texture was specified.  Try to load it.
-			if (FAILED(CreateWICTextureFromFile(_device.Get(),
-											    _deviceContext.Get(),
-												textureName.c_str(),
-												nullptr,
-												texture.GetAddressOf()
-												)))
-			{
-				texture = nullptr;
-			}
-		}
-		else
-		{
-			texture = nullptr;;
-		}
-		shared_ptr<Material> material = make_shared<Material>(materialName, diffuseColour, specularColour, shininess, opacity, texture);
-		MaterialResourceStruct resourceStruct;
-		resourceStruct.ReferenceCount = 0;
-		resourceStruct.MaterialPointer = material;
-		_materialResources[materialName] = resourceStruct;
-	}
-}
-
-shared_ptr<Mesh> ResourceManager::LoadModelFromFile(wstring modelName)
-{
-	ComPtr<ID3D11Buffer> vertexBuffer;
-	ComPtr<ID3D11Buffer> indexBuffer;
-	wstring* materials = nullptr;
-
-	Importer importer;
-
-	unsigned int postProcessSteps = aiProcess_Triangulate |
-		aiProcess_ConvertToLeftHanded;
-	string modelNameUTF8 = ws2s(modelName);
-	const aiScene* scene = importer.ReadFile(modelNameUTF8.c_str(), postProcessSteps);
-	if (!scene)
-	{
-		// If failed to load, there is nothing to do
-		return nullptr;
-	}
-	if (!scene->HasMeshes())
-	{
-		//If there are no meshes, then there is nothing to do.
-		return nullptr;
-	}
-	if (scene->HasMaterials())
-	{
-		// We need to find the directory part of the model name since we will need to add it to any texture names. 
-		// There is definately a more elegant and accurate way to do this using Windows API calls, but this is a quick
-		// and dirty approach
-		string::size_type slashIndex = modelNameUTF8.find_last_of("\\");
-		string directory;
-		if (slashIndex == string::npos)
-		{
-			directory = ".";
-		}
-		else if (slashIndex == 0)
-		{
-			directory = "/";
-		}
-		else
-		{
-			directory = modelNameUTF8.substr(0, slashIndex);
-		}
-		// Let's deal with the materials/textures first
-		materials = new wstring[scene->mNumMaterials];
-		for (unsigned int i = 0; i < scene->mNumMaterials; i++)
-		{
-			// Get the core material properties.  Ideally, we would be looking for more information
-			// e.g. emissive colour, etc.  This is a task for later.
-			aiMaterial* material = scene->mMaterials[i];
-
-			aiColor3D diffuseColour(0.0f, 0.0f, 0.0f);
-			material->Get(AI_MATKEY_COLOR_DIFFUSE, diffuseColour);
-			aiColor3D specularColour(0.0f, 0.0f, 0.0f);
-			material->Get(AI_MATKEY_COLOR_SPECULAR, specularColour);
-			float defaultShininess = 0.0f;
-			float& shininess = defaultShininess;
-			material->Get(AI_MATKEY_SHININESS, shininess);
-			float defaultOpacity = 1.0f;
-			float& opacity = defaultOpacity;
-			material->Get(AI_MATKEY_OPACITY, opacity);
-			string fullTextureNamePath = "";
-			if (material->GetTextureCount(aiTextureType_DIFFUSE) > 0)
-			{
-				aiString textureName;
-				float blendFactor;
-				aiTextureOp blendOp;
-				if (material->GetTexture(aiTextureType_DIFFUSE, 0, &textureName, NULL, NULL, &blendFactor, &blendOp, NULL) == AI_SUCCESS)
-				{
-					// Get full path to texture by prepending the same folder as included in the model name. This
-					// does assume that textures are in the same folder as the model files
-					fullTextureNamePath = directory + "\\" + textureName.data;
-				}
-			}
-			// Now create a unique name for the material based on the model name and loop count
-			stringstream materialNameStream;
-			materialNameStream << modelNameUTF8 << i;
-			string materialName = materialNameStream.str();
-			wstring materialNameWS = s2ws(materialName);
-			CreateMaterial(materialNameWS,
-				Vector4(diffuseColour.r, diffuseColour.g, diffuseColour.b, 1.0f),
-				Vector4(specularColour.r, specularColour.g, specularColour.b, 1.0f),
-				shininess,
-				opacity,
-				s2ws(fullTextureNamePath));
-			materials[i] = materialNameWS;
-		}
-	}
-	// Now we have created all of the materials, build up the mesh
-	shared_ptr<Mesh> resourceMesh = make_shared<Mesh>();
-	for (unsigned int sm = 0; sm < scene->mNumMeshes; sm++)
-	{
-		aiMesh* subMesh = scene->mMeshes[sm];
-		unsigned int numVertices = subMesh->mNumVertices;
-		bool hasNormals = subMesh->HasNormals();
-		bool hasTexCoords = subMesh->HasTextureCoords(0);
-		if (numVertices == 0)
-		{
-			return nullptr;
-		}
-		// Build up our vertex structure
-		aiVector3D* subMeshVertices = subMesh->mVertices;
-		aiVector3D* subMeshNormals = subMesh->mNormals;
-		// We only handle one set of UV coordinates at the moment.  Again, handling multiple sets of UV
-		// coordinates is a future enhancement.
-		aiVector3D* subMeshTexCoords = subMesh->mTextureCoords[0];
-		Vertex* modelVertices = new Vertex[numVertices];
-		Vertex* currentVertex = modelVertices;
-		for (unsigned int i = 0; i < numVertices; i++)
-		{
-			currentVertex->Position = Vector3(subMeshVertices->x, subMeshVertices->y, subMeshVertices->z);
-			if (hasNormals)
-			{
-				currentVertex->Normal = Vector3(subMeshNormals->x, subMeshNormals->y, subMeshNormals->z);
-			}
-			else
-			{
-				currentVertex->Normal = Vector3(0, 0, 0);
-			}
-			subMeshVertices++;
-			subMeshNormals++;
-			if (!hasTexCoords)
-			{
-				// If the model does not have texture coordinates, set them to 0
-				currentVertex->TexCoord = Vector2(0.0f, 0.0f);
-			}
-			else
-			{
-				// Handle negative texture coordinates by wrapping them to positive.  This should
-				// ideally be handled in the shader.  Note we are assuming that negative coordinates
-				// here are no smaller than -1.0 - this may not be a valid assumption.
-				if (subMeshTexCoords->x < 0)
-				{
-					currentVertex->TexCoord.x = subMeshTexCoords->x + 1.0f;
-				}
-				else
-				{
-					currentVertex->TexCoord.x = subMeshTexCoords->x;
-				}
-				if (subMeshTexCoords->y < 0)
-				{
-					currentVertex->TexCoord.y = subMeshTexCoords->y + 1.0f;
-				}
-				else
-				{
-					currentVertex->TexCoord.y = subMeshTexCoords->y;
-				}
-				subMeshTexCoords++;
-			}
-			currentVertex++;
-		}
-
-		D3D11_BUFFER_DESC vertexBufferDescriptor;
-		vertexBufferDescriptor.Usage = D3D11_USAGE_IMMUTABLE;
-		vertexBufferDescriptor.ByteWidth = sizeof(Vertex) * numVertices;
-		vertexBufferDescriptor.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-		vertexBufferDescriptor.CPUAccessFlags = 0;
-		vertexBufferDescriptor.MiscFlags = 0;
-		vertexBufferDescriptor.StructureByteStride = 0;
-
-		// Now set up a structure that tells DirectX where to get the
-		// data for the vertices from
-		D3D11_SUBRESOURCE_DATA vertexInitialisationData;
-		vertexInitialisationData.pSysMem = modelVertices;
-
-		// and create the vertex buffer
-		if (FAILED(_device->CreateBuffer(&vertexBufferDescriptor, &vertexInitialisationData, vertexBuffer.GetAddressOf())))
-		{
-			return nullptr;
-		}
-
-		// Now extract the indices from the file
-		unsigned int numberOfFaces = subMesh->mNumFaces;
-		unsigned int numberOfIndices = numberOfFaces * 3;
-		aiFace* subMeshFaces = subMesh->mFaces;
-		if (subMeshFaces->mNumIndices != 3)
-		{
-			// We are not dealing with triangles, so we cannot handle it
-			return nullptr;
-		}
-		unsigned int* modelIndices = new unsigned int[numberOfIndices * 3];
-		unsigned int* currentIndex = modelIndices;
-		for (unsigned int i = 0; i < numberOfFaces; i++)
-		{
-			*currentIndex++ = subMeshFaces->mIndices[0];
-			*currentIndex++ = subMeshFaces->mIndices[1];
-			*currentIndex++ = subMeshFaces->mIndices[2];
-			subMeshFaces++;
-		}
-		// Setup the structure that specifies how big the index 
-		// buffer should be
-		D3D11_BUFFER_DESC indexBufferDescriptor;
-		indexBufferDescriptor.Usage = D3D11_USAGE_IMMUTABLE;
-		indexBufferDescriptor.ByteWidth = sizeof(UINT) * numberOfIndices * 3;
-		indexBufferDescriptor.BindFlags = D3D11_BIND_INDEX_BUFFER;
-		indexBufferDescriptor.CPUAccessFlags = 0;
-		indexBufferDescriptor.MiscFlags = 0;
-		indexBufferDescriptor.StructureByteStride = 0;
-
-		// Now set up a structure that tells DirectX where to get the
-		// data for the indices from
-		D3D11_SUBRESOURCE_DATA indexInitialisationData;
-		indexInitialisationData.pSysMem = modelIndices;
-
-		// and create the index buffer
-		if (FAILED(_device->CreateBuffer(&indexBufferDescriptor, &indexInitialisationData, indexBuffer.GetAddressOf())))
-		{
-			return nullptr;
-		}
-
-		// Do we have a material associated with this mesh?
-		shared_ptr<Material> material = nullptr;
-		if (scene->HasMaterials())
-		{
-			material = GetMaterial(materials[subMesh->mMaterialIndex]);
-		}
-		shared_ptr<SubMesh> resourceSubMesh = make_shared<SubMesh>(vertexBuffer, indexBuffer, numVertices, numberOfIndices, material, hasNormals, hasTexCoords);
-		resourceMesh->AddSubMesh(resourceSubMesh);
-		delete[] modelVertices;
-		delete[] modelIndices;
-	}
-	return resourceMesh;
-}
+#include "ResourceManager.h"
+#include "DirectXFramework.h"
+#include "ContentHash.h"
+#include "WICTextureLoader.h"
+#include "DDSTextureLoader.h"
+#include "DdsFile.h"
+#include "ImageDecoder.h"
+#include "MappedFile.h"
+#include "ModelBuilder.h"
+#include "ParallelFor.h"
+#include "StringConversion.h"
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#pragma comment(lib, "Assimp/lib/release/assimp-vc143-mt.lib")
+
+// The renderer's vertices are filled straight from the cooked vertices
+static_assert(sizeof(Vertex) == sizeof(CookedVertex), "Vertex and CookedVertex must have the same layout");
+
+namespace
+{
+	// Largest width or height of an image file, or 0 if it is not in a format whose header we can read
+	size_t GetImageLargestSize(const uint8_t* data, size_t size)
+	{
+		if (IsDds(data, size))
+		{
+			DdsTexture dds;
+			return ParseDds(data, size, dds) ? (max)(dds.Width, dds.Height) : 0;
+		}
+		ImageInfo info;
+		return ReadImageInfo(data, size, info) ? (max)(info.Width, info.Height) : 0;
+	}
+}
+
+ResourceManager::ResourceManager()
+	: _textureStreamer(_textureCache, [this](const wstring& materialName) { return TakeMaterialScreenSize(materialName); },
+					   [this](const shared_ptr<CachedTexture>& texture, size_t size) { return ResizeCachedTexture(texture, size); }),
+	  _hotReloader([this](const string& fileName, const WatchedFile& file) { ReloadFile(fileName, file); })
+{
+	_device = DirectXFramework::GetDXFramework()->GetDevice();
+	_deviceContext = DirectXFramework::GetDXFramework()->GetDeviceContext();
+	_keepWarm = false;
+	_memoryBudget = DefaultResourceMemoryBudget;
+	_gpuBytes = 0;
+	_cpuBytes = 0;
+	_useCounter = 0;
+	_textureCompression = DefaultTextureCompression;
+	_maximumTextureSize = DefaultMaximumTextureSize;
+	_textureAtlasing = DefaultTextureAtlasing;
+	_preloadRecording = false;
+}
+
+ResourceManager::~ResourceManager(void)
+{
+	// The streaming and reload threads use the resource manager, so they have to stop before any of it goes
+	DisableTextureStreaming();
+	DisableHotReload();
+}
+
+shared_ptr<Mesh> ResourceManager::GetMesh(wstring_view modelName, const string& importProfile)
+{
+	if (_preloadRecording)
+	{
+		RecordPreloadRequest(PreloadType::Mesh, ws2s(modelName), importProfile);
+	}
+	InternedName name(modelName);
+	unsigned long long use = ++_useCounter;
+	// Check to see if the mesh has already been loaded (or is being loaded by another thread)
+	MeshResourceMap::EntryPointer resource;
+	while (!(resource = _meshResources.Acquire(name, use)))
+	{
+		// This is the first request for this model.  Add an entry for it so that any other thread
+		// that asks for it waits for us, then load the mesh.  If another thread added an entry first,
+		// go round again and use that one.
+		resource = _meshResources.Insert(name, 1, use);
+		if (resource)
+		{
+			shared_ptr<Mesh> mesh = LoadModelFromFile(modelName, importProfile);
+			if (mesh == nullptr)
+			{
+				// Remove the entry so that a later request can try again
+				_meshResources.Erase(name, resource);
+				resource->FailLoading();
+				return nullptr;
+			}
+			size_t gpuBytes = mesh->GetGpuMemorySize();
+			size_t cpuBytes = mesh->GetCpuMemorySize();
+			_gpuBytes += gpuBytes;
+			_cpuBytes += cpuBytes;
+			resource->FinishLoading(mesh, gpuBytes, cpuBytes);
+			WatchMesh(modelName, importProfile);
+			EnforceMemoryBudget();
+			return mesh;
+		}
+	}
+	if (!resource->WaitForLoad())
+	{
+		// The thread that was loading the mesh could not load it
+		resource->Release();
+		return nullptr;
+	}
+	if (resource->ResourcePointer->GetImportProfile() != importProfile)
+	{
+		OutputDebugStringA(("GetMesh: " + ws2s(modelName) + " is already loaded with the " + resource->ResourcePointer->GetImportProfile() +
+							" import profile, so it cannot be loaded with " + importProfile + "\n").c_str());
+		ReleaseMesh(modelName);
+		return nullptr;
+	}
+	return resource->ResourcePointer;
+}
+
+void ResourceManager::ReleaseMesh(wstring_view modelName)
+{
+	MeshResourceMap::EntryPointer resource = _meshResources.Find(modelName);
+	if (resource)
+	{
+		resource->LastUsed = ++_useCounter;
+		if (resource->Release())
+		{
+			if (_keepWarm)
+			{
+				// Leave the mesh loaded unless we are now over budget
+				EnforceMemoryBudget();
+			}
+			else
+			{
+				EvictMesh(InternedName::Find(modelName));
+			}
+		}
+	}
+}
+
+void ResourceManager::EvictMesh(const InternedName& modelName)
+{
+	// This does nothing if another thread has taken a reference to the mesh (or evicted it) since it
+	// was released
+	MeshResourceMap::EntryPointer resource = _meshResources.EraseIfUnreferenced(modelName);
+	if (!resource)
+	{
+		return;
+	}
+	_gpuBytes -= resource->GpuBytes;
+	_cpuBytes -= resource->CpuBytes;
+	ReleaseMeshMaterials(*resource->ResourcePointer);
+}
+
+void ResourceManager::ReleaseMeshMaterials(Mesh& mesh)
+{
+	// Release any materials used by this mesh
+	unsigned int subMeshCount = static_cast<unsigned int>(mesh.GetSubMeshCount());
+	// Loop through all submeshes in the mesh
+	for (unsigned int i = 0; i < subMeshCount; i++)
+	{
+		shared_ptr<SubMesh> subMesh = mesh.GetSubMesh(i);
+		if (subMesh->GetMaterial())
+		{
+			ReleaseMaterialReference(subMesh->GetMaterial()->GetMaterialName());
+		}
+	}
+}
+
+void ResourceManager::CreateMaterialFromTexture(wstring_view textureName)
+{
+    // We have no diffuse or specular colours here since we are just building a default material structure
+    // based on a provided texture. Just use the texture name as the material name in this case
+    InitialiseMaterial(textureName, 
+                       Vector4(1.0f, 1.0f, 1.0f, 1.0f), 
+                       Vector4(0.0f, 0.0f, 0.0f, 1.0f),
+                       0,
+	   			       1.0f,
+                       textureName);
+}
+
+void ResourceManager::CreateMaterialWithNoTexture(wstring_view materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity)
+{
+    InitialiseMaterial(materialName, diffuseColour, specularColour, shininess, opacity, L"");
+}
+
+void ResourceManager::CreateMaterial(wstring_view materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring_view textureName)
+{
+    InitialiseMaterial(materialName, diffuseColour, specularColour, shininess, opacity, textureName);
+}
+
+shared_ptr<Material> ResourceManager::GetMaterial(wstring_view materialName)
+{
+	return GetMaterial(InternedName::Find(materialName));
+}
+
+shared_ptr<Material> ResourceManager::GetMaterial(const InternedName& materialName)
+{
+	// This works a bit different to the GetMesh method.  We can only find
+	// materials we have previously created (usually when the mesh was loaded
+	// from the file).
+	MaterialResourceMap::EntryPointer resource = _materialResources.Acquire(materialName, ++_useCounter);
+	if (!resource)
+	{
+		// Material not previously created.
+		return nullptr;
+	}
+	if (!resource->WaitForLoad())
+	{
+		resource->Release();
+		return nullptr;
+	}
+	return resource->ResourcePointer;
+}
+
+void ResourceManager::ReleaseMaterial(wstring_view materialName)
+{
+	ReleaseMaterial(InternedName::Find(materialName));
+}
+
+void ResourceManager::ReleaseMaterial(const InternedName& materialName)
+{
+	if (ReleaseMaterialReference(materialName) && _keepWarm)
+	{
+		EnforceMemoryBudget();
+	}
+}
+
+// Returns true if this was the last reference to the material.  The material is evicted straight away unless
+// resources are being kept warm.
+bool ResourceManager::ReleaseMaterialReference(const InternedName& materialName)
+{
+	MaterialResourceMap::EntryPointer resource = _materialResources.Find(materialName);
+	if (!resource)
+	{
+		return false;
+	}
+	resource->LastUsed = ++_useCounter;
+	if (!resource->Release())
+	{
+		return false;
+	}
+	if (!_keepWarm)
+	{
+		EvictMaterial(materialName);
+	}
+	return true;
+}
+
+void ResourceManager::EvictMaterial(const InternedName& materialName)
+{
+	MaterialResourceMap::EntryPointer resource = _materialResources.EraseIfUnreferenced(materialName);
+	if (resource)
+	{
+		_gpuBytes -= resource->GpuBytes;
+		_cpuBytes -= resource->CpuBytes;
+		ReleaseMaterialTexture(materialName);
+	}
+}
+
+void ResourceManager::SetKeepWarm(bool keepWarm)
+{
+	_keepWarm = keepWarm;
+	// Unload anything that is no longer allowed to stay loaded
+	EnforceMemoryBudget();
+}
+
+void ResourceManager::SetMemoryBudget(size_t budgetBytes)
+{
+	_memoryBudget = budgetBytes;
+	EnforceMemoryBudget();
+}
+
+ResourceMemoryUsage ResourceManager::GetMemoryUsage()
+{
+	ResourceMemoryUsage usage;
+	usage.GpuBytes = _gpuBytes + _textureCache.GetGpuBytes();
+	usage.CpuBytes = _cpuBytes;
+	usage.UnreferencedBytes = 0;
+	usage.MeshCount = _meshResources.Size();
+	usage.MaterialCount = _materialResources.Size();
+	_meshResources.ForEach([&](const InternedName&, const MeshResourceMap::EntryPointer& resource)
+	{
+		if (resource->ReferenceCount == 0 && resource->State == ResourceState::Loaded)
+		{
+			usage.UnreferencedBytes += resource->GpuBytes + resource->CpuBytes;
+		}
+	});
+	_materialResources.ForEach([&](const InternedName&, const MaterialResourceMap::EntryPointer& resource)
+	{
+		if (resource->ReferenceCount == 0 && resource->State == ResourceState::Loaded)
+		{
+			usage.UnreferencedBytes += resource->GpuBytes + resource->CpuBytes;
+		}
+	});
+	return usage;
+}
+
+void ResourceManager::EnforceMemoryBudget()
+{
+	lock_guard<mutex> lock(_budgetMutex);
+	// Unload the least recently used unreferenced resource until we are within budget or there is nothing
+	// left that can be unloaded.  Unloading a mesh releases its materials, which can then be unloaded too.
+	// Materials that have been created but never requested are left alone since they cannot be reloaded.
+	size_t budget = _keepWarm ? _memoryBudget.load() : 0;
+	while (GetResidentBytes() > budget)
+	{
+		InternedName oldestMesh;
+		unsigned long long oldestMeshUse = ULLONG_MAX;
+		_meshResources.ForEach([&](const InternedName& name, const MeshResourceMap::EntryPointer& resource)
+		{
+			if (resource->ReferenceCount == 0 && resource->State == ResourceState::Loaded && resource->LastUsed < oldestMeshUse)
+			{
+				oldestMesh = name;
+				oldestMeshUse = resource->LastUsed;
+			}
+		});
+		InternedName oldestMaterial;
+		unsigned long long oldestMaterialUse = ULLONG_MAX;
+		_materialResources.ForEach([&](const InternedName& name, const MaterialResourceMap::EntryPointer& resource)
+		{
+			if (resource->ReferenceCount == 0 && resource->State == ResourceState::Loaded &&
+				resource->LastUsed != 0 && resource->LastUsed < oldestMaterialUse)
+			{
+				oldestMaterial = name;
+				oldestMaterialUse = resource->LastUsed;
+			}
+		});
+		if (oldestMeshUse == ULLONG_MAX && oldestMaterialUse == ULLONG_MAX)
+		{
+			return;
+		}
+		// If another thread has taken a reference to the resource since we looked at it, it will not be
+		// evicted and we will pick something else next time round
+		if (oldestMeshUse < oldestMaterialUse)
+		{
+			EvictMesh(oldestMesh);
+		}
+		else
+		{
+			EvictMaterial(oldestMaterial);
+		}
+	}
+}
+
+bool ResourceManager::MountArchive(wstring_view archiveName)
+{
+	return _archive.Open(ws2s(archiveName));
+}
+
+HRESULT ResourceManager::LoadTexture(wstring_view textureName, ID3D11ShaderResourceView** texture)
+{
+	return ReadTexture(textureName, [&](const uint8_t* data, size_t size)
+	{
+		return CreateTextureFromMemory(data, size, _maximumTextureSize, texture);
+	});
+}
+
+HRESULT ResourceManager::ReadTexture(wstring_view textureName, const function<HRESULT(const uint8_t*, size_t)>& use)
+{
+	// Textures stored uncompressed in the archive, and loose files, are used straight from a memory
+	// mapping.  Compressed ones are decompressed in parallel first.
+	string archiveName = ws2s(textureName);
+	if (_preloadRecording)
+	{
+		RecordPreloadRequest(PreloadType::Texture, archiveName);
+	}
+	vector<uint8_t> contents;
+	if (TakePreloadedFile(archiveName, contents))
+	{
+		return use(contents.data(), contents.size());
+	}
+	const uint8_t* data;
+	size_t size;
+	if (_archive.Find(archiveName, data, size))
+	{
+		return use(data, size);
+	}
+	if (_archive.Contains(archiveName))
+	{
+		if (!_archive.Read(archiveName, contents))
+		{
+			return E_FAIL;
+		}
+		return use(contents.data(), contents.size());
+	}
+	MappedFile file;
+	if (!file.Open(archiveName))
+	{
+		return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+	}
+	return use(file.GetData(), file.GetSize());
+}
+
+bool ResourceManager::OpenTextureDiskCache(wstring_view directoryName, size_t sizeLimit)
+{
+	return _textureDiskCache.Open(ws2s(directoryName), sizeLimit);
+}
+
+HRESULT ResourceManager::CreateTextureFromMemory(const uint8_t* data, size_t size, size_t maximumSize, ID3D11ShaderResourceView** texture)
+{
+	// DDS files already hold the mip levels in the format the GPU wants, so they are uploaded as they are.
+	// This only uses the device, which is free-threaded, so it does not hold up rendering.
+	if (IsDds(data, size))
+	{
+		return CreateDDSTextureFromMemory(_device.Get(), data, size, nullptr, texture, maximumSize);
+	}
+	unsigned int loadFlags = GetTextureLoadFlags();
+	bool useDiskCache = _textureDiskCache.IsOpen();
+	TextureDiskCacheKey cacheKey{ 0, size, loadFlags, maximumSize, 0 };
+	if (useDiskCache)
+	{
+		// The stored texture was made with the same maximum size and compression on a device that supports
+		// the same, so it is used whole
+		cacheKey.SourceHash = HashContents(data, size);
+		cacheKey.MaximumSize = maximumSize != 0 ? maximumSize : GetWICMaximumTextureSize(_device.Get());
+		cacheKey.CompressedFormat = GetWICBlockCompressedFormat(_device.Get(), loadFlags);
+		MappedFile cachedFile;
+		if (_textureDiskCache.Find(cacheKey, cachedFile))
+		{
+			if (SUCCEEDED(CreateDDSTextureFromMemory(_device.Get(), cachedFile.GetData(), cachedFile.GetSize(), nullptr, texture)))
+			{
+				return S_OK;
+			}
+			cachedFile.Close();
+			_textureDiskCache.Remove(cacheKey);
+		}
+	}
+	// The image is decoded and compressed without holding the device context mutex, which the loader only
+	// locks if it has to generate mip maps on the GPU.  The loader also gives back the levels it made, which
+	// are stored (with no lock held) for next time.
+	vector<uint8_t> contents;
+	HRESULT hr = CreateWICTextureFromMemoryEx(_device.Get(), _deviceContext.Get(), data, size, maximumSize, D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0,
+											  loadFlags, nullptr, texture, &_deviceContextMutex, useDiskCache ? &contents : nullptr);
+	if (SUCCEEDED(hr) && !contents.empty())
+	{
+		_textureDiskCache.Store(cacheKey, contents);
+	}
+	return hr;
+}
+
+unsigned int ResourceManager::GetTextureLoadFlags()
+{
+	unsigned int loadFlags = WIC_LOADER_DEFAULT;
+	switch (_textureCompression)
+	{
+	case TextureCompression::BC1OrBC3:
+		loadFlags |= WIC_LOADER_BLOCK_COMPRESS;
+		break;
+	case TextureCompression::BC7:
+		loadFlags |= WIC_LOADER_BLOCK_COMPRESS_BC7;
+		break;
+	default:
+		break;
+	}
+	return loadFlags;
+}
+
+bool ResourceManager::BuildTextureAtlas(const CookedModel& model, const vector<wstring>& textureNames, const vector<bool>& candidates,
+										ComPtr<ID3D11ShaderResourceView>& atlas, vector<Vector4>& atlasRegions)
+{
+	atlasRegions.assign(model.Materials.size(), Vector4::Zero);
+	// A texture can only go in the atlas if none of the sub-meshes using it repeat it
+	vector<bool> usable(candidates);
+	for (const CookedSubMesh& subMesh : model.SubMeshes)
+	{
+		if (subMesh.Material < 0 || !subMesh.HasTexCoords || !usable[subMesh.Material])
+		{
+			continue;
+		}
+		for (uint32_t i = 0; i < subMesh.VertexCount; i++)
+		{
+			const float* texCoord = model.Vertices[subMesh.BaseVertex + i].TexCoord;
+			if (!IsAtlasTexCoord(texCoord[0], texCoord[1]))
+			{
+				usable[subMesh.Material] = false;
+				break;
+			}
+		}
+	}
+
+	// Decode each texture once, however many materials use it.  The atlas is either sRGB or not, so only
+	// the textures that match the first one go in.
+	vector<wstring> images;
+	vector<vector<uint8_t>> imagePixels;
+	vector<pair<uint32_t, uint32_t>> imageSizes;
+	vector<int> materialImages(model.Materials.size(), -1);
+	bool srgb = false;
+	for (size_t i = 0; i < model.Materials.size(); i++)
+	{
+		if (!usable[i] || textureNames[i].empty())
+		{
+			continue;
+		}
+		vector<wstring>::iterator image = find(images.begin(), images.end(), textureNames[i]);
+		if (image != images.end())
+		{
+			materialImages[i] = static_cast<int>(image - images.begin());
+			continue;
+		}
+		ImageInfo info;
+		vector<uint8_t> pixels;
+		HRESULT hr = ReadTexture(textureNames[i], [&](const uint8_t* data, size_t size)
+		{
+			if (!ReadImageInfo(data, size, info) || info.Width > AtlasMaximumImageSize || info.Height > AtlasMaximumImageSize ||
+				(!images.empty() && info.Srgb != srgb))
+			{
+				return E_FAIL;
+			}
+			pixels.resize(static_cast<size_t>(info.Width) * info.Height * 4);
+			return DecodeImage(data, size, pixels.data(), static_cast<size_t>(info.Width) * 4) ? S_OK : E_FAIL;
+		});
+		if (FAILED(hr))
+		{
+			continue;
+		}
+		srgb = info.Srgb;
+		materialImages[i] = static_cast<int>(images.size());
+		images.push_back(textureNames[i]);
+		imagePixels.push_back(move(pixels));
+		imageSizes.push_back(make_pair(info.Width, info.Height));
+	}
+
+	size_t maximumSize = AtlasMaximumSize;
+	if (_maximumTextureSize != 0)
+	{
+		maximumSize = (min)(maximumSize, _maximumTextureSize.load());
+	}
+	unsigned int loadFlags = GetTextureLoadFlags() | (srgb ? WIC_LOADER_FORCE_SRGB : 0);
+	bool compressed = (loadFlags & (WIC_LOADER_BLOCK_COMPRESS | WIC_LOADER_BLOCK_COMPRESS_BC7)) != 0;
+	AtlasLayout layout;
+	if (!PackAtlas(imageSizes, static_cast<uint32_t>(maximumSize), compressed ? AtlasCompressedGutter : AtlasGutter, layout))
+	{
+		return false;
+	}
+	vector<const uint8_t*> packedPixels(images.size(), nullptr);
+	for (size_t i = 0; i < images.size(); i++)
+	{
+		if (layout.Regions[i].Packed)
+		{
+			packedPixels[i] = imagePixels[i].data();
+		}
+	}
+	vector<uint8_t> atlasPixels;
+	BuildAtlasImage(layout, packedPixels, atlasPixels);
+	// The mip levels are made and compressed on the CPU and the texture is created on the device, so the
+	// device context is not used
+	if (FAILED(CreateTextureFromRGBAPixels(_device.Get(), atlasPixels.data(), layout.Width, layout.Height, static_cast<size_t>(layout.Width) * 4,
+										   AtlasMipLevels, loadFlags, nullptr, atlas.ReleaseAndGetAddressOf())))
+	{
+		return false;
+	}
+	for (size_t i = 0; i < model.Materials.size(); i++)
+	{
+		if (materialImages[i] >= 0 && layout.Regions[materialImages[i]].Packed)
+		{
+			float scale[2];
+			float offset[2];
+			GetAtlasTransform(layout, materialImages[i], scale, offset);
+			atlasRegions[i] = Vector4(offset[0], offset[1], scale[0], scale[1]);
+		}
+	}
+	return true;
+}
+
+HRESULT ResourceManager::AcquireMaterialTexture(const InternedName& materialName, wstring_view textureName, ComPtr<ID3D11ShaderResourceView>& texture)
+{
+	wstring material(materialName.View());
+	unsigned int loadFlags = GetTextureLoadFlags();
+	size_t maximumSize = _maximumTextureSize;
+	TextureFileKey fileKey(GetCanonicalTextureName(textureName), loadFlags, maximumSize);
+	ComPtr<ID3D11ShaderResourceView> cachedTexture = _textureCache.AcquireByFile(material, fileKey);
+	if (cachedTexture)
+	{
+		texture = cachedTexture;
+		return S_OK;
+	}
+	// Read the file and see if a texture with the same contents is already loaded.  The cache is not locked
+	// while the texture is being made, so another thread may load the same texture in the meantime, in which
+	// case we use whichever one went into the cache first.
+	return ReadTexture(textureName, [&](const uint8_t* data, size_t size)
+	{
+		TextureContentKey contentKey(HashContents(data, size), size, loadFlags, maximumSize);
+		ComPtr<ID3D11ShaderResourceView> cachedTexture = _textureCache.AcquireByContent(material, fileKey, contentKey);
+		if (cachedTexture)
+		{
+			texture = cachedTexture;
+			return S_OK;
+		}
+		// When textures are streamed, start with a small version of the texture.  A DDS file without small
+		// enough mip levels is loaded as it is.
+		size_t loadSize = maximumSize;
+		if (_textureStreamer.IsEnabled() && (maximumSize == 0 || maximumSize > TextureStreamingInitialSize))
+		{
+			loadSize = TextureStreamingInitialSize;
+		}
+		ComPtr<ID3D11ShaderResourceView> newTexture;
+		HRESULT hr = CreateTextureFromMemory(data, size, loadSize, newTexture.GetAddressOf());
+		if (FAILED(hr) && loadSize != maximumSize)
+		{
+			loadSize = maximumSize;
+			hr = CreateTextureFromMemory(data, size, loadSize, newTexture.GetAddressOf());
+		}
+		if (FAILED(hr))
+		{
+			return hr;
+		}
+		size_t residentSize = GetTextureLargestSize(newTexture.Get());
+		size_t fullSize = residentSize;
+		if (loadSize != maximumSize)
+		{
+			// If we cannot read the image's size, it was not shrunk if it is smaller than it was allowed to be
+			size_t largestSize = maximumSize != 0 ? maximumSize : D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION;
+			size_t imageSize = GetImageLargestSize(data, size);
+			fullSize = imageSize != 0 ? (min)(imageSize, largestSize) : (residentSize < loadSize ? residentSize : largestSize);
+		}
+		texture = _textureCache.Add(material, fileKey, contentKey, newTexture, textureName, fullSize);
+		return S_OK;
+	});
+}
+
+void ResourceManager::ReleaseMaterialTexture(const InternedName& materialName)
+{
+	_textureCache.Release(wstring(materialName.View()));
+}
+
+string ResourceManager::GetCanonicalTextureName(wstring_view textureName)
+{
+	// Textures in the archive are known by their name in it.  Loose files are known by their full path, so
+	// that different relative paths to the same file match.
+	string name = ws2s(textureName);
+	if (!_archive.Contains(name))
+	{
+		error_code error;
+		filesystem::path canonicalPath = filesystem::weakly_canonical(filesystem::path(textureName), error);
+		if (!error)
+		{
+			name = canonicalPath.u8string();
+		}
+	}
+	return AssetArchive::NormaliseName(name);
+}
+
+size_t ResourceManager::GetMaterialGpuBytes(Material& material)
+{
+	return material.IsInAtlas() ? material.GetGpuMemorySize() : 0;
+}
+
+bool ResourceManager::ResizeCachedTexture(const shared_ptr<CachedTexture>& texture, size_t size)
+{
+	wstring sourceName;
+	size_t fullSize;
+	_textureCache.GetSource(texture, sourceName, fullSize);
+	// The full size texture is loaded with the same maximum size as a texture that is not streamed
+	size_t maximumSize = get<3>(texture->ContentKey);
+	size_t loadSize = size >= fullSize ? maximumSize : size;
+	ComPtr<ID3D11ShaderResourceView> newTexture;
+	HRESULT hr = ReadTexture(sourceName, [&](const uint8_t* data, size_t dataSize)
+	{
+		return CreateTextureFromMemory(data, dataSize, loadSize, newTexture.GetAddressOf());
+	});
+	if (FAILED(hr))
+	{
+		return false;
+	}
+	ComPtr<ID3D11ShaderResourceView> oldTexture;
+	vector<wstring> materialNames;
+	if (!_textureCache.Replace(texture, newTexture, loadSize == maximumSize, oldTexture, materialNames))
+	{
+		return false;
+	}
+	for (const wstring& materialName : materialNames)
+	{
+		ChangeMaterial(InternedName(materialName), [&](Material& material)
+		{
+			// The material may have been given a different texture in the meantime
+			if (material.GetTexture() == oldTexture)
+			{
+				lock_guard<recursive_mutex> lock(_deviceContextMutex);
+				material.SetTexture(newTexture);
+			}
+		});
+	}
+	return true;
+}
+
+float ResourceManager::TakeMaterialScreenSize(const wstring& materialName)
+{
+	MaterialResourceMap::EntryPointer resource = _materialResources.Find(materialName);
+	if (!resource || resource->State != ResourceState::Loaded)
+	{
+		return 0.0f;
+	}
+	return resource->ResourcePointer->TakeScreenSize();
+}
+
+void ResourceManager::InitialiseMaterial(wstring_view materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring_view textureName,
+										 ComPtr<ID3D11ShaderResourceView> atlas, const Vector4& atlasRegion)
+{
+	// If the material already exists (or another thread is creating it), there is nothing to do.  New
+	// materials are not used until they are requested.
+	InternedName name(materialName);
+	MaterialResourceMap::EntryPointer resource = _materialResources.Insert(name, 0, 0);
+	if (resource)
+	{
+		// We are creating the material for the first time
+		ComPtr<ID3D11ShaderResourceView> texture = atlas;
+		if (!atlas && textureName.size() > 0)
+		{
+			// A texture was specified.  Use it if it is already loaded, otherwise try to load it.
+			if (FAILED(AcquireMaterialTexture(name, textureName, texture)))
+			{
+				texture = nullptr;
+			}
+		}
+		shared_ptr<Material> material = make_shared<Material>(name, diffuseColour, specularColour, shininess, opacity, texture, textureName);
+		if (atlas)
+		{
+			material->SetAtlasRegion(atlasRegion);
+		}
+		size_t gpuBytes = GetMaterialGpuBytes(*material);
+		size_t cpuBytes = material->GetCpuMemorySize();
+		_gpuBytes += gpuBytes;
+		_cpuBytes += cpuBytes;
+		resource->FinishLoading(material, gpuBytes, cpuBytes);
+		// Changes to a texture in an atlas reload the mesh that made the atlas instead (see WatchAtlasTexture)
+		if (!atlas)
+		{
+			WatchTexture(textureName, name);
+		}
+	}
+}
+
+bool ResourceManager::UpdateMaterial(const InternedName& materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring_view textureName,
+									 ComPtr<ID3D11ShaderResourceView> atlas, const Vector4& atlasRegion)
+{
+	return ChangeMaterial(materialName, [&](Material& material)
+	{
+		// Only load the texture again if the material now uses a different one (or has left an atlas).
+		// Changes to the texture file itself are picked up when that file is reloaded.
+		ComPtr<ID3D11ShaderResourceView> texture = material.GetTexture();
+		if (atlas)
+		{
+			texture = atlas;
+			ReleaseMaterialTexture(materialName);
+		}
+		else if (material.GetTextureName() != textureName || material.IsInAtlas())
+		{
+			texture = nullptr;
+			if (textureName.empty() || FAILED(AcquireMaterialTexture(materialName, textureName, texture)))
+			{
+				texture = nullptr;
+				ReleaseMaterialTexture(materialName);
+			}
+			WatchTexture(textureName, materialName);
+		}
+		lock_guard<recursive_mutex> lock(_deviceContextMutex);
+		material.Update(diffuseColour, specularColour, shininess, opacity, texture, textureName);
+		material.SetAtlasRegion(atlas ? atlasRegion : Vector4::Zero);
+	});
+}
+
+// Make a change to a material that is already loaded and account for any change in its size.  Returns false
+// if the material is not loaded.
+bool ResourceManager::ChangeMaterial(const InternedName& materialName, const function<void(Material&)>& change)
+{
+	// Hold a reference while the material changes so that it cannot be evicted in the meantime, without
+	// making it look more recently used than it is
+	MaterialResourceMap::EntryPointer resource = _materialResources.Find(materialName);
+	if (!resource || !(resource = _materialResources.Acquire(materialName, resource->LastUsed)))
+	{
+		return false;
+	}
+	bool changed = resource->WaitForLoad();
+	if (changed)
+	{
+		shared_ptr<Material> material = resource->ResourcePointer;
+		change(*material);
+		UpdateResourceSize(*resource, GetMaterialGpuBytes(*material), material->GetCpuMemorySize());
+	}
+	// If everything else released the material while it was changing, do what the last release would have
+	// done.  Materials that have never been requested stay loaded as usual.
+	if (resource->Release() && resource->LastUsed != 0)
+	{
+		if (_keepWarm)
+		{
+			EnforceMemoryBudget();
+		}
+		else
+		{
+			EvictMaterial(materialName);
+		}
+	}
+	return changed;
+}
+
+template<typename TResource>
+void ResourceManager::UpdateResourceSize(ResourceEntry<TResource>& resource, size_t gpuBytes, size_t cpuBytes)
+{
+	// The totals are unsigned, so adding the difference wraps round to the right value if the resource has
+	// got smaller
+	_gpuBytes += gpuBytes - resource.GpuBytes.exchange(gpuBytes);
+	_cpuBytes += cpuBytes - resource.CpuBytes.exchange(cpuBytes);
+}
+
+
+shared_ptr<Mesh> ResourceManager::LoadModelFromFile(wstring_view modelName, const string& importProfile)
+{
+	CookedModel model;
+	if (!LoadModel(modelName, importProfile, model))
+	{
+		return nullptr;
+	}
+	return CreateMesh(modelName, model, false);
+}
+
+bool ResourceManager::LoadModel(wstring_view modelName, const string& importProfile, CookedModel& model)
+{
+	// Use the cooked model if the asset cooker has made one with the same import profile.  Otherwise import
+	// the model and do the processing here.
+	if (!LoadCookedModel(modelName, importProfile, model))
+	{
+		const ImportProfile* profile = FindImportProfile(importProfile);
+		if (!profile)
+		{
+			// Unknown profile name
+			return false;
+		}
+		// The scene belongs to this thread's importer and stays valid until we release it (or the next import on this thread)
+		string modelNameUTF8 = ws2s(modelName);
+		const aiScene* scene = ImportScene(modelNameUTF8, *profile, &_archive);
+		bool built = scene != nullptr && BuildCookedModel(scene, modelNameUTF8, importProfile, model);
+		// We have everything we need from the scene now
+		ReleaseImportedScene();
+		return built;
+	}
+	return true;
+}
+
+bool ResourceManager::LoadCookedModel(wstring_view modelName, const string& importProfile, CookedModel& model)
+{
+	string cookedName = ws2s(modelName) + CookedModelExtension;
+	vector<uint8_t> contents;
+	if (_archive.Contains(cookedName))
+	{
+		if (!TakePreloadedFile(cookedName, contents) && !_archive.Read(cookedName, contents))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		// A loose cooked model is ignored if the source model has changed since it was cooked
+		error_code error;
+		filesystem::path cookedPath = filesystem::u8path(cookedName);
+		filesystem::file_time_type cookedTime = filesystem::last_write_time(cookedPath, error);
+		if (error)
+		{
+			return false;
+		}
+		filesystem::file_time_type sourceTime = filesystem::last_write_time(filesystem::path(modelName), error);
+		if ((!error && sourceTime > cookedTime) || (!TakePreloadedFile(cookedName, contents) && !ReadFileContents(cookedName, contents)))
+		{
+			return false;
+		}
+	}
+	return ReadCookedModel(contents.data(), contents.size(), model) && model.ImportProfile == importProfile;
+}
+
+shared_ptr<Mesh> ResourceManager::CreateMesh(wstring_view modelName, const CookedModel& model, bool reload)
+{
+	ComPtr<ID3D11Buffer> vertexBuffer;
+	ComPtr<ID3D11Buffer> indexBuffer;
+
+	// Let's deal with the materials/textures first.  We need to find the directory part of the model name
+	// since we will need to add it to any texture names.
+	filesystem::path directory = filesystem::path(modelName).parent_path();
+	vector<InternedName> materials(model.Materials.size());
+	vector<wstring> textureNames(model.Materials.size());
+	// Materials that are already loaded keep the texture they have, unless the model is being reloaded
+	vector<bool> atlasCandidates(model.Materials.size());
+	for (size_t i = 0; i < model.Materials.size(); i++)
+	{
+		if (!model.Materials[i].TextureName.empty())
+		{
+			textureNames[i] = (directory / s2ws(model.Materials[i].TextureName)).wstring();
+		}
+		// Now create a unique name for the material based on the model name and loop count
+		wstring materialName(modelName);
+		materialName += to_wstring(i);
+		materials[i] = InternedName(materialName);
+		atlasCandidates[i] = reload || !_materialResources.Find(materials[i]);
+	}
+
+	// Put the textures that can share a texture into an atlas
+	ComPtr<ID3D11ShaderResourceView> atlas;
+	vector<Vector4> atlasRegions(model.Materials.size(), Vector4::Zero);
+	if (_textureAtlasing && BuildTextureAtlas(model, textureNames, atlasCandidates, atlas, atlasRegions))
+	{
+		for (size_t i = 0; i < model.Materials.size(); i++)
+		{
+			if (atlasRegions[i].z > 0.0f)
+			{
+				WatchAtlasTexture(textureNames[i], modelName, model.ImportProfile);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < model.Materials.size(); i++)
+	{
+		const CookedMaterial& material = model.Materials[i];
+		ComPtr<ID3D11ShaderResourceView> materialAtlas = atlasRegions[i].z > 0.0f ? atlas : nullptr;
+		// When the model is reloaded, its materials are updated in place so that everything using them sees the change
+		if (!reload || !UpdateMaterial(materials[i],
+									   Vector4(material.DiffuseColour),
+									   Vector4(material.SpecularColour),
+									   material.Shininess,
+									   material.Opacity,
+									   textureNames[i],
+									   materialAtlas,
+									   atlasRegions[i]))
+		{
+			InitialiseMaterial(materials[i].View(),
+				Vector4(material.DiffuseColour),
+				Vector4(material.SpecularColour),
+				material.Shininess,
+				material.Opacity,
+				textureNames[i],
+				materialAtlas,
+				atlasRegions[i]);
+		}
+	}
+
+	// Each sub-mesh takes a reference to its material.  The texture coordinates of sub-meshes whose material is
+	// in an atlas are mapped into it.  The region is taken from the material itself, since a material that was
+	// already loaded keeps the texture it has.
+	const CookedModel* meshModel = &model;
+	CookedModel atlasModel;
+	vector<shared_ptr<Material>> subMeshMaterials(model.SubMeshes.size());
+	for (size_t s = 0; s < model.SubMeshes.size(); s++)
+	{
+		const CookedSubMesh& cookedSubMesh = model.SubMeshes[s];
+		if (cookedSubMesh.Material >= 0)
+		{
+			subMeshMaterials[s] = GetMaterial(materials[cookedSubMesh.Material]);
+		}
+		const shared_ptr<Material>& material = subMeshMaterials[s];
+		if (material && material->IsInAtlas() && cookedSubMesh.HasTexCoords)
+		{
+			if (meshModel == &model)
+			{
+				atlasModel = model;
+				meshModel = &atlasModel;
+			}
+			const Vector4& region = material->GetAtlasRegion();
+			for (uint32_t v = cookedSubMesh.BaseVertex; v < cookedSubMesh.BaseVertex + cookedSubMesh.VertexCount; v++)
+			{
+				float* texCoord = atlasModel.Vertices[v].TexCoord;
+				texCoord[0] = region.x + region.z * (min)((max)(texCoord[0], 0.0f), 1.0f);
+				texCoord[1] = region.y + region.w * (min)((max)(texCoord[1], 0.0f), 1.0f);
+			}
+		}
+	}
+
+	// The sub-meshes of a node whose materials are in the new atlas and are otherwise the same no longer need
+	// different textures, so they are merged (see MergeSubMeshes) and drawn together with the first material.
+	// The sub-meshes that are merged away give up their reference to their material.
+	if (atlas)
+	{
+		vector<int> keys(model.SubMeshes.size(), -1);
+		bool merging = false;
+		for (size_t s = 0; s < model.SubMeshes.size(); s++)
+		{
+			const shared_ptr<Material>& material = subMeshMaterials[s];
+			if (!material || material->GetTexture().Get() != atlas.Get() || !model.SubMeshes[s].HasTexCoords)
+			{
+				continue;
+			}
+			for (size_t other = 0; keys[s] < 0 && other <= s; other++)
+			{
+				const shared_ptr<Material>& otherMaterial = subMeshMaterials[other];
+				if (other == s || (keys[other] >= 0 &&
+								   otherMaterial->GetDiffuseColour() == material->GetDiffuseColour() &&
+								   otherMaterial->GetSpecularColour() == material->GetSpecularColour() &&
+								   otherMaterial->GetShininess() == material->GetShininess() &&
+								   otherMaterial->GetOpacity() == material->GetOpacity()))
+				{
+					keys[s] = other == s ? static_cast<int>(s) : keys[other];
+					merging = merging || other != s;
+				}
+			}
+		}
+		if (merging)
+		{
+			vector<uint32_t> mergedInto;
+			MergeSubMeshes(atlasModel, keys, mergedInto);
+			vector<shared_ptr<Material>> mergedMaterials(atlasModel.SubMeshes.size());
+			vector<bool> drawn(atlasModel.SubMeshes.size(), false);
+			for (size_t s = 0; s < subMeshMaterials.size(); s++)
+			{
+				if (!drawn[mergedInto[s]])
+				{
+					drawn[mergedInto[s]] = true;
+					mergedMaterials[mergedInto[s]] = subMeshMaterials[s];
+				}
+				else if (subMeshMaterials[s])
+				{
+					ReleaseMaterialReference(subMeshMaterials[s]->GetMaterialName());
+				}
+			}
+			subMeshMaterials = move(mergedMaterials);
+		}
+	}
+
+	// Now we have created all of the materials, build up the mesh.  The geometry for all of the sub-meshes
+	// (including their levels of detail) is packed into one vertex buffer and one index buffer owned by
+	// the mesh.  Each sub-mesh just records where its data starts in those buffers.
+	shared_ptr<Mesh> resourceMesh = make_shared<Mesh>();
+	resourceMesh->SetImportProfile(model.ImportProfile);
+	vector<Matrix> nodeModelTransformations(meshModel->Nodes.size());
+	for (size_t n = 0; n < meshModel->Nodes.size(); n++)
+	{
+		const CookedNode& cookedNode = meshModel->Nodes[n];
+		MeshNode node;
+		node.Name = s2ws(cookedNode.Name);
+		node.LocalTransformation = Matrix(cookedNode.LocalTransformation);
+		node.Parent = cookedNode.Parent;
+		// Parents come before their children, so the parent's model transformation is already known
+		nodeModelTransformations[n] = node.Parent < 0 ? node.LocalTransformation : node.LocalTransformation * nodeModelTransformations[node.Parent];
+		for (uint32_t s : cookedNode.SubMeshes)
+		{
+			const CookedSubMesh& cookedSubMesh = meshModel->SubMeshes[s];
+			// Any missing normals were generated when the model was built
+			shared_ptr<SubMesh> resourceSubMesh = make_shared<SubMesh>(cookedSubMesh.BaseVertex, cookedSubMesh.VertexCount,
+																	   cookedSubMesh.LodLevels[0].StartIndex, cookedSubMesh.LodLevels[0].IndexCount,
+																	   subMeshMaterials[s], true, cookedSubMesh.HasTexCoords != 0);
+			BoundingBox boundingBox;
+			BoundingBox::CreateFromPoints(boundingBox,
+										  XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(cookedSubMesh.BoxMinimum)),
+										  XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(cookedSubMesh.BoxMaximum)));
+			resourceSubMesh->SetBounds(boundingBox, BoundingSphere(boundingBox.Center, cookedSubMesh.SphereRadius));
+			for (size_t lod = 1; lod < cookedSubMesh.LodLevels.size(); lod++)
+			{
+				const CookedLodLevel& lodLevel = cookedSubMesh.LodLevels[lod];
+				resourceSubMesh->AddLodLevel(lodLevel.StartIndex, lodLevel.IndexCount, lodLevel.Error);
+			}
+			node.SubMeshes.push_back(static_cast<UINT>(resourceMesh->GetSubMeshCount()));
+			resourceMesh->AddSubMesh(resourceSubMesh, nodeModelTransformations[n]);
+		}
+		resourceMesh->AddNode(node);
+	}
+	if (model.Vertices.empty())
+	{
+		// None of the nodes draw anything
+		return nullptr;
+	}
+
+	D3D11_BUFFER_DESC vertexBufferDescriptor;
+	vertexBufferDescriptor.Usage = D3D11_USAGE_IMMUTABLE;
+	vertexBufferDescriptor.ByteWidth = static_cast<UINT>(sizeof(Vertex) * meshModel->Vertices.size());
+	vertexBufferDescriptor.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	vertexBufferDescriptor.CPUAccessFlags = 0;
+	vertexBufferDescriptor.MiscFlags = 0;
+	vertexBufferDescriptor.StructureByteStride = 0;
+
+	// Now set up a structure that tells DirectX where to get the
+	// data for the vertices from
+	D3D11_SUBRESOURCE_DATA vertexInitialisationData;
+	vertexInitialisationData.pSysMem = meshModel->Vertices.data();
+
+	// and create the vertex buffer
+	if (FAILED(_device->CreateBuffer(&vertexBufferDescriptor, &vertexInitialisationData, vertexBuffer.GetAddressOf())))
+	{
+		return nullptr;
+	}
+
+	// Setup the structure that specifies how big the index 
+	// buffer should be
+	D3D11_BUFFER_DESC indexBufferDescriptor;
+	indexBufferDescriptor.Usage = D3D11_USAGE_IMMUTABLE;
+	indexBufferDescriptor.ByteWidth = static_cast<UINT>(sizeof(UINT) * meshModel->Indices.size());
+	indexBufferDescriptor.BindFlags = D3D11_BIND_INDEX_BUFFER;
+	indexBufferDescriptor.CPUAccessFlags = 0;
+	indexBufferDescriptor.MiscFlags = 0;
+	indexBufferDescriptor.StructureByteStride = 0;
+
+	// Now set up a structure that tells DirectX where to get the
+	// data for the indices from
+	D3D11_SUBRESOURCE_DATA indexInitialisationData;
+	indexInitialisationData.pSysMem = meshModel->Indices.data();
+
+	// and create the index buffer
+	if (FAILED(_device->CreateBuffer(&indexBufferDescriptor, &indexInitialisationData, indexBuffer.GetAddressOf())))
+	{
+		return nullptr;
+	}
+	resourceMesh->SetBuffers(vertexBuffer, indexBuffer);
+	return resourceMesh;
+}
+
+HRESULT ResourceManager::GetShaderByteCode(wstring_view fileName, const char* entryPoint, const char* target, ID3DBlob** byteCode, ID3DBlob** compilationMessages)
+{
+	if (_preloadRecording)
+	{
+		RecordPreloadRequest(PreloadType::Shader, ws2s(fileName), entryPoint, target);
+	}
+	tuple<wstring, string, string> key(wstring(fileName), entryPoint, target);
+	CompiledShader shader;
+	bool compiled = false;
+	{
+		lock_guard<mutex> lock(_shaderMutex);
+		map<tuple<wstring, string, string>, CompiledShader>::iterator compiledShader = _compiledShaders.find(key);
+		if (compiledShader != _compiledShaders.end())
+		{
+			shader = compiledShader->second;
+			compiled = true;
+		}
+	}
+	HRESULT hr = S_OK;
+	if (!compiled)
+	{
+		DWORD shaderCompileFlags = 0;
+#if defined( _DEBUG )
+		shaderCompileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+		hr = D3DCompileFromFile(get<0>(key).c_str(),
+			nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE,
+			entryPoint, target,
+			shaderCompileFlags, 0,
+			shader.ByteCode.GetAddressOf(),
+			shader.CompilationMessages.GetAddressOf());
+		if (SUCCEEDED(hr))
+		{
+			// If another thread has compiled the same shader in the meantime, either copy will do
+			lock_guard<mutex> lock(_shaderMutex);
+			_compiledShaders.emplace(key, shader);
+		}
+	}
+	shader.ByteCode.CopyTo(byteCode);
+	if (compilationMessages)
+	{
+		shader.CompilationMessages.CopyTo(compilationMessages);
+	}
+	return hr;
+}
+
+ComPtr<ID3DBlob> ResourceManager::CompileShader(wstring_view fileName, const char* entryPoint, const char* target)
+{
+	ComPtr<ID3DBlob> byteCode;
+	ComPtr<ID3DBlob> compilationMessages;
+	HRESULT hr = GetShaderByteCode(fileName, entryPoint, target, byteCode.GetAddressOf(), compilationMessages.GetAddressOf());
+	if (compilationMessages)
+	{
+		OutputDebugStringA(static_cast<const char*>(compilationMessages->GetBufferPointer()));
+	}
+	if (FAILED(hr))
+	{
+		return nullptr;
+	}
+	return byteCode;
+}
+
+void ResourceManager::WatchMesh(wstring_view modelName, const string& importProfile)
+{
+	if (!_hotReloader.IsEnabled())
+	{
+		return;
+	}
+	// The mesh is rebuilt if either the source model or its cooked version changes (see LoadCookedModel)
+	wstring cookedName(modelName);
+	cookedName += s2ws(CookedModelExtension);
+	InternedName name(modelName);
+	for (wstring_view fileName : { modelName, wstring_view(cookedName) })
+	{
+		if (!_archive.Contains(ws2s(fileName)))
+		{
+			_hotReloader.WatchMesh(fileName, name, importProfile);
+		}
+	}
+}
+
+void ResourceManager::WatchTexture(wstring_view textureName, const InternedName& materialName)
+{
+	if (_hotReloader.IsEnabled() && !textureName.empty() && !_archive.Contains(ws2s(textureName)))
+	{
+		_hotReloader.WatchMaterial(textureName, materialName);
+	}
+}
+
+void ResourceManager::WatchAtlasTexture(wstring_view textureName, wstring_view modelName, const string& importProfile)
+{
+	if (_hotReloader.IsEnabled() && !_archive.Contains(ws2s(textureName)))
+	{
+		_hotReloader.WatchMesh(textureName, InternedName(modelName), importProfile);
+	}
+}
+
+void ResourceManager::ReloadFile(const string& fileName, const WatchedFile& file)
+{
+	auto reloadStart = chrono::steady_clock::now();
+	size_t reloadedCount = 0;
+	for (const pair<InternedName, string>& mesh : file.Meshes)
+	{
+		if (ReloadMesh(mesh.first, mesh.second))
+		{
+			reloadedCount++;
+		}
+	}
+	if (!file.Materials.empty())
+	{
+		// The texture is loaded once (through the texture cache) and given to every material that uses it
+		// The textures already loaded from the file stay loaded for the materials using them (and for any other
+		// file with the same old contents) until those materials are given the new one
+		wstring textureName = s2ws(fileName);
+		_textureCache.ForgetFile(GetCanonicalTextureName(textureName));
+		for (const InternedName& materialName : file.Materials)
+		{
+			bool changed = ChangeMaterial(materialName, [&](Material& material)
+			{
+				// The material may have been given a different texture since it started using this one, or put
+				// it in an atlas (in which case the mesh that made the atlas has been reloaded above)
+				ComPtr<ID3D11ShaderResourceView> texture;
+				if (material.GetTextureName() == textureName && !material.IsInAtlas() &&
+					SUCCEEDED(AcquireMaterialTexture(materialName, textureName, texture)))
+				{
+					lock_guard<recursive_mutex> lock(_deviceContextMutex);
+					material.SetTexture(texture);
+				}
+			});
+			if (changed)
+			{
+				reloadedCount++;
+			}
+		}
+	}
+	{
+		// Shaders compiled from the file are compiled again when they are next asked for
+		wstring changedFileName = s2ws(fileName);
+		lock_guard<mutex> lock(_shaderMutex);
+		for (map<tuple<wstring, string, string>, CompiledShader>::iterator shader = _compiledShaders.begin(); shader != _compiledShaders.end(); )
+		{
+			shader = get<0>(shader->first) == changedFileName ? _compiledShaders.erase(shader) : next(shader);
+		}
+	}
+	EnforceMemoryBudget();
+	double reloadMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - reloadStart).count();
+	stringstream report;
+	report << fixed << setprecision(2)
+		   << "Hot reload: " << fileName << " changed, reloaded " << reloadedCount << " resources in " << reloadMilliseconds << "ms\n";
+	OutputDebugStringA(report.str().c_str());
+}
+
+bool ResourceManager::ReloadMesh(const InternedName& modelName, const string& importProfile)
+{
+	// Hold a reference while the mesh is reloaded so that it cannot be evicted in the meantime.  If it has
+	// already been evicted, there is nothing to do since it will be loaded from the new file next time.
+	MeshResourceMap::EntryPointer resource = _meshResources.Find(modelName);
+	if (!resource || !(resource = _meshResources.Acquire(modelName, resource->LastUsed)))
+	{
+		return false;
+	}
+	bool reloaded = false;
+	if (resource->WaitForLoad())
+	{
+		shared_ptr<Mesh> mesh = resource->ResourcePointer;
+		CookedModel model;
+		if (LoadModel(modelName.View(), importProfile, model))
+		{
+			// The scene graph built from the model refers to its nodes by index, so the hierarchy must not change.
+			// This is checked before the mesh is created, since creating it updates the materials in place.
+			bool sameNodes = model.Nodes.size() == mesh->GetNodeCount();
+			for (size_t i = 0; sameNodes && i < mesh->GetNodeCount(); i++)
+			{
+				sameNodes = s2ws(model.Nodes[i].Name) == mesh->GetNode(i).Name && model.Nodes[i].Parent == mesh->GetNode(i).Parent;
+			}
+			shared_ptr<Mesh> newMesh = sameNodes ? CreateMesh(modelName.View(), model, true) : nullptr;
+			if (newMesh)
+			{
+				{
+					lock_guard<recursive_mutex> lock(_deviceContextMutex);
+					mesh->Swap(*newMesh);
+				}
+				UpdateResourceSize(*resource, mesh->GetGpuMemorySize(), mesh->GetCpuMemorySize());
+				// After the swap, this releases the materials of the old sub-meshes
+				ReleaseMeshMaterials(*newMesh);
+				reloaded = true;
+			}
+			else if (!sameNodes)
+			{
+				OutputDebugStringA(("Hot reload: the node hierarchy of " + ws2s(modelName.View()) + " has changed, restart to see the changes\n").c_str());
+			}
+		}
+	}
+	if (resource->Release())
+	{
+		if (_keepWarm)
+		{
+			EnforceMemoryBudget();
+		}
+		else
+		{
+			EvictMesh(modelName);
+		}
+	}
+	return reloaded;
+}
+
+void ResourceManager::StartPreloadRecording()
+{
+	lock_guard<mutex> lock(_preloadMutex);
+	_preloadRequests.clear();
+	_preloadRecordStart = chrono::steady_clock::now();
+	_preloadRecording = true;
+}
+
+void ResourceManager::RecordPreloadRequest(PreloadType type, const string& name, const string& profile, const string& target)
+{
+	lock_guard<mutex> lock(_preloadMutex);
+	if (!_preloadRecording || chrono::steady_clock::now() - _preloadRecordStart > chrono::seconds(PreloadRecordSeconds))
+	{
+		return;
+	}
+	for (const PreloadRequest& request : _preloadRequests)
+	{
+		if (request.Type == type && request.Name == name && request.Profile == profile && request.Target == target)
+		{
+			return;
+		}
+	}
+	_preloadRequests.push_back(PreloadRequest{ type, name, profile, target });
+}
+
+// The manifest is a text file with a line for each request, in the order they were made:
+//
+//		mesh <import profile> <model name>
+//		texture <texture name>
+//		shader <entry point> <target> <file name>
+//
+// Names come last so that they can contain spaces.
+bool ResourceManager::SavePreloadManifest(wstring_view manifestName)
+{
+	stringstream manifest;
+	{
+		lock_guard<mutex> lock(_preloadMutex);
+		if (!_preloadRecording)
+		{
+			return false;
+		}
+		_preloadRecording = false;
+		for (const PreloadRequest& request : _preloadRequests)
+		{
+			switch (request.Type)
+			{
+			case PreloadType::Mesh:
+				manifest << "mesh " << request.Profile << " " << request.Name << "\n";
+				break;
+			case PreloadType::Texture:
+				manifest << "texture " << request.Name << "\n";
+				break;
+			case PreloadType::Shader:
+				manifest << "shader " << request.Profile << " " << request.Target << " " << request.Name << "\n";
+				break;
+			}
+		}
+	}
+	// Write the new manifest alongside the old one and then replace it, so that a damaged manifest is never left behind
+	filesystem::path manifestPath(manifestName);
+	filesystem::path temporaryPath = manifestPath;
+	temporaryPath += L".tmp";
+	{
+		ofstream file(temporaryPath, ios::binary | ios::trunc);
+		file << manifest.str();
+		if (!file)
+		{
+			return false;
+		}
+	}
+	error_code error;
+	filesystem::rename(temporaryPath, manifestPath, error);
+	return !error;
+}
+
+bool ResourceManager::Preload(wstring_view manifestName)
+{
+	ifstream manifest(filesystem::path(manifestName), ios::binary);
+	if (!manifest)
+	{
+		return false;
+	}
+	auto preloadStart = chrono::steady_clock::now();
+	vector<PreloadRequest> requests;
+	string line;
+	while (getline(manifest, line))
+	{
+		istringstream fields(line);
+		string type;
+		PreloadRequest request;
+		fields >> type;
+		if (type == "mesh")
+		{
+			request.Type = PreloadType::Mesh;
+			fields >> request.Profile;
+		}
+		else if (type == "texture")
+		{
+			request.Type = PreloadType::Texture;
+		}
+		else if (type == "shader")
+		{
+			request.Type = PreloadType::Shader;
+			fields >> request.Profile >> request.Target;
+		}
+		else
+		{
+			continue;
+		}
+		fields >> ws;
+		getline(fields, request.Name);
+		if (!request.Name.empty())
+		{
+			requests.push_back(request);
+		}
+	}
+
+	// Work out which files are going to be read and sort them into the order they are stored: assets in the
+	// archive by where they are in it, then loose files by name, which keeps files in the same directory together
+	struct PreloadFile
+	{
+		string			Name;
+		bool			InArchive;
+		uint64_t		Offset;
+		// The contents are kept for LoadTexture and LoadCookedModel.  Other files (source models and shaders,
+		// which are read by Assimp and the shader compiler) are only read so that they are in the file cache.
+		bool			Keep;
+	};
+	vector<PreloadFile> files;
+	auto addFile = [&](const string& name, bool keep)
+	{
+		for (const PreloadFile& file : files)
+		{
+			if (file.Name == name)
+			{
+				return;
+			}
+		}
+		PreloadFile file{ name, false, 0, keep };
+		file.InArchive = _archive.GetAssetOffset(name, file.Offset);
+		files.push_back(file);
+	};
+	for (const PreloadRequest& request : requests)
+	{
+		if (request.Type == PreloadType::Mesh)
+		{
+			addFile(request.Name, false);
+			addFile(request.Name + CookedModelExtension, true);
+		}
+		else
+		{
+			addFile(request.Name, request.Type == PreloadType::Texture);
+		}
+	}
+	sort(files.begin(), files.end(), [](const PreloadFile& first, const PreloadFile& second)
+	{
+		if (first.InArchive != second.InArchive)
+		{
+			return first.InArchive;
+		}
+		return first.InArchive ? first.Offset < second.Offset : first.Name < second.Name;
+	});
+
+	size_t bytesRead = 0;
+	for (const PreloadFile& file : files)
+	{
+		vector<uint8_t> contents;
+		if (file.InArchive)
+		{
+			const uint8_t* data;
+			size_t size;
+			if (_archive.Find(file.Name, data, size))
+			{
+				// The asset is used straight from the mapping of the archive, so just touch each page of it to
+				// have the operating system read it now
+				volatile uint8_t page;
+				for (size_t offset = 0; offset < size; offset += 4096)
+				{
+					page = data[offset];
+				}
+				bytesRead += size;
+				continue;
+			}
+			if (!file.Keep || !_archive.Read(file.Name, contents))
+			{
+				continue;
+			}
+		}
+		else if (!ReadFileContents(file.Name, contents))
+		{
+			continue;
+		}
+		bytesRead += contents.size();
+		if (file.Keep)
+		{
+			lock_guard<mutex> lock(_preloadMutex);
+			_preloadedFiles[file.Name] = move(contents);
+		}
+	}
+
+	// Now load the meshes and compile the shaders in parallel.  Meshes take the longest, so start them first.
+	stable_sort(requests.begin(), requests.end(), [](const PreloadRequest& first, const PreloadRequest& second)
+	{
+		return first.Type < second.Type;
+	});
+	atomic<size_t> meshCount(0);
+	atomic<size_t> shaderCount(0);
+	ParallelFor(requests.size(), 1, [&](size_t begin, size_t end)
+	{
+		// Textures are loaded with WIC, which needs COM on each thread
+		HRESULT comInitialised = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+		for (size_t i = begin; i < end; i++)
+		{
+			const PreloadRequest& request = requests[i];
+			if (request.Type == PreloadType::Mesh)
+			{
+				wstring modelName = s2ws(request.Name);
+				if (GetMesh(modelName, request.Profile))
+				{
+					lock_guard<mutex> lock(_preloadMutex);
+					_preloadedMeshes.push_back(modelName);
+					meshCount++;
+				}
+			}
+			else if (request.Type == PreloadType::Shader)
+			{
+				ComPtr<ID3DBlob> byteCode;
+				if (SUCCEEDED(GetShaderByteCode(s2ws(request.Name), request.Profile.c_str(), request.Target.c_str(), byteCode.GetAddressOf())))
+				{
+					shaderCount++;
+				}
+			}
+		}
+		if (SUCCEEDED(comInitialised))
+		{
+			CoUninitialize();
+		}
+	});
+
+	double preloadMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - preloadStart).count();
+	stringstream report;
+	report << fixed << setprecision(2)
+		   << "Preload: read " << files.size() << " files (" << bytesRead / (1024.0 * 1024.0) << "MB), loaded "
+		   << meshCount << " meshes and compiled " << shaderCount << " shaders in " << preloadMilliseconds << "ms\n";
+	OutputDebugStringA(report.str().c_str());
+	return true;
+}
+
+void ResourceManager::FinishPreload()
+{
+	vector<wstring> meshes;
+	map<string, vector<uint8_t>> unusedFiles;
+	{
+		lock_guard<mutex> lock(_preloadMutex);
+		meshes.swap(_preloadedMeshes);
+		unusedFiles.swap(_preloadedFiles);
+	}
+	// Anything that the scene did not ask for is unloaded as usual
+	for (const wstring& modelName : meshes)
+	{
+		ReleaseMesh(modelName);
+	}
+}
+
+bool ResourceManager::TakePreloadedFile(const string& fileName, vector<uint8_t>& contents)
+{
+	lock_guard<mutex> lock(_preloadMutex);
+	map<string, vector<uint8_t>>::iterator preloadedFile = _preloadedFiles.find(fileName);
+	if (preloadedFile == _preloadedFiles.end())
+	{
+		return false;
+	}
+	contents = move(preloadedFile->second);
+	_preloadedFiles.erase(preloadedFile);
+	return true;
+}
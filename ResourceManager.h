@@ -1,51 +1,310 @@
-#pragma once
-#include "Mesh.h"
-#include <map>
-#include <assimp\importer.hpp>
-#include <assimp\scene.h>
-#include <assimp\postprocess.h>
-
-using namespace Assimp;
-
-struct MeshResourceStruct
-{
-	unsigned int			ReferenceCount;
-	shared_ptr<Mesh>		MeshPointer;
-};
-
-typedef map<wstring, MeshResourceStruct>		MeshResourceMap;
-
-struct MaterialResourceStruct
-{
-	unsigned int			ReferenceCount;
-	shared_ptr<Material>	MaterialPointer;
-};
-
-typedef map<wstring, MaterialResourceStruct>	MaterialResourceMap;
-
-class ResourceManager
-{
-public:
-	ResourceManager();
-	~ResourceManager();
-				
-	shared_ptr<Mesh>							GetMesh(wstring modelName);
-	void										ReleaseMesh(wstring modelName);
-
-	void										CreateMaterialFromTexture(wstring textureName);
-    void										CreateMaterialWithNoTexture(wstring materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity);
-    void										CreateMaterial(wstring materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring textureName);
-	shared_ptr<Material>						GetMaterial(wstring materialName);
-	void										ReleaseMaterial(wstring materialName);
-
-private:
-	MeshResourceMap								_meshResources;
-	MaterialResourceMap							_materialResources;
-
-	ComPtr<ID3D11Device>						_device;
-	ComPtr<ID3D11DeviceContext>					_deviceContext;
-
-	shared_ptr<Mesh>							LoadModelFromFile(wstring modelName);
-    void										InitialiseMaterial(wstring materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring textureName);
-};
-
+#pragma once
+#include "Mesh.h"
+#include "ModelImporter.h"
+#include "CookedModel.h"
+#include "InternedName.h"
+#include "ConcurrentResourceMap.h"
+#include "TextureDiskCache.h"
+#include "TextureCache.h"
+#include "TextureStreamer.h"
+#include "HotReloader.h"
+#include <chrono>
+#include <functional>
+#include <map>
+#include <tuple>
+
+// Archive that is mounted at startup if it exists
+#define DefaultAssetArchiveName			L"assets.pak"
+
+// Memory budget for loaded resources that is used when resources are kept warm
+#define DefaultResourceMemoryBudget		(256 * 1024 * 1024)
+
+// How textures are block compressed when they are loaded (see TextureCompression)
+#define DefaultTextureCompression		TextureCompression::BC1OrBC3
+
+// Largest width or height of a loaded texture (0 for the largest the device supports)
+#define DefaultMaximumTextureSize		0
+
+// Whether the small textures of a model are put into a texture atlas when it is loaded
+#define DefaultTextureAtlasing			true
+
+// Directory of the texture disk cache that is opened at startup, and the most disk space it uses (see
+// OpenTextureDiskCache)
+#define DefaultTextureDiskCacheName		L"texturecache"
+#define DefaultTextureDiskCacheSize		(512 * 1024 * 1024)
+
+// Preload manifest that is read at startup and written when the application exits
+#define DefaultPreloadManifestName		L"preload.manifest"
+// Requests made during this long after recording starts are written to the preload manifest
+#define PreloadRecordSeconds			10
+
+// Memory held by a resource is measured when it is loaded.  LastUsed is the value of the resource manager's
+// use counter the last time the resource was requested or released, which orders the resources for eviction.
+
+typedef ResourceEntry<Mesh>						MeshResourceStruct;
+typedef ConcurrentResourceMap<Mesh>				MeshResourceMap;
+
+typedef ResourceEntry<Material>					MaterialResourceStruct;
+typedef ConcurrentResourceMap<Material>			MaterialResourceMap;
+
+// Block compression applied to 8-bit textures whose size is a multiple of 4 when they are loaded.  BC1 and
+// BC3 are quick to compress; BC7 looks better (especially with alpha) but takes longer and needs feature
+// level 11.  Textures whose format cannot be compressed are loaded as they are.
+enum class TextureCompression
+{
+	None,
+	// BC1 if the texture is opaque, otherwise BC3
+	BC1OrBC3,
+	BC7
+};
+
+// Memory held by the resources that are currently loaded
+struct ResourceMemoryUsage
+{
+	size_t					GpuBytes;
+	size_t					CpuBytes;
+	// The part of GpuBytes and CpuBytes held by resources that nothing references (i.e. that are being kept warm)
+	size_t					UnreferencedBytes;
+	size_t					MeshCount;
+	size_t					MaterialCount;
+};
+
+// The resource manager can be used from any thread.  Loader threads must initialise COM before loading
+// anything with textures, since textures are loaded with WIC.  Textures are decoded and created without
+// the immediate device context, except for the few formats whose mip maps are generated on the GPU.  The
+// immediate context is not thread-safe, so anything using it while resources might be loading on another
+// thread (and anything changing what the renderer draws with) must hold GetDeviceContextMutex().
+
+class ResourceManager
+{
+public:
+	ResourceManager();
+	~ResourceManager();
+				
+	// importProfile names the Assimp post-processing profile used if the model needs to be loaded (see ModelImporter.h).
+	// A model can only be loaded with one profile at a time (its materials are named after the model), so this
+	// returns nullptr if the model is already loaded with a different profile.
+	shared_ptr<Mesh>							GetMesh(wstring_view modelName, const string& importProfile = DefaultImportProfile);
+	void										ReleaseMesh(wstring_view modelName);
+
+	void										CreateMaterialFromTexture(wstring_view textureName);
+    void										CreateMaterialWithNoTexture(wstring_view materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity);
+    void										CreateMaterial(wstring_view materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring_view textureName);
+	shared_ptr<Material>						GetMaterial(wstring_view materialName);
+	shared_ptr<Material>						GetMaterial(const InternedName& materialName);
+	void										ReleaseMaterial(wstring_view materialName);
+	void										ReleaseMaterial(const InternedName& materialName);
+
+	// By default, a resource is unloaded as soon as nothing references it.  If keep warm is turned on,
+	// unreferenced resources stay loaded so that they can be reused, and the least recently used of them are
+	// unloaded when the memory held by all resources (GPU and CPU) goes over the budget.  Resources that
+	// are still referenced are never unloaded, so the budget can be exceeded if they need more memory.
+	void										SetKeepWarm(bool keepWarm);
+	inline bool									GetKeepWarm() { return _keepWarm; }
+	void										SetMemoryBudget(size_t budgetBytes);
+	inline size_t								GetMemoryBudget() { return _memoryBudget; }
+
+	ResourceMemoryUsage							GetMemoryUsage();
+	inline size_t								GetResidentBytes() { return _gpuBytes + _textureCache.GetGpuBytes() + _cpuBytes; }
+
+	inline recursive_mutex&						GetDeviceContextMutex() { return _deviceContextMutex; }
+
+	// Once an asset archive has been mounted, models and textures are loaded from it if it contains them and
+	// from loose files otherwise.  Mount the archive before anything is loaded.
+	bool										MountArchive(wstring_view archiveName);
+	inline const AssetArchive&					GetArchive() { return _archive; }
+
+	// Once the texture disk cache has been opened, textures made from images (rather than DDS files) are
+	// stored in it, as the loader made them, the first time they are loaded, and later loads of the same
+	// image with the same settings (even in later runs) use the stored texture instead of decoding the
+	// image again (see TextureDiskCache.h).  The directory is made if it does not exist.
+	bool										OpenTextureDiskCache(wstring_view directoryName, size_t sizeLimit = DefaultTextureDiskCacheSize);
+	inline TextureDiskCacheStatistics			GetTextureDiskCacheStatistics() { return _textureDiskCache.GetStatistics(); }
+
+	// Load a texture from the archive or from a file
+	HRESULT										LoadTexture(wstring_view textureName, ID3D11ShaderResourceView** texture);
+	// Only affects textures loaded afterwards
+	inline void									SetTextureCompression(TextureCompression compression) { _textureCompression = compression; }
+	inline TextureCompression					GetTextureCompression() { return _textureCompression; }
+	// Textures bigger than this are shrunk when they are loaded (see ImageResampler.h), or lose their top mip
+	// levels if they are DDS files.  Lowering it trades texture detail for memory.  Only affects textures
+	// loaded afterwards.
+	inline void									SetMaximumTextureSize(size_t size) { _maximumTextureSize = size; }
+	inline size_t								GetMaximumTextureSize() { return _maximumTextureSize; }
+	// When a model is loaded, the BMP, TGA and PNG textures of its materials that are small enough and are not
+	// repeated across its sub-meshes are packed into one texture atlas (see TextureAtlas.h) and the texture
+	// coordinates of the sub-meshes are mapped into it, so the sub-meshes all draw with the same texture.
+	// Only affects models loaded afterwards.
+	inline void									SetTextureAtlasing(bool atlasing) { _textureAtlasing = atlasing; }
+	inline bool									GetTextureAtlasing() { return _textureAtlasing; }
+
+	// The textures of materials are shared: a texture is only loaded once however many materials use it (see
+	// TextureCache.h).  Textures put in an atlas are not shared.
+	inline TextureCacheStatistics				GetTextureCacheStatistics() { return _textureCache.GetStatistics(); }
+
+	// When texture streaming is turned on, textures from the texture cache are loaded small at first and a
+	// background thread loads them again in more detail as they are needed, within the texture memory budget
+	// (see TextureStreamer.h).  The textures are put into the materials using them as they are loaded.
+	inline void									EnableTextureStreaming() { _textureStreamer.Enable(); }
+	inline void									DisableTextureStreaming() { _textureStreamer.Disable(); }
+	inline bool									IsTextureStreamingEnabled() { return _textureStreamer.IsEnabled(); }
+	inline void									SetTextureMemoryBudget(size_t budgetBytes) { _textureStreamer.SetMemoryBudget(budgetBytes); }
+	inline size_t								GetTextureMemoryBudget() { return _textureStreamer.GetMemoryBudget(); }
+
+	// When hot reload is turned on, the files that loaded meshes and materials came from are watched and a
+	// background thread reloads them when they change (see HotReloader.h).  A reloaded mesh is swapped into the Mesh object that
+	// is already in use and a reloaded texture is put into the Material objects that use it, so everything
+	// holding them picks up the change on the next frame.  Only the resources that came from the changed
+	// file are touched.  A model whose node hierarchy has changed is not reloaded, since the scene graph
+	// built from it (see ModelNode::CreateModel) would no longer match.  Files that are read from the asset
+	// archive never change while it is mounted.
+	inline void									EnableHotReload() { _hotReloader.Enable(); }
+	inline void									DisableHotReload() { _hotReloader.Disable(); }
+	inline bool									IsHotReloadEnabled() { return _hotReloader.IsEnabled(); }
+
+	// Number of times a file has changed since it was first asked about.  When hot reload is on, asking
+	// about a file starts watching it, so users of files that the resource manager does not load itself
+	// (such as shaders) can tell when they need to reload them.  Always 0 when hot reload is off.
+	inline unsigned int							GetFileVersion(wstring_view fileName) { return _hotReloader.GetFileVersion(fileName); }
+
+	// Compile a shader from a file.  The byte code is kept, so each shader is only compiled once however many
+	// nodes use it (until its file changes, if hot reload is on).  Works like D3DCompileFromFile:
+	// compilationMessages (which can be nullptr) is set to the compiler's messages, or nullptr if there were none.
+	HRESULT										GetShaderByteCode(wstring_view fileName, const char* entryPoint, const char* target, ID3DBlob** byteCode, ID3DBlob** compilationMessages = nullptr);
+	// Returns nullptr (and writes the compiler's messages to the debugger output) if the shader does not
+	// compile, so that a shader with an error in it can be reloaded without stopping the application.
+	ComPtr<ID3DBlob>							CompileShader(wstring_view fileName, const char* entryPoint, const char* target);
+
+	// Startup preloading.  While recording, the meshes, textures and shaders that are asked for during the
+	// first PreloadRecordSeconds are noted, and SavePreloadManifest writes them to a manifest.  At the next
+	// start, Preload reads the files named in the manifest in the order they are stored on disk (archive
+	// assets by their offset in the archive), then loads the meshes (with their materials) and compiles the
+	// shaders in parallel, so by the time the scene asks for them they are already there.  Textures that do
+	// not belong to a mesh are read but only decoded when they are asked for.  The preloaded meshes are held
+	// until FinishPreload is called, which should be done once the scene has been created.
+	bool										Preload(wstring_view manifestName);
+	void										FinishPreload();
+	void										StartPreloadRecording();
+	bool										SavePreloadManifest(wstring_view manifestName);
+
+private:
+	MeshResourceMap								_meshResources;
+	MaterialResourceMap							_materialResources;
+	AssetArchive								_archive;
+	TextureDiskCache							_textureDiskCache;
+	atomic<bool>								_keepWarm;
+	atomic<size_t>								_memoryBudget;
+	atomic<size_t>								_gpuBytes;
+	atomic<size_t>								_cpuBytes;
+	atomic<unsigned long long>					_useCounter;
+	atomic<TextureCompression>					_textureCompression;
+	atomic<size_t>								_maximumTextureSize;
+	atomic<bool>								_textureAtlasing;
+	// Only one thread at a time enforces the budget
+	mutex										_budgetMutex;
+	recursive_mutex								_deviceContextMutex;
+
+	ComPtr<ID3D11Device>						_device;
+	ComPtr<ID3D11DeviceContext>					_deviceContext;
+
+	TextureCache								_textureCache;
+	TextureStreamer								_textureStreamer;
+	HotReloader									_hotReloader;
+
+	// Compiled shaders keyed by file name, entry point and target
+	struct CompiledShader
+	{
+		ComPtr<ID3DBlob>						ByteCode;
+		ComPtr<ID3DBlob>						CompilationMessages;
+	};
+
+	mutex										_shaderMutex;
+	map<tuple<wstring, string, string>, CompiledShader>	_compiledShaders;
+
+	enum class PreloadType
+	{
+		Mesh,
+		Texture,
+		Shader
+	};
+
+	// A request noted in the preload manifest.  For meshes, Profile is the import profile.  For shaders,
+	// Profile is the entry point and Target is the shader target.
+	struct PreloadRequest
+	{
+		PreloadType								Type;
+		string									Name;
+		string									Profile;
+		string									Target;
+	};
+
+	mutex										_preloadMutex;
+	atomic<bool>								_preloadRecording;
+	chrono::steady_clock::time_point			_preloadRecordStart;
+	vector<PreloadRequest>						_preloadRequests;
+	// Contents of the files read by Preload, until they are used
+	map<string, vector<uint8_t>>				_preloadedFiles;
+	// Meshes that Preload holds a reference to
+	vector<wstring>								_preloadedMeshes;
+
+	shared_ptr<Mesh>							LoadModelFromFile(wstring_view modelName, const string& importProfile);
+	// Load the cooked version of a model, or import and build it if there is not an up to date one
+	bool										LoadModel(wstring_view modelName, const string& importProfile, CookedModel& model);
+	// Load the cooked version of a model (see CookedModel.h).  Returns false if there is not an up to date one.
+	bool										LoadCookedModel(wstring_view modelName, const string& importProfile, CookedModel& model);
+	// If reload is true, the materials of a mesh that is already loaded are updated rather than left alone
+	shared_ptr<Mesh>							CreateMesh(wstring_view modelName, const CookedModel& model, bool reload);
+	// Read a texture from the archive or from a file and pass its contents to use
+	HRESULT										ReadTexture(wstring_view textureName, const function<HRESULT(const uint8_t*, size_t)>& use);
+	// Create a texture from an image file's contents, with mipmaps and the texture compression that is set
+	// Textures bigger than maximumSize (0 for the largest the device supports) are shrunk, or lose mip levels.
+	HRESULT										CreateTextureFromMemory(const uint8_t* data, size_t size, size_t maximumSize, ID3D11ShaderResourceView** texture);
+	// The WIC loader flags for the texture compression that is set
+	unsigned int								GetTextureLoadFlags();
+	// Pack the textures of the materials of a model that can share an atlas into one.  atlasRegions is set to
+	// the region of each material's texture in the atlas (see Material::GetAtlasRegion), or all zero for the
+	// materials that are not in it.  Returns false if no atlas was made.
+	bool										BuildTextureAtlas(const CookedModel& model, const vector<wstring>& textureNames, const vector<bool>& candidates,
+																  ComPtr<ID3D11ShaderResourceView>& atlas, vector<Vector4>& atlasRegions);
+	// Give a material a texture from the texture cache, loading it if it is not already loaded, in place of the
+	// one it had.  If the texture cannot be loaded, the material keeps the one it had.
+	HRESULT										AcquireMaterialTexture(const InternedName& materialName, wstring_view textureName, ComPtr<ID3D11ShaderResourceView>& texture);
+	// Stop a material using the texture it got from the texture cache
+	void										ReleaseMaterialTexture(const InternedName& materialName);
+	string										GetCanonicalTextureName(wstring_view textureName);
+	// Load a texture in the cache again with the given largest width or height and give it to the materials using
+	// it (for the texture streamer)
+	bool										ResizeCachedTexture(const shared_ptr<CachedTexture>& texture, size_t size);
+	// Pixels across the biggest sub-mesh drawn with a material since the texture streamer last asked
+	float										TakeMaterialScreenSize(const wstring& materialName);
+	// GPU memory accounted to a material.  Textures from the texture cache are shared, so they are accounted
+	// for by the cache instead.
+	size_t										GetMaterialGpuBytes(Material& material);
+	// If atlas is not nullptr, the material uses it (with the given region) rather than loading its texture
+    void										InitialiseMaterial(wstring_view materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring_view textureName,
+																   ComPtr<ID3D11ShaderResourceView> atlas = nullptr, const Vector4& atlasRegion = Vector4::Zero);
+	// Returns false if the material is not loaded
+	bool										UpdateMaterial(const InternedName& materialName, Vector4 diffuseColour, Vector4 specularColour, float shininess, float opacity, wstring_view textureName,
+															   ComPtr<ID3D11ShaderResourceView> atlas = nullptr, const Vector4& atlasRegion = Vector4::Zero);
+	bool										ChangeMaterial(const InternedName& materialName, const function<void(Material&)>& change);
+	void										EvictMesh(const InternedName& modelName);
+	void										ReleaseMeshMaterials(Mesh& mesh);
+	bool										ReleaseMaterialReference(const InternedName& materialName);
+	void										EvictMaterial(const InternedName& materialName);
+	void										EnforceMemoryBudget();
+	template<typename TResource>
+	void										UpdateResourceSize(ResourceEntry<TResource>& resource, size_t gpuBytes, size_t cpuBytes);
+
+	// Note the files that resources are loaded from for hot reload (files in the archive are not watched)
+	void										WatchMesh(wstring_view modelName, const string& importProfile);
+	void										WatchTexture(wstring_view textureName, const InternedName& materialName);
+	// Reload a mesh when a texture it has put in an atlas changes, since the atlas has to be made again
+	void										WatchAtlasTexture(wstring_view textureName, wstring_view modelName, const string& importProfile);
+	// Reload the resources that came from a file that has changed (for the hot reloader)
+	void										ReloadFile(const string& fileName, const WatchedFile& file);
+	bool										ReloadMesh(const InternedName& modelName, const string& importProfile);
+	void										RecordPreloadRequest(PreloadType type, const string& name, const string& profile = "", const string& target = "");
+	// Take the contents of a file that Preload has read.  Returns false if it has not read it.
+	bool										TakePreloadedFile(const string& fileName, vector<uint8_t>& contents);
+};
+
@@ -0,0 +1,175 @@
+#pragma once
+#include "InternedName.h"
+#include <vector>
+
+// Open addressing hash map from resource names to resources, used by the ResourceManager.
+//
+// Keys are interned names, so the hash of a key never has to be recalculated and keys are compared by
+// pointer.  Lookups can also be made with a plain string view without creating a string or interning
+// the name.  Collisions are resolved by linear probing and entries are removed by shifting the rest of
+// the probe sequence back, so there are no tombstones to slow down later lookups.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+template<typename TValue>
+class ResourceMap
+{
+public:
+	ResourceMap() : _count(0)
+	{
+		_slots.resize(16);
+	}
+
+	TValue* Find(const InternedName& name)
+	{
+		size_t slot = FindSlot(name);
+		return slot == NotFound ? nullptr : &_slots[slot].Value;
+	}
+
+	TValue* Find(std::wstring_view name)
+	{
+		return Find(name, InternedName::HashName(name));
+	}
+
+	// hash must be InternedName::HashName(name)
+	TValue* Find(std::wstring_view name, size_t hash)
+	{
+		size_t slot = FindSlot(name, hash);
+		return slot == NotFound ? nullptr : &_slots[slot].Value;
+	}
+
+	// Returns the value for name, adding a default constructed value if there is not one already
+	TValue& operator[](const InternedName& name)
+	{
+		size_t slot = FindSlot(name);
+		if (slot != NotFound)
+		{
+			return _slots[slot].Value;
+		}
+		// Keep the table no more than half full so that probe sequences stay short
+		if ((_count + 1) * 2 > _slots.size())
+		{
+			Grow();
+		}
+		slot = InsertSlot(name);
+		_count++;
+		return _slots[slot].Value;
+	}
+
+	bool Erase(const InternedName& name)
+	{
+		return RemoveSlot(FindSlot(name));
+	}
+
+	bool Erase(std::wstring_view name)
+	{
+		return RemoveSlot(FindSlot(name, InternedName::HashName(name)));
+	}
+
+	inline size_t Size() const { return _count; }
+
+	// Call function(name, value) for every entry
+	template<typename TFunction>
+	void ForEach(const TFunction& function)
+	{
+		for (Slot& slot : _slots)
+		{
+			if (slot.Used)
+			{
+				function(slot.Name, slot.Value);
+			}
+		}
+	}
+
+private:
+	struct Slot
+	{
+		Slot() : Used(false) {}
+		InternedName	Name;
+		TValue			Value{};
+		bool			Used;
+	};
+
+	static const size_t NotFound = static_cast<size_t>(-1);
+
+	std::vector<Slot>	_slots;
+	size_t				_count;
+
+	size_t FindSlot(std::wstring_view name, size_t hash) const
+	{
+		size_t mask = _slots.size() - 1;
+		for (size_t slot = hash & mask; _slots[slot].Used; slot = (slot + 1) & mask)
+		{
+			if (_slots[slot].Name.Hash() == hash && _slots[slot].Name.View() == name)
+			{
+				return slot;
+			}
+		}
+		return NotFound;
+	}
+
+	// Interned names can be compared by pointer
+	size_t FindSlot(const InternedName& name) const
+	{
+		size_t mask = _slots.size() - 1;
+		for (size_t slot = name.Hash() & mask; _slots[slot].Used; slot = (slot + 1) & mask)
+		{
+			if (_slots[slot].Name == name)
+			{
+				return slot;
+			}
+		}
+		return NotFound;
+	}
+
+	bool RemoveSlot(size_t slot)
+	{
+		if (slot == NotFound)
+		{
+			return false;
+		}
+		// Backward shift deletion.  Move later entries of the probe sequence into the gap unless they are
+		// already between their home slot and the gap.
+		size_t mask = _slots.size() - 1;
+		size_t gap = slot;
+		for (size_t next = (gap + 1) & mask; _slots[next].Used; next = (next + 1) & mask)
+		{
+			size_t home = _slots[next].Name.Hash() & mask;
+			if (((next - home) & mask) >= ((next - gap) & mask))
+			{
+				_slots[gap] = std::move(_slots[next]);
+				gap = next;
+			}
+		}
+		_slots[gap] = Slot();
+		_count--;
+		return true;
+	}
+
+	size_t InsertSlot(const InternedName& name)
+	{
+		size_t mask = _slots.size() - 1;
+		size_t slot = name.Hash() & mask;
+		while (_slots[slot].Used)
+		{
+			slot = (slot + 1) & mask;
+		}
+		_slots[slot].Name = name;
+		_slots[slot].Used = true;
+		return slot;
+	}
+
+	void Grow()
+	{
+		std::vector<Slot> oldSlots(_slots.size() * 2);
+		oldSlots.swap(_slots);
+		for (Slot& oldSlot : oldSlots)
+		{
+			if (oldSlot.Used)
+			{
+				size_t slot = InsertSlot(oldSlot.Name);
+				_slots[slot].Value = std::move(oldSlot.Value);
+			}
+		}
+	}
+};
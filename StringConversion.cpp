@@ -0,0 +1,176 @@
+#include "StringConversion.h"
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+	const char32_t ReplacementCharacter = 0xFFFD;
+
+	// True if none of the eight bytes starting at text have their top bit set
+	inline bool IsAsciiBlock(const char* text)
+	{
+		uint64_t block;
+		memcpy(&block, text, sizeof(block));
+		return (block & 0x8080808080808080ull) == 0;
+	}
+
+	// Decode one character from a UTF-8 sequence that is not plain ASCII.  position is moved past it.
+	char32_t DecodeUtf8(const unsigned char* text, size_t length, size_t& position)
+	{
+		unsigned char lead = text[position++];
+		size_t continuationCount;
+		char32_t character;
+		char32_t minimum;
+		if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			continuationCount = 1;
+			character = lead & 0x1F;
+			minimum = 0x80;
+		}
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			continuationCount = 2;
+			character = lead & 0x0F;
+			minimum = 0x800;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			continuationCount = 3;
+			character = lead & 0x07;
+			minimum = 0x10000;
+		}
+		else
+		{
+			// Stray continuation byte or a lead byte that is never valid
+			return ReplacementCharacter;
+		}
+		for (size_t i = 0; i < continuationCount; i++)
+		{
+			if (position >= length || (text[position] & 0xC0) != 0x80)
+			{
+				// Truncated sequence.  Leave position at the byte that broke the sequence.
+				return ReplacementCharacter;
+			}
+			character = (character << 6) | (text[position++] & 0x3F);
+		}
+		if (character < minimum || character > 0x10FFFF || (character >= 0xD800 && character <= 0xDFFF))
+		{
+			// Overlong encoding, out of range or an encoded surrogate
+			return ReplacementCharacter;
+		}
+		return character;
+	}
+
+	inline void AppendWide(wstring& result, char32_t character)
+	{
+		if (sizeof(wchar_t) == 2 && character >= 0x10000)
+		{
+			character -= 0x10000;
+			result.push_back(static_cast<wchar_t>(0xD800 + (character >> 10)));
+			result.push_back(static_cast<wchar_t>(0xDC00 + (character & 0x3FF)));
+		}
+		else
+		{
+			result.push_back(static_cast<wchar_t>(character));
+		}
+	}
+
+	inline void AppendUtf8(string& result, char32_t character)
+	{
+		if (character < 0x80)
+		{
+			result.push_back(static_cast<char>(character));
+		}
+		else if (character < 0x800)
+		{
+			result.push_back(static_cast<char>(0xC0 | (character >> 6)));
+			result.push_back(static_cast<char>(0x80 | (character & 0x3F)));
+		}
+		else if (character < 0x10000)
+		{
+			result.push_back(static_cast<char>(0xE0 | (character >> 12)));
+			result.push_back(static_cast<char>(0x80 | ((character >> 6) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | (character & 0x3F)));
+		}
+		else
+		{
+			result.push_back(static_cast<char>(0xF0 | (character >> 18)));
+			result.push_back(static_cast<char>(0x80 | ((character >> 12) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | ((character >> 6) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | (character & 0x3F)));
+		}
+	}
+}
+
+wstring s2ws(string_view str)
+{
+	wstring result;
+	// Every UTF-8 sequence produces at most one wide character per byte
+	result.reserve(str.size());
+	const unsigned char* text = reinterpret_cast<const unsigned char*>(str.data());
+	size_t length = str.size();
+	size_t position = 0;
+	while (position < length)
+	{
+		// Copy runs of ASCII directly
+		while (position + 8 <= length && IsAsciiBlock(str.data() + position))
+		{
+			for (size_t i = 0; i < 8; i++)
+			{
+				result.push_back(static_cast<wchar_t>(text[position + i]));
+			}
+			position += 8;
+		}
+		if (position >= length)
+		{
+			break;
+		}
+		if (text[position] < 0x80)
+		{
+			result.push_back(static_cast<wchar_t>(text[position++]));
+		}
+		else
+		{
+			AppendWide(result, DecodeUtf8(text, length, position));
+		}
+	}
+	return result;
+}
+
+string ws2s(wstring_view wstr)
+{
+	string result;
+	result.reserve(wstr.size());
+	size_t length = wstr.size();
+	size_t position = 0;
+	while (position < length)
+	{
+		char32_t character = static_cast<char32_t>(wstr[position++]);
+		if (character < 0x80)
+		{
+			result.push_back(static_cast<char>(character));
+			continue;
+		}
+		if (sizeof(wchar_t) == 2 && character >= 0xD800 && character <= 0xDFFF)
+		{
+			// Combine a surrogate pair.  Unpaired surrogates cannot be represented in UTF-8.
+			if (character <= 0xDBFF && position < length &&
+				wstr[position] >= 0xDC00 && wstr[position] <= 0xDFFF)
+			{
+				character = 0x10000 + ((character - 0xD800) << 10) + (static_cast<char32_t>(wstr[position++]) - 0xDC00);
+			}
+			else
+			{
+				character = ReplacementCharacter;
+			}
+		}
+		else if (character > 0x10FFFF || (character >= 0xD800 && character <= 0xDFFF))
+		{
+			character = ReplacementCharacter;
+		}
+		AppendUtf8(result, character);
+	}
+	return result;
+}
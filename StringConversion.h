@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// Conversion between UTF-8 (used by Assimp and the C runtime) and wide strings (used by Windows and the
+// rest of the framework).  Wide strings are UTF-16 on Windows and UTF-32 elsewhere.
+//
+// Runs of ASCII characters, which make up almost all file and material names, are copied eight at a
+// time.  Invalid or truncated sequences are replaced by U+FFFD rather than causing an error.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+std::wstring	s2ws(std::string_view str);
+std::string		ws2s(std::wstring_view wstr);
@@ -0,0 +1,375 @@
+#include "TeapotGeometry.h"
+#include "ParallelFor.h"
+#include <vector>
+
+using namespace std;
+
+// The teapot is scaled by this and moved down (and slightly along x) so that it sits where the
+// hard-coded teapot used to be
+#define TeapotScale			0.5f
+#define TeapotOffsetX		-0.021127f
+#define TeapotOffsetY		-0.869322f
+
+namespace
+{
+	// Number of vertices handled by each task when the patches are spread across threads
+	const size_t BatchSize = 4096;
+
+	// Control points of the classic Newell teapot.  The data is z-up and only covers one quarter of the
+	// rim, body, lid and bottom and one half of the handle and spout.  The rest is made by reflection.
+	const float TeapotControlPoints[127][3] =
+	{
+		{ 0.2f, 0.0f, 2.7f }, { 0.2f, -0.112f, 2.7f }, { 0.112f, -0.2f, 2.7f }, { 0.0f, -0.2f, 2.7f },
+		{ 1.3375f, 0.0f, 2.53125f }, { 1.3375f, -0.749f, 2.53125f }, { 0.749f, -1.3375f, 2.53125f }, { 0.0f, -1.3375f, 2.53125f },
+		{ 1.4375f, 0.0f, 2.53125f }, { 1.4375f, -0.805f, 2.53125f }, { 0.805f, -1.4375f, 2.53125f }, { 0.0f, -1.4375f, 2.53125f },
+		{ 1.5f, 0.0f, 2.4f }, { 1.5f, -0.84f, 2.4f }, { 0.84f, -1.5f, 2.4f }, { 0.0f, -1.5f, 2.4f },
+		{ 1.75f, 0.0f, 1.875f }, { 1.75f, -0.98f, 1.875f }, { 0.98f, -1.75f, 1.875f }, { 0.0f, -1.75f, 1.875f },
+		{ 2.0f, 0.0f, 1.35f }, { 2.0f, -1.12f, 1.35f }, { 1.12f, -2.0f, 1.35f }, { 0.0f, -2.0f, 1.35f },
+		{ 2.0f, 0.0f, 0.9f }, { 2.0f, -1.12f, 0.9f }, { 1.12f, -2.0f, 0.9f }, { 0.0f, -2.0f, 0.9f },
+		{ -2.0f, 0.0f, 0.9f }, { 2.0f, 0.0f, 0.45f }, { 2.0f, -1.12f, 0.45f }, { 1.12f, -2.0f, 0.45f },
+		{ 0.0f, -2.0f, 0.45f }, { 1.5f, 0.0f, 0.225f }, { 1.5f, -0.84f, 0.225f }, { 0.84f, -1.5f, 0.225f },
+		{ 0.0f, -1.5f, 0.225f }, { 1.5f, 0.0f, 0.15f }, { 1.5f, -0.84f, 0.15f }, { 0.84f, -1.5f, 0.15f },
+		{ 0.0f, -1.5f, 0.15f }, { -1.6f, 0.0f, 2.025f }, { -1.6f, -0.3f, 2.025f }, { -1.5f, -0.3f, 2.25f },
+		{ -1.5f, 0.0f, 2.25f }, { -2.3f, 0.0f, 2.025f }, { -2.3f, -0.3f, 2.025f }, { -2.5f, -0.3f, 2.25f },
+		{ -2.5f, 0.0f, 2.25f }, { -2.7f, 0.0f, 2.025f }, { -2.7f, -0.3f, 2.025f }, { -3.0f, -0.3f, 2.25f },
+		{ -3.0f, 0.0f, 2.25f }, { -2.7f, 0.0f, 1.8f }, { -2.7f, -0.3f, 1.8f }, { -3.0f, -0.3f, 1.8f },
+		{ -3.0f, 0.0f, 1.8f }, { -2.7f, 0.0f, 1.575f }, { -2.7f, -0.3f, 1.575f }, { -3.0f, -0.3f, 1.35f },
+		{ -3.0f, 0.0f, 1.35f }, { -2.5f, 0.0f, 1.125f }, { -2.5f, -0.3f, 1.125f }, { -2.65f, -0.3f, 0.9375f },
+		{ -2.65f, 0.0f, 0.9375f }, { -2.0f, -0.3f, 0.9f }, { -1.9f, -0.3f, 0.6f }, { -1.9f, 0.0f, 0.6f },
+		{ 1.7f, 0.0f, 1.425f }, { 1.7f, -0.66f, 1.425f }, { 1.7f, -0.66f, 0.6f }, { 1.7f, 0.0f, 0.6f },
+		{ 2.6f, 0.0f, 1.425f }, { 2.6f, -0.66f, 1.425f }, { 3.1f, -0.66f, 0.825f }, { 3.1f, 0.0f, 0.825f },
+		{ 2.3f, 0.0f, 2.1f }, { 2.3f, -0.25f, 2.1f }, { 2.4f, -0.25f, 2.025f }, { 2.4f, 0.0f, 2.025f },
+		{ 2.7f, 0.0f, 2.4f }, { 2.7f, -0.25f, 2.4f }, { 3.3f, -0.25f, 2.4f }, { 3.3f, 0.0f, 2.4f },
+		{ 2.8f, 0.0f, 2.475f }, { 2.8f, -0.25f, 2.475f }, { 3.525f, -0.25f, 2.49375f }, { 3.525f, 0.0f, 2.49375f },
+		{ 2.9f, 0.0f, 2.475f }, { 2.9f, -0.15f, 2.475f }, { 3.45f, -0.15f, 2.5125f }, { 3.45f, 0.0f, 2.5125f },
+		{ 2.8f, 0.0f, 2.4f }, { 2.8f, -0.15f, 2.4f }, { 3.2f, -0.15f, 2.4f }, { 3.2f, 0.0f, 2.4f },
+		{ 0.0f, 0.0f, 3.15f }, { 0.8f, 0.0f, 3.15f }, { 0.8f, -0.45f, 3.15f }, { 0.45f, -0.8f, 3.15f },
+		{ 0.0f, -0.8f, 3.15f }, { 0.0f, 0.0f, 2.85f }, { 1.4f, 0.0f, 2.4f }, { 1.4f, -0.784f, 2.4f },
+		{ 0.784f, -1.4f, 2.4f }, { 0.0f, -1.4f, 2.4f }, { 0.4f, 0.0f, 2.55f }, { 0.4f, -0.224f, 2.55f },
+		{ 0.224f, -0.4f, 2.55f }, { 0.0f, -0.4f, 2.55f }, { 1.3f, 0.0f, 2.55f }, { 1.3f, -0.728f, 2.55f },
+		{ 0.728f, -1.3f, 2.55f }, { 0.0f, -1.3f, 2.55f }, { 1.3f, 0.0f, 2.4f }, { 1.3f, -0.728f, 2.4f },
+		{ 0.728f, -1.3f, 2.4f }, { 0.0f, -1.3f, 2.4f }, { 0.0f, 0.0f, 0.0f }, { 1.425f, -0.798f, 0.0f },
+		{ 1.5f, 0.0f, 0.075f }, { 1.425f, 0.0f, 0.0f }, { 0.798f, -1.425f, 0.0f }, { 0.0f, -1.5f, 0.075f },
+		{ 0.0f, -1.425f, 0.0f }, { 1.5f, -0.84f, 0.075f }, { 0.84f, -1.5f, 0.075f }
+	};
+
+	// The control points used by each patch (4 rows of 4)
+	const int TeapotPatchIndices[10][16] =
+	{
+		// Rim
+		{ 102, 103, 104, 105, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		// Body
+		{ 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27 },
+		{ 24, 25, 26, 27, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40 },
+		// Lid
+		{ 96, 96, 96, 96, 97, 98, 99, 100, 101, 101, 101, 101, 0, 1, 2, 3 },
+		{ 0, 1, 2, 3, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117 },
+		// Bottom
+		{ 118, 118, 118, 118, 124, 122, 119, 121, 123, 126, 125, 120, 40, 39, 38, 37 },
+		// Handle
+		{ 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56 },
+		{ 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 28, 65, 66, 67 },
+		// Spout
+		{ 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83 },
+		{ 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95 }
+	};
+
+	// The first six patches are reflected into all four quarters.  The handle and spout are only
+	// reflected across the plane of symmetry of the teapot.
+	const int FullyReflectedPatchCount = 6;
+
+	struct TeapotPatch
+	{
+		XMFLOAT3	ControlPoints[16];
+		// True if the patch has been reflected an odd number of times, which turns it inside out
+		bool		Mirrored;
+	};
+
+	// Build the full set of patches in our coordinate system (y-up)
+	vector<TeapotPatch> BuildTeapotPatches()
+	{
+		const float reflections[4][2] = { { 1.0f, 1.0f }, { 1.0f, -1.0f }, { -1.0f, -1.0f }, { -1.0f, 1.0f } };
+		vector<TeapotPatch> patches;
+		patches.reserve(TeapotPatchCount);
+		for (int p = 0; p < ARRAYSIZE(TeapotPatchIndices); p++)
+		{
+			int reflectionCount = p < FullyReflectedPatchCount ? 4 : 2;
+			for (int r = 0; r < reflectionCount; r++)
+			{
+				TeapotPatch patch;
+				for (int i = 0; i < 16; i++)
+				{
+					const float* point = TeapotControlPoints[TeapotPatchIndices[p][i]];
+					float x = point[0] * reflections[r][0];
+					float y = point[1] * reflections[r][1];
+					patch.ControlPoints[i] = XMFLOAT3(x * TeapotScale + TeapotOffsetX,
+													  point[2] * TeapotScale + TeapotOffsetY,
+													  -y * TeapotScale);
+				}
+				patch.Mirrored = reflections[r][0] * reflections[r][1] < 0.0f;
+				patches.push_back(patch);
+			}
+		}
+		return patches;
+	}
+
+	const vector<TeapotPatch>& GetTeapotPatches()
+	{
+		static const vector<TeapotPatch> patches = BuildTeapotPatches();
+		return patches;
+	}
+
+	// Cubic Bernstein polynomials and their derivatives
+	inline void BernsteinBasis(float t, float basis[4], float derivative[4])
+	{
+		float s = 1.0f - t;
+		basis[0] = s * s * s;
+		basis[1] = 3.0f * t * s * s;
+		basis[2] = 3.0f * t * t * s;
+		basis[3] = t * t * t;
+		derivative[0] = -3.0f * s * s;
+		derivative[1] = 3.0f * s * s - 6.0f * t * s;
+		derivative[2] = 6.0f * t * s - 3.0f * t * t;
+		derivative[3] = 3.0f * t * t;
+	}
+
+	// Combine the four rows of control points into the four control points of the curve across the
+	// patch at v, along with the derivatives of those points with respect to v
+	void EvaluateRowCurve(const TeapotPatch& patch, float v, XMFLOAT3 curve[4], XMFLOAT3 curveDerivative[4])
+	{
+		float basis[4];
+		float derivative[4];
+		BernsteinBasis(v, basis, derivative);
+		for (int column = 0; column < 4; column++)
+		{
+			XMVECTOR point = XMVectorZero();
+			XMVECTOR pointDerivative = XMVectorZero();
+			for (int row = 0; row < 4; row++)
+			{
+				XMVECTOR controlPoint = XMLoadFloat3(&patch.ControlPoints[row * 4 + column]);
+				point = XMVectorMultiplyAdd(XMVectorReplicate(basis[row]), controlPoint, point);
+				pointDerivative = XMVectorMultiplyAdd(XMVectorReplicate(derivative[row]), controlPoint, pointDerivative);
+			}
+			XMStoreFloat3(&curve[column], point);
+			XMStoreFloat3(&curveDerivative[column], pointDerivative);
+		}
+	}
+
+	// Unnormalised normal of a patch at a single point
+	XMVECTOR EvaluateNormal(const TeapotPatch& patch, float u, float v)
+	{
+		XMFLOAT3 curve[4];
+		XMFLOAT3 curveDerivative[4];
+		EvaluateRowCurve(patch, v, curve, curveDerivative);
+		float basis[4];
+		float derivative[4];
+		BernsteinBasis(u, basis, derivative);
+		XMVECTOR du = XMVectorZero();
+		XMVECTOR dv = XMVectorZero();
+		for (int column = 0; column < 4; column++)
+		{
+			du = XMVectorMultiplyAdd(XMVectorReplicate(derivative[column]), XMLoadFloat3(&curve[column]), du);
+			dv = XMVectorMultiplyAdd(XMVectorReplicate(basis[column]), XMLoadFloat3(&curveDerivative[column]), dv);
+		}
+		return XMVector3Cross(du, dv);
+	}
+
+	// Some patches collapse an edge to a single point (the top of the lid and the centre of the bottom),
+	// where the normal is undefined.  Use the normal just inside the patch instead.
+	XMVECTOR EvaluateDegenerateNormal(const TeapotPatch& patch, float u, float v)
+	{
+		const float inset = 1.0e-3f;
+		u = u < inset ? inset : (u > 1.0f - inset ? 1.0f - inset : u);
+		v = v < inset ? inset : (v > 1.0f - inset ? 1.0f - inset : v);
+		return XMVector3Normalize(EvaluateNormal(patch, u, v));
+	}
+
+	// The Bernstein basis (and derivative) for each column of the tessellation grid, in groups of four
+	// columns so that they can be loaded straight into SIMD registers.  Columns past the end of the
+	// grid repeat the last column.
+	void BuildColumnBasis(UINT tessellation, vector<float>& columnBasis)
+	{
+		UINT groupCount = (tessellation + 4) / 4;
+		columnBasis.resize(groupCount * 8 * 4);
+		for (UINT group = 0; group < groupCount; group++)
+		{
+			for (UINT lane = 0; lane < 4; lane++)
+			{
+				UINT column = group * 4 + lane;
+				float u = static_cast<float>(column > tessellation ? tessellation : column) / tessellation;
+				float basis[4];
+				float derivative[4];
+				BernsteinBasis(u, basis, derivative);
+				for (int i = 0; i < 4; i++)
+				{
+					columnBasis[(group * 8 + i) * 4 + lane] = basis[i];
+					columnBasis[(group * 8 + 4 + i) * 4 + lane] = derivative[i];
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	inline T* Element(T* first, size_t stride, size_t index)
+	{
+		return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(first) + stride * index);
+	}
+
+	// Evaluate the grid of vertices for a patch.  Each row of the grid is evaluated four columns at
+	// a time with each SIMD lane working on a different vertex.
+	void TessellatePatch(const TeapotPatch& patch, UINT tessellation, const vector<float>& columnBasis,
+						 XMFLOAT3* positions, size_t positionStride,
+						 XMFLOAT3* normals, size_t normalStride)
+	{
+		UINT gridSize = tessellation + 1;
+		UINT groupCount = (tessellation + 4) / 4;
+		XMVECTOR normalSign = XMVectorReplicate(patch.Mirrored ? -1.0f : 1.0f);
+		for (UINT row = 0; row < gridSize; row++)
+		{
+			float v = static_cast<float>(row) / tessellation;
+			XMFLOAT3 curve[4];
+			XMFLOAT3 curveDerivative[4];
+			EvaluateRowCurve(patch, v, curve, curveDerivative);
+			for (UINT group = 0; group < groupCount; group++)
+			{
+				const float* basis = &columnBasis[group * 8 * 4];
+				XMVECTOR px = XMVectorZero();
+				XMVECTOR py = XMVectorZero();
+				XMVECTOR pz = XMVectorZero();
+				XMVECTOR dux = XMVectorZero();
+				XMVECTOR duy = XMVectorZero();
+				XMVECTOR duz = XMVectorZero();
+				XMVECTOR dvx = XMVectorZero();
+				XMVECTOR dvy = XMVectorZero();
+				XMVECTOR dvz = XMVectorZero();
+				for (int i = 0; i < 4; i++)
+				{
+					XMVECTOR b = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(basis + i * 4));
+					XMVECTOR d = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(basis + (4 + i) * 4));
+					px = XMVectorMultiplyAdd(b, XMVectorReplicate(curve[i].x), px);
+					py = XMVectorMultiplyAdd(b, XMVectorReplicate(curve[i].y), py);
+					pz = XMVectorMultiplyAdd(b, XMVectorReplicate(curve[i].z), pz);
+					dux = XMVectorMultiplyAdd(d, XMVectorReplicate(curve[i].x), dux);
+					duy = XMVectorMultiplyAdd(d, XMVectorReplicate(curve[i].y), duy);
+					duz = XMVectorMultiplyAdd(d, XMVectorReplicate(curve[i].z), duz);
+					dvx = XMVectorMultiplyAdd(b, XMVectorReplicate(curveDerivative[i].x), dvx);
+					dvy = XMVectorMultiplyAdd(b, XMVectorReplicate(curveDerivative[i].y), dvy);
+					dvz = XMVectorMultiplyAdd(b, XMVectorReplicate(curveDerivative[i].z), dvz);
+				}
+				// The normal is the cross product of the partial derivatives
+				XMVECTOR nx = XMVectorSubtract(XMVectorMultiply(duy, dvz), XMVectorMultiply(duz, dvy));
+				XMVECTOR ny = XMVectorSubtract(XMVectorMultiply(duz, dvx), XMVectorMultiply(dux, dvz));
+				XMVECTOR nz = XMVectorSubtract(XMVectorMultiply(dux, dvy), XMVectorMultiply(duy, dvx));
+				XMVECTOR lengthSquared = XMVectorMultiplyAdd(nx, nx, XMVectorMultiplyAdd(ny, ny, XMVectorMultiply(nz, nz)));
+				XMVECTOR scale = XMVectorMultiply(XMVectorReciprocalSqrt(lengthSquared), normalSign);
+
+				alignas(16) float result[7][4];
+				XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(result[0]), px);
+				XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(result[1]), py);
+				XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(result[2]), pz);
+				XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(result[3]), XMVectorMultiply(nx, scale));
+				XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(result[4]), XMVectorMultiply(ny, scale));
+				XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(result[5]), XMVectorMultiply(nz, scale));
+				XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(result[6]), lengthSquared);
+
+				for (UINT lane = 0; lane < 4 && group * 4 + lane < gridSize; lane++)
+				{
+					UINT column = group * 4 + lane;
+					size_t vertex = row * gridSize + column;
+					*Element(positions, positionStride, vertex) = XMFLOAT3(result[0][lane], result[1][lane], result[2][lane]);
+					XMFLOAT3* normal = Element(normals, normalStride, vertex);
+					if (result[6][lane] > 1.0e-12f)
+					{
+						*normal = XMFLOAT3(result[3][lane], result[4][lane], result[5][lane]);
+					}
+					else
+					{
+						float u = static_cast<float>(column) / tessellation;
+						XMStoreFloat3(normal, XMVectorMultiply(EvaluateDegenerateNormal(patch, u, v), normalSign));
+					}
+				}
+			}
+		}
+	}
+
+	// Two triangles for each quad of the grid, wound so that they face the same way as the normals
+	void BuildPatchIndices(UINT tessellation, UINT firstVertex, bool mirrored, UINT* indices)
+	{
+		UINT gridSize = tessellation + 1;
+		for (UINT row = 0; row < tessellation; row++)
+		{
+			for (UINT column = 0; column < tessellation; column++)
+			{
+				UINT topLeft = firstVertex + row * gridSize + column;
+				UINT topRight = topLeft + 1;
+				UINT bottomLeft = topLeft + gridSize;
+				UINT bottomRight = bottomLeft + 1;
+				if (!mirrored)
+				{
+					*indices++ = topLeft;
+					*indices++ = topRight;
+					*indices++ = bottomLeft;
+					*indices++ = topRight;
+					*indices++ = bottomRight;
+					*indices++ = bottomLeft;
+				}
+				else
+				{
+					*indices++ = topLeft;
+					*indices++ = bottomLeft;
+					*indices++ = topRight;
+					*indices++ = topRight;
+					*indices++ = bottomLeft;
+					*indices++ = bottomRight;
+				}
+			}
+		}
+	}
+}
+
+size_t GetTeapotVertexCount(UINT tessellation)
+{
+	if (tessellation == 0)
+	{
+		tessellation = 1;
+	}
+	return static_cast<size_t>(TeapotPatchCount) * (tessellation + 1) * (tessellation + 1);
+}
+
+size_t GetTeapotIndexCount(UINT tessellation)
+{
+	if (tessellation == 0)
+	{
+		tessellation = 1;
+	}
+	return static_cast<size_t>(TeapotPatchCount) * tessellation * tessellation * 6;
+}
+
+void TessellateTeapot(UINT tessellation,
+					  XMFLOAT3* positions, size_t positionStride,
+					  XMFLOAT3* normals, size_t normalStride,
+					  UINT* indices)
+{
+	if (tessellation == 0)
+	{
+		tessellation = 1;
+	}
+	const vector<TeapotPatch>& patches = GetTeapotPatches();
+	vector<float> columnBasis;
+	BuildColumnBasis(tessellation, columnBasis);
+
+	size_t patchVertexCount = static_cast<size_t>(tessellation + 1) * (tessellation + 1);
+	size_t patchIndexCount = static_cast<size_t>(tessellation) * tessellation * 6;
+	size_t patchesPerTask = patchVertexCount < BatchSize ? BatchSize / patchVertexCount : 1;
+	ParallelFor(patches.size(), patchesPerTask, [&](size_t begin, size_t end)
+	{
+		for (size_t p = begin; p < end; p++)
+		{
+			size_t firstVertex = p * patchVertexCount;
+			TessellatePatch(patches[p], tessellation, columnBasis,
+							Element(positions, positionStride, firstVertex), positionStride,
+							Element(normals, normalStride, firstVertex), normalStride);
+			BuildPatchIndices(tessellation, static_cast<UINT>(firstVertex), patches[p].Mirrored, indices + p * patchIndexCount);
+		}
+	});
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "DirectXCore.h"
+#include <vector>
+
+// Procedural teapot geometry.
+//
+// The teapot is built by tessellating the 32 bicubic Bezier patches of the classic Newell teapot.
+// tessellation is the number of quads along each edge of a patch, so the level of detail can be
+// chosen at run time.  Positions and normals are evaluated directly from the patches (the normal
+// is the cross product of the partial derivatives of the surface), so no normal generation pass is
+// needed afterwards.  Each row of a patch is evaluated four vertices at a time using SIMD and the
+// patches are spread across threads when there is enough work to make it worthwhile.
+//
+// Each patch has its own grid of vertices, so vertices are duplicated along the edges of patches.
+// The teapot is scaled and positioned to match the teapot that used to be hard-coded in TeapotNode.
+
+#define TeapotPatchCount			32
+#define DefaultTeapotTessellation	8
+
+size_t GetTeapotVertexCount(UINT tessellation);
+size_t GetTeapotIndexCount(UINT tessellation);
+
+// positions, normals and indices must have room for GetTeapotVertexCount and GetTeapotIndexCount
+// entries respectively.  Triangles are wound clockwise when viewed from outside the teapot.
+void TessellateTeapot(UINT tessellation,
+					  XMFLOAT3* positions, size_t positionStride,
+					  XMFLOAT3* normals, size_t normalStride,
+					  UINT* indices);
+
+// Version for vertex structures that have Position and Normal members
+
+template<typename TVertex>
+inline void TessellateTeapot(UINT tessellation, std::vector<TVertex>& vertices, std::vector<UINT>& indices)
+{
+	vertices.resize(GetTeapotVertexCount(tessellation));
+	indices.resize(GetTeapotIndexCount(tessellation));
+	TessellateTeapot(tessellation,
+					 &vertices[0].Position, sizeof(TVertex),
+					 &vertices[0].Normal, sizeof(TVertex),
+					 indices.data());
+}
@@ -0,0 +1,244 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+	// A horizontal segment of the top edge of everything placed so far
+	struct SkylineSegment
+	{
+		uint32_t	X;
+		uint32_t	Y;
+		uint32_t	Width;
+	};
+
+	// Size of the space an image takes up, including its gutter, rounded up so that images start on a
+	// multiple of the gutter size
+	inline uint32_t GetCellSize(uint32_t size, uint32_t gutter)
+	{
+		return (size + 2 * gutter + gutter - 1) / gutter * gutter;
+	}
+
+	// Find the lowest place a cell fits on the skyline.  Returns false if it does not fit at all.
+	bool FindSkylinePosition(const vector<SkylineSegment>& skyline, uint32_t width, uint32_t height, uint32_t atlasWidth, uint32_t atlasHeight,
+							 size_t& bestSegment, uint32_t& bestY)
+	{
+		bool found = false;
+		for (size_t i = 0; i < skyline.size(); i++)
+		{
+			uint32_t x = skyline[i].X;
+			if (x + width > atlasWidth)
+			{
+				break;
+			}
+			// The cell rests on the highest segment under it
+			uint32_t y = 0;
+			for (size_t j = i; j < skyline.size() && skyline[j].X < x + width; j++)
+			{
+				y = (max)(y, skyline[j].Y);
+			}
+			if (y + height <= atlasHeight && (!found || y < bestY))
+			{
+				found = true;
+				bestSegment = i;
+				bestY = y;
+			}
+		}
+		return found;
+	}
+
+	void AddToSkyline(vector<SkylineSegment>& skyline, size_t segment, uint32_t y, uint32_t width, uint32_t height)
+	{
+		uint32_t x = skyline[segment].X;
+		skyline.insert(skyline.begin() + segment, SkylineSegment{ x, y + height, width });
+		// Cut away the parts of the following segments that are now underneath the cell
+		size_t next = segment + 1;
+		while (next < skyline.size() && skyline[next].X < x + width)
+		{
+			uint32_t end = skyline[next].X + skyline[next].Width;
+			if (end <= x + width)
+			{
+				skyline.erase(skyline.begin() + next);
+			}
+			else
+			{
+				skyline[next].Width = end - (x + width);
+				skyline[next].X = x + width;
+				break;
+			}
+		}
+		// Join neighbouring segments at the same height
+		for (size_t i = 0; i + 1 < skyline.size(); )
+		{
+			if (skyline[i].Y == skyline[i + 1].Y)
+			{
+				skyline[i].Width += skyline[i + 1].Width;
+				skyline.erase(skyline.begin() + i + 1);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+	// Pack the cells (in the order given) into an atlas of the given size.  Returns the number packed.
+	size_t PackCells(const vector<pair<uint32_t, uint32_t>>& cells, const vector<size_t>& order, uint32_t atlasWidth, uint32_t atlasHeight,
+					 uint32_t gutter, vector<AtlasRegion>& regions)
+	{
+		vector<SkylineSegment> skyline{ { 0, 0, atlasWidth } };
+		size_t packedCount = 0;
+		for (size_t image : order)
+		{
+			size_t segment;
+			uint32_t y;
+			if (!FindSkylinePosition(skyline, cells[image].first, cells[image].second, atlasWidth, atlasHeight, segment, y))
+			{
+				continue;
+			}
+			AtlasRegion& region = regions[image];
+			region.Packed = true;
+			region.X = skyline[segment].X + gutter;
+			region.Y = y + gutter;
+			AddToSkyline(skyline, segment, y, cells[image].first, cells[image].second);
+			packedCount++;
+		}
+		return packedCount;
+	}
+}
+
+bool PackAtlas(const vector<pair<uint32_t, uint32_t>>& sizes, uint32_t maximumSize, uint32_t gutter, AtlasLayout& layout)
+{
+	layout.Width = 0;
+	layout.Height = 0;
+	layout.Gutter = gutter;
+	layout.Regions.assign(sizes.size(), AtlasRegion{ false, 0, 0, 0, 0 });
+
+	// Work out the space each image needs and put the tallest first
+	vector<pair<uint32_t, uint32_t>> cells(sizes.size());
+	vector<size_t> order;
+	uint64_t area = 0;
+	uint32_t largestCell = 1;
+	for (size_t i = 0; i < sizes.size(); i++)
+	{
+		layout.Regions[i].Width = sizes[i].first;
+		layout.Regions[i].Height = sizes[i].second;
+		cells[i] = make_pair(GetCellSize(sizes[i].first, gutter), GetCellSize(sizes[i].second, gutter));
+		if (sizes[i].first == 0 || sizes[i].second == 0 || sizes[i].first > AtlasMaximumImageSize || sizes[i].second > AtlasMaximumImageSize ||
+			cells[i].first > maximumSize || cells[i].second > maximumSize)
+		{
+			continue;
+		}
+		order.push_back(i);
+		area += static_cast<uint64_t>(cells[i].first) * cells[i].second;
+		largestCell = (max)(largestCell, (max)(cells[i].first, cells[i].second));
+	}
+	if (order.size() < 2)
+	{
+		return false;
+	}
+	stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+	{
+		return cells[a].second > cells[b].second || (cells[a].second == cells[b].second && cells[a].first > cells[b].first);
+	});
+
+	// Grow the atlas (keeping it roughly square) until everything fits or it cannot get any bigger
+	uint32_t width = 1;
+	while (width < largestCell)
+	{
+		width *= 2;
+	}
+	uint32_t height = width;
+	while (static_cast<uint64_t>(width) * height < area && (width < maximumSize || height < maximumSize))
+	{
+		if (width <= height && width < maximumSize)
+		{
+			width *= 2;
+		}
+		else
+		{
+			height *= 2;
+		}
+	}
+	width = (min)(width, maximumSize);
+	height = (min)(height, maximumSize);
+	vector<AtlasRegion> regions;
+	for (;;)
+	{
+		regions = layout.Regions;
+		size_t packedCount = PackCells(cells, order, width, height, gutter, regions);
+		if (packedCount == order.size() || (width >= maximumSize && height >= maximumSize))
+		{
+			if (packedCount < 2)
+			{
+				return false;
+			}
+			break;
+		}
+		if ((width <= height && width < maximumSize) || height >= maximumSize)
+		{
+			width = (min)(width * 2, maximumSize);
+		}
+		else
+		{
+			height = (min)(height * 2, maximumSize);
+		}
+	}
+	layout.Regions = regions;
+
+	// Trim the atlas to the space that is used.  The cell sizes are multiples of the gutter, so the atlas
+	// stays a multiple of it too.
+	layout.Width = 0;
+	layout.Height = 0;
+	for (size_t i = 0; i < layout.Regions.size(); i++)
+	{
+		const AtlasRegion& region = layout.Regions[i];
+		if (region.Packed)
+		{
+			layout.Width = (max)(layout.Width, region.X - gutter + cells[i].first);
+			layout.Height = (max)(layout.Height, region.Y - gutter + cells[i].second);
+		}
+	}
+	return true;
+}
+
+void BuildAtlasImage(const AtlasLayout& layout, const vector<const uint8_t*>& images, vector<uint8_t>& atlas)
+{
+	size_t atlasRowPitch = static_cast<size_t>(layout.Width) * 4;
+	atlas.assign(atlasRowPitch * layout.Height, 0);
+	for (size_t i = 0; i < layout.Regions.size() && i < images.size(); i++)
+	{
+		const AtlasRegion& region = layout.Regions[i];
+		if (!region.Packed || images[i] == nullptr)
+		{
+			continue;
+		}
+		// Each row of the gutter repeats the nearest row of the image, with its first and last pixels repeated
+		// out to the sides
+		size_t imageRowPitch = static_cast<size_t>(region.Width) * 4;
+		int32_t gutter = static_cast<int32_t>(layout.Gutter);
+		for (int32_t y = -gutter; y < static_cast<int32_t>(region.Height) + gutter; y++)
+		{
+			int32_t sourceY = (min)((max)(y, 0), static_cast<int32_t>(region.Height) - 1);
+			const uint8_t* source = images[i] + sourceY * imageRowPitch;
+			uint8_t* destination = atlas.data() + (region.Y + y) * atlasRowPitch + region.X * 4;
+			memcpy(destination, source, imageRowPitch);
+			for (int32_t x = 1; x <= gutter; x++)
+			{
+				memcpy(destination - x * 4, source, 4);
+				memcpy(destination + imageRowPitch + (x - 1) * 4, source + imageRowPitch - 4, 4);
+			}
+		}
+	}
+}
+
+void GetAtlasTransform(const AtlasLayout& layout, size_t image, float scale[2], float offset[2])
+{
+	const AtlasRegion& region = layout.Regions[image];
+	scale[0] = static_cast<float>(region.Width) / layout.Width;
+	scale[1] = static_cast<float>(region.Height) / layout.Height;
+	offset[0] = static_cast<float>(region.X) / layout.Width;
+	offset[1] = static_cast<float>(region.Y) / layout.Height;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Texture atlases, used to put the small textures of a model into one texture when the model is loaded so
+// that the sub-meshes of a node that only differed in their texture can be merged and drawn together (see
+// ResourceManager::CreateMesh).
+//
+// Images are packed with the skyline bottom-left method: the top edge of everything placed so far is kept
+// as a list of horizontal segments, and each image (tallest first) goes wherever its top would be lowest.
+// The atlas starts as the smallest power of two that could hold the images and grows until they fit, then
+// is trimmed to the space they use.
+//
+// Each image is surrounded by a gutter filled by repeating its edge pixels, and images start on a multiple
+// of the gutter size.  A texel of any of the first AtlasMipLevels mip levels then only covers one image (or
+// its gutter), and bilinear filtering at an image's edge only reaches the gutter, so each image looks as it
+// would on its own with clamped addressing.  Atlases are made with just those mip levels.  An atlas that is
+// block compressed needs a gutter as big as a 4x4 block of the smallest level, since otherwise the blocks of
+// the smaller levels would take in the neighbouring images.  Texture
+// coordinates have to be between 0 and 1 to be mapped into the atlas, since a repeating texture cannot be
+// repeated inside it.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+// Largest atlas made, and the largest image put in one (bigger images gain little from sharing a texture)
+#define AtlasMaximumSize			2048
+#define AtlasMaximumImageSize		512
+// Mip levels of an atlas, and the gutter round each image (one texel of the smallest level, or one block of
+// it if the atlas is block compressed)
+#define AtlasMipLevels				4
+#define AtlasGutter					(1 << (AtlasMipLevels - 1))
+#define AtlasCompressedGutter		(4 << (AtlasMipLevels - 1))
+// How far outside 0 to 1 a texture coordinate can be and still be mapped into an atlas (it is clamped)
+#define AtlasTexCoordTolerance		0.001f
+
+// Where an image is in the atlas (not including its gutter).  Packed is false for images that did not fit.
+struct AtlasRegion
+{
+	bool						Packed;
+	uint32_t					X;
+	uint32_t					Y;
+	uint32_t					Width;
+	uint32_t					Height;
+};
+
+struct AtlasLayout
+{
+	uint32_t					Width;
+	uint32_t					Height;
+	uint32_t					Gutter;
+	// One for each image, in the order they were given
+	std::vector<AtlasRegion>	Regions;
+};
+
+// Work out where images of the given sizes go in an atlas no bigger than maximumSize each way, with the given
+// gutter (AtlasGutter or AtlasCompressedGutter).  Images that do not fit (or are bigger than
+// AtlasMaximumImageSize) are left out.  Returns false if fewer than two images were packed, since an atlas
+// would not save anything.
+bool		PackAtlas(const std::vector<std::pair<uint32_t, uint32_t>>& sizes, uint32_t maximumSize, uint32_t gutter, AtlasLayout& layout);
+
+// Make the atlas image from RGBA8 images with tightly packed rows (nullptr for the images that were not
+// packed).  Space that no image uses is transparent black.
+void		BuildAtlasImage(const AtlasLayout& layout, const std::vector<const uint8_t*>& images, std::vector<uint8_t>& atlas);
+
+// The scale and offset that map an image's texture coordinates into the atlas: (u, v) * scale + offset
+void		GetAtlasTransform(const AtlasLayout& layout, std::size_t image, float scale[2], float offset[2]);
+
+// Whether a texture coordinate can be mapped into an atlas
+inline bool	IsAtlasTexCoord(float u, float v)
+{
+	return u >= -AtlasTexCoordTolerance && u <= 1.0f + AtlasTexCoordTolerance && v >= -AtlasTexCoordTolerance && v <= 1.0f + AtlasTexCoordTolerance;
+}
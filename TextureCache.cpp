@@ -0,0 +1,194 @@
+#include "TextureCache.h"
+#include "Mesh.h"
+#include <algorithm>
+
+TextureCache::TextureCache()
+{
+	_contentMatches = 0;
+	_gpuBytes = 0;
+}
+
+ComPtr<ID3D11ShaderResourceView> TextureCache::AcquireByFile(const wstring& materialName, const TextureFileKey& fileKey)
+{
+	lock_guard<mutex> lock(_mutex);
+	map<TextureFileKey, shared_ptr<CachedTexture>>::iterator cached = _texturesByFile.find(fileKey);
+	if (cached == _texturesByFile.end())
+	{
+		return nullptr;
+	}
+	SetMaterialTexture(materialName, cached->second);
+	return cached->second->Texture;
+}
+
+ComPtr<ID3D11ShaderResourceView> TextureCache::AcquireByContent(const wstring& materialName, const TextureFileKey& fileKey, const TextureContentKey& contentKey)
+{
+	lock_guard<mutex> lock(_mutex);
+	map<TextureContentKey, shared_ptr<CachedTexture>>::iterator cached = _texturesByContent.find(contentKey);
+	if (cached == _texturesByContent.end())
+	{
+		return nullptr;
+	}
+	_contentMatches++;
+	if (_texturesByFile.emplace(fileKey, cached->second).second)
+	{
+		cached->second->FileKeys.push_back(fileKey);
+	}
+	SetMaterialTexture(materialName, cached->second);
+	return cached->second->Texture;
+}
+
+ComPtr<ID3D11ShaderResourceView> TextureCache::Add(const wstring& materialName, const TextureFileKey& fileKey, const TextureContentKey& contentKey,
+												   ComPtr<ID3D11ShaderResourceView> texture, wstring_view sourceName, size_t fullSize)
+{
+	size_t residentSize = GetTextureLargestSize(texture.Get());
+	lock_guard<mutex> lock(_mutex);
+	shared_ptr<CachedTexture>& cached = _texturesByContent[contentKey];
+	if (!cached)
+	{
+		cached = make_shared<CachedTexture>();
+		cached->Texture = texture;
+		cached->GpuBytes = GetTextureMemorySize(texture.Get());
+		cached->ReferenceCount = 0;
+		cached->ContentKey = contentKey;
+		cached->SourceName = sourceName;
+		cached->ResidentSize = residentSize;
+		cached->MinimumSize = residentSize;
+		cached->FullSize = (max)(fullSize, residentSize);
+		_gpuBytes += cached->GpuBytes;
+	}
+	if (_texturesByFile.emplace(fileKey, cached).second)
+	{
+		cached->FileKeys.push_back(fileKey);
+	}
+	SetMaterialTexture(materialName, cached);
+	return cached->Texture;
+}
+
+void TextureCache::Release(const wstring& materialName)
+{
+	lock_guard<mutex> lock(_mutex);
+	SetMaterialTexture(materialName, nullptr);
+}
+
+void TextureCache::SetMaterialTexture(const wstring& materialName, const shared_ptr<CachedTexture>& texture)
+{
+	// Take the new reference before dropping the old one, in case they are the same texture
+	shared_ptr<CachedTexture> oldTexture;
+	if (texture)
+	{
+		texture->ReferenceCount++;
+		shared_ptr<CachedTexture>& materialTexture = _materialTextures[materialName];
+		oldTexture = materialTexture;
+		materialTexture = texture;
+	}
+	else
+	{
+		map<wstring, shared_ptr<CachedTexture>>::iterator materialTexture = _materialTextures.find(materialName);
+		if (materialTexture == _materialTextures.end())
+		{
+			return;
+		}
+		oldTexture = materialTexture->second;
+		_materialTextures.erase(materialTexture);
+	}
+	if (!oldTexture || --oldTexture->ReferenceCount > 0)
+	{
+		return;
+	}
+	// Nothing uses the texture any more, so unload it.  The names it is known by may since have been given
+	// to a newer texture (see ForgetFile), so only remove the ones that are still its own.
+	map<TextureContentKey, shared_ptr<CachedTexture>>::iterator content = _texturesByContent.find(oldTexture->ContentKey);
+	if (content != _texturesByContent.end() && content->second == oldTexture)
+	{
+		_texturesByContent.erase(content);
+	}
+	for (const TextureFileKey& fileKey : oldTexture->FileKeys)
+	{
+		map<TextureFileKey, shared_ptr<CachedTexture>>::iterator file = _texturesByFile.find(fileKey);
+		if (file != _texturesByFile.end() && file->second == oldTexture)
+		{
+			_texturesByFile.erase(file);
+		}
+	}
+	_gpuBytes -= oldTexture->GpuBytes;
+}
+
+void TextureCache::ForgetFile(const string& canonicalName)
+{
+	lock_guard<mutex> lock(_mutex);
+	for (map<TextureFileKey, shared_ptr<CachedTexture>>::iterator file = _texturesByFile.begin(); file != _texturesByFile.end(); )
+	{
+		file = get<0>(file->first) == canonicalName ? _texturesByFile.erase(file) : next(file);
+	}
+}
+
+vector<CachedTextureUse> TextureCache::GetTextures()
+{
+	lock_guard<mutex> lock(_mutex);
+	vector<CachedTextureUse> textures;
+	map<CachedTexture*, size_t> textureIndices;
+	for (const pair<const wstring, shared_ptr<CachedTexture>>& materialTexture : _materialTextures)
+	{
+		const shared_ptr<CachedTexture>& cached = materialTexture.second;
+		pair<map<CachedTexture*, size_t>::iterator, bool> index = textureIndices.emplace(cached.get(), textures.size());
+		if (index.second)
+		{
+			textures.push_back(CachedTextureUse{ cached, {}, cached->ResidentSize, cached->MinimumSize, cached->FullSize, cached->GpuBytes });
+		}
+		textures[index.first->second].Materials.push_back(materialTexture.first);
+	}
+	return textures;
+}
+
+void TextureCache::GetSource(const shared_ptr<CachedTexture>& cached, wstring& sourceName, size_t& fullSize)
+{
+	lock_guard<mutex> lock(_mutex);
+	sourceName = cached->SourceName;
+	fullSize = cached->FullSize;
+}
+
+bool TextureCache::Replace(const shared_ptr<CachedTexture>& cached, ComPtr<ID3D11ShaderResourceView> texture, bool isFullSize,
+						   ComPtr<ID3D11ShaderResourceView>& oldTexture, vector<wstring>& materialNames)
+{
+	size_t gpuBytes = GetTextureMemorySize(texture.Get());
+	size_t residentSize = GetTextureLargestSize(texture.Get());
+	lock_guard<mutex> lock(_mutex);
+	// Nothing may be using the texture any more
+	if (cached->ReferenceCount == 0)
+	{
+		return false;
+	}
+	oldTexture = cached->Texture;
+	_gpuBytes += gpuBytes - cached->GpuBytes;
+	cached->Texture = texture;
+	cached->GpuBytes = gpuBytes;
+	cached->ResidentSize = residentSize;
+	if (isFullSize)
+	{
+		cached->FullSize = residentSize;
+	}
+	for (const pair<const wstring, shared_ptr<CachedTexture>>& materialTexture : _materialTextures)
+	{
+		if (materialTexture.second == cached)
+		{
+			materialNames.push_back(materialTexture.first);
+		}
+	}
+	return true;
+}
+
+TextureCacheStatistics TextureCache::GetStatistics()
+{
+	lock_guard<mutex> lock(_mutex);
+	TextureCacheStatistics statistics{};
+	statistics.TextureCount = _texturesByContent.size();
+	statistics.FileCount = _texturesByFile.size();
+	statistics.MaterialCount = _materialTextures.size();
+	statistics.ContentMatches = _contentMatches;
+	for (const pair<const TextureContentKey, shared_ptr<CachedTexture>>& texture : _texturesByContent)
+	{
+		statistics.GpuBytes += texture.second->GpuBytes;
+		statistics.BytesSaved += texture.second->GpuBytes * (texture.second->ReferenceCount - 1);
+	}
+	return statistics;
+}
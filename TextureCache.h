@@ -0,0 +1,120 @@
+#pragma once
+#include "core.h"
+#include "DirectXCore.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+// The textures of materials, shared so that a texture is only loaded once however many materials use it.
+//
+// A texture is found by the canonical name of each file it has been loaded from and, once a file has been
+// read, by a hash of its contents (see ContentHash.h), each together with the settings it was loaded with, so
+// the same image saved under two names (e.g. next to two models) is only uploaded once and textures are only
+// shared if they were loaded with the same texture compression and maximum size.  A texture is unloaded
+// when the last material using it stops.
+//
+// The cache only keeps track of the textures: the resource manager reads and creates them and hands them to
+// the cache.  It also remembers the sizes each texture has and can have, for the texture streamer (see
+// TextureStreamer.h).  It can be used from any thread.
+
+// Textures shared between materials by the texture cache
+struct TextureCacheStatistics
+{
+	// Distinct textures that are loaded, and the number of file names they are known by
+	size_t					TextureCount;
+	size_t					FileCount;
+	// Materials using them
+	size_t					MaterialCount;
+	size_t					GpuBytes;
+	// GPU memory that would also be used if every material had its own copy of its texture
+	size_t					BytesSaved;
+	// Textures that were found to be loaded already under a different file name with the same contents
+	size_t					ContentMatches;
+};
+
+// The canonical file name, loader flags and maximum size a texture was loaded with
+typedef tuple<string, unsigned int, size_t>					TextureFileKey;
+// The hash and size of the file's contents, loader flags and maximum size a texture was loaded with
+typedef tuple<uint64_t, size_t, unsigned int, size_t>		TextureContentKey;
+
+struct CachedTexture
+{
+	ComPtr<ID3D11ShaderResourceView>		Texture;
+	size_t									GpuBytes;
+	// Number of materials using the texture
+	unsigned int							ReferenceCount;
+	TextureContentKey						ContentKey;
+	vector<TextureFileKey>					FileKeys;
+	// The file the texture is streamed from, with the largest width or height it has now, the smallest it is
+	// streamed down to and the largest it can have
+	wstring									SourceName;
+	size_t									ResidentSize;
+	size_t									MinimumSize;
+	size_t									FullSize;
+};
+
+// A copy of what the cache knows about a texture, with the materials using it
+struct CachedTextureUse
+{
+	shared_ptr<CachedTexture>				Texture;
+	vector<wstring>							Materials;
+	size_t									ResidentSize;
+	size_t									MinimumSize;
+	size_t									FullSize;
+	size_t									GpuBytes;
+};
+
+class TextureCache
+{
+public:
+	TextureCache();
+
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	// Give a material the texture loaded from a file, in place of the one it had.  Returns nullptr (and leaves
+	// the material alone) if the file has not been loaded with the same settings.
+	ComPtr<ID3D11ShaderResourceView>		AcquireByFile(const wstring& materialName, const TextureFileKey& fileKey);
+	// Give a material a texture loaded from a file with the same contents, which is known by this file name from
+	// now on.  Returns nullptr if there is not one.
+	ComPtr<ID3D11ShaderResourceView>		AcquireByContent(const wstring& materialName, const TextureFileKey& fileKey, const TextureContentKey& contentKey);
+	// Add a texture that has just been created from sourceName and give it to a material.  fullSize is the
+	// largest width or height it can have.  If another thread has added a texture with the same contents in the
+	// meantime, the material is given that one instead.  Returns the texture the material was given.
+	ComPtr<ID3D11ShaderResourceView>		Add(const wstring& materialName, const TextureFileKey& fileKey, const TextureContentKey& contentKey,
+												ComPtr<ID3D11ShaderResourceView> texture, wstring_view sourceName, size_t fullSize);
+	// Stop a material using the texture it got from the cache
+	void									Release(const wstring& materialName);
+	// Forget what a file (by its canonical name) contained, after it has changed.  The textures already
+	// loaded from it stay loaded for the materials using them until those materials are given the new one.
+	void									ForgetFile(const string& canonicalName);
+
+	// Take a copy of every texture that is in use
+	vector<CachedTextureUse>				GetTextures();
+	// The file a texture is streamed from and the largest width or height it can have
+	void									GetSource(const shared_ptr<CachedTexture>& cached, wstring& sourceName, size_t& fullSize);
+	// Put a version of a texture with a different size in its place.  isFullSize says whether it was loaded as
+	// big as it can be.  oldTexture is set to the version it replaced and materialNames to the materials that
+	// use it, which still have to be given the new version.  Returns false if nothing uses the texture any more.
+	bool									Replace(const shared_ptr<CachedTexture>& cached, ComPtr<ID3D11ShaderResourceView> texture, bool isFullSize,
+													ComPtr<ID3D11ShaderResourceView>& oldTexture, vector<wstring>& materialNames);
+
+	// GPU memory held by the textures in the cache
+	inline size_t							GetGpuBytes() { return _gpuBytes; }
+	TextureCacheStatistics					GetStatistics();
+
+private:
+	mutex									_mutex;
+	map<TextureFileKey, shared_ptr<CachedTexture>>		_texturesByFile;
+	map<TextureContentKey, shared_ptr<CachedTexture>>	_texturesByContent;
+	// The texture each material is using, by material name
+	map<wstring, shared_ptr<CachedTexture>>	_materialTextures;
+	size_t									_contentMatches;
+	atomic<size_t>							_gpuBytes;
+
+	// Give a material a texture, or take its texture away if texture is nullptr.  _mutex must be held.
+	void									SetMaterialTexture(const wstring& materialName, const shared_ptr<CachedTexture>& texture);
+};
@@ -0,0 +1,210 @@
+#include "TextureDiskCache.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+
+TextureDiskCache::TextureDiskCache()
+{
+	_open = false;
+	_sizeLimit = 0;
+	_totalBytes = 0;
+	_temporaryCount = 0;
+	_statistics = TextureDiskCacheStatistics{};
+}
+
+bool TextureDiskCache::Open(const string& directory, uint64_t sizeLimit)
+{
+	Close();
+	lock_guard<mutex> lock(_mutex);
+	error_code error;
+	filesystem::path directoryPath = filesystem::u8path(directory);
+	filesystem::create_directories(directoryPath, error);
+	if (!filesystem::is_directory(directoryPath, error))
+	{
+		return false;
+	}
+	_directory = directoryPath;
+	_sizeLimit = sizeLimit;
+
+	// Note the files that are already there.  Files left half written, or written by another version, are
+	// deleted.
+	string versionPrefix = "v" + to_string(TextureDiskCacheVersion) + "-";
+	vector<filesystem::path> staleFiles;
+	for (filesystem::directory_iterator file(_directory, error), end; !error && file != end; file.increment(error))
+	{
+		if (!file->is_regular_file(error))
+		{
+			continue;
+		}
+		string extension = file->path().extension().u8string();
+		string fileName = file->path().filename().u8string();
+		if (extension == TextureDiskCacheTemporary || (extension == TextureDiskCacheExtension && fileName.compare(0, versionPrefix.size(), versionPrefix) != 0))
+		{
+			staleFiles.push_back(file->path());
+		}
+		else if (extension == TextureDiskCacheExtension)
+		{
+			CachedFile cachedFile{ file->file_size(error), file->last_write_time(error) };
+			_files[fileName] = cachedFile;
+			_totalBytes += cachedFile.Size;
+		}
+	}
+	for (const filesystem::path& staleFile : staleFiles)
+	{
+		filesystem::remove(staleFile, error);
+	}
+	_open = true;
+	EnforceSizeLimit("");
+	return true;
+}
+
+void TextureDiskCache::Close()
+{
+	lock_guard<mutex> lock(_mutex);
+	_open = false;
+	_files.clear();
+	_totalBytes = 0;
+	_statistics = TextureDiskCacheStatistics{};
+}
+
+bool TextureDiskCache::IsOpen()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _open;
+}
+
+bool TextureDiskCache::Find(const TextureDiskCacheKey& key, MappedFile& file)
+{
+	string fileName = GetFileName(key);
+	lock_guard<mutex> lock(_mutex);
+	if (!_open)
+	{
+		return false;
+	}
+	map<string, CachedFile>::iterator cachedFile = _files.find(fileName);
+	if (cachedFile == _files.end() || !file.Open((_directory / filesystem::u8path(fileName)).u8string()))
+	{
+		_statistics.Misses++;
+		return false;
+	}
+	// Mark the file as used, here and on disk
+	error_code error;
+	cachedFile->second.LastUsed = filesystem::file_time_type::clock::now();
+	filesystem::last_write_time(_directory / filesystem::u8path(fileName), cachedFile->second.LastUsed, error);
+	_statistics.Hits++;
+	return true;
+}
+
+bool TextureDiskCache::Store(const TextureDiskCacheKey& key, const vector<uint8_t>& contents)
+{
+	string fileName = GetFileName(key);
+	filesystem::path path;
+	filesystem::path temporaryPath;
+	{
+		lock_guard<mutex> lock(_mutex);
+		if (!_open || contents.size() > _sizeLimit)
+		{
+			return false;
+		}
+		path = _directory / filesystem::u8path(fileName);
+		// Two threads can store the same texture at once, so each writes its own temporary file
+		temporaryPath = _directory / filesystem::u8path(fileName + "." + to_string(_temporaryCount++) + TextureDiskCacheTemporary);
+	}
+	{
+		ofstream file(temporaryPath, ios::binary | ios::trunc);
+		file.write(reinterpret_cast<const char*>(contents.data()), contents.size());
+		if (!file)
+		{
+			file.close();
+			error_code error;
+			filesystem::remove(temporaryPath, error);
+			return false;
+		}
+	}
+	lock_guard<mutex> lock(_mutex);
+	error_code error;
+	// The cache may have been closed (or opened somewhere else) while the file was written
+	if (!_open || path.parent_path() != _directory)
+	{
+		filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	filesystem::rename(temporaryPath, path, error);
+	if (error)
+	{
+		// Most likely the old file is still mapped, in which case it stays in use
+		filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	CachedFile& cachedFile = _files[fileName];
+	_totalBytes += contents.size() - cachedFile.Size;
+	cachedFile.Size = contents.size();
+	cachedFile.LastUsed = filesystem::file_time_type::clock::now();
+	_statistics.Stores++;
+	EnforceSizeLimit(fileName);
+	return true;
+}
+
+void TextureDiskCache::Remove(const TextureDiskCacheKey& key)
+{
+	lock_guard<mutex> lock(_mutex);
+	if (_open)
+	{
+		RemoveFile(GetFileName(key));
+	}
+}
+
+TextureDiskCacheStatistics TextureDiskCache::GetStatistics()
+{
+	lock_guard<mutex> lock(_mutex);
+	TextureDiskCacheStatistics statistics = _statistics;
+	statistics.FileCount = _files.size();
+	statistics.TotalBytes = _totalBytes;
+	return statistics;
+}
+
+string TextureDiskCache::GetFileName(const TextureDiskCacheKey& key)
+{
+	char fileName[128];
+	snprintf(fileName, sizeof(fileName), "v%d-%016llx-%llx-%x-%llx-%x%s", TextureDiskCacheVersion, static_cast<unsigned long long>(key.SourceHash),
+			 static_cast<unsigned long long>(key.SourceSize), key.LoadFlags, static_cast<unsigned long long>(key.MaximumSize), key.CompressedFormat,
+			 TextureDiskCacheExtension);
+	return fileName;
+}
+
+void TextureDiskCache::EnforceSizeLimit(const string& keep)
+{
+	while (_totalBytes > _sizeLimit)
+	{
+		map<string, CachedFile>::iterator oldest = _files.end();
+		for (map<string, CachedFile>::iterator file = _files.begin(); file != _files.end(); ++file)
+		{
+			if (file->first != keep && (oldest == _files.end() || file->second.LastUsed < oldest->second.LastUsed))
+			{
+				oldest = file;
+			}
+		}
+		if (oldest == _files.end())
+		{
+			return;
+		}
+		RemoveFile(oldest->first);
+		_statistics.Evictions++;
+	}
+}
+
+void TextureDiskCache::RemoveFile(const string& fileName)
+{
+	map<string, CachedFile>::iterator cachedFile = _files.find(fileName);
+	if (cachedFile == _files.end())
+	{
+		return;
+	}
+	// A file that is mapped cannot be deleted on Windows.  It is forgotten anyway, and is found again (and
+	// counted) the next time the cache is opened.
+	error_code error;
+	filesystem::remove(_directory / filesystem::u8path(fileName), error);
+	_totalBytes -= cachedFile->second.Size;
+	_files.erase(cachedFile);
+}
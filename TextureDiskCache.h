@@ -0,0 +1,105 @@
+#pragma once
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Disk cache of decoded textures, so that images only have to be decoded, resized, mipmapped and block
+// compressed the first time they are loaded (see ResourceManager::OpenTextureDiskCache).
+//
+// Each texture is stored as a DDS file (see DdsFile.h) holding exactly what was uploaded to the GPU, every
+// mip level in its final format, so a cached texture is loaded by memory mapping the file and passing its
+// levels straight to the GPU, like any other DDS file.  A texture is found by a hash of the contents of the
+// image it was made from (see ContentHash.h) together with everything that affects how it was made,
+// including what the device supports, so a changed image is never mistaken for the old one and a cache
+// written with another device is never used.  The version is part of every file name, so changing the
+// way textures are made only needs TextureDiskCacheVersion to be raised.
+//
+// The cache keeps its files within a size limit by deleting the least recently used ones.  Using a file
+// updates its modification time, so the order carries over to the next run.  Files are written under a
+// temporary name (without holding the cache's lock, so other threads can find textures meanwhile) and then
+// renamed, so a file that is found is always complete.  The directory belongs to the cache: files in it
+// with the cache's extensions that are not from this version are deleted.
+//
+// This code does not depend on DirectX so it can also be used by offline tools.
+
+#define TextureDiskCacheVersion		2
+#define TextureDiskCacheExtension	".dds"
+#define TextureDiskCacheTemporary	".tmp"
+
+// Everything that decides what texture is made from an image
+struct TextureDiskCacheKey
+{
+	uint64_t					SourceHash;
+	uint64_t					SourceSize;
+	// The loader flags the texture was loaded with
+	uint32_t					LoadFlags;
+	// The largest width or height the texture could be (taking the device's limit into account)
+	uint64_t					MaximumSize;
+	// The format textures are block compressed to on the device (a DXGI_FORMAT value), or 0 for none
+	uint32_t					CompressedFormat;
+};
+
+struct TextureDiskCacheStatistics
+{
+	std::size_t					Hits;
+	std::size_t					Misses;
+	std::size_t					Stores;
+	std::size_t					Evictions;
+	std::size_t					FileCount;
+	uint64_t					TotalBytes;
+};
+
+class TextureDiskCache
+{
+public:
+	TextureDiskCache();
+
+	TextureDiskCache(const TextureDiskCache&) = delete;
+	TextureDiskCache& operator=(const TextureDiskCache&) = delete;
+
+	// directory is UTF-8 and is made if it does not exist.  Files are deleted if the cache is bigger than
+	// sizeLimit bytes.  Returns false if the directory cannot be used.
+	bool						Open(const std::string& directory, uint64_t sizeLimit);
+	void						Close();
+	bool						IsOpen();
+
+	// Map the file holding a texture.  Returns false if the cache does not have it.
+	bool						Find(const TextureDiskCacheKey& key, MappedFile& file);
+	// Store a texture, given as the contents of a DDS file, replacing any that has the same key
+	bool						Store(const TextureDiskCacheKey& key, const std::vector<uint8_t>& contents);
+	// Delete a texture that was found but could not be used (e.g. because the file is damaged)
+	void						Remove(const TextureDiskCacheKey& key);
+
+	TextureDiskCacheStatistics	GetStatistics();
+
+	static std::string			GetFileName(const TextureDiskCacheKey& key);
+
+private:
+	struct CachedFile
+	{
+		uint64_t							Size;
+		std::filesystem::file_time_type		LastUsed;
+	};
+
+	std::mutex							_mutex;
+	bool								_open;
+	std::filesystem::path				_directory;
+	uint64_t							_sizeLimit;
+	uint64_t							_totalBytes;
+	// Used to give each file being written its own temporary name
+	uint64_t							_temporaryCount;
+	// The files in the cache by name
+	std::map<std::string, CachedFile>	_files;
+	TextureDiskCacheStatistics			_statistics;
+
+	// Delete the least recently used files (other than keep) until the cache is within its limit.  _mutex must
+	// be held.
+	void								EnforceSizeLimit(const std::string& keep);
+	// _mutex must be held
+	void								RemoveFile(const std::string& fileName);
+};
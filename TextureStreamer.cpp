@@ -0,0 +1,174 @@
+#include "TextureStreamer.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+	// The size a streamed texture needs to cover the given number of pixels: the next power of two, kept between
+	// the smallest and largest sizes it can have
+	size_t GetStreamingSize(float pixels, size_t minimumSize, size_t fullSize)
+	{
+		size_t size = 1;
+		while (static_cast<float>(size) < pixels && size < fullSize)
+		{
+			size *= 2;
+		}
+		return (max)((min)(size, fullSize), minimumSize);
+	}
+
+	// The next smaller power of two
+	size_t HalveStreamingSize(size_t size)
+	{
+		size_t smaller = 1;
+		while (smaller * 2 < size)
+		{
+			smaller *= 2;
+		}
+		return smaller;
+	}
+
+	// Memory a texture would use with a different largest width or height, worked out from what it uses now
+	double EstimateTextureBytes(size_t gpuBytes, size_t residentSize, size_t size)
+	{
+		double scale = static_cast<double>(size) / (max)(residentSize, static_cast<size_t>(1));
+		return gpuBytes * scale * scale;
+	}
+}
+
+TextureStreamer::TextureStreamer(TextureCache& textureCache, const function<float(const wstring&)>& takeScreenSize,
+								 const function<bool(const shared_ptr<CachedTexture>&, size_t)>& resizeTexture)
+	: _textureCache(textureCache), _takeScreenSize(takeScreenSize), _resizeTexture(resizeTexture)
+{
+	_running = false;
+	_memoryBudget = DefaultTextureMemoryBudget;
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	Disable();
+}
+
+void TextureStreamer::Enable()
+{
+	if (_running.exchange(true))
+	{
+		return;
+	}
+	_thread = thread(&TextureStreamer::StreamTextures, this);
+}
+
+void TextureStreamer::Disable()
+{
+	if (!_running.exchange(false))
+	{
+		return;
+	}
+	// The streaming thread notices within one pass
+	_thread.join();
+}
+
+void TextureStreamer::StreamTextures()
+{
+	// Textures are loaded with WIC, which needs COM on this thread
+	HRESULT comInitialised = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+	while (_running)
+	{
+		this_thread::sleep_for(chrono::milliseconds(TextureStreamingMilliseconds));
+		UpdateTextures();
+	}
+	if (SUCCEEDED(comInitialised))
+	{
+		CoUninitialize();
+	}
+}
+
+void TextureStreamer::UpdateTextures()
+{
+	struct StreamedTexture : CachedTextureUse
+	{
+		// Pixels across the biggest sub-mesh drawn with the texture since the last pass (0 if it was not drawn)
+		float									ScreenSize;
+		size_t									TargetSize;
+	};
+
+	// Take a copy of the textures in the cache and the materials using them
+	vector<StreamedTexture> textures;
+	for (const CachedTextureUse& use : _textureCache.GetTextures())
+	{
+		textures.push_back(StreamedTexture{ use, 0.0f, use.MinimumSize });
+	}
+	for (StreamedTexture& texture : textures)
+	{
+		for (const wstring& materialName : texture.Materials)
+		{
+			texture.ScreenSize = (max)(texture.ScreenSize, _takeScreenSize(materialName));
+		}
+	}
+
+	// Every texture has at least its smallest size.  Then the textures on screen are given the detail they need,
+	// biggest on screen first, until the budget runs out.  Then textures keep any more detail they already have
+	// while there is room for it.
+	double budget = static_cast<double>(_memoryBudget.load());
+	double usedBytes = 0.0;
+	for (const StreamedTexture& texture : textures)
+	{
+		usedBytes += EstimateTextureBytes(texture.GpuBytes, texture.ResidentSize, texture.TargetSize);
+	}
+	stable_sort(textures.begin(), textures.end(), [](const StreamedTexture& a, const StreamedTexture& b)
+	{
+		return a.ScreenSize > b.ScreenSize;
+	});
+	for (StreamedTexture& texture : textures)
+	{
+		if (texture.ScreenSize <= 0.0f)
+		{
+			break;
+		}
+		double targetBytes = EstimateTextureBytes(texture.GpuBytes, texture.ResidentSize, texture.TargetSize);
+		size_t size = GetStreamingSize(texture.ScreenSize, texture.MinimumSize, texture.FullSize);
+		while (size > texture.TargetSize && usedBytes - targetBytes + EstimateTextureBytes(texture.GpuBytes, texture.ResidentSize, size) > budget)
+		{
+			size = HalveStreamingSize(size);
+		}
+		if (size > texture.TargetSize)
+		{
+			usedBytes += EstimateTextureBytes(texture.GpuBytes, texture.ResidentSize, size) - targetBytes;
+			texture.TargetSize = size;
+		}
+	}
+	for (StreamedTexture& texture : textures)
+	{
+		if (texture.ResidentSize > texture.TargetSize)
+		{
+			double extraBytes = texture.GpuBytes - EstimateTextureBytes(texture.GpuBytes, texture.ResidentSize, texture.TargetSize);
+			if (usedBytes + extraBytes <= budget)
+			{
+				usedBytes += extraBytes;
+				texture.TargetSize = texture.ResidentSize;
+			}
+		}
+	}
+
+	// Make room first, then load more detail for the textures that are biggest on screen.  Only a few textures
+	// are made bigger each pass so that the ones that need it most are not held up by the rest.
+	for (const StreamedTexture& texture : textures)
+	{
+		if (_running && texture.TargetSize < texture.ResidentSize)
+		{
+			_resizeTexture(texture.Texture, texture.TargetSize);
+		}
+	}
+	size_t loadCount = 0;
+	for (const StreamedTexture& texture : textures)
+	{
+		if (!_running || loadCount == TextureStreamingLoadsPerPass)
+		{
+			break;
+		}
+		if (texture.TargetSize > texture.ResidentSize)
+		{
+			_resizeTexture(texture.Texture, texture.TargetSize);
+			loadCount++;
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "TextureCache.h"
+#include <atomic>
+#include <functional>
+#include <thread>
+
+// Streams the textures in the texture cache (see TextureCache.h) at the detail they need.
+//
+// While streaming is on, the resource manager first loads textures with their largest width or height cut
+// down to TextureStreamingInitialSize (the smallest mip levels of a DDS file), so they can be drawn with
+// straight away, and a background thread loads them again in more detail as they are needed.  Each texture
+// needs as many texels across as the biggest sub-mesh drawn with it covers pixels on screen (see
+// Material::NoteScreenSize).  Textures are given the detail they need in order of how big they are on screen
+// until the texture memory budget is used up, and detail they no longer need is kept while there is room for
+// it, so textures that have gone out of view or into the distance only drop detail to make room for others.
+// Textures are never cut down below the initial size, so the budget can be exceeded if they need more memory.
+// Turning streaming off leaves textures at the size they have.
+
+// GPU memory that streamed textures are kept within
+#define DefaultTextureMemoryBudget		(128 * 1024 * 1024)
+// Largest width or height a texture is first loaded at when textures are streamed
+#define TextureStreamingInitialSize		64
+// How often the texture streamer looks at what is on screen, and the most textures it makes bigger each time
+#define TextureStreamingMilliseconds	100
+#define TextureStreamingLoadsPerPass	4
+
+class TextureStreamer
+{
+public:
+	// takeScreenSize gives the pixels across the biggest sub-mesh drawn with a material since it was last asked
+	// (0 if the material is not loaded).  resizeTexture loads a texture in the cache again with the given largest
+	// width or height and gives it to the materials using it.  Both are called on the streaming thread.
+	TextureStreamer(TextureCache& textureCache, const function<float(const wstring&)>& takeScreenSize,
+					const function<bool(const shared_ptr<CachedTexture>&, size_t)>& resizeTexture);
+	~TextureStreamer();
+
+	TextureStreamer(const TextureStreamer&) = delete;
+	TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+	void									Enable();
+	// Waits for the streaming thread to finish the texture it is loading
+	void									Disable();
+	inline bool								IsEnabled() { return _running; }
+	inline void								SetMemoryBudget(size_t budgetBytes) { _memoryBudget = budgetBytes; }
+	inline size_t							GetMemoryBudget() { return _memoryBudget; }
+
+private:
+	TextureCache&							_textureCache;
+	function<float(const wstring&)>			_takeScreenSize;
+	function<bool(const shared_ptr<CachedTexture>&, size_t)>	_resizeTexture;
+	thread									_thread;
+	atomic<bool>							_running;
+	atomic<size_t>							_memoryBudget;
+
+	void									StreamTextures();
+	// Work out the size each texture in the cache should have, and load the ones that need to change
+	void									UpdateTextures();
+};
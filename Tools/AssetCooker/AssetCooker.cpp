@@ -0,0 +1,526 @@
+// Offline asset cooker.
+//
+// Runs the same model import path as the ResourceManager (Assimp with an import profile, followed by node
+// merging, normal generation, bounds and level of detail simplification in ModelBuilder) ahead of time and
+// writes the result as cooked models (see CookedModel.h), which the ResourceManager loads instead of the
+// source models.  BMP, TGA and PNG textures (see ImageDecoder.h) whose size is a multiple of 4 are cooked to
+// block compressed DDS files with their full mip chain (BC1 if they are opaque, otherwise BC3), so loading
+// them costs no more than reading them; other textures are copied into the output as they are and decoded
+// with WIC when they are loaded.  Optionally, everything that was cooked is packed into an asset archive.
+//
+//		AssetCooker [-profile <name>] [-archive <file>] [-force] <output directory> <asset>...
+//
+// Cooking is incremental.  A manifest in the output directory records, for every asset, the files it was
+// cooked from (every file Assimp opened while importing it) with their size, modification time and a hash
+// of their contents.  An asset is only cooked again if one of those files has changed, if it is asked for
+// with a different profile, if its output has gone or if the cooker itself has changed.  A file whose time
+// has changed but whose contents have not (e.g. after a fresh checkout) does not cause the asset to be
+// cooked again.  Assets are cooked in parallel, each on its own thread with its own Assimp importer.
+//
+// This only uses the parts of the engine that do not depend on DirectX, so it builds on Linux with the
+// system Assimp library:
+//
+//		g++ -std=c++17 -O2 -pthread -I. Tools/AssetCooker/AssetCooker.cpp CookedModel.cpp ModelBuilder.cpp MeshProcessing.cpp
+//			ModelImporter.cpp MeshSimplifier.cpp AssetArchive.cpp MappedFile.cpp LzCompression.cpp ContentHash.cpp ImageDecoder.cpp
+//			MipGenerator.cpp ImageResampler.cpp BlockCompression.cpp DdsFile.cpp -lassimp -o AssetCooker
+
+#include "CookedModel.h"
+#include "ModelBuilder.h"
+#include "ModelImporter.h"
+#include "AssetArchive.h"
+#include "BlockCompression.h"
+#include "ContentHash.h"
+#include "DdsFile.h"
+#include "ImageDecoder.h"
+#include "MipGenerator.h"
+#include "ParallelFor.h"
+#include <assimp/DefaultIOSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+using namespace std;
+
+// Changing the cooker version makes everything cook again.  It must change whenever the cooked output for
+// the same input would be different.
+#define CookerVersion			4
+#define CookerManifestName		"cook.manifest"
+
+namespace
+{
+	// A file that an asset was cooked from
+	struct CookedInput
+	{
+		string						Path;
+		unsigned long long			Size;
+		long long					ModifiedTime;
+		uint64_t					Hash;
+	};
+
+	// What the manifest records about an asset
+	struct ManifestEntry
+	{
+		unsigned int				Version;
+		string						Profile;
+		vector<CookedInput>			Inputs;
+	};
+
+	enum class CookResult
+	{
+		UpToDate,
+		Cooked,
+		Failed
+	};
+
+	struct CookJob
+	{
+		// Name of the source asset as it was given
+		string						AssetName;
+		// Name of the cooked asset, which is also its path relative to the output directory
+		string						OutputName;
+		bool						IsModel;
+		const ManifestEntry*		PreviousEntry;
+		ManifestEntry				Entry;
+		CookResult					Result;
+		string						Message;
+	};
+
+	bool IsTexture(const string& assetName)
+	{
+		static const char* const textureExtensions[] = { ".bmp", ".png", ".jpg", ".jpeg", ".tga", ".dds", ".tif", ".tiff", ".gif" };
+		string extension = filesystem::u8path(assetName).extension().u8string();
+		for (char& c : extension)
+		{
+			c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+		}
+		for (const char* textureExtension : textureExtensions)
+		{
+			if (extension == textureExtension)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool GetFileTimeAndSize(const string& path, long long& modifiedTime, unsigned long long& size)
+	{
+		error_code error;
+		filesystem::path filePath = filesystem::u8path(path);
+		size = filesystem::file_size(filePath, error);
+		if (error)
+		{
+			return false;
+		}
+		modifiedTime = filesystem::last_write_time(filePath, error).time_since_epoch().count();
+		return !error;
+	}
+
+	bool DescribeInput(const string& path, CookedInput& input)
+	{
+		vector<uint8_t> contents;
+		if (!GetFileTimeAndSize(path, input.ModifiedTime, input.Size) || !ReadFileContents(path, contents))
+		{
+			return false;
+		}
+		input.Path = path;
+		input.Hash = HashContents(contents.data(), contents.size());
+		return true;
+	}
+
+	// An input is unchanged if its size and time are the same as when it was cooked, or if its contents are
+	// the same.  The contents are only hashed when the time or size has changed.
+	bool IsInputUnchanged(const CookedInput& previous)
+	{
+		CookedInput current;
+		if (!GetFileTimeAndSize(previous.Path, current.ModifiedTime, current.Size))
+		{
+			return false;
+		}
+		if (current.Size == previous.Size && current.ModifiedTime == previous.ModifiedTime)
+		{
+			return true;
+		}
+		return current.Size == previous.Size && DescribeInput(previous.Path, current) && current.Hash == previous.Hash;
+	}
+
+	// Write a file by writing a temporary file and renaming it over the old one, so an interrupted cook never
+	// leaves a half written output behind
+	bool WriteFileContents(const filesystem::path& path, const vector<uint8_t>& contents)
+	{
+		error_code error;
+		filesystem::create_directories(path.parent_path(), error);
+		filesystem::path temporaryPath = path;
+		temporaryPath += ".tmp";
+		{
+			ofstream file(temporaryPath, ios::binary | ios::trunc);
+			file.write(reinterpret_cast<const char*>(contents.data()), static_cast<streamsize>(contents.size()));
+			if (!file)
+			{
+				return false;
+			}
+		}
+		filesystem::rename(temporaryPath, path, error);
+		return !error;
+	}
+
+	// Assimp IO system that records the name of every file that is opened, which gives the full set of files a
+	// model depends on (e.g. a .obj file and its .mtl file)
+	class RecordingIOSystem : public Assimp::DefaultIOSystem
+	{
+	public:
+		RecordingIOSystem(vector<string>& openedFiles) : _openedFiles(openedFiles)
+		{
+		}
+
+		Assimp::IOStream* Open(const char* fileName, const char* mode) override
+		{
+			Assimp::IOStream* stream = DefaultIOSystem::Open(fileName, mode);
+			if (stream && strchr(mode, 'w') == nullptr)
+			{
+				_openedFiles.push_back(filesystem::u8path(fileName).lexically_normal().u8string());
+			}
+			return stream;
+		}
+
+	private:
+		vector<string>&		_openedFiles;
+	};
+
+	bool CookModel(CookJob& job, const ImportProfile& profile, const filesystem::path& outputPath)
+	{
+		vector<string> openedFiles;
+		const aiScene* scene = ImportScene(job.AssetName, profile, new RecordingIOSystem(openedFiles));
+		if (!scene)
+		{
+			job.Message = "unable to import the model";
+			return false;
+		}
+		CookedModel model;
+		bool built = BuildCookedModel(scene, job.AssetName, profile.Name, model);
+		ReleaseImportedScene();
+		if (!built)
+		{
+			job.Message = "the model has nothing that can be drawn";
+			return false;
+		}
+		vector<uint8_t> data;
+		WriteCookedModel(model, data);
+		if (!WriteFileContents(outputPath, data))
+		{
+			job.Message = "unable to write " + outputPath.u8string();
+			return false;
+		}
+
+		// The model itself is always an input, even if Assimp opened it under a different name
+		openedFiles.push_back(filesystem::u8path(job.AssetName).lexically_normal().u8string());
+		sort(openedFiles.begin(), openedFiles.end());
+		openedFiles.erase(unique(openedFiles.begin(), openedFiles.end()), openedFiles.end());
+		for (const string& openedFile : openedFiles)
+		{
+			CookedInput input;
+			if (!DescribeInput(openedFile, input))
+			{
+				job.Message = "unable to read " + openedFile;
+				return false;
+			}
+			job.Entry.Inputs.push_back(input);
+		}
+		ostringstream message;
+		message << model.Nodes.size() << " nodes, " << model.SubMeshes.size() << " sub-meshes, "
+				<< model.Vertices.size() << " vertices, " << model.Indices.size() << " indices (including levels of detail)";
+		job.Message = message.str();
+		return true;
+	}
+
+	// Make a block compressed DDS file with the full mip chain of an image.  Returns false if the image cannot
+	// be decoded or its size is not a multiple of 4 (which a block compressed texture needs).  The mip levels are
+	// made with the Kaiser filter and compressed at the highest quality, since it does not slow down loading.
+	bool CompressTexture(const vector<uint8_t>& contents, vector<uint8_t>& dds, string& description)
+	{
+		ImageInfo info;
+		if (!ReadImageInfo(contents.data(), contents.size(), info) || info.Width % 4 != 0 || info.Height % 4 != 0)
+		{
+			return false;
+		}
+		size_t rowPitch = static_cast<size_t>(info.Width) * 4;
+		vector<uint8_t> pixels(rowPitch * info.Height);
+		if (!DecodeImage(contents.data(), contents.size(), pixels.data(), rowPitch))
+		{
+			return false;
+		}
+		// Images with transparent pixels are filtered premultiplied, so their colour does not bleed in, the same
+		// as when they are loaded
+		bool opaque = IsOpaque(pixels.data(), info.Width, info.Height, rowPitch);
+		BlockFormat format = opaque ? BlockFormat::BC1 : BlockFormat::BC3;
+		MipChain chain;
+		if (!GenerateMipChain(pixels.data(), info.Width, info.Height, rowPitch, MipFormat::RGBA8, true, MipFilter::Kaiser, chain, 0,
+							  opaque ? MipAlpha::Separate : MipAlpha::Straight))
+		{
+			return false;
+		}
+		uint32_t ddsFormat = opaque ? (info.Srgb ? DdsFormatBC1Srgb : DdsFormatBC1) : (info.Srgb ? DdsFormatBC3Srgb : DdsFormatBC3);
+		WriteDdsHeader(dds, ddsFormat, info.Width, info.Height, static_cast<uint32_t>(chain.Levels.size()));
+		for (size_t level = 0; level < chain.Levels.size(); level++)
+		{
+			const MipLevel& mipLevel = chain.Levels[level];
+			vector<uint8_t> blocks;
+			CompressBlocks(chain.GetLevelPixels(level), mipLevel.Width, mipLevel.Height, mipLevel.RowPitch, false, format, BlockQuality::High, blocks);
+			dds.insert(dds.end(), blocks.begin(), blocks.end());
+		}
+		ostringstream message;
+		message << info.Width << "x" << info.Height << " " << (opaque ? "BC1" : "BC3") << ", " << chain.Levels.size() << " levels, ";
+		description = message.str();
+		return true;
+	}
+
+	// The cooked texture keeps the name of the image, since textures are found by name and the ResourceManager
+	// tells DDS files by their contents
+	bool CookTexture(CookJob& job, const filesystem::path& outputPath)
+	{
+		vector<uint8_t> contents;
+		CookedInput input;
+		if (!ReadFileContents(job.AssetName, contents) || !DescribeInput(job.AssetName, input))
+		{
+			job.Message = "unable to read the texture";
+			return false;
+		}
+		vector<uint8_t> dds;
+		string description;
+		bool compressed = CompressTexture(contents, dds, description);
+		const vector<uint8_t>& output = compressed ? dds : contents;
+		if (!WriteFileContents(outputPath, output))
+		{
+			job.Message = "unable to write " + outputPath.u8string();
+			return false;
+		}
+		job.Entry.Inputs.push_back(input);
+		job.Message = (compressed ? description : "copied, ") + to_string(output.size()) + " bytes";
+		return true;
+	}
+
+	bool IsUpToDate(const CookJob& job, const filesystem::path& outputPath)
+	{
+		const ManifestEntry* previous = job.PreviousEntry;
+		if (!previous || previous->Version != CookerVersion || previous->Profile != job.Entry.Profile || previous->Inputs.empty())
+		{
+			return false;
+		}
+		error_code error;
+		if (!filesystem::exists(outputPath, error))
+		{
+			return false;
+		}
+		for (const CookedInput& input : previous->Inputs)
+		{
+			if (!IsInputUnchanged(input))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// The manifest is a text file.  Each asset has a line
+	//		asset <cooker version> <profile> <output name>
+	// followed by a line for each of its inputs
+	//		input <size> <modified time> <hash> <path>
+	// Names come last on each line so that they can contain spaces.
+	map<string, ManifestEntry> ReadManifest(const filesystem::path& manifestPath)
+	{
+		map<string, ManifestEntry> manifest;
+		ifstream file(manifestPath);
+		string line;
+		ManifestEntry* entry = nullptr;
+		while (getline(file, line))
+		{
+			istringstream fields(line);
+			string kind;
+			fields >> kind;
+			if (kind == "asset")
+			{
+				ManifestEntry newEntry;
+				string outputName;
+				fields >> newEntry.Version >> newEntry.Profile;
+				getline(fields >> ws, outputName);
+				entry = fields ? &(manifest[outputName] = newEntry) : nullptr;
+			}
+			else if (kind == "input" && entry)
+			{
+				CookedInput input;
+				fields >> input.Size >> input.ModifiedTime >> input.Hash;
+				getline(fields >> ws, input.Path);
+				if (fields)
+				{
+					entry->Inputs.push_back(input);
+				}
+			}
+		}
+		return manifest;
+	}
+
+	bool WriteManifest(const filesystem::path& manifestPath, const vector<CookJob>& jobs)
+	{
+		ostringstream manifest;
+		for (const CookJob& job : jobs)
+		{
+			const ManifestEntry* entry = job.Result == CookResult::UpToDate ? job.PreviousEntry : &job.Entry;
+			if (job.Result == CookResult::Failed)
+			{
+				// Leave it out so that it is tried again next time
+				continue;
+			}
+			manifest << "asset " << CookerVersion << " " << entry->Profile << " " << job.OutputName << "\n";
+			for (const CookedInput& input : entry->Inputs)
+			{
+				manifest << "input " << input.Size << " " << input.ModifiedTime << " " << input.Hash << " " << input.Path << "\n";
+			}
+		}
+		string text = manifest.str();
+		return WriteFileContents(manifestPath, vector<uint8_t>(text.begin(), text.end()));
+	}
+
+	int PrintUsage()
+	{
+		cerr << "Usage: AssetCooker [-profile <name>] [-archive <file>] [-force] <output directory> <asset>..." << endl;
+		cerr << "Import profiles:";
+		size_t profileCount;
+		const ImportProfile* profiles = GetImportProfiles(profileCount);
+		for (size_t i = 0; i < profileCount; i++)
+		{
+			cerr << " " << profiles[i].Name;
+		}
+		cerr << endl;
+		return 2;
+	}
+}
+
+int main(int argumentCount, char* arguments[])
+{
+	string profileName = DefaultImportProfile;
+	string archiveName;
+	bool force = false;
+	int argument = 1;
+	for (; argument < argumentCount && arguments[argument][0] == '-'; argument++)
+	{
+		if (strcmp(arguments[argument], "-profile") == 0 && argument + 1 < argumentCount)
+		{
+			profileName = arguments[++argument];
+		}
+		else if (strcmp(arguments[argument], "-archive") == 0 && argument + 1 < argumentCount)
+		{
+			archiveName = arguments[++argument];
+		}
+		else if (strcmp(arguments[argument], "-force") == 0)
+		{
+			force = true;
+		}
+		else
+		{
+			return PrintUsage();
+		}
+	}
+	const ImportProfile* profile = FindImportProfile(profileName);
+	if (!profile || argumentCount - argument < 2)
+	{
+		return PrintUsage();
+	}
+	filesystem::path outputDirectory = filesystem::u8path(arguments[argument++]);
+	filesystem::path manifestPath = outputDirectory / CookerManifestName;
+	map<string, ManifestEntry> manifest = ReadManifest(manifestPath);
+
+	vector<CookJob> jobs;
+	for (; argument < argumentCount; argument++)
+	{
+		CookJob job;
+		job.AssetName = arguments[argument];
+		job.IsModel = !IsTexture(job.AssetName);
+		job.OutputName = filesystem::u8path(job.AssetName).lexically_normal().relative_path().generic_u8string();
+		if (job.IsModel)
+		{
+			job.OutputName += CookedModelExtension;
+		}
+		map<string, ManifestEntry>::const_iterator previous = manifest.find(job.OutputName);
+		job.PreviousEntry = force || previous == manifest.end() ? nullptr : &previous->second;
+		job.Entry.Version = CookerVersion;
+		job.Entry.Profile = job.IsModel ? profile->Name : "-";
+		job.Result = CookResult::Failed;
+		jobs.push_back(job);
+	}
+
+	// Each asset is cooked on its own, so the assets are shared out between threads one at a time
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+	ParallelFor(jobs.size(), 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			CookJob& job = jobs[i];
+			filesystem::path outputPath = outputDirectory / filesystem::u8path(job.OutputName);
+			if (IsUpToDate(job, outputPath))
+			{
+				job.Result = CookResult::UpToDate;
+				continue;
+			}
+			bool cooked = job.IsModel ? CookModel(job, *profile, outputPath) : CookTexture(job, outputPath);
+			job.Result = cooked ? CookResult::Cooked : CookResult::Failed;
+		}
+	});
+	double milliseconds = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+
+	size_t counts[3] = { 0, 0, 0 };
+	for (const CookJob& job : jobs)
+	{
+		counts[static_cast<int>(job.Result)]++;
+		switch (job.Result)
+		{
+			case CookResult::UpToDate:
+				cout << "up to date  " << job.OutputName << endl;
+				break;
+
+			case CookResult::Cooked:
+				cout << "cooked      " << job.OutputName << ": " << job.Message << endl;
+				break;
+
+			case CookResult::Failed:
+				cerr << "failed      " << job.AssetName << ": " << job.Message << endl;
+				break;
+		}
+	}
+	if (!WriteManifest(manifestPath, jobs))
+	{
+		cerr << "Unable to write " << manifestPath.u8string() << endl;
+		return 1;
+	}
+	cout << counts[static_cast<int>(CookResult::Cooked)] << " cooked, "
+		 << counts[static_cast<int>(CookResult::UpToDate)] << " up to date, "
+		 << counts[static_cast<int>(CookResult::Failed)] << " failed in " << milliseconds << "ms" << endl;
+
+	// The archive is only written again if something in it has changed
+	error_code error;
+	bool archiveExists = !archiveName.empty() && filesystem::exists(filesystem::u8path(archiveName), error);
+	if (!archiveName.empty() && (counts[static_cast<int>(CookResult::Cooked)] > 0 || !archiveExists))
+	{
+		AssetArchiveWriter writer;
+		for (const CookJob& job : jobs)
+		{
+			if (job.Result != CookResult::Failed &&
+				!writer.AddFile(job.OutputName, (outputDirectory / filesystem::u8path(job.OutputName)).u8string()))
+			{
+				cerr << "Unable to read " << job.OutputName << endl;
+				return 1;
+			}
+		}
+		if (!writer.Write(archiveName))
+		{
+			cerr << "Unable to write " << archiveName << endl;
+			return 1;
+		}
+		cout << "Packed " << writer.GetAssetCount() << " assets into " << archiveName << endl;
+	}
+	return counts[static_cast<int>(CookResult::Failed)] > 0 ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+// Image decoding benchmark.
+//
+// Decodes each image (see ImageDecoder.h) over and over into the same buffer and reports how long a decode
+// takes and the throughput, in megapixels and in megabytes of decoded RGBA per second.  For comparison, the
+// time to copy the decoded image once with memcpy is shown as well, which is about as fast as a decode into
+// memory could ever be.  The files are memory mapped, as the ResourceManager does, so the disk is not timed.
+//
+//		ImageBenchmark [-bgra] [-seconds <time per image>] <image>...
+//
+// For the textures that ship with the engine:
+//
+//		ImageBenchmark woodbox.bmp wings.bmp bihull.bmp
+//
+// This only uses the parts of the engine that do not depend on DirectX, so it builds on Linux:
+//
+//		g++ -std=c++17 -O2 -pthread -I. Tools/ImageBenchmark/ImageBenchmark.cpp ImageDecoder.cpp MappedFile.cpp
+//			-o ImageBenchmark
+
+#include "ImageDecoder.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+	const char* GetFormatName(ImageFileFormat format)
+	{
+		switch (format)
+		{
+			case ImageFileFormat::Bmp:
+				return "BMP";
+
+			case ImageFileFormat::Tga:
+				return "TGA";
+
+			case ImageFileFormat::Png:
+				return "PNG";
+
+			default:
+				return "unknown";
+		}
+	}
+
+	// Run body until at least seconds have passed (and at least a few times) and return the quickest run in
+	// milliseconds
+	template<typename TBody>
+	double TimeBest(double seconds, const TBody& body)
+	{
+		typedef chrono::high_resolution_clock Clock;
+		double best = 1e30;
+		Clock::time_point start = Clock::now();
+		for (int run = 0; run < 5 || chrono::duration<double>(Clock::now() - start).count() < seconds; run++)
+		{
+			Clock::time_point runStart = Clock::now();
+			if (!body())
+			{
+				return -1.0;
+			}
+			best = (min)(best, chrono::duration<double, milli>(Clock::now() - runStart).count());
+		}
+		return best;
+	}
+
+	int PrintUsage()
+	{
+		cerr << "Usage: ImageBenchmark [-bgra] [-seconds <time per image>] <image>..." << endl;
+		return 2;
+	}
+}
+
+int main(int argumentCount, char* arguments[])
+{
+	bool bgra = false;
+	double seconds = 1.0;
+	int argument = 1;
+	for (; argument < argumentCount && arguments[argument][0] == '-'; argument++)
+	{
+		if (strcmp(arguments[argument], "-bgra") == 0)
+		{
+			bgra = true;
+		}
+		else if (strcmp(arguments[argument], "-seconds") == 0 && argument + 1 < argumentCount)
+		{
+			seconds = atof(arguments[++argument]);
+		}
+		else
+		{
+			return PrintUsage();
+		}
+	}
+	if (argument == argumentCount)
+	{
+		return PrintUsage();
+	}
+
+	int failures = 0;
+	double totalPixels = 0.0;
+	double totalMilliseconds = 0.0;
+	for (; argument < argumentCount; argument++)
+	{
+		MappedFile file;
+		ImageInfo info;
+		if (!file.Open(arguments[argument]) || !ReadImageInfo(file.GetData(), file.GetSize(), info))
+		{
+			cerr << "failed      " << arguments[argument] << ": unable to read the image" << endl;
+			failures++;
+			continue;
+		}
+		size_t rowPitch = static_cast<size_t>(info.Width) * 4;
+		size_t imageSize = rowPitch * info.Height;
+		vector<uint8_t> pixels(imageSize);
+		vector<uint8_t> copy(imageSize);
+		double decodeTime = TimeBest(seconds, [&]()
+		{
+			return DecodeImage(file.GetData(), file.GetSize(), pixels.data(), rowPitch, bgra);
+		});
+		if (decodeTime < 0.0)
+		{
+			cerr << "failed      " << arguments[argument] << ": unable to decode the image" << endl;
+			failures++;
+			continue;
+		}
+		double copyTime = TimeBest(seconds / 4, [&]()
+		{
+			memcpy(copy.data(), pixels.data(), imageSize);
+			return true;
+		});
+
+		double pixelCount = static_cast<double>(info.Width) * info.Height;
+		totalPixels += pixelCount;
+		totalMilliseconds += decodeTime;
+		cout << "decoded     " << arguments[argument] << ": " << GetFormatName(info.Format) << " " << info.Width << "x" << info.Height
+			 << " in " << fixed << setprecision(3) << decodeTime << "ms, " << setprecision(1) << pixelCount / (decodeTime * 1000.0)
+			 << " Mpixels/s, " << imageSize / (decodeTime * 1000.0) << " MB/s (memcpy " << setprecision(3) << copyTime << "ms)" << endl;
+	}
+	if (totalMilliseconds > 0.0)
+	{
+		cout << "total       " << fixed << setprecision(3) << totalMilliseconds << "ms, " << setprecision(1)
+			 << totalPixels / (totalMilliseconds * 1000.0) << " Mpixels/s" << endl;
+	}
+	return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,260 @@
+// Stress test for the thread-safe resource map and the interned name table.
+//
+// Several threads acquire, load, release and evict resources from a ConcurrentResourceMap (see
+// ConcurrentResourceMap.h) following the same protocol as the ResourceManager: the first thread to ask for a
+// resource inserts a Loading entry and loads it, other threads wait for that load, some loads fail and are
+// removed so that a later request can try again, and released resources are evicted when nothing
+// references them.  One thread also evicts unreferenced resources in the background, as enforcing the
+// memory budget does.  Names are interned from fresh strings on every request, so the name table (see
+// InternedName.h) is used from every thread as well.
+//
+//		ResourceMapStress [-threads <count>] [-names <count>] [-iterations <per thread>]
+//
+// It checks that every thread gets the resource it asked for, that a resource is never evicted while it is
+// referenced, that interning the same name twice gives the same entry, and that the map is empty at the
+// end.  It is meant to be run under ThreadSanitizer, which reports any data race in the map or the name
+// table.  This only uses the parts of the engine that do not depend on DirectX, so it builds on Linux:
+//
+//		g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -I. Tools/ResourceMapStress/ResourceMapStress.cpp
+//			InternedName.cpp -o ResourceMapStress
+
+#include "ConcurrentResourceMap.h"
+#include "InternedName.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+	struct StressResource
+	{
+		wstring					Name;
+		// Set when the resource is evicted.  Nothing may see this while it holds a reference.
+		atomic<bool>			Evicted{ false };
+	};
+
+	typedef ConcurrentResourceMap<StressResource>	StressResourceMap;
+
+	struct StressCounters
+	{
+		atomic<size_t>			Loads{ 0 };
+		atomic<size_t>			FailedLoads{ 0 };
+		atomic<size_t>			Evictions{ 0 };
+		atomic<size_t>			Errors{ 0 };
+	};
+
+	void ReportError(StressCounters& counters, const char* message)
+	{
+		if (counters.Errors++ < 10)
+		{
+			cerr << "error: " << message << endl;
+		}
+	}
+
+	wstring GetResourceName(size_t index)
+	{
+		return L"resource" + to_wstring(index);
+	}
+
+	// Get a resource, loading it if it is not loaded, as ResourceManager::GetMesh does
+	shared_ptr<StressResource> AcquireResource(StressResourceMap& resources, const InternedName& name, unsigned long long use,
+											   bool failLoad, StressCounters& counters)
+	{
+		StressResourceMap::EntryPointer resource;
+		while (!(resource = resources.Acquire(name, use)))
+		{
+			resource = resources.Insert(name, 1, use);
+			if (resource)
+			{
+				if (failLoad)
+				{
+					resources.Erase(name, resource);
+					resource->FailLoading();
+					counters.FailedLoads++;
+					return nullptr;
+				}
+				shared_ptr<StressResource> loaded = make_shared<StressResource>();
+				loaded->Name = name.String();
+				resource->FinishLoading(loaded, loaded->Name.size(), sizeof(StressResource));
+				counters.Loads++;
+				return loaded;
+			}
+		}
+		if (!resource->WaitForLoad())
+		{
+			resource->Release();
+			return nullptr;
+		}
+		return resource->ResourcePointer;
+	}
+
+	void EvictResource(StressResourceMap& resources, const InternedName& name, StressCounters& counters)
+	{
+		StressResourceMap::EntryPointer resource = resources.EraseIfUnreferenced(name);
+		if (resource)
+		{
+			resource->ResourcePointer->Evicted = true;
+			counters.Evictions++;
+		}
+	}
+
+	int PrintUsage()
+	{
+		cerr << "usage: ResourceMapStress [-threads <count>] [-names <count>] [-iterations <per thread>]" << endl;
+		return 1;
+	}
+}
+
+int main(int argumentCount, char* arguments[])
+{
+	size_t threadCount = 8;
+	size_t nameCount = 64;
+	size_t iterations = 20000;
+	for (int argument = 1; argument < argumentCount; argument++)
+	{
+		if (argument + 1 < argumentCount && strcmp(arguments[argument], "-threads") == 0)
+		{
+			threadCount = strtoul(arguments[++argument], nullptr, 10);
+		}
+		else if (argument + 1 < argumentCount && strcmp(arguments[argument], "-names") == 0)
+		{
+			nameCount = strtoul(arguments[++argument], nullptr, 10);
+		}
+		else if (argument + 1 < argumentCount && strcmp(arguments[argument], "-iterations") == 0)
+		{
+			iterations = strtoul(arguments[++argument], nullptr, 10);
+		}
+		else
+		{
+			return PrintUsage();
+		}
+	}
+	if (threadCount == 0 || nameCount == 0)
+	{
+		return PrintUsage();
+	}
+
+	StressResourceMap resources;
+	StressCounters counters;
+	atomic<unsigned long long> useCounter(0);
+	atomic<size_t> runningThreads(threadCount);
+	vector<thread> threads;
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		threads.emplace_back([&, i]()
+		{
+			mt19937 random(static_cast<unsigned int>(i + 1));
+			uniform_int_distribution<size_t> pickName(0, nameCount - 1);
+			uniform_int_distribution<int> pickPercent(0, 99);
+			vector<pair<InternedName, shared_ptr<StressResource>>> held;
+			for (size_t iteration = 0; iteration < iterations; iteration++)
+			{
+				// Hold a few resources at a time, releasing the oldest as new ones are acquired
+				wstring nameString = GetResourceName(pickName(random));
+				InternedName name(nameString);
+				if (InternedName(wstring(nameString)) != name || InternedName::Find(nameString) != name || name.View() != nameString)
+				{
+					ReportError(counters, "interning the same name gave different entries");
+				}
+				shared_ptr<StressResource> resource = AcquireResource(resources, name, ++useCounter, pickPercent(random) < 5, counters);
+				if (resource)
+				{
+					if (resource->Name != nameString)
+					{
+						ReportError(counters, "acquired the wrong resource");
+					}
+					held.emplace_back(name, resource);
+				}
+				for (const pair<InternedName, shared_ptr<StressResource>>& heldResource : held)
+				{
+					if (heldResource.second->Evicted)
+					{
+						ReportError(counters, "a resource was evicted while it was referenced");
+					}
+				}
+				if (held.size() > 4 || (!held.empty() && pickPercent(random) < 30))
+				{
+					InternedName heldName = held.front().first;
+					held.erase(held.begin());
+					StressResourceMap::EntryPointer entry = resources.Find(heldName.View());
+					if (!entry)
+					{
+						ReportError(counters, "a referenced resource is not in the map");
+					}
+					else
+					{
+						entry->LastUsed = ++useCounter;
+						// Keep about half of the released resources warm for the background evictor
+						if (entry->Release() && pickPercent(random) < 50)
+						{
+							EvictResource(resources, heldName, counters);
+						}
+					}
+				}
+			}
+			for (const pair<InternedName, shared_ptr<StressResource>>& heldResource : held)
+			{
+				StressResourceMap::EntryPointer entry = resources.Find(heldResource.first);
+				if (entry)
+				{
+					entry->Release();
+				}
+			}
+			runningThreads--;
+		});
+	}
+	// Evict everything that is not referenced in the background, as the memory budget does
+	thread evictor([&]()
+	{
+		while (runningThreads > 0)
+		{
+			vector<InternedName> names;
+			for (size_t i = 0; i < nameCount; i++)
+			{
+				InternedName name = InternedName::Find(GetResourceName(i));
+				if (!name.IsEmpty())
+				{
+					names.push_back(name);
+				}
+			}
+			resources.ForEach([&](const InternedName&, StressResourceMap::EntryPointer& entry)
+			{
+				if (entry->State == ResourceState::Loaded && entry->ResourcePointer->Evicted)
+				{
+					ReportError(counters, "an evicted resource is still in the map");
+				}
+			});
+			for (const InternedName& name : names)
+			{
+				EvictResource(resources, name, counters);
+			}
+			this_thread::yield();
+		}
+	});
+	for (thread& workerThread : threads)
+	{
+		workerThread.join();
+	}
+	evictor.join();
+
+	// Nothing references anything now, so everything can be evicted
+	for (size_t i = 0; i < nameCount; i++)
+	{
+		EvictResource(resources, InternedName(GetResourceName(i)), counters);
+	}
+	if (resources.Size() != 0)
+	{
+		ReportError(counters, "resources were left in the map");
+	}
+	cout << threadCount << " threads, " << counters.Loads << " loads, " << counters.FailedLoads << " failed loads, "
+		 << counters.Evictions << " evictions, " << counters.Errors << " errors" << endl;
+	return counters.Errors == 0 ? 0 : 1;
+}
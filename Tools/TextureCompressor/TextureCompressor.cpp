@@ -0,0 +1,287 @@
+// Offline texture compressor.
+//
+// Makes the full mip chain of each image (with the Kaiser filter, see MipGenerator.h), block compresses
+// every level (see BlockCompression.h) and writes the result as a DDS file in the output directory.  For
+// each image it reports the format, the compression ratio, the error (PSNR) of the top level and the time
+// taken.  Compressing offline means the best quality can be used without slowing down loading.
+//
+//		TextureCompressor [-format bc1|bc3|bc7] [-quality fast|normal|high] [-linear] [-srgb] [-maxsize <size>]
+//			[-premultiply | -separatealpha] <output directory> <image>...
+//
+// Without -format, opaque images are compressed to BC1 and the others to BC3.  -linear says that the colour
+// channels are not sRGB encoded (e.g. normal maps), so the mip levels are filtered as they are.  -srgb marks
+// the DDS files as sRGB, so that the GPU converts them to linear when they are sampled.  -maxsize shrinks
+// images whose width or height is bigger than size (keeping their shape) with the Lanczos3 filter (see
+// ImageResampler.h) before the mip chain is made.  Images with transparent pixels are filtered with their
+// colour premultiplied by alpha; -premultiply stores them premultiplied too, and -separatealpha filters alpha
+// like the other channels (for alpha that is not coverage).  BMP, TGA and PNG files are read (see
+// ImageDecoder.h).
+//
+// This only uses the parts of the engine that do not depend on DirectX, so it builds on Linux:
+//
+//		g++ -std=c++17 -O2 -pthread -I. Tools/TextureCompressor/TextureCompressor.cpp BlockCompression.cpp
+//			MipGenerator.cpp ImageResampler.cpp DdsFile.cpp ImageDecoder.cpp -o TextureCompressor
+
+#include "BlockCompression.h"
+#include "DdsFile.h"
+#include "ImageDecoder.h"
+#include "ImageResampler.h"
+#include "MipGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+	// An 8-bit RGBA image with tightly packed rows
+	struct Image
+	{
+		uint32_t					Width;
+		uint32_t					Height;
+		vector<uint8_t>				Pixels;
+	};
+
+	bool ReadFile(const filesystem::path& path, vector<uint8_t>& contents)
+	{
+		ifstream file(path, ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+		contents.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+		return true;
+	}
+
+	// Shrink an image so that neither its width nor its height is bigger than maximumSize, keeping its shape
+	void ShrinkImage(Image& image, uint32_t maximumSize, bool srgb, ResampleAlpha alpha)
+	{
+		Image shrunk;
+		if (image.Width >= image.Height)
+		{
+			shrunk.Width = maximumSize;
+			shrunk.Height = (max)(static_cast<uint32_t>(static_cast<uint64_t>(image.Height) * maximumSize / image.Width), 1u);
+		}
+		else
+		{
+			shrunk.Height = maximumSize;
+			shrunk.Width = (max)(static_cast<uint32_t>(static_cast<uint64_t>(image.Width) * maximumSize / image.Height), 1u);
+		}
+		shrunk.Pixels.resize(static_cast<size_t>(shrunk.Width) * shrunk.Height * 4);
+		ResampleImage(image.Pixels.data(), image.Width, image.Height, image.Width * 4, shrunk.Pixels.data(), shrunk.Width, shrunk.Height,
+					  shrunk.Width * 4, ResampleFormat::RGBA8, srgb, ResampleFilter::Lanczos3, alpha);
+		image = move(shrunk);
+	}
+
+	bool WriteFile(const filesystem::path& path, const vector<uint8_t>& contents)
+	{
+		ofstream file(path, ios::binary | ios::trunc);
+		file.write(reinterpret_cast<const char*>(contents.data()), contents.size());
+		return static_cast<bool>(file);
+	}
+
+	bool ReadImage(const vector<uint8_t>& file, Image& image)
+	{
+		ImageInfo info;
+		if (!ReadImageInfo(file.data(), file.size(), info))
+		{
+			return false;
+		}
+		image.Width = info.Width;
+		image.Height = info.Height;
+		image.Pixels.resize(static_cast<size_t>(image.Width) * image.Height * 4);
+		return DecodeImage(file.data(), file.size(), image.Pixels.data(), static_cast<size_t>(image.Width) * 4);
+	}
+
+	vector<uint8_t> MakeDds(uint32_t width, uint32_t height, uint32_t format, const vector<vector<uint8_t>>& levels)
+	{
+		vector<uint8_t> dds;
+		WriteDdsHeader(dds, format, width, height, static_cast<uint32_t>(levels.size()));
+		for (const vector<uint8_t>& level : levels)
+		{
+			dds.insert(dds.end(), level.begin(), level.end());
+		}
+		return dds;
+	}
+
+	uint32_t GetDdsFormat(BlockFormat format, bool srgb)
+	{
+		switch (format)
+		{
+			case BlockFormat::BC1:
+				return srgb ? DdsFormatBC1Srgb : DdsFormatBC1;
+
+			case BlockFormat::BC3:
+				return srgb ? DdsFormatBC3Srgb : DdsFormatBC3;
+
+			default:
+				return srgb ? DdsFormatBC7Srgb : DdsFormatBC7;
+		}
+	}
+
+	const char* GetFormatName(BlockFormat format)
+	{
+		return format == BlockFormat::BC1 ? "BC1" : (format == BlockFormat::BC3 ? "BC3" : "BC7");
+	}
+
+	int PrintUsage()
+	{
+		cerr << "Usage: TextureCompressor [-format bc1|bc3|bc7] [-quality fast|normal|high] [-linear] [-srgb] [-maxsize <size>] [-premultiply | -separatealpha] <output directory> <image>..." << endl;
+		return 2;
+	}
+}
+
+int main(int argumentCount, char* arguments[])
+{
+	bool automaticFormat = true;
+	BlockFormat format = BlockFormat::BC1;
+	BlockQuality quality = BlockQuality::High;
+	bool linear = false;
+	bool srgb = false;
+	uint32_t maximumSize = 0;
+	bool premultiply = false;
+	bool separateAlpha = false;
+	int argument = 1;
+	for (; argument < argumentCount && arguments[argument][0] == '-'; argument++)
+	{
+		if (strcmp(arguments[argument], "-format") == 0 && argument + 1 < argumentCount)
+		{
+			string formatName = arguments[++argument];
+			automaticFormat = false;
+			if (formatName == "bc1")
+			{
+				format = BlockFormat::BC1;
+			}
+			else if (formatName == "bc3")
+			{
+				format = BlockFormat::BC3;
+			}
+			else if (formatName == "bc7")
+			{
+				format = BlockFormat::BC7;
+			}
+			else
+			{
+				return PrintUsage();
+			}
+		}
+		else if (strcmp(arguments[argument], "-quality") == 0 && argument + 1 < argumentCount)
+		{
+			string qualityName = arguments[++argument];
+			if (qualityName == "fast")
+			{
+				quality = BlockQuality::Fast;
+			}
+			else if (qualityName == "normal")
+			{
+				quality = BlockQuality::Normal;
+			}
+			else if (qualityName == "high")
+			{
+				quality = BlockQuality::High;
+			}
+			else
+			{
+				return PrintUsage();
+			}
+		}
+		else if (strcmp(arguments[argument], "-linear") == 0)
+		{
+			linear = true;
+		}
+		else if (strcmp(arguments[argument], "-srgb") == 0)
+		{
+			srgb = true;
+		}
+		else if (strcmp(arguments[argument], "-premultiply") == 0)
+		{
+			premultiply = true;
+		}
+		else if (strcmp(arguments[argument], "-separatealpha") == 0)
+		{
+			separateAlpha = true;
+		}
+		else if (strcmp(arguments[argument], "-maxsize") == 0 && argument + 1 < argumentCount)
+		{
+			maximumSize = static_cast<uint32_t>(atoi(arguments[++argument]));
+			if (maximumSize == 0)
+			{
+				return PrintUsage();
+			}
+		}
+		else
+		{
+			return PrintUsage();
+		}
+	}
+	if (argumentCount - argument < 2 || (premultiply && separateAlpha))
+	{
+		return PrintUsage();
+	}
+	filesystem::path outputDirectory = filesystem::u8path(arguments[argument++]);
+	error_code error;
+	filesystem::create_directories(outputDirectory, error);
+
+	int failures = 0;
+	for (; argument < argumentCount; argument++)
+	{
+		filesystem::path imagePath = filesystem::u8path(arguments[argument]);
+		vector<uint8_t> file;
+		Image image;
+		if (!ReadFile(imagePath, file) || !ReadImage(file, image))
+		{
+			cerr << "failed      " << arguments[argument] << ": unable to read the image" << endl;
+			failures++;
+			continue;
+		}
+
+		// Each level is compressed in parallel (by rows of blocks), so the images are done one at a time
+		chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+		bool opaque = IsOpaque(image.Pixels.data(), image.Width, image.Height, image.Width * 4);
+		ResampleAlpha alpha = opaque || separateAlpha ? ResampleAlpha::Separate : ResampleAlpha::Straight;
+		if (maximumSize != 0 && (image.Width > maximumSize || image.Height > maximumSize))
+		{
+			ShrinkImage(image, maximumSize, !linear, alpha);
+		}
+		BlockFormat imageFormat = format;
+		if (automaticFormat)
+		{
+			imageFormat = opaque ? BlockFormat::BC1 : BlockFormat::BC3;
+		}
+		MipChain chain;
+		GenerateMipChain(image.Pixels.data(), image.Width, image.Height, image.Width * 4, MipFormat::RGBA8, !linear, MipFilter::Kaiser, chain, 0,
+						 premultiply && !opaque ? MipAlpha::Premultiply : alpha);
+		vector<vector<uint8_t>> levels(chain.Levels.size());
+		size_t compressedSize = 0;
+		for (size_t level = 0; level < chain.Levels.size(); level++)
+		{
+			const MipLevel& mipLevel = chain.Levels[level];
+			CompressBlocks(chain.GetLevelPixels(level), mipLevel.Width, mipLevel.Height, mipLevel.RowPitch, false, imageFormat, quality, levels[level]);
+			compressedSize += levels[level].size();
+		}
+		double milliseconds = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+		BlockCompressionError compressionError = MeasureBlockCompressionError(chain.GetLevelPixels(0), image.Width, image.Height, image.Width * 4, false,
+																			  imageFormat, levels[0].data());
+
+		filesystem::path outputPath = outputDirectory / imagePath.filename().replace_extension(".dds");
+		if (!WriteFile(outputPath, MakeDds(image.Width, image.Height, GetDdsFormat(imageFormat, srgb), levels)))
+		{
+			cerr << "failed      " << arguments[argument] << ": unable to write " << outputPath.u8string() << endl;
+			failures++;
+			continue;
+		}
+		cout << "compressed  " << outputPath.u8string() << ": " << image.Width << "x" << image.Height << " " << GetFormatName(imageFormat)
+			 << ", " << chain.Levels.size() << " levels, " << fixed << setprecision(1)
+			 << static_cast<double>(chain.Pixels.size()) / compressedSize << ":1, PSNR " << setprecision(2) << compressionError.Psnr
+			 << "dB in " << setprecision(1) << milliseconds << "ms" << endl;
+	}
+	return failures > 0 ? 1 : 0;
+}
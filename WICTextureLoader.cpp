@@ -1,934 +1,1343 @@
-//--------------------------------------------------------------------------------------
-// File: WICTextureLoader.cpp
-//
-// Function for loading a WIC image and creating a Direct3D runtime texture for it
-// (auto-generating mipmaps if possible)
-//
-// Note: Assumes application has already called CoInitializeEx
-//
-// Warning: CreateWICTexture* functions are not thread-safe if given a d3dContext instance for
-//          auto-gen mipmap support.
-//
-// Note these functions are useful for images created as simple 2D textures. For
-// more complex resources, DDSTextureLoader is an excellent light-weight runtime loader.
-// For a full-featured DDS file reader, writer, and texture processing pipeline see
-// the 'Texconv' sample and the 'DirectXTex' library.
-//
-// THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF
-// ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO
-// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
-// PARTICULAR PURPOSE.
-//
-// Copyright (c) Microsoft Corporation. All rights reserved.
-//
-// http://go.microsoft.com/fwlink/?LinkId=248926
-// http://go.microsoft.com/fwlink/?LinkId=248929
-//--------------------------------------------------------------------------------------
-
-// We could load multi-frame images (TIFF/GIF) into a texture array.
-// For now, we just load the first frame (note: DirectXTex supports multi-frame images)
-
-#include "WICTextureLoader.h"
-
-#include <dxgiformat.h>
-#include <assert.h>
-
-#include <wincodec.h>
-
-#include <wrl\client.h>
-
-#include <algorithm>
-#include <memory>
-
-#if !defined(NO_D3D11_DEBUG_NAME) && ( defined(_DEBUG) || defined(PROFILE) )
-#pragma comment(lib,"dxguid.lib")
-#endif
-
-using namespace DirectX;
-using Microsoft::WRL::ComPtr;
-
-namespace
-{
-    //--------------------------------------------------------------------------------------
-    template<UINT TNameLength>
-    inline void SetDebugObjectName(_In_ ID3D11DeviceChild* resource, _In_ const char(&name)[TNameLength])
-    {
-#if !defined(NO_D3D11_DEBUG_NAME) && ( defined(_DEBUG) || defined(PROFILE) )
-        resource->SetPrivateData(WKPDID_D3DDebugObjectName, TNameLength - 1, name);
-#else
-        UNREFERENCED_PARAMETER(resource);
-        UNREFERENCED_PARAMETER(name);
-#endif
-    }
-
-    //-------------------------------------------------------------------------------------
-    // WIC Pixel Format Translation Data
-    //-------------------------------------------------------------------------------------
-    struct WICTranslate
-    {
-        GUID                wic;
-        DXGI_FORMAT         format;
-    };
-
-    const WICTranslate g_WICFormats[] =
-    {
-        { GUID_WICPixelFormat128bppRGBAFloat,       DXGI_FORMAT_R32G32B32A32_FLOAT },
-
-        { GUID_WICPixelFormat64bppRGBAHalf,         DXGI_FORMAT_R16G16B16A16_FLOAT },
-        { GUID_WICPixelFormat64bppRGBA,             DXGI_FORMAT_R16G16B16A16_UNORM },
-
-        { GUID_WICPixelFormat32bppRGBA,             DXGI_FORMAT_R8G8B8A8_UNORM },
-        { GUID_WICPixelFormat32bppBGRA,             DXGI_FORMAT_B8G8R8A8_UNORM }, // DXGI 1.1
-        { GUID_WICPixelFormat32bppBGR,              DXGI_FORMAT_B8G8R8X8_UNORM }, // DXGI 1.1
-
-        { GUID_WICPixelFormat32bppRGBA1010102XR,    DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM }, // DXGI 1.1
-        { GUID_WICPixelFormat32bppRGBA1010102,      DXGI_FORMAT_R10G10B10A2_UNORM },
-
-        { GUID_WICPixelFormat16bppBGRA5551,         DXGI_FORMAT_B5G5R5A1_UNORM },
-        { GUID_WICPixelFormat16bppBGR565,           DXGI_FORMAT_B5G6R5_UNORM },
-
-        { GUID_WICPixelFormat32bppGrayFloat,        DXGI_FORMAT_R32_FLOAT },
-        { GUID_WICPixelFormat16bppGrayHalf,         DXGI_FORMAT_R16_FLOAT },
-        { GUID_WICPixelFormat16bppGray,             DXGI_FORMAT_R16_UNORM },
-        { GUID_WICPixelFormat8bppGray,              DXGI_FORMAT_R8_UNORM },
-
-        { GUID_WICPixelFormat8bppAlpha,             DXGI_FORMAT_A8_UNORM },
-    };
-
-    //-------------------------------------------------------------------------------------
-    // WIC Pixel Format nearest conversion table
-    //-------------------------------------------------------------------------------------
-
-    struct WICConvert
-    {
-        GUID        source;
-        GUID        target;
-    };
-
-    const WICConvert g_WICConvert[] =
-    {
-        // Note target GUID in this conversion table must be one of those directly supported formats (above).
-
-        { GUID_WICPixelFormatBlackWhite,            GUID_WICPixelFormat8bppGray }, // DXGI_FORMAT_R8_UNORM
-
-        { GUID_WICPixelFormat1bppIndexed,           GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
-        { GUID_WICPixelFormat2bppIndexed,           GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
-        { GUID_WICPixelFormat4bppIndexed,           GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
-        { GUID_WICPixelFormat8bppIndexed,           GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
-
-        { GUID_WICPixelFormat2bppGray,              GUID_WICPixelFormat8bppGray }, // DXGI_FORMAT_R8_UNORM 
-        { GUID_WICPixelFormat4bppGray,              GUID_WICPixelFormat8bppGray }, // DXGI_FORMAT_R8_UNORM 
-
-        { GUID_WICPixelFormat16bppGrayFixedPoint,   GUID_WICPixelFormat16bppGrayHalf }, // DXGI_FORMAT_R16_FLOAT 
-        { GUID_WICPixelFormat32bppGrayFixedPoint,   GUID_WICPixelFormat32bppGrayFloat }, // DXGI_FORMAT_R32_FLOAT 
-
-        { GUID_WICPixelFormat16bppBGR555,           GUID_WICPixelFormat16bppBGRA5551 }, // DXGI_FORMAT_B5G5R5A1_UNORM
-
-        { GUID_WICPixelFormat32bppBGR101010,        GUID_WICPixelFormat32bppRGBA1010102 }, // DXGI_FORMAT_R10G10B10A2_UNORM
-
-        { GUID_WICPixelFormat24bppBGR,              GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
-        { GUID_WICPixelFormat24bppRGB,              GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
-        { GUID_WICPixelFormat32bppPBGRA,            GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
-        { GUID_WICPixelFormat32bppPRGBA,            GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
-
-        { GUID_WICPixelFormat48bppRGB,              GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
-        { GUID_WICPixelFormat48bppBGR,              GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
-        { GUID_WICPixelFormat64bppBGRA,             GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
-        { GUID_WICPixelFormat64bppPRGBA,            GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
-        { GUID_WICPixelFormat64bppPBGRA,            GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
-
-        { GUID_WICPixelFormat48bppRGBFixedPoint,    GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
-        { GUID_WICPixelFormat48bppBGRFixedPoint,    GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
-        { GUID_WICPixelFormat64bppRGBAFixedPoint,   GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
-        { GUID_WICPixelFormat64bppBGRAFixedPoint,   GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
-        { GUID_WICPixelFormat64bppRGBFixedPoint,    GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
-        { GUID_WICPixelFormat64bppRGBHalf,          GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
-        { GUID_WICPixelFormat48bppRGBHalf,          GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
-
-        { GUID_WICPixelFormat128bppPRGBAFloat,      GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
-        { GUID_WICPixelFormat128bppRGBFloat,        GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
-        { GUID_WICPixelFormat128bppRGBAFixedPoint,  GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
-        { GUID_WICPixelFormat128bppRGBFixedPoint,   GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
-        { GUID_WICPixelFormat32bppRGBE,             GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
-
-        { GUID_WICPixelFormat32bppCMYK,             GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM
-        { GUID_WICPixelFormat64bppCMYK,             GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
-        { GUID_WICPixelFormat40bppCMYKAlpha,        GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM
-        { GUID_WICPixelFormat80bppCMYKAlpha,        GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
-
-    #if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
-        { GUID_WICPixelFormat32bppRGB,              GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM
-        { GUID_WICPixelFormat64bppRGB,              GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
-        { GUID_WICPixelFormat64bppPRGBAHalf,        GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
-    #endif
-
-        // We don't support n-channel formats
-    };
-
-    bool g_WIC2 = false;
-
-    //--------------------------------------------------------------------------------------
-    IWICImagingFactory* _GetWIC()
-    {
-        static INIT_ONCE s_initOnce = INIT_ONCE_STATIC_INIT;
-
-        IWICImagingFactory* factory = nullptr;
-        InitOnceExecuteOnce(&s_initOnce,
-            [](PINIT_ONCE, PVOID, PVOID *factory) -> BOOL
-        {
-#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
-            HRESULT hr = CoCreateInstance(
-                CLSID_WICImagingFactory2,
-                nullptr,
-                CLSCTX_INPROC_SERVER,
-                __uuidof(IWICImagingFactory2),
-                factory
-            );
-
-            if (SUCCEEDED(hr))
-            {
-                // WIC2 is available on Windows 10, Windows 8.x, and Windows 7 SP1 with KB 2670838 installed
-                g_WIC2 = true;
-                return TRUE;
-            }
-            else
-            {
-                hr = CoCreateInstance(
-                    CLSID_WICImagingFactory1,
-                    nullptr,
-                    CLSCTX_INPROC_SERVER,
-                    __uuidof(IWICImagingFactory),
-                    factory
-                );
-                return SUCCEEDED(hr) ? TRUE : FALSE;
-            }
-#else
-            return SUCCEEDED(CoCreateInstance(
-                CLSID_WICImagingFactory,
-                nullptr,
-                CLSCTX_INPROC_SERVER,
-                __uuidof(IWICImagingFactory),
-                factory)) ? TRUE : FALSE;
-#endif
-        }, nullptr, reinterpret_cast<LPVOID*>(&factory));
-
-        return factory;
-    }
-
-    //---------------------------------------------------------------------------------
-    DXGI_FORMAT _WICToDXGI(const GUID& guid)
-    {
-        for (size_t i = 0; i < _countof(g_WICFormats); ++i)
-        {
-            if (memcmp(&g_WICFormats[i].wic, &guid, sizeof(GUID)) == 0)
-                return g_WICFormats[i].format;
-        }
-
-#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
-        if (g_WIC2)
-        {
-            if (memcmp(&GUID_WICPixelFormat96bppRGBFloat, &guid, sizeof(GUID)) == 0)
-                return DXGI_FORMAT_R32G32B32_FLOAT;
-        }
-#endif
-
-        return DXGI_FORMAT_UNKNOWN;
-    }
-
-    //---------------------------------------------------------------------------------
-    size_t _WICBitsPerPixel(REFGUID targetGuid)
-    {
-        auto pWIC = _GetWIC();
-        if (!pWIC)
-            return 0;
-
-        ComPtr<IWICComponentInfo> cinfo;
-        if (FAILED(pWIC->CreateComponentInfo(targetGuid, cinfo.GetAddressOf())))
-            return 0;
-
-        WICComponentType type;
-        if (FAILED(cinfo->GetComponentType(&type)))
-            return 0;
-
-        if (type != WICPixelFormat)
-            return 0;
-
-        ComPtr<IWICPixelFormatInfo> pfinfo;
-        if (FAILED(cinfo.As(&pfinfo)))
-            return 0;
-
-        UINT bpp;
-        if (FAILED(pfinfo->GetBitsPerPixel(&bpp)))
-            return 0;
-
-        return bpp;
-    }
-
-
-    //--------------------------------------------------------------------------------------
-    DXGI_FORMAT MakeSRGB(_In_ DXGI_FORMAT format)
-    {
-        switch (format)
-        {
-        case DXGI_FORMAT_R8G8B8A8_UNORM:
-            return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
-
-        case DXGI_FORMAT_BC1_UNORM:
-            return DXGI_FORMAT_BC1_UNORM_SRGB;
-
-        case DXGI_FORMAT_BC2_UNORM:
-            return DXGI_FORMAT_BC2_UNORM_SRGB;
-
-        case DXGI_FORMAT_BC3_UNORM:
-            return DXGI_FORMAT_BC3_UNORM_SRGB;
-
-        case DXGI_FORMAT_B8G8R8A8_UNORM:
-            return DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
-
-        case DXGI_FORMAT_B8G8R8X8_UNORM:
-            return DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
-
-        case DXGI_FORMAT_BC7_UNORM:
-            return DXGI_FORMAT_BC7_UNORM_SRGB;
-
-        default:
-            return format;
-        }
-    }
-
-
-    //---------------------------------------------------------------------------------
-    HRESULT CreateTextureFromWIC(_In_ ID3D11Device* d3dDevice,
-        _In_opt_ ID3D11DeviceContext* d3dContext,
-        _In_ IWICBitmapFrameDecode *frame,
-        _In_ size_t maxsize,
-        _In_ D3D11_USAGE usage,
-        _In_ unsigned int bindFlags,
-        _In_ unsigned int cpuAccessFlags,
-        _In_ unsigned int miscFlags,
-        _In_ unsigned int loadFlags,
-        _Outptr_opt_ ID3D11Resource** texture,
-        _Outptr_opt_ ID3D11ShaderResourceView** textureView)
-    {
-        UINT width, height;
-        HRESULT hr = frame->GetSize(&width, &height);
-        if (FAILED(hr))
-            return hr;
-
-        assert(width > 0 && height > 0);
-
-        if (!maxsize)
-        {
-            // This is a bit conservative because the hardware could support larger textures than
-            // the Feature Level defined minimums, but doing it this way is much easier and more
-            // performant for WIC than the 'fail and retry' model used by DDSTextureLoader
-
-            switch (d3dDevice->GetFeatureLevel())
-            {
-            case D3D_FEATURE_LEVEL_9_1:
-            case D3D_FEATURE_LEVEL_9_2:
-                maxsize = 2048 /*D3D_FL9_1_REQ_TEXTURE2D_U_OR_V_DIMENSION*/;
-                break;
-
-            case D3D_FEATURE_LEVEL_9_3:
-                maxsize = 4096 /*D3D_FL9_3_REQ_TEXTURE2D_U_OR_V_DIMENSION*/;
-                break;
-
-            case D3D_FEATURE_LEVEL_10_0:
-            case D3D_FEATURE_LEVEL_10_1:
-                maxsize = 8192 /*D3D10_REQ_TEXTURE2D_U_OR_V_DIMENSION*/;
-                break;
-
-            default:
-                maxsize = D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION;
-                break;
-            }
-        }
-
-        assert(maxsize > 0);
-
-        UINT twidth, theight;
-        if (width > maxsize || height > maxsize)
-        {
-            float ar = static_cast<float>(height) / static_cast<float>(width);
-            if (width > height)
-            {
-                twidth = static_cast<UINT>(maxsize);
-                theight = std::max<UINT>(1, static_cast<UINT>(static_cast<float>(maxsize) * ar));
-            }
-            else
-            {
-                theight = static_cast<UINT>(maxsize);
-                twidth = std::max<UINT>(1, static_cast<UINT>(static_cast<float>(maxsize) / ar));
-            }
-            assert(twidth <= maxsize && theight <= maxsize);
-        }
-        else
-        {
-            twidth = width;
-            theight = height;
-        }
-
-        // Determine format
-        WICPixelFormatGUID pixelFormat;
-        hr = frame->GetPixelFormat(&pixelFormat);
-        if (FAILED(hr))
-            return hr;
-
-        WICPixelFormatGUID convertGUID;
-        memcpy(&convertGUID, &pixelFormat, sizeof(WICPixelFormatGUID));
-
-        size_t bpp = 0;
-
-        DXGI_FORMAT format = _WICToDXGI(pixelFormat);
-        if (format == DXGI_FORMAT_UNKNOWN)
-        {
-            if (memcmp(&GUID_WICPixelFormat96bppRGBFixedPoint, &pixelFormat, sizeof(WICPixelFormatGUID)) == 0)
-            {
-#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
-                if (g_WIC2)
-                {
-                    memcpy(&convertGUID, &GUID_WICPixelFormat96bppRGBFloat, sizeof(WICPixelFormatGUID));
-                    format = DXGI_FORMAT_R32G32B32_FLOAT;
-                    bpp = 96;
-                }
-                else
-#endif
-                {
-                    memcpy(&convertGUID, &GUID_WICPixelFormat128bppRGBAFloat, sizeof(WICPixelFormatGUID));
-                    format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-                    bpp = 128;
-                }
-            }
-            else
-            {
-                for (size_t i = 0; i < _countof(g_WICConvert); ++i)
-                {
-                    if (memcmp(&g_WICConvert[i].source, &pixelFormat, sizeof(WICPixelFormatGUID)) == 0)
-                    {
-                        memcpy(&convertGUID, &g_WICConvert[i].target, sizeof(WICPixelFormatGUID));
-
-                        format = _WICToDXGI(g_WICConvert[i].target);
-                        assert(format != DXGI_FORMAT_UNKNOWN);
-                        bpp = _WICBitsPerPixel(convertGUID);
-                        break;
-                    }
-                }
-            }
-
-            if (format == DXGI_FORMAT_UNKNOWN)
-                return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
-        }
-        else
-        {
-            bpp = _WICBitsPerPixel(pixelFormat);
-        }
-
-#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
-        if ((format == DXGI_FORMAT_R32G32B32_FLOAT) && d3dContext != 0 && textureView != 0)
-        {
-            // Special case test for optional device support for autogen mipchains for R32G32B32_FLOAT 
-            UINT fmtSupport = 0;
-            hr = d3dDevice->CheckFormatSupport(DXGI_FORMAT_R32G32B32_FLOAT, &fmtSupport);
-            if (FAILED(hr) || !(fmtSupport & D3D11_FORMAT_SUPPORT_MIP_AUTOGEN))
-            {
-                // Use R32G32B32A32_FLOAT instead which is required for Feature Level 10.0 and up
-                memcpy(&convertGUID, &GUID_WICPixelFormat128bppRGBAFloat, sizeof(WICPixelFormatGUID));
-                format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-                bpp = 128;
-            }
-        }
-#endif
-
-        if (!bpp)
-            return E_FAIL;
-
-        // Handle sRGB formats
-        if (loadFlags & WIC_LOADER_FORCE_SRGB)
-        {
-            format = MakeSRGB(format);
-        }
-        else if (!(loadFlags & WIC_LOADER_IGNORE_SRGB))
-        {
-            ComPtr<IWICMetadataQueryReader> metareader;
-            if (SUCCEEDED(frame->GetMetadataQueryReader(metareader.GetAddressOf())))
-            {
-                GUID containerFormat;
-                if (SUCCEEDED(metareader->GetContainerFormat(&containerFormat)))
-                {
-                    // Check for sRGB colorspace metadata
-                    bool sRGB = false;
-
-                    PROPVARIANT value;
-                    PropVariantInit(&value);
-
-                    if (memcmp(&containerFormat, &GUID_ContainerFormatPng, sizeof(GUID)) == 0)
-                    {
-                        // Check for sRGB chunk
-                        if (SUCCEEDED(metareader->GetMetadataByName(L"/sRGB/RenderingIntent", &value)) && value.vt == VT_UI1)
-                        {
-                            sRGB = true;
-                        }
-                    }
-                    else if (SUCCEEDED(metareader->GetMetadataByName(L"System.Image.ColorSpace", &value)) && value.vt == VT_UI2 && value.uiVal == 1)
-                    {
-                        sRGB = true;
-                    }
-
-                    (void)PropVariantClear(&value);
-
-                    if (sRGB)
-                        format = MakeSRGB(format);
-                }
-            }
-        }
-
-        // Verify our target format is supported by the current device
-        // (handles WDDM 1.0 or WDDM 1.1 device driver cases as well as DirectX 11.0 Runtime without 16bpp format support)
-        UINT support = 0;
-        hr = d3dDevice->CheckFormatSupport(format, &support);
-        if (FAILED(hr) || !(support & D3D11_FORMAT_SUPPORT_TEXTURE2D))
-        {
-            // Fallback to RGBA 32-bit format which is supported by all devices
-            memcpy(&convertGUID, &GUID_WICPixelFormat32bppRGBA, sizeof(WICPixelFormatGUID));
-            format = DXGI_FORMAT_R8G8B8A8_UNORM;
-            bpp = 32;
-        }
-
-        // Allocate temporary memory for image
-        size_t rowPitch = (twidth * bpp + 7) / 8;
-        size_t imageSize = rowPitch * theight;
-
-        std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[imageSize]);
-        if (!temp)
-            return E_OUTOFMEMORY;
-
-        // Load image data
-        if (memcmp(&convertGUID, &pixelFormat, sizeof(GUID)) == 0
-            && twidth == width
-            && theight == height)
-        {
-            // No format conversion or resize needed
-            hr = frame->CopyPixels(0, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize), temp.get());
-            if (FAILED(hr))
-                return hr;
-        }
-        else if (twidth != width || theight != height)
-        {
-            // Resize
-            auto pWIC = _GetWIC();
-            if (!pWIC)
-                return E_NOINTERFACE;
-
-            ComPtr<IWICBitmapScaler> scaler;
-            hr = pWIC->CreateBitmapScaler(scaler.GetAddressOf());
-            if (FAILED(hr))
-                return hr;
-
-            hr = scaler->Initialize(frame, twidth, theight, WICBitmapInterpolationModeFant);
-            if (FAILED(hr))
-                return hr;
-
-            WICPixelFormatGUID pfScaler;
-            hr = scaler->GetPixelFormat(&pfScaler);
-            if (FAILED(hr))
-                return hr;
-
-            if (memcmp(&convertGUID, &pfScaler, sizeof(GUID)) == 0)
-            {
-                // No format conversion needed
-                hr = scaler->CopyPixels(0, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize), temp.get());
-                if (FAILED(hr))
-                    return hr;
-            }
-            else
-            {
-                ComPtr<IWICFormatConverter> FC;
-                hr = pWIC->CreateFormatConverter(FC.GetAddressOf());
-                if (FAILED(hr))
-                    return hr;
-
-                BOOL canConvert = FALSE;
-                hr = FC->CanConvert(pfScaler, convertGUID, &canConvert);
-                if (FAILED(hr) || !canConvert)
-                {
-                    return E_UNEXPECTED;
-                }
-
-                hr = FC->Initialize(scaler.Get(), convertGUID, WICBitmapDitherTypeErrorDiffusion, nullptr, 0, WICBitmapPaletteTypeMedianCut);
-                if (FAILED(hr))
-                    return hr;
-
-                hr = FC->CopyPixels(0, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize), temp.get());
-                if (FAILED(hr))
-                    return hr;
-            }
-        }
-        else
-        {
-            // Format conversion but no resize
-            auto pWIC = _GetWIC();
-            if (!pWIC)
-                return E_NOINTERFACE;
-
-            ComPtr<IWICFormatConverter> FC;
-            hr = pWIC->CreateFormatConverter(FC.GetAddressOf());
-            if (FAILED(hr))
-                return hr;
-
-            BOOL canConvert = FALSE;
-            hr = FC->CanConvert(pixelFormat, convertGUID, &canConvert);
-            if (FAILED(hr) || !canConvert)
-            {
-                return E_UNEXPECTED;
-            }
-
-            hr = FC->Initialize(frame, convertGUID, WICBitmapDitherTypeErrorDiffusion, nullptr, 0, WICBitmapPaletteTypeMedianCut);
-            if (FAILED(hr))
-                return hr;
-
-            hr = FC->CopyPixels(0, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize), temp.get());
-            if (FAILED(hr))
-                return hr;
-        }
-
-        // See if format is supported for auto-gen mipmaps (varies by feature level)
-        bool autogen = false;
-        if (d3dContext != 0 && textureView != 0) // Must have context and shader-view to auto generate mipmaps
-        {
-            UINT fmtSupport = 0;
-            hr = d3dDevice->CheckFormatSupport(format, &fmtSupport);
-            if (SUCCEEDED(hr) && (fmtSupport & D3D11_FORMAT_SUPPORT_MIP_AUTOGEN))
-            {
-                autogen = true;
-            }
-        }
-
-        // Create texture
-        D3D11_TEXTURE2D_DESC desc;
-        desc.Width = twidth;
-        desc.Height = theight;
-        desc.MipLevels = (autogen) ? 0 : 1;
-        desc.ArraySize = 1;
-        desc.Format = format;
-        desc.SampleDesc.Count = 1;
-        desc.SampleDesc.Quality = 0;
-        desc.Usage = usage;
-        desc.CPUAccessFlags = cpuAccessFlags;
-
-        if (autogen)
-        {
-            desc.BindFlags = bindFlags | D3D11_BIND_RENDER_TARGET;
-            desc.MiscFlags = miscFlags | D3D11_RESOURCE_MISC_GENERATE_MIPS;
-        }
-        else
-        {
-            desc.BindFlags = bindFlags;
-            desc.MiscFlags = miscFlags;
-        }
-
-        D3D11_SUBRESOURCE_DATA initData;
-        initData.pSysMem = temp.get();
-        initData.SysMemPitch = static_cast<UINT>(rowPitch);
-        initData.SysMemSlicePitch = static_cast<UINT>(imageSize);
-
-        ID3D11Texture2D* tex = nullptr;
-        hr = d3dDevice->CreateTexture2D(&desc, (autogen) ? nullptr : &initData, &tex);
-        if (SUCCEEDED(hr) && tex != 0)
-        {
-            if (textureView != 0)
-            {
-                D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc = {};
-                SRVDesc.Format = desc.Format;
-
-                SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-                SRVDesc.Texture2D.MipLevels = (autogen) ? -1 : 1;
-
-                hr = d3dDevice->CreateShaderResourceView(tex, &SRVDesc, textureView);
-                if (FAILED(hr))
-                {
-                    tex->Release();
-                    return hr;
-                }
-
-                if (autogen)
-                {
-                    assert(d3dContext != 0);
-                    d3dContext->UpdateSubresource(tex, 0, nullptr, temp.get(), static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize));
-                    d3dContext->GenerateMips(*textureView);
-                }
-            }
-
-            if (texture != 0)
-            {
-                *texture = tex;
-            }
-            else
-            {
-                SetDebugObjectName(tex, "WICTextureLoader");
-                tex->Release();
-            }
-        }
-
-        return hr;
-    }
-} // anonymous namespace
-
-//--------------------------------------------------------------------------------------
-_Use_decl_annotations_
-HRESULT DirectX::CreateWICTextureFromMemory(ID3D11Device* d3dDevice,
-    const uint8_t* wicData,
-    size_t wicDataSize,
-    ID3D11Resource** texture,
-    ID3D11ShaderResourceView** textureView,
-    size_t maxsize)
-{
-    return CreateWICTextureFromMemoryEx(d3dDevice, nullptr, wicData, wicDataSize, maxsize,
-        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, WIC_LOADER_DEFAULT,
-        texture, textureView);
-}
-
-_Use_decl_annotations_
-HRESULT DirectX::CreateWICTextureFromMemory(ID3D11Device* d3dDevice,
-    ID3D11DeviceContext* d3dContext,
-    const uint8_t* wicData,
-    size_t wicDataSize,
-    ID3D11Resource** texture,
-    ID3D11ShaderResourceView** textureView,
-    size_t maxsize)
-{
-    return CreateWICTextureFromMemoryEx(d3dDevice, d3dContext, wicData, wicDataSize, maxsize,
-        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, WIC_LOADER_DEFAULT,
-        texture, textureView);
-}
-
-_Use_decl_annotations_
-HRESULT DirectX::CreateWICTextureFromMemoryEx(ID3D11Device* d3dDevice,
-    const uint8_t* wicData,
-    size_t wicDataSize,
-    size_t maxsize,
-    D3D11_USAGE usage,
-    unsigned int bindFlags,
-    unsigned int cpuAccessFlags,
-    unsigned int miscFlags,
-    unsigned int loadFlags,
-    ID3D11Resource** texture,
-    ID3D11ShaderResourceView** textureView)
-{
-    return CreateWICTextureFromMemoryEx(d3dDevice, nullptr, wicData, wicDataSize, maxsize,
-        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
-        texture, textureView);
-}
-
-_Use_decl_annotations_
-HRESULT DirectX::CreateWICTextureFromMemoryEx(ID3D11Device* d3dDevice,
-    ID3D11DeviceContext* d3dContext,
-    const uint8_t* wicData,
-    size_t wicDataSize,
-    size_t maxsize,
-    D3D11_USAGE usage,
-    unsigned int bindFlags,
-    unsigned int cpuAccessFlags,
-    unsigned int miscFlags,
-    unsigned int loadFlags,
-    ID3D11Resource** texture,
-    ID3D11ShaderResourceView** textureView)
-{
-    if (texture)
-    {
-        *texture = nullptr;
-    }
-    if (textureView)
-    {
-        *textureView = nullptr;
-    }
-
-    if (!d3dDevice || !wicData || (!texture && !textureView))
-        return E_INVALIDARG;
-
-    if (!wicDataSize)
-        return E_FAIL;
-
-    if (wicDataSize > UINT32_MAX)
-        return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
-
-    auto pWIC = _GetWIC();
-    if (!pWIC)
-        return E_NOINTERFACE;
-
-    // Create input stream for memory
-    ComPtr<IWICStream> stream;
-    HRESULT hr = pWIC->CreateStream(stream.GetAddressOf());
-    if (FAILED(hr))
-        return hr;
-
-    hr = stream->InitializeFromMemory(const_cast<uint8_t*>(wicData), static_cast<DWORD>(wicDataSize));
-    if (FAILED(hr))
-        return hr;
-
-    // Initialize WIC
-    ComPtr<IWICBitmapDecoder> decoder;
-    hr = pWIC->CreateDecoderFromStream(stream.Get(), 0, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
-    if (FAILED(hr))
-        return hr;
-
-    ComPtr<IWICBitmapFrameDecode> frame;
-    hr = decoder->GetFrame(0, frame.GetAddressOf());
-    if (FAILED(hr))
-        return hr;
-
-    hr = CreateTextureFromWIC(d3dDevice, d3dContext, frame.Get(), maxsize,
-        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
-        texture, textureView);
-    if (FAILED(hr))
-        return hr;
-
-    if (texture != 0 && *texture != 0)
-    {
-        SetDebugObjectName(*texture, "WICTextureLoader");
-    }
-
-    if (textureView != 0 && *textureView != 0)
-    {
-        SetDebugObjectName(*textureView, "WICTextureLoader");
-    }
-
-    return hr;
-}
-
-//--------------------------------------------------------------------------------------
-_Use_decl_annotations_
-HRESULT DirectX::CreateWICTextureFromFile(ID3D11Device* d3dDevice,
-    const wchar_t* fileName,
-    ID3D11Resource** texture,
-    ID3D11ShaderResourceView** textureView,
-    size_t maxsize)
-{
-    return CreateWICTextureFromFileEx(d3dDevice, nullptr, fileName, maxsize,
-        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, WIC_LOADER_DEFAULT,
-        texture, textureView);
-}
-
-_Use_decl_annotations_
-HRESULT DirectX::CreateWICTextureFromFile(ID3D11Device* d3dDevice,
-    ID3D11DeviceContext* d3dContext,
-    const wchar_t* fileName,
-    ID3D11Resource** texture,
-    ID3D11ShaderResourceView** textureView,
-    size_t maxsize)
-{
-    return CreateWICTextureFromFileEx(d3dDevice, d3dContext, fileName, maxsize,
-        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, WIC_LOADER_DEFAULT,
-        texture, textureView);
-}
-
-_Use_decl_annotations_
-HRESULT DirectX::CreateWICTextureFromFileEx(ID3D11Device* d3dDevice,
-    const wchar_t* fileName,
-    size_t maxsize,
-    D3D11_USAGE usage,
-    unsigned int bindFlags,
-    unsigned int cpuAccessFlags,
-    unsigned int miscFlags,
-    unsigned int loadFlags,
-    ID3D11Resource** texture,
-    ID3D11ShaderResourceView** textureView)
-{
-    return CreateWICTextureFromFileEx(d3dDevice, nullptr, fileName, maxsize,
-        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
-        texture, textureView);
-}
-
-_Use_decl_annotations_
-HRESULT DirectX::CreateWICTextureFromFileEx(ID3D11Device* d3dDevice,
-    ID3D11DeviceContext* d3dContext,
-    const wchar_t* fileName,
-    size_t maxsize,
-    D3D11_USAGE usage,
-    unsigned int bindFlags,
-    unsigned int cpuAccessFlags,
-    unsigned int miscFlags,
-    unsigned int loadFlags,
-    ID3D11Resource** texture,
-    ID3D11ShaderResourceView** textureView)
-{
-    if (texture)
-    {
-        *texture = nullptr;
-    }
-    if (textureView)
-    {
-        *textureView = nullptr;
-    }
-
-    if (!d3dDevice || !fileName || (!texture && !textureView))
-        return E_INVALIDARG;
-
-    auto pWIC = _GetWIC();
-    if (!pWIC)
-        return E_NOINTERFACE;
-
-    // Initialize WIC
-    ComPtr<IWICBitmapDecoder> decoder;
-    HRESULT hr = pWIC->CreateDecoderFromFilename(fileName, 0, GENERIC_READ, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
-    if (FAILED(hr))
-        return hr;
-
-    ComPtr<IWICBitmapFrameDecode> frame;
-    hr = decoder->GetFrame(0, frame.GetAddressOf());
-    if (FAILED(hr))
-        return hr;
-
-    hr = CreateTextureFromWIC(d3dDevice, d3dContext, frame.Get(), maxsize,
-        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
-        texture, textureView);
-
-#if !defined(NO_D3D11_DEBUG_NAME) && ( defined(_DEBUG) || defined(PROFILE) )
-    if (SUCCEEDED(hr))
-    {
-        if (texture != 0 || textureView != 0)
-        {
-            char strFileA[MAX_PATH];
-            int result = WideCharToMultiByte(CP_ACP,
-                WC_NO_BEST_FIT_CHARS,
-                fileName,
-                -1,
-                strFileA,
-                MAX_PATH,
-                nullptr,
-                FALSE
-            );
-            if (result > 0)
-            {
-                const char* pstrName = strrchr(strFileA, '\\');
-                if (!pstrName)
-                {
-                    pstrName = strFileA;
-                }
-                else
-                {
-                    pstrName++;
-                }
-
-                if (texture != 0 && *texture != 0)
-                {
-                    (*texture)->SetPrivateData(WKPDID_D3DDebugObjectName,
-                        static_cast<UINT>(strnlen_s(pstrName, MAX_PATH)),
-                        pstrName
-                    );
-                }
-
-                if (textureView != 0 && *textureView != 0)
-                {
-                    (*textureView)->SetPrivateData(WKPDID_D3DDebugObjectName,
-                        static_cast<UINT>(strnlen_s(pstrName, MAX_PATH)),
-                        pstrName
-                    );
-                }
-            }
-        }
-    }
-#endif
-
-    return hr;
-}
+//--------------------------------------------------------------------------------------
+// File: WICTextureLoader.cpp
+//
+// Function for loading a WIC image and creating a Direct3D runtime texture for it
+// (auto-generating mipmaps if possible)
+//
+// Mipmaps for 8-bit RGBA/BGRA and 16/32-bit float RGBA images are generated on the CPU
+// (see MipGenerator.h) with gamma-correct filtering, premultiplying the colour of 8-bit
+// images that have transparent pixels while they are filtered; other formats fall back
+// to the GPU auto-gen path.  8-bit images can be block compressed (BC1/BC3 or BC7, see
+// BlockCompression.h) when they are loaded.
+//
+// Note: Assumes application has already called CoInitializeEx
+//
+// Warning: CreateWICTexture* functions are not thread-safe if given a d3dContext instance for
+//          auto-gen mipmap support.
+//
+// Note these functions are useful for images created as simple 2D textures. For
+// more complex resources, DDSTextureLoader is an excellent light-weight runtime loader.
+// For a full-featured DDS file reader, writer, and texture processing pipeline see
+// the 'Texconv' sample and the 'DirectXTex' library.
+//
+// THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+// PARTICULAR PURPOSE.
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// http://go.microsoft.com/fwlink/?LinkId=248926
+// http://go.microsoft.com/fwlink/?LinkId=248929
+//--------------------------------------------------------------------------------------
+
+// We could load multi-frame images (TIFF/GIF) into a texture array.
+// For now, we just load the first frame (note: DirectXTex supports multi-frame images)
+
+#include "WICTextureLoader.h"
+#include "MipGenerator.h"
+#include "BlockCompression.h"
+#include "ImageDecoder.h"
+#include "ImageResampler.h"
+#include "DdsFile.h"
+
+#include <dxgiformat.h>
+#include <assert.h>
+
+#include <wincodec.h>
+
+#include <wrl\client.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if !defined(NO_D3D11_DEBUG_NAME) && ( defined(_DEBUG) || defined(PROFILE) )
+#pragma comment(lib,"dxguid.lib")
+#endif
+
+using namespace DirectX;
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+    //--------------------------------------------------------------------------------------
+    template<UINT TNameLength>
+    inline void SetDebugObjectName(_In_ ID3D11DeviceChild* resource, _In_ const char(&name)[TNameLength])
+    {
+#if !defined(NO_D3D11_DEBUG_NAME) && ( defined(_DEBUG) || defined(PROFILE) )
+        resource->SetPrivateData(WKPDID_D3DDebugObjectName, TNameLength - 1, name);
+#else
+        UNREFERENCED_PARAMETER(resource);
+        UNREFERENCED_PARAMETER(name);
+#endif
+    }
+
+    //-------------------------------------------------------------------------------------
+    // WIC Pixel Format Translation Data
+    //-------------------------------------------------------------------------------------
+    struct WICTranslate
+    {
+        GUID                wic;
+        DXGI_FORMAT         format;
+    };
+
+    const WICTranslate g_WICFormats[] =
+    {
+        { GUID_WICPixelFormat128bppRGBAFloat,       DXGI_FORMAT_R32G32B32A32_FLOAT },
+
+        { GUID_WICPixelFormat64bppRGBAHalf,         DXGI_FORMAT_R16G16B16A16_FLOAT },
+        { GUID_WICPixelFormat64bppRGBA,             DXGI_FORMAT_R16G16B16A16_UNORM },
+
+        { GUID_WICPixelFormat32bppRGBA,             DXGI_FORMAT_R8G8B8A8_UNORM },
+        { GUID_WICPixelFormat32bppBGRA,             DXGI_FORMAT_B8G8R8A8_UNORM }, // DXGI 1.1
+        { GUID_WICPixelFormat32bppBGR,              DXGI_FORMAT_B8G8R8X8_UNORM }, // DXGI 1.1
+
+        { GUID_WICPixelFormat32bppRGBA1010102XR,    DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM }, // DXGI 1.1
+        { GUID_WICPixelFormat32bppRGBA1010102,      DXGI_FORMAT_R10G10B10A2_UNORM },
+
+        { GUID_WICPixelFormat16bppBGRA5551,         DXGI_FORMAT_B5G5R5A1_UNORM },
+        { GUID_WICPixelFormat16bppBGR565,           DXGI_FORMAT_B5G6R5_UNORM },
+
+        { GUID_WICPixelFormat32bppGrayFloat,        DXGI_FORMAT_R32_FLOAT },
+        { GUID_WICPixelFormat16bppGrayHalf,         DXGI_FORMAT_R16_FLOAT },
+        { GUID_WICPixelFormat16bppGray,             DXGI_FORMAT_R16_UNORM },
+        { GUID_WICPixelFormat8bppGray,              DXGI_FORMAT_R8_UNORM },
+
+        { GUID_WICPixelFormat8bppAlpha,             DXGI_FORMAT_A8_UNORM },
+    };
+
+    //-------------------------------------------------------------------------------------
+    // WIC Pixel Format nearest conversion table
+    //-------------------------------------------------------------------------------------
+
+    struct WICConvert
+    {
+        GUID        source;
+        GUID        target;
+    };
+
+    const WICConvert g_WICConvert[] =
+    {
+        // Note target GUID in this conversion table must be one of those directly supported formats (above).
+
+        { GUID_WICPixelFormatBlackWhite,            GUID_WICPixelFormat8bppGray }, // DXGI_FORMAT_R8_UNORM
+
+        { GUID_WICPixelFormat1bppIndexed,           GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
+        { GUID_WICPixelFormat2bppIndexed,           GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
+        { GUID_WICPixelFormat4bppIndexed,           GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
+        { GUID_WICPixelFormat8bppIndexed,           GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
+
+        { GUID_WICPixelFormat2bppGray,              GUID_WICPixelFormat8bppGray }, // DXGI_FORMAT_R8_UNORM 
+        { GUID_WICPixelFormat4bppGray,              GUID_WICPixelFormat8bppGray }, // DXGI_FORMAT_R8_UNORM 
+
+        { GUID_WICPixelFormat16bppGrayFixedPoint,   GUID_WICPixelFormat16bppGrayHalf }, // DXGI_FORMAT_R16_FLOAT 
+        { GUID_WICPixelFormat32bppGrayFixedPoint,   GUID_WICPixelFormat32bppGrayFloat }, // DXGI_FORMAT_R32_FLOAT 
+
+        { GUID_WICPixelFormat16bppBGR555,           GUID_WICPixelFormat16bppBGRA5551 }, // DXGI_FORMAT_B5G5R5A1_UNORM
+
+        { GUID_WICPixelFormat32bppBGR101010,        GUID_WICPixelFormat32bppRGBA1010102 }, // DXGI_FORMAT_R10G10B10A2_UNORM
+
+        { GUID_WICPixelFormat24bppBGR,              GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
+        { GUID_WICPixelFormat24bppRGB,              GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
+        { GUID_WICPixelFormat32bppPBGRA,            GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
+        { GUID_WICPixelFormat32bppPRGBA,            GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM 
+
+        { GUID_WICPixelFormat48bppRGB,              GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
+        { GUID_WICPixelFormat48bppBGR,              GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
+        { GUID_WICPixelFormat64bppBGRA,             GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
+        { GUID_WICPixelFormat64bppPRGBA,            GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
+        { GUID_WICPixelFormat64bppPBGRA,            GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
+
+        { GUID_WICPixelFormat48bppRGBFixedPoint,    GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
+        { GUID_WICPixelFormat48bppBGRFixedPoint,    GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
+        { GUID_WICPixelFormat64bppRGBAFixedPoint,   GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
+        { GUID_WICPixelFormat64bppBGRAFixedPoint,   GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
+        { GUID_WICPixelFormat64bppRGBFixedPoint,    GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
+        { GUID_WICPixelFormat64bppRGBHalf,          GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
+        { GUID_WICPixelFormat48bppRGBHalf,          GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
+
+        { GUID_WICPixelFormat128bppPRGBAFloat,      GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
+        { GUID_WICPixelFormat128bppRGBFloat,        GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
+        { GUID_WICPixelFormat128bppRGBAFixedPoint,  GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
+        { GUID_WICPixelFormat128bppRGBFixedPoint,   GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
+        { GUID_WICPixelFormat32bppRGBE,             GUID_WICPixelFormat128bppRGBAFloat }, // DXGI_FORMAT_R32G32B32A32_FLOAT 
+
+        { GUID_WICPixelFormat32bppCMYK,             GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM
+        { GUID_WICPixelFormat64bppCMYK,             GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
+        { GUID_WICPixelFormat40bppCMYKAlpha,        GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM
+        { GUID_WICPixelFormat80bppCMYKAlpha,        GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
+
+    #if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
+        { GUID_WICPixelFormat32bppRGB,              GUID_WICPixelFormat32bppRGBA }, // DXGI_FORMAT_R8G8B8A8_UNORM
+        { GUID_WICPixelFormat64bppRGB,              GUID_WICPixelFormat64bppRGBA }, // DXGI_FORMAT_R16G16B16A16_UNORM
+        { GUID_WICPixelFormat64bppPRGBAHalf,        GUID_WICPixelFormat64bppRGBAHalf }, // DXGI_FORMAT_R16G16B16A16_FLOAT 
+    #endif
+
+        // We don't support n-channel formats
+    };
+
+    bool g_WIC2 = false;
+
+    //--------------------------------------------------------------------------------------
+    IWICImagingFactory* _GetWIC()
+    {
+        static INIT_ONCE s_initOnce = INIT_ONCE_STATIC_INIT;
+
+        IWICImagingFactory* factory = nullptr;
+        InitOnceExecuteOnce(&s_initOnce,
+            [](PINIT_ONCE, PVOID, PVOID *factory) -> BOOL
+        {
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
+            HRESULT hr = CoCreateInstance(
+                CLSID_WICImagingFactory2,
+                nullptr,
+                CLSCTX_INPROC_SERVER,
+                __uuidof(IWICImagingFactory2),
+                factory
+            );
+
+            if (SUCCEEDED(hr))
+            {
+                // WIC2 is available on Windows 10, Windows 8.x, and Windows 7 SP1 with KB 2670838 installed
+                g_WIC2 = true;
+                return TRUE;
+            }
+            else
+            {
+                hr = CoCreateInstance(
+                    CLSID_WICImagingFactory1,
+                    nullptr,
+                    CLSCTX_INPROC_SERVER,
+                    __uuidof(IWICImagingFactory),
+                    factory
+                );
+                return SUCCEEDED(hr) ? TRUE : FALSE;
+            }
+#else
+            return SUCCEEDED(CoCreateInstance(
+                CLSID_WICImagingFactory,
+                nullptr,
+                CLSCTX_INPROC_SERVER,
+                __uuidof(IWICImagingFactory),
+                factory)) ? TRUE : FALSE;
+#endif
+        }, nullptr, reinterpret_cast<LPVOID*>(&factory));
+
+        return factory;
+    }
+
+    //---------------------------------------------------------------------------------
+    DXGI_FORMAT _WICToDXGI(const GUID& guid)
+    {
+        for (size_t i = 0; i < _countof(g_WICFormats); ++i)
+        {
+            if (memcmp(&g_WICFormats[i].wic, &guid, sizeof(GUID)) == 0)
+                return g_WICFormats[i].format;
+        }
+
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
+        if (g_WIC2)
+        {
+            if (memcmp(&GUID_WICPixelFormat96bppRGBFloat, &guid, sizeof(GUID)) == 0)
+                return DXGI_FORMAT_R32G32B32_FLOAT;
+        }
+#endif
+
+        return DXGI_FORMAT_UNKNOWN;
+    }
+
+    //---------------------------------------------------------------------------------
+    size_t _WICBitsPerPixel(REFGUID targetGuid)
+    {
+        auto pWIC = _GetWIC();
+        if (!pWIC)
+            return 0;
+
+        ComPtr<IWICComponentInfo> cinfo;
+        if (FAILED(pWIC->CreateComponentInfo(targetGuid, cinfo.GetAddressOf())))
+            return 0;
+
+        WICComponentType type;
+        if (FAILED(cinfo->GetComponentType(&type)))
+            return 0;
+
+        if (type != WICPixelFormat)
+            return 0;
+
+        ComPtr<IWICPixelFormatInfo> pfinfo;
+        if (FAILED(cinfo.As(&pfinfo)))
+            return 0;
+
+        UINT bpp;
+        if (FAILED(pfinfo->GetBitsPerPixel(&bpp)))
+            return 0;
+
+        return bpp;
+    }
+
+
+    //--------------------------------------------------------------------------------------
+    DXGI_FORMAT MakeSRGB(_In_ DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+            return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+
+        case DXGI_FORMAT_BC1_UNORM:
+            return DXGI_FORMAT_BC1_UNORM_SRGB;
+
+        case DXGI_FORMAT_BC2_UNORM:
+            return DXGI_FORMAT_BC2_UNORM_SRGB;
+
+        case DXGI_FORMAT_BC3_UNORM:
+            return DXGI_FORMAT_BC3_UNORM_SRGB;
+
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+            return DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+
+        case DXGI_FORMAT_B8G8R8X8_UNORM:
+            return DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+
+        case DXGI_FORMAT_BC7_UNORM:
+            return DXGI_FORMAT_BC7_UNORM_SRGB;
+
+        default:
+            return format;
+        }
+    }
+
+
+    //--------------------------------------------------------------------------------------
+    bool GetMipFormat(_In_ DXGI_FORMAT format, _Out_ MipFormat& mipFormat)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+            mipFormat = MipFormat::RGBA8;
+            return true;
+
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+            mipFormat = MipFormat::RGBA16F;
+            return true;
+
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            mipFormat = MipFormat::RGBA32F;
+            return true;
+
+        default:
+            mipFormat = MipFormat::RGBA8;
+            return false;
+        }
+    }
+
+
+    //--------------------------------------------------------------------------------------
+    DXGI_FORMAT GetBlockCompressedFormat(_In_ BlockFormat blockFormat, _In_ bool srgb)
+    {
+        switch (blockFormat)
+        {
+        case BlockFormat::BC1:
+            return (srgb) ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+
+        case BlockFormat::BC3:
+            return (srgb) ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+
+        default:
+            return (srgb) ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+        }
+    }
+
+
+    //---------------------------------------------------------------------------------
+    size_t GetMaximumTextureSize(_In_ ID3D11Device* d3dDevice)
+    {
+        // This is a bit conservative because the hardware could support larger textures than
+        // the Feature Level defined minimums, but doing it this way is much easier and more
+        // performant for WIC than the 'fail and retry' model used by DDSTextureLoader
+
+        switch (d3dDevice->GetFeatureLevel())
+        {
+        case D3D_FEATURE_LEVEL_9_1:
+        case D3D_FEATURE_LEVEL_9_2:
+            return 2048 /*D3D_FL9_1_REQ_TEXTURE2D_U_OR_V_DIMENSION*/;
+
+        case D3D_FEATURE_LEVEL_9_3:
+            return 4096 /*D3D_FL9_3_REQ_TEXTURE2D_U_OR_V_DIMENSION*/;
+
+        case D3D_FEATURE_LEVEL_10_0:
+        case D3D_FEATURE_LEVEL_10_1:
+            return 8192 /*D3D10_REQ_TEXTURE2D_U_OR_V_DIMENSION*/;
+
+        default:
+            return D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION;
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // The size of an image once it has been shrunk (keeping its aspect ratio) to fit in maxsize
+    void GetTargetSize(_In_ UINT width, _In_ UINT height, _In_ size_t maxsize, _Out_ UINT& twidth, _Out_ UINT& theight)
+    {
+        if (width > maxsize || height > maxsize)
+        {
+            float ar = static_cast<float>(height) / static_cast<float>(width);
+            if (width > height)
+            {
+                twidth = static_cast<UINT>(maxsize);
+                theight = std::max<UINT>(1, static_cast<UINT>(static_cast<float>(maxsize) * ar));
+            }
+            else
+            {
+                theight = static_cast<UINT>(maxsize);
+                twidth = std::max<UINT>(1, static_cast<UINT>(static_cast<float>(maxsize) / ar));
+            }
+            assert(twidth <= maxsize && theight <= maxsize);
+        }
+        else
+        {
+            twidth = width;
+            theight = height;
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Copies the pixels of a frame, converting them to convertGUID if they are not already in it
+    HRESULT CopyConvertedPixels(_In_ IWICBitmapFrameDecode* frame,
+        _In_ const WICPixelFormatGUID& pixelFormat,
+        _In_ const WICPixelFormatGUID& convertGUID,
+        _In_ size_t rowPitch,
+        _In_ size_t imageSize,
+        _Out_writes_bytes_(imageSize) uint8_t* pixels)
+    {
+        if (memcmp(&convertGUID, &pixelFormat, sizeof(GUID)) == 0)
+            return frame->CopyPixels(0, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize), pixels);
+
+        auto pWIC = _GetWIC();
+        if (!pWIC)
+            return E_NOINTERFACE;
+
+        ComPtr<IWICFormatConverter> FC;
+        HRESULT hr = pWIC->CreateFormatConverter(FC.GetAddressOf());
+        if (FAILED(hr))
+            return hr;
+
+        BOOL canConvert = FALSE;
+        hr = FC->CanConvert(pixelFormat, convertGUID, &canConvert);
+        if (FAILED(hr) || !canConvert)
+        {
+            return E_UNEXPECTED;
+        }
+
+        hr = FC->Initialize(frame, convertGUID, WICBitmapDitherTypeErrorDiffusion, nullptr, 0, WICBitmapPaletteTypeMedianCut);
+        if (FAILED(hr))
+            return hr;
+
+        return FC->CopyPixels(0, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize), pixels);
+    }
+
+    //---------------------------------------------------------------------------------
+    // Writes a DDS file holding the mip levels a texture was created from (see DdsFile.h).
+    // The file is left empty if DDS files cannot hold the format.
+    void WriteDdsFile(_Out_ std::vector<uint8_t>& ddsFile,
+        _In_ DXGI_FORMAT format,
+        _In_ UINT width,
+        _In_ UINT height,
+        _In_ UINT mipLevels,
+        _In_reads_(mipLevels) const D3D11_SUBRESOURCE_DATA* levels)
+    {
+        ddsFile.clear();
+        size_t rowPitch, slicePitch;
+        if (!GetDdsLevelPitch(format, width, height, rowPitch, slicePitch))
+            return;
+
+        WriteDdsHeader(ddsFile, format, width, height, mipLevels);
+        for (UINT level = 0; level < mipLevels; ++level)
+        {
+            GetDdsLevelPitch(format, std::max<UINT>(width >> level, 1), std::max<UINT>(height >> level, 1), rowPitch, slicePitch);
+            // The rows the texture was created from can be padded, so copy them one at a time
+            auto source = static_cast<const uint8_t*>(levels[level].pSysMem);
+            for (size_t row = 0; row < slicePitch / rowPitch; ++row)
+            {
+                ddsFile.insert(ddsFile.end(), source + row * levels[level].SysMemPitch, source + row * levels[level].SysMemPitch + rowPitch);
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Generates the mips (at most maxMipLevels, or a full chain if it is 0), block compresses
+    // and creates the texture from decoded pixels
+    HRESULT CreateTextureFromPixels(_In_ ID3D11Device* d3dDevice,
+        _In_opt_ ID3D11DeviceContext* d3dContext,
+        _In_opt_ std::recursive_mutex* d3dContextMutex,
+        _In_ const uint8_t* pixels,
+        _In_ UINT twidth,
+        _In_ UINT theight,
+        _In_ size_t rowPitch,
+        _In_ DXGI_FORMAT format,
+        _In_ UINT maxMipLevels,
+        _In_ D3D11_USAGE usage,
+        _In_ unsigned int bindFlags,
+        _In_ unsigned int cpuAccessFlags,
+        _In_ unsigned int miscFlags,
+        _In_ unsigned int loadFlags,
+        _Outptr_opt_ ID3D11Resource** texture,
+        _Outptr_opt_ ID3D11ShaderResourceView** textureView,
+        _Out_opt_ std::vector<uint8_t>* ddsFile)
+    {
+        HRESULT hr = S_OK;
+        size_t imageSize = rowPitch * theight;
+
+        // Generate the mip chain on the CPU if the format is one we can filter
+        MipFormat mipFormat;
+        bool filterable = GetMipFormat(format, mipFormat);
+        MipChain mipChain;
+        bool cpuMips = false;
+        if (textureView != 0 && (twidth > 1 || theight > 1) && filterable)
+        {
+            MipFilter filter = (loadFlags & WIC_LOADER_MIP_KAISER) ? MipFilter::Kaiser : MipFilter::Box;
+            // Images with transparent pixels are filtered premultiplied, so their colour does not bleed in
+            MipAlpha alpha = MipAlpha::Separate;
+            if (!(loadFlags & WIC_LOADER_SEPARATE_ALPHA) && mipFormat == MipFormat::RGBA8 && !IsOpaque(pixels, twidth, theight, rowPitch))
+            {
+                alpha = MipAlpha::Straight;
+            }
+            cpuMips = GenerateMipChain(pixels, twidth, theight, rowPitch, mipFormat, !(loadFlags & WIC_LOADER_MIP_LINEAR), filter, mipChain, maxMipLevels, alpha);
+        }
+
+        UINT mipLevels = (cpuMips) ? static_cast<UINT>(mipChain.Levels.size()) : 1;
+
+        // Block compress 8-bit images if asked to (the top level of a block compressed texture has to be a
+        // multiple of 4 pixels each way)
+        DXGI_FORMAT compressedFormat = DXGI_FORMAT_UNKNOWN;
+        BlockFormat blockFormat = BlockFormat::BC1;
+        std::vector<std::vector<uint8_t>> blocks;
+        if ((loadFlags & (WIC_LOADER_BLOCK_COMPRESS | WIC_LOADER_BLOCK_COMPRESS_BC7)) && filterable && mipFormat == MipFormat::RGBA8
+            && (twidth % 4) == 0 && (theight % 4) == 0)
+        {
+            bool bgra = (format == DXGI_FORMAT_B8G8R8A8_UNORM || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB);
+            bool srgb = (format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB);
+            if (loadFlags & WIC_LOADER_BLOCK_COMPRESS_BC7)
+            {
+                blockFormat = BlockFormat::BC7;
+            }
+            else
+            {
+                blockFormat = IsOpaque(pixels, twidth, theight, rowPitch) ? BlockFormat::BC1 : BlockFormat::BC3;
+            }
+            compressedFormat = GetBlockCompressedFormat(blockFormat, srgb);
+
+            UINT fmtSupport = 0;
+            hr = d3dDevice->CheckFormatSupport(compressedFormat, &fmtSupport);
+            if (SUCCEEDED(hr) && (fmtSupport & D3D11_FORMAT_SUPPORT_TEXTURE2D))
+            {
+                blocks.resize(mipLevels);
+                for (UINT level = 0; level < mipLevels; ++level)
+                {
+                    if (cpuMips)
+                    {
+                        const MipLevel& mipLevel = mipChain.Levels[level];
+                        CompressBlocks(mipChain.GetLevelPixels(level), mipLevel.Width, mipLevel.Height, mipLevel.RowPitch, bgra,
+                            blockFormat, BlockQuality::Normal, blocks[level]);
+                    }
+                    else
+                    {
+                        CompressBlocks(pixels, twidth, theight, rowPitch, bgra, blockFormat, BlockQuality::Normal, blocks[level]);
+                    }
+                }
+            }
+            else
+            {
+                compressedFormat = DXGI_FORMAT_UNKNOWN;
+            }
+        }
+
+        // Otherwise, see if format is supported for auto-gen mipmaps (varies by feature level)
+        bool autogen = false;
+        if (!cpuMips && compressedFormat == DXGI_FORMAT_UNKNOWN && d3dContext != 0 && textureView != 0) // Must have context and shader-view to auto generate mipmaps
+        {
+            UINT fmtSupport = 0;
+            hr = d3dDevice->CheckFormatSupport(format, &fmtSupport);
+            if (SUCCEEDED(hr) && (fmtSupport & D3D11_FORMAT_SUPPORT_MIP_AUTOGEN))
+            {
+                autogen = true;
+            }
+        }
+
+        // Create texture
+        D3D11_TEXTURE2D_DESC desc;
+        desc.Width = twidth;
+        desc.Height = theight;
+        desc.MipLevels = (autogen) ? 0 : mipLevels;
+        desc.ArraySize = 1;
+        desc.Format = (compressedFormat != DXGI_FORMAT_UNKNOWN) ? compressedFormat : format;
+        desc.SampleDesc.Count = 1;
+        desc.SampleDesc.Quality = 0;
+        desc.Usage = usage;
+        desc.CPUAccessFlags = cpuAccessFlags;
+
+        if (autogen)
+        {
+            desc.BindFlags = bindFlags | D3D11_BIND_RENDER_TARGET;
+            desc.MiscFlags = miscFlags | D3D11_RESOURCE_MISC_GENERATE_MIPS;
+        }
+        else
+        {
+            desc.BindFlags = bindFlags;
+            desc.MiscFlags = miscFlags;
+        }
+
+        std::unique_ptr<D3D11_SUBRESOURCE_DATA[]> initData(new (std::nothrow) D3D11_SUBRESOURCE_DATA[mipLevels]);
+        if (!initData)
+            return E_OUTOFMEMORY;
+
+        if (compressedFormat != DXGI_FORMAT_UNKNOWN)
+        {
+            for (UINT level = 0; level < mipLevels; ++level)
+            {
+                UINT levelWidth = (cpuMips) ? mipChain.Levels[level].Width : twidth;
+                initData[level].pSysMem = blocks[level].data();
+                initData[level].SysMemPitch = static_cast<UINT>(GetBlockRowPitch(blockFormat, levelWidth));
+                initData[level].SysMemSlicePitch = static_cast<UINT>(blocks[level].size());
+            }
+        }
+        else if (cpuMips)
+        {
+            for (UINT level = 0; level < mipLevels; ++level)
+            {
+                const MipLevel& mipLevel = mipChain.Levels[level];
+                initData[level].pSysMem = mipChain.GetLevelPixels(level);
+                initData[level].SysMemPitch = static_cast<UINT>(mipLevel.RowPitch);
+                initData[level].SysMemSlicePitch = static_cast<UINT>(mipLevel.RowPitch * mipLevel.Height);
+            }
+        }
+        else
+        {
+            initData[0].pSysMem = pixels;
+            initData[0].SysMemPitch = static_cast<UINT>(rowPitch);
+            initData[0].SysMemSlicePitch = static_cast<UINT>(imageSize);
+        }
+
+        ID3D11Texture2D* tex = nullptr;
+        hr = d3dDevice->CreateTexture2D(&desc, (autogen) ? nullptr : initData.get(), &tex);
+        if (SUCCEEDED(hr) && tex != 0)
+        {
+            if (textureView != 0)
+            {
+                D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc = {};
+                SRVDesc.Format = desc.Format;
+
+                SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+                SRVDesc.Texture2D.MipLevels = (autogen) ? -1 : mipLevels;
+
+                hr = d3dDevice->CreateShaderResourceView(tex, &SRVDesc, textureView);
+                if (FAILED(hr))
+                {
+                    tex->Release();
+                    return hr;
+                }
+
+                if (autogen)
+                {
+                    assert(d3dContext != 0);
+                    std::unique_lock<std::recursive_mutex> lock;
+                    if (d3dContextMutex)
+                    {
+                        lock = std::unique_lock<std::recursive_mutex>(*d3dContextMutex);
+                    }
+                    d3dContext->UpdateSubresource(tex, 0, nullptr, pixels, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize));
+                    d3dContext->GenerateMips(*textureView);
+                }
+            }
+
+            // Keep the texture as it was created, so that it can be loaded again without being decoded
+            if (ddsFile != 0 && !autogen)
+            {
+                WriteDdsFile(*ddsFile, desc.Format, twidth, theight, mipLevels, initData.get());
+            }
+
+            if (texture != 0)
+            {
+                *texture = tex;
+            }
+            else
+            {
+                SetDebugObjectName(tex, "WICTextureLoader");
+                tex->Release();
+            }
+        }
+
+        return hr;
+    }
+
+    //---------------------------------------------------------------------------------
+    HRESULT CreateTextureFromWIC(_In_ ID3D11Device* d3dDevice,
+        _In_opt_ ID3D11DeviceContext* d3dContext,
+        _In_opt_ std::recursive_mutex* d3dContextMutex,
+        _In_ IWICBitmapFrameDecode *frame,
+        _In_ size_t maxsize,
+        _In_ D3D11_USAGE usage,
+        _In_ unsigned int bindFlags,
+        _In_ unsigned int cpuAccessFlags,
+        _In_ unsigned int miscFlags,
+        _In_ unsigned int loadFlags,
+        _Outptr_opt_ ID3D11Resource** texture,
+        _Outptr_opt_ ID3D11ShaderResourceView** textureView,
+        _Out_opt_ std::vector<uint8_t>* ddsFile)
+    {
+        UINT width, height;
+        HRESULT hr = frame->GetSize(&width, &height);
+        if (FAILED(hr))
+            return hr;
+
+        assert(width > 0 && height > 0);
+
+        if (!maxsize)
+        {
+            maxsize = GetMaximumTextureSize(d3dDevice);
+        }
+
+        assert(maxsize > 0);
+
+        UINT twidth, theight;
+        GetTargetSize(width, height, maxsize, twidth, theight);
+
+        // Determine format
+        WICPixelFormatGUID pixelFormat;
+        hr = frame->GetPixelFormat(&pixelFormat);
+        if (FAILED(hr))
+            return hr;
+
+        WICPixelFormatGUID convertGUID;
+        memcpy(&convertGUID, &pixelFormat, sizeof(WICPixelFormatGUID));
+
+        size_t bpp = 0;
+
+        DXGI_FORMAT format = _WICToDXGI(pixelFormat);
+        if (format == DXGI_FORMAT_UNKNOWN)
+        {
+            if (memcmp(&GUID_WICPixelFormat96bppRGBFixedPoint, &pixelFormat, sizeof(WICPixelFormatGUID)) == 0)
+            {
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
+                if (g_WIC2)
+                {
+                    memcpy(&convertGUID, &GUID_WICPixelFormat96bppRGBFloat, sizeof(WICPixelFormatGUID));
+                    format = DXGI_FORMAT_R32G32B32_FLOAT;
+                    bpp = 96;
+                }
+                else
+#endif
+                {
+                    memcpy(&convertGUID, &GUID_WICPixelFormat128bppRGBAFloat, sizeof(WICPixelFormatGUID));
+                    format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+                    bpp = 128;
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < _countof(g_WICConvert); ++i)
+                {
+                    if (memcmp(&g_WICConvert[i].source, &pixelFormat, sizeof(WICPixelFormatGUID)) == 0)
+                    {
+                        memcpy(&convertGUID, &g_WICConvert[i].target, sizeof(WICPixelFormatGUID));
+
+                        format = _WICToDXGI(g_WICConvert[i].target);
+                        assert(format != DXGI_FORMAT_UNKNOWN);
+                        bpp = _WICBitsPerPixel(convertGUID);
+                        break;
+                    }
+                }
+            }
+
+            if (format == DXGI_FORMAT_UNKNOWN)
+                return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+        else
+        {
+            bpp = _WICBitsPerPixel(pixelFormat);
+        }
+
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(_WIN7_PLATFORM_UPDATE)
+        if ((format == DXGI_FORMAT_R32G32B32_FLOAT) && d3dContext != 0 && textureView != 0)
+        {
+            // Special case test for optional device support for autogen mipchains for R32G32B32_FLOAT 
+            UINT fmtSupport = 0;
+            hr = d3dDevice->CheckFormatSupport(DXGI_FORMAT_R32G32B32_FLOAT, &fmtSupport);
+            if (FAILED(hr) || !(fmtSupport & D3D11_FORMAT_SUPPORT_MIP_AUTOGEN))
+            {
+                // Use R32G32B32A32_FLOAT instead which is required for Feature Level 10.0 and up
+                memcpy(&convertGUID, &GUID_WICPixelFormat128bppRGBAFloat, sizeof(WICPixelFormatGUID));
+                format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+                bpp = 128;
+            }
+        }
+#endif
+
+        if (!bpp)
+            return E_FAIL;
+
+        // Handle sRGB formats
+        if (loadFlags & WIC_LOADER_FORCE_SRGB)
+        {
+            format = MakeSRGB(format);
+        }
+        else if (!(loadFlags & WIC_LOADER_IGNORE_SRGB))
+        {
+            ComPtr<IWICMetadataQueryReader> metareader;
+            if (SUCCEEDED(frame->GetMetadataQueryReader(metareader.GetAddressOf())))
+            {
+                GUID containerFormat;
+                if (SUCCEEDED(metareader->GetContainerFormat(&containerFormat)))
+                {
+                    // Check for sRGB colorspace metadata
+                    bool sRGB = false;
+
+                    PROPVARIANT value;
+                    PropVariantInit(&value);
+
+                    if (memcmp(&containerFormat, &GUID_ContainerFormatPng, sizeof(GUID)) == 0)
+                    {
+                        // Check for sRGB chunk
+                        if (SUCCEEDED(metareader->GetMetadataByName(L"/sRGB/RenderingIntent", &value)) && value.vt == VT_UI1)
+                        {
+                            sRGB = true;
+                        }
+                    }
+                    else if (SUCCEEDED(metareader->GetMetadataByName(L"System.Image.ColorSpace", &value)) && value.vt == VT_UI2 && value.uiVal == 1)
+                    {
+                        sRGB = true;
+                    }
+
+                    (void)PropVariantClear(&value);
+
+                    if (sRGB)
+                        format = MakeSRGB(format);
+                }
+            }
+        }
+
+        // Verify our target format is supported by the current device
+        // (handles WDDM 1.0 or WDDM 1.1 device driver cases as well as DirectX 11.0 Runtime without 16bpp format support)
+        UINT support = 0;
+        hr = d3dDevice->CheckFormatSupport(format, &support);
+        if (FAILED(hr) || !(support & D3D11_FORMAT_SUPPORT_TEXTURE2D))
+        {
+            // Fallback to RGBA 32-bit format which is supported by all devices
+            memcpy(&convertGUID, &GUID_WICPixelFormat32bppRGBA, sizeof(WICPixelFormatGUID));
+            format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            bpp = 32;
+        }
+
+        // Allocate temporary memory for image
+        size_t rowPitch = (twidth * bpp + 7) / 8;
+        size_t imageSize = rowPitch * theight;
+
+        std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[imageSize]);
+        if (!temp)
+            return E_OUTOFMEMORY;
+
+        // Load image data
+        MipFormat resampleFormat;
+        if ((twidth != width || theight != height) && GetMipFormat(format, resampleFormat))
+        {
+            // Resize on the CPU (see ImageResampler.h)
+            size_t sourceRowPitch = (width * bpp + 7) / 8;
+            size_t sourceSize = sourceRowPitch * height;
+            std::unique_ptr<uint8_t[]> source(new (std::nothrow) uint8_t[sourceSize]);
+            if (!source)
+                return E_OUTOFMEMORY;
+
+            hr = CopyConvertedPixels(frame, pixelFormat, convertGUID, sourceRowPitch, sourceSize, source.get());
+            if (FAILED(hr))
+                return hr;
+
+            ResampleAlpha alpha = ResampleAlpha::Separate;
+            if (!(loadFlags & WIC_LOADER_SEPARATE_ALPHA) && resampleFormat == ResampleFormat::RGBA8 && !IsOpaque(source.get(), width, height, sourceRowPitch))
+            {
+                alpha = ResampleAlpha::Straight;
+            }
+            ResampleImage(source.get(), width, height, sourceRowPitch, temp.get(), twidth, theight, rowPitch,
+                resampleFormat, !(loadFlags & WIC_LOADER_MIP_LINEAR), ResampleFilter::Mitchell, alpha);
+        }
+        else if (twidth != width || theight != height)
+        {
+            // Resize with WIC, for the formats we cannot filter
+            auto pWIC = _GetWIC();
+            if (!pWIC)
+                return E_NOINTERFACE;
+
+            ComPtr<IWICBitmapScaler> scaler;
+            hr = pWIC->CreateBitmapScaler(scaler.GetAddressOf());
+            if (FAILED(hr))
+                return hr;
+
+            hr = scaler->Initialize(frame, twidth, theight, WICBitmapInterpolationModeFant);
+            if (FAILED(hr))
+                return hr;
+
+            WICPixelFormatGUID pfScaler;
+            hr = scaler->GetPixelFormat(&pfScaler);
+            if (FAILED(hr))
+                return hr;
+
+            if (memcmp(&convertGUID, &pfScaler, sizeof(GUID)) == 0)
+            {
+                // No format conversion needed
+                hr = scaler->CopyPixels(0, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize), temp.get());
+                if (FAILED(hr))
+                    return hr;
+            }
+            else
+            {
+                ComPtr<IWICFormatConverter> FC;
+                hr = pWIC->CreateFormatConverter(FC.GetAddressOf());
+                if (FAILED(hr))
+                    return hr;
+
+                BOOL canConvert = FALSE;
+                hr = FC->CanConvert(pfScaler, convertGUID, &canConvert);
+                if (FAILED(hr) || !canConvert)
+                {
+                    return E_UNEXPECTED;
+                }
+
+                hr = FC->Initialize(scaler.Get(), convertGUID, WICBitmapDitherTypeErrorDiffusion, nullptr, 0, WICBitmapPaletteTypeMedianCut);
+                if (FAILED(hr))
+                    return hr;
+
+                hr = FC->CopyPixels(0, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize), temp.get());
+                if (FAILED(hr))
+                    return hr;
+            }
+        }
+        else
+        {
+            hr = CopyConvertedPixels(frame, pixelFormat, convertGUID, rowPitch, imageSize, temp.get());
+            if (FAILED(hr))
+                return hr;
+        }
+
+        return CreateTextureFromPixels(d3dDevice, d3dContext, d3dContextMutex, temp.get(), twidth, theight, rowPitch, format, 0,
+            usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags, texture, textureView, ddsFile);
+    }
+
+    //---------------------------------------------------------------------------------
+    // BMP, TGA and PNG files are decoded without WIC (see ImageDecoder.h).  Returns
+    // ERROR_NOT_SUPPORTED for the files WIC has to handle: other formats and the ones the
+    // decoder cannot read.
+    HRESULT CreateTextureFromDecodedImage(_In_ ID3D11Device* d3dDevice,
+        _In_opt_ ID3D11DeviceContext* d3dContext,
+        _In_opt_ std::recursive_mutex* d3dContextMutex,
+        _In_reads_bytes_(imageDataSize) const uint8_t* imageData,
+        _In_ size_t imageDataSize,
+        _In_ size_t maxsize,
+        _In_ D3D11_USAGE usage,
+        _In_ unsigned int bindFlags,
+        _In_ unsigned int cpuAccessFlags,
+        _In_ unsigned int miscFlags,
+        _In_ unsigned int loadFlags,
+        _Outptr_opt_ ID3D11Resource** texture,
+        _Outptr_opt_ ID3D11ShaderResourceView** textureView,
+        _Out_opt_ std::vector<uint8_t>* ddsFile)
+    {
+        ImageInfo info;
+        if (!ReadImageInfo(imageData, imageDataSize, info))
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+        if (!maxsize)
+        {
+            maxsize = GetMaximumTextureSize(d3dDevice);
+        }
+
+        size_t rowPitch = static_cast<size_t>(info.Width) * 4;
+        std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[rowPitch * info.Height]);
+        if (!temp)
+            return E_OUTOFMEMORY;
+
+        if (!DecodeImage(imageData, imageDataSize, temp.get(), rowPitch))
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+        // Shrink images that are too big (see ImageResampler.h)
+        UINT twidth, theight;
+        GetTargetSize(info.Width, info.Height, maxsize, twidth, theight);
+        if (twidth != info.Width || theight != info.Height)
+        {
+            size_t resizedRowPitch = static_cast<size_t>(twidth) * 4;
+            std::unique_ptr<uint8_t[]> resized(new (std::nothrow) uint8_t[resizedRowPitch * theight]);
+            if (!resized)
+                return E_OUTOFMEMORY;
+
+            bool straightAlpha = info.HasAlpha && !(loadFlags & WIC_LOADER_SEPARATE_ALPHA);
+            ResampleImage(temp.get(), info.Width, info.Height, rowPitch, resized.get(), twidth, theight, resizedRowPitch,
+                ResampleFormat::RGBA8, !(loadFlags & WIC_LOADER_MIP_LINEAR), ResampleFilter::Mitchell,
+                straightAlpha ? ResampleAlpha::Straight : ResampleAlpha::Separate);
+            temp = std::move(resized);
+            rowPitch = resizedRowPitch;
+        }
+
+        DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        if ((loadFlags & WIC_LOADER_FORCE_SRGB) || (info.Srgb && !(loadFlags & WIC_LOADER_IGNORE_SRGB)))
+        {
+            format = MakeSRGB(format);
+        }
+
+        return CreateTextureFromPixels(d3dDevice, d3dContext, d3dContextMutex, temp.get(), twidth, theight, rowPitch, format, 0,
+            usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags, texture, textureView, ddsFile);
+    }
+} // anonymous namespace
+
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromMemory(ID3D11Device* d3dDevice,
+    const uint8_t* wicData,
+    size_t wicDataSize,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView,
+    size_t maxsize)
+{
+    return CreateWICTextureFromMemoryEx(d3dDevice, nullptr, wicData, wicDataSize, maxsize,
+        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, WIC_LOADER_DEFAULT,
+        texture, textureView);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromMemory(ID3D11Device* d3dDevice,
+    ID3D11DeviceContext* d3dContext,
+    const uint8_t* wicData,
+    size_t wicDataSize,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView,
+    size_t maxsize)
+{
+    return CreateWICTextureFromMemoryEx(d3dDevice, d3dContext, wicData, wicDataSize, maxsize,
+        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, WIC_LOADER_DEFAULT,
+        texture, textureView);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromMemoryEx(ID3D11Device* d3dDevice,
+    const uint8_t* wicData,
+    size_t wicDataSize,
+    size_t maxsize,
+    D3D11_USAGE usage,
+    unsigned int bindFlags,
+    unsigned int cpuAccessFlags,
+    unsigned int miscFlags,
+    unsigned int loadFlags,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView)
+{
+    return CreateWICTextureFromMemoryEx(d3dDevice, nullptr, wicData, wicDataSize, maxsize,
+        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
+        texture, textureView);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromMemoryEx(ID3D11Device* d3dDevice,
+    ID3D11DeviceContext* d3dContext,
+    const uint8_t* wicData,
+    size_t wicDataSize,
+    size_t maxsize,
+    D3D11_USAGE usage,
+    unsigned int bindFlags,
+    unsigned int cpuAccessFlags,
+    unsigned int miscFlags,
+    unsigned int loadFlags,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView,
+    std::recursive_mutex* d3dContextMutex,
+    std::vector<uint8_t>* ddsFile)
+{
+    if (texture)
+    {
+        *texture = nullptr;
+    }
+    if (textureView)
+    {
+        *textureView = nullptr;
+    }
+    if (ddsFile)
+    {
+        ddsFile->clear();
+    }
+
+    if (!d3dDevice || !wicData || (!texture && !textureView))
+        return E_INVALIDARG;
+
+    if (!wicDataSize)
+        return E_FAIL;
+
+    HRESULT hr = CreateTextureFromDecodedImage(d3dDevice, d3dContext, d3dContextMutex, wicData, wicDataSize, maxsize,
+        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
+        texture, textureView, ddsFile);
+    if (hr != HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED))
+    {
+        if (SUCCEEDED(hr) && texture != 0 && *texture != 0)
+        {
+            SetDebugObjectName(*texture, "WICTextureLoader");
+        }
+
+        if (SUCCEEDED(hr) && textureView != 0 && *textureView != 0)
+        {
+            SetDebugObjectName(*textureView, "WICTextureLoader");
+        }
+
+        return hr;
+    }
+
+    if (wicDataSize > UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+
+    auto pWIC = _GetWIC();
+    if (!pWIC)
+        return E_NOINTERFACE;
+
+    // Create input stream for memory
+    ComPtr<IWICStream> stream;
+    hr = pWIC->CreateStream(stream.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    hr = stream->InitializeFromMemory(const_cast<uint8_t*>(wicData), static_cast<DWORD>(wicDataSize));
+    if (FAILED(hr))
+        return hr;
+
+    // Initialize WIC
+    ComPtr<IWICBitmapDecoder> decoder;
+    hr = pWIC->CreateDecoderFromStream(stream.Get(), 0, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    ComPtr<IWICBitmapFrameDecode> frame;
+    hr = decoder->GetFrame(0, frame.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    hr = CreateTextureFromWIC(d3dDevice, d3dContext, d3dContextMutex, frame.Get(), maxsize,
+        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
+        texture, textureView, ddsFile);
+    if (FAILED(hr))
+        return hr;
+
+    if (texture != 0 && *texture != 0)
+    {
+        SetDebugObjectName(*texture, "WICTextureLoader");
+    }
+
+    if (textureView != 0 && *textureView != 0)
+    {
+        SetDebugObjectName(*textureView, "WICTextureLoader");
+    }
+
+    return hr;
+}
+
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromFile(ID3D11Device* d3dDevice,
+    const wchar_t* fileName,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView,
+    size_t maxsize)
+{
+    return CreateWICTextureFromFileEx(d3dDevice, nullptr, fileName, maxsize,
+        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, WIC_LOADER_DEFAULT,
+        texture, textureView);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromFile(ID3D11Device* d3dDevice,
+    ID3D11DeviceContext* d3dContext,
+    const wchar_t* fileName,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView,
+    size_t maxsize)
+{
+    return CreateWICTextureFromFileEx(d3dDevice, d3dContext, fileName, maxsize,
+        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, WIC_LOADER_DEFAULT,
+        texture, textureView);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromFileEx(ID3D11Device* d3dDevice,
+    const wchar_t* fileName,
+    size_t maxsize,
+    D3D11_USAGE usage,
+    unsigned int bindFlags,
+    unsigned int cpuAccessFlags,
+    unsigned int miscFlags,
+    unsigned int loadFlags,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView)
+{
+    return CreateWICTextureFromFileEx(d3dDevice, nullptr, fileName, maxsize,
+        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
+        texture, textureView);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromFileEx(ID3D11Device* d3dDevice,
+    ID3D11DeviceContext* d3dContext,
+    const wchar_t* fileName,
+    size_t maxsize,
+    D3D11_USAGE usage,
+    unsigned int bindFlags,
+    unsigned int cpuAccessFlags,
+    unsigned int miscFlags,
+    unsigned int loadFlags,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView,
+    std::recursive_mutex* d3dContextMutex,
+    std::vector<uint8_t>* ddsFile)
+{
+    if (texture)
+    {
+        *texture = nullptr;
+    }
+    if (textureView)
+    {
+        *textureView = nullptr;
+    }
+
+    if (!d3dDevice || !fileName || (!texture && !textureView))
+        return E_INVALIDARG;
+
+    auto pWIC = _GetWIC();
+    if (!pWIC)
+        return E_NOINTERFACE;
+
+    // Initialize WIC
+    ComPtr<IWICBitmapDecoder> decoder;
+    HRESULT hr = pWIC->CreateDecoderFromFilename(fileName, 0, GENERIC_READ, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    ComPtr<IWICBitmapFrameDecode> frame;
+    hr = decoder->GetFrame(0, frame.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    hr = CreateTextureFromWIC(d3dDevice, d3dContext, d3dContextMutex, frame.Get(), maxsize,
+        usage, bindFlags, cpuAccessFlags, miscFlags, loadFlags,
+        texture, textureView, ddsFile);
+
+#if !defined(NO_D3D11_DEBUG_NAME) && ( defined(_DEBUG) || defined(PROFILE) )
+    if (SUCCEEDED(hr))
+    {
+        if (texture != 0 || textureView != 0)
+        {
+            char strFileA[MAX_PATH];
+            int result = WideCharToMultiByte(CP_ACP,
+                WC_NO_BEST_FIT_CHARS,
+                fileName,
+                -1,
+                strFileA,
+                MAX_PATH,
+                nullptr,
+                FALSE
+            );
+            if (result > 0)
+            {
+                const char* pstrName = strrchr(strFileA, '\\');
+                if (!pstrName)
+                {
+                    pstrName = strFileA;
+                }
+                else
+                {
+                    pstrName++;
+                }
+
+                if (texture != 0 && *texture != 0)
+                {
+                    (*texture)->SetPrivateData(WKPDID_D3DDebugObjectName,
+                        static_cast<UINT>(strnlen_s(pstrName, MAX_PATH)),
+                        pstrName
+                    );
+                }
+
+                if (textureView != 0 && *textureView != 0)
+                {
+                    (*textureView)->SetPrivateData(WKPDID_D3DDebugObjectName,
+                        static_cast<UINT>(strnlen_s(pstrName, MAX_PATH)),
+                        pstrName
+                    );
+                }
+            }
+        }
+    }
+#endif
+
+    return hr;
+}
+
+
+_Use_decl_annotations_
+HRESULT DirectX::CreateTextureFromRGBAPixels(ID3D11Device* d3dDevice,
+    const uint8_t* pixels,
+    UINT width,
+    UINT height,
+    size_t rowPitch,
+    UINT maxMipLevels,
+    unsigned int loadFlags,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView)
+{
+    if (texture)
+    {
+        *texture = nullptr;
+    }
+    if (textureView)
+    {
+        *textureView = nullptr;
+    }
+
+    if (!d3dDevice || !pixels || !width || !height || (!texture && !textureView))
+        return E_INVALIDARG;
+
+    size_t maxsize = GetMaximumTextureSize(d3dDevice);
+    if (width > maxsize || height > maxsize)
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    DXGI_FORMAT format = (loadFlags & WIC_LOADER_FORCE_SRGB) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+    HRESULT hr = CreateTextureFromPixels(d3dDevice, nullptr, nullptr, pixels, width, height, rowPitch, format, maxMipLevels,
+        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, loadFlags, texture, textureView, nullptr);
+
+    if (SUCCEEDED(hr) && texture != 0 && *texture != 0)
+    {
+        SetDebugObjectName(*texture, "WICTextureLoader");
+    }
+
+    if (SUCCEEDED(hr) && textureView != 0 && *textureView != 0)
+    {
+        SetDebugObjectName(*textureView, "WICTextureLoader");
+    }
+
+    return hr;
+}
+
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+size_t DirectX::GetWICMaximumTextureSize(ID3D11Device* d3dDevice)
+{
+    return GetMaximumTextureSize(d3dDevice);
+}
+
+_Use_decl_annotations_
+DXGI_FORMAT DirectX::GetWICBlockCompressedFormat(ID3D11Device* d3dDevice, unsigned int loadFlags)
+{
+    if (!(loadFlags & (WIC_LOADER_BLOCK_COMPRESS | WIC_LOADER_BLOCK_COMPRESS_BC7)))
+        return DXGI_FORMAT_UNKNOWN;
+
+    DXGI_FORMAT format = GetBlockCompressedFormat((loadFlags & WIC_LOADER_BLOCK_COMPRESS_BC7) ? BlockFormat::BC7 : BlockFormat::BC1, false);
+    UINT fmtSupport = 0;
+    HRESULT hr = d3dDevice->CheckFormatSupport(format, &fmtSupport);
+    if (FAILED(hr) || !(fmtSupport & D3D11_FORMAT_SUPPORT_TEXTURE2D))
+        return DXGI_FORMAT_UNKNOWN;
+
+    return format;
+}